@@ -3,6 +3,7 @@
 #include "Channels/MovieSceneFloatPerlinNoiseChannel.h"
 #include "MovieScene.h"
 #include "MovieSceneSection.h"
+#include "Channels/MovieScenePerlinNoiseBatch.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(MovieSceneFloatPerlinNoiseChannel)
 
@@ -38,3 +39,32 @@ float FMovieSceneFloatPerlinNoiseChannel::Evaluate(const FPerlinNoiseParams& InP
 	return Result;
 }
 
+void FMovieSceneFloatPerlinNoiseChannel::EvaluateBatch(TArrayView<const FPerlinNoiseParams> InParams, TArrayView<const double> InSeconds, TArrayView<double> OutResults)
+{
+	check(InParams.Num() == InSeconds.Num() && InParams.Num() == OutResults.Num());
+
+	// Process in fixed-size chunks so the noise inputs can be staged on the stack
+	constexpr int32 ChunkSize = 64;
+
+	float NoiseInputs[ChunkSize];
+	float Noise[ChunkSize];
+
+	const int32 Num = InParams.Num();
+	for (int32 ChunkStart = 0; ChunkStart < Num; ChunkStart += ChunkSize)
+	{
+		const int32 ChunkNum = FMath::Min(ChunkSize, Num - ChunkStart);
+		for (int32 Index = 0; Index < ChunkNum; ++Index)
+		{
+			const FPerlinNoiseParams& Params = InParams[ChunkStart + Index];
+			NoiseInputs[Index] = static_cast<float>((InSeconds[ChunkStart + Index] + Params.Offset) * Params.Frequency);
+		}
+
+		UE::MovieScene::PerlinNoise1D_Batch(NoiseInputs, Noise, ChunkNum);
+
+		for (int32 Index = 0; Index < ChunkNum; ++Index)
+		{
+			const FPerlinNoiseParams& Params = InParams[ChunkStart + Index];
+			OutResults[ChunkStart + Index] = static_cast<double>(static_cast<float>(Noise[Index] * Params.Amplitude));
+		}
+	}
+}
@@ -0,0 +1,106 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Channels/MovieScenePerlinNoiseBatch.h"
+#include "Math/UnrealMathUtility.h"
+#include "Math/VectorRegister.h"
+
+namespace UE::MovieScene
+{
+
+/**
+ * Per-lattice-point gradients used by FMath::PerlinNoise1D.
+ *
+ * The permutation and gradient tables used by FMath::PerlinNoise1D are private to Core, so we recover the gradient for
+ * each of the 256 lattice points by sampling the scalar implementation a tiny distance past each point where the
+ * fade curve is effectively zero and noise(i + t) == 0.5 * Gradient(i) * t. All gradients are multiples of 1/8,
+ * so rounding the estimate recovers them exactly.
+ */
+struct FPerlinNoise1DGradients
+{
+	/** 257 entries so that Gradients[Xi + 1] never needs to be wrapped */
+	float Gradients[257];
+
+	FPerlinNoise1DGradients()
+	{
+		constexpr float SampleOffset = 1.f / 1024.f;
+		for (int32 Index = 0; Index < 256; ++Index)
+		{
+			const float Noise    = FMath::PerlinNoise1D(static_cast<float>(Index) + SampleOffset);
+			const float Estimate = Noise / (0.5f * SampleOffset);
+
+			Gradients[Index] = FMath::RoundToFloat(Estimate * 8.f) / 8.f;
+		}
+		Gradients[256] = Gradients[0];
+	}
+
+	static const FPerlinNoise1DGradients& Get()
+	{
+		static const FPerlinNoise1DGradients Instance;
+		return Instance;
+	}
+};
+
+FORCEINLINE float PerlinNoise1D_Scalar(const float* Gradients, float X)
+{
+	// Identical operation order to FMath::PerlinNoise1D
+	const float Xfl = FMath::FloorToFloat(X);
+	const int32 Xi  = static_cast<int32>(Xfl) & 255;
+	const float X0  = X - Xfl;
+	const float X1  = X0 - 1.0f;
+
+	const float A     = Gradients[Xi] * X0;
+	const float B     = Gradients[Xi + 1] * X1;
+	const float Alpha = X0 * X0 * X0 * (X0 * (X0 * 6.0f - 15.0f) + 10.0f);
+
+	return 0.5f * (A + Alpha * (B - A));
+}
+
+void PerlinNoise1D_Batch(const float* InValues, float* OutNoise, int32 Num)
+{
+	const float* Gradients = FPerlinNoise1DGradients::Get().Gradients;
+
+	const VectorRegister4Float Half    = VectorSetFloat1(0.5f);
+	const VectorRegister4Float Six     = VectorSetFloat1(6.0f);
+	const VectorRegister4Float Fifteen = VectorSetFloat1(15.0f);
+	const VectorRegister4Float Ten     = VectorSetFloat1(10.0f);
+	const VectorRegister4Float One     = VectorOneFloat();
+
+	int32 Index = 0;
+	for ( ; Index + 4 <= Num; Index += 4)
+	{
+		const VectorRegister4Float X   = VectorLoad(InValues + Index);
+		const VectorRegister4Float Xfl = VectorFloor(X);
+		const VectorRegister4Float X0  = VectorSubtract(X, Xfl);
+		const VectorRegister4Float X1  = VectorSubtract(X0, One);
+
+		// Gradient lookups have no portable vector gather, so they are the only scalar part of the kernel
+		alignas(16) float Floors[4];
+		alignas(16) float G0[4];
+		alignas(16) float G1[4];
+		VectorStoreAligned(Xfl, Floors);
+		for (int32 Lane = 0; Lane < 4; ++Lane)
+		{
+			const int32 Xi = static_cast<int32>(Floors[Lane]) & 255;
+			G0[Lane] = Gradients[Xi];
+			G1[Lane] = Gradients[Xi + 1];
+		}
+
+		const VectorRegister4Float A = VectorMultiply(VectorLoadAligned(G0), X0);
+		const VectorRegister4Float B = VectorMultiply(VectorLoadAligned(G1), X1);
+
+		// X0 * X0 * X0 * (X0 * (X0 * 6 - 15) + 10) without fused multiply-adds to match the scalar rounding
+		VectorRegister4Float Alpha = VectorSubtract(VectorMultiply(X0, Six), Fifteen);
+		Alpha = VectorAdd(VectorMultiply(X0, Alpha), Ten);
+		Alpha = VectorMultiply(VectorMultiply(VectorMultiply(X0, X0), X0), Alpha);
+
+		const VectorRegister4Float Result = VectorMultiply(Half, VectorAdd(A, VectorMultiply(Alpha, VectorSubtract(B, A))));
+		VectorStore(Result, OutNoise + Index);
+	}
+
+	for ( ; Index < Num; ++Index)
+	{
+		OutNoise[Index] = PerlinNoise1D_Scalar(Gradients, InValues[Index]);
+	}
+}
+
+} // namespace UE::MovieScene
@@ -0,0 +1,21 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+
+namespace UE::MovieScene
+{
+
+/**
+ * Evaluate FMath::PerlinNoise1D for a contiguous batch of inputs.
+ * Lattice and interpolation math is performed 4-wide using the platform vector intrinsics, with a scalar
+ * tail for any remainder. Results match FMath::PerlinNoise1D to within floating point rounding.
+ *
+ * @param InValues     Pointer to Num noise-space input values
+ * @param OutNoise     Pointer to Num output values to receive the (unscaled) noise
+ * @param Num          The number of values to evaluate
+ */
+void PerlinNoise1D_Batch(const float* InValues, float* OutNoise, int32 Num);
+
+} // namespace UE::MovieScene
@@ -524,6 +524,11 @@ FMovieSceneTracksComponentTypes::FMovieSceneTracksComponentTypes()
 	ComponentRegistry->NewPropertyType(Parameters.Color, TEXT("Color parameter"));
 	ComponentRegistry->NewPropertyType(Parameters.Transform, TEXT("Transform parameter"));
 
+	// Allow bool property tracks to opt in to skipping unchanged values through UMovieScenePropertyTrack::SetSkipUnchangedValues.
+	// Bool properties commonly drive expensive setters (ie, visibility or collision toggles) whose animated values rarely change between frames.
+	// This only defines the storage: values are always applied unless the track explicitly opts in.
+	ComponentRegistry->NewLastAppliedValueType(Bool, TEXT("bool"));
+
 	Color.MetaDataComponents.Initialize(BuiltInComponents->VariantPropertyTypeIndex);
 	Double.MetaDataComponents.Initialize(BuiltInComponents->VariantPropertyTypeIndex);
 	Integer.MetaDataComponents.Initialize(BuiltInComponents->VariantPropertyTypeIndex);
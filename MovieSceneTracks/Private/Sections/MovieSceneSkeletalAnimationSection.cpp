@@ -643,6 +643,17 @@ void UMovieSceneSkeletalAnimationSection::GetRootMotion(FFrameTime CurrentTime,
 	}
 }
 
+void UMovieSceneSkeletalAnimationSection::EvaluateRootMotion(FFrameTime CurrentTime, const FMovieSceneTrackEvaluationField& EvaluationField, UMovieSceneSkeletalAnimationSection::FRootMotionParams& OutRootMotionParams) const
+{
+	if (const UMovieSceneCommonAnimationTrack* Track = GetTypedOuter<UMovieSceneCommonAnimationTrack>())
+	{
+		OutRootMotionParams.Transform = Track->EvaluateRootMotion(CurrentTime, EvaluationField);
+		OutRootMotionParams.ChildBoneIndex = TempRootBoneIndex.IsSet() ? TempRootBoneIndex.GetValue() : INDEX_NONE;
+		OutRootMotionParams.bBlendFirstChildOfRoot = Track->bBlendFirstChildOfRoot;
+		OutRootMotionParams.PreviousTransform = PreviousTransform;
+	}
+}
+
 bool UMovieSceneSkeletalAnimationSection::GetRootMotionVelocity(FFrameTime PreviousTime, FFrameTime CurrentTime, FFrameRate FrameRate, 
 	FTransform& OutVelocity, float& OutWeight) const
 {
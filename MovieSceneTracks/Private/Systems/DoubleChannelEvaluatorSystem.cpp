@@ -71,7 +71,8 @@ struct FInitializeConstantDoubleChannelMutation : IMovieSceneConditionalEntityMu
 		const int32 Num = Allocation->Num();
 		for (int32 Index = 0; Index < Num; ++Index)
 		{
-			if (Channels[Index].Source->GetTimes().Num() <= 1)
+			// Streamed channels have no resident keys but are not constant
+			if (Channels[Index].Source->GetTimes().Num() <= 1 && Channels[Index].Source->GetStreamedData() == nullptr)
 			{
 				OutEntitiesToMutate.PadToNum(Index + 1, false);
 				OutEntitiesToMutate[Index] = true;
@@ -22,9 +22,11 @@ namespace UE
 	{
 		struct FEvaluateDoublePerlinNoiseChannels
 		{
-			static void ForEachEntity(double EvalSeconds, const FPerlinNoiseParams& PerlinNoiseParams, double& OutResult)
+			static void ForEachAllocation(FEntityAllocationIteratorItem Item, TRead<double> EvalSeconds, TRead<FPerlinNoiseParams> PerlinNoiseParams, TWrite<double> OutResults)
 			{
-				OutResult = FMovieSceneDoublePerlinNoiseChannel::Evaluate(PerlinNoiseParams, EvalSeconds);
+				// Evaluate the whole allocation at once so the noise kernel can run vectorized
+				const int32 Num = Item.GetAllocation()->Num();
+				FMovieSceneDoublePerlinNoiseChannel::EvaluateBatch(PerlinNoiseParams.AsArray(Num), EvalSeconds.AsArray(Num), OutResults.AsArray(Num));
 			}
 		};
 	} // namespace MovieScene
@@ -72,7 +74,7 @@ void UDoublePerlinNoiseChannelEvaluatorSystem::OnSchedulePersistentTasks(UE::Mov
 		.Write(BuiltInComponents->DoubleResult[i])
 		.FilterNone({ BuiltInComponents->Tags.Ignored })
 		.SetStat(GET_STATID(MovieSceneEval_EvaluateDoublePerlinNoiseChannelTask))
-		.Fork_PerEntity<FEvaluateDoublePerlinNoiseChannels>(&Linker->EntityManager, TaskScheduler);
+		.Fork_PerAllocation<FEvaluateDoublePerlinNoiseChannels>(&Linker->EntityManager, TaskScheduler);
 	}
 }
 
@@ -87,6 +89,7 @@ void UDoublePerlinNoiseChannelEvaluatorSystem::OnRun(FSystemTaskPrerequisites& I
 
 	if (Runner->GetCurrentPhase() == ESystemPhase::Instantiation)
 	{
+		FEvaluateDoublePerlinNoiseChannels EvaluateTask;
 		for (int32 i = 0; i < UE_ARRAY_COUNT(BuiltInComponents->DoubleResult); ++i)
 		{
 			FEntityTaskBuilder()
@@ -95,7 +98,7 @@ void UDoublePerlinNoiseChannelEvaluatorSystem::OnRun(FSystemTaskPrerequisites& I
 				.Write(BuiltInComponents->BaseDouble[i])
 				.FilterAll({ BuiltInComponents->Tags.NeedsLink })
 				.FilterNone({ BuiltInComponents->Tags.Ignored })
-				.RunInline_PerEntity(&Linker->EntityManager, FEvaluateDoublePerlinNoiseChannels());
+				.RunInline_PerAllocation(&Linker->EntityManager, EvaluateTask);
 		}
 	}
 	else if (Runner->GetCurrentPhase() == ESystemPhase::Evaluation)
@@ -108,7 +111,7 @@ void UDoublePerlinNoiseChannelEvaluatorSystem::OnRun(FSystemTaskPrerequisites& I
 				.Write(BuiltInComponents->DoubleResult[i])
 				.FilterNone({ BuiltInComponents->Tags.Ignored })
 				.SetStat(GET_STATID(MovieSceneEval_EvaluateDoublePerlinNoiseChannelTask))
-				.Dispatch_PerEntity<FEvaluateDoublePerlinNoiseChannels>(&Linker->EntityManager, InPrerequisites, &Subsequents);
+				.Dispatch_PerAllocation<FEvaluateDoublePerlinNoiseChannels>(&Linker->EntityManager, InPrerequisites, &Subsequents);
 		}
 	}
 }
@@ -22,10 +22,11 @@ namespace UE
 	{
 		struct FEvaluateFloatPerlinNoiseChannels
 		{
-			static void ForEachEntity(double EvalSeconds, const FPerlinNoiseParams& PerlinNoiseParams, double& OutResult)
+			static void ForEachAllocation(FEntityAllocationIteratorItem Item, TRead<double> EvalSeconds, TRead<FPerlinNoiseParams> PerlinNoiseParams, TWrite<double> OutResults)
 			{
-				const float NoiseResult = FMovieSceneFloatPerlinNoiseChannel::Evaluate(PerlinNoiseParams, EvalSeconds);
-				OutResult = (double)NoiseResult;
+				// Evaluate the whole allocation at once so the noise kernel can run vectorized
+				const int32 Num = Item.GetAllocation()->Num();
+				FMovieSceneFloatPerlinNoiseChannel::EvaluateBatch(PerlinNoiseParams.AsArray(Num), EvalSeconds.AsArray(Num), OutResults.AsArray(Num));
 			}
 		};
 	} // namespace MovieScene
@@ -73,7 +74,7 @@ void UFloatPerlinNoiseChannelEvaluatorSystem::OnSchedulePersistentTasks(UE::Movi
 		.Write(BuiltInComponents->DoubleResult[i])
 		.FilterNone({ BuiltInComponents->Tags.Ignored })
 		.SetStat(GET_STATID(MovieSceneEval_EvaluateFloatPerlinNoiseChannelTask))
-		.Fork_PerEntity<FEvaluateFloatPerlinNoiseChannels>(&Linker->EntityManager, TaskScheduler);
+		.Fork_PerAllocation<FEvaluateFloatPerlinNoiseChannels>(&Linker->EntityManager, TaskScheduler);
 	}
 }
 
@@ -88,6 +89,7 @@ void UFloatPerlinNoiseChannelEvaluatorSystem::OnRun(FSystemTaskPrerequisites& In
 
 	if (Runner->GetCurrentPhase() == ESystemPhase::Instantiation)
 	{
+		FEvaluateFloatPerlinNoiseChannels EvaluateTask;
 		for (int32 i = 0; i < UE_ARRAY_COUNT(BuiltInComponents->DoubleResult); ++i)
 		{
 			FEntityTaskBuilder()
@@ -96,7 +98,7 @@ void UFloatPerlinNoiseChannelEvaluatorSystem::OnRun(FSystemTaskPrerequisites& In
 				.Write(BuiltInComponents->BaseDouble[i])
 				.FilterAll({ BuiltInComponents->Tags.NeedsLink })
 				.FilterNone({ BuiltInComponents->Tags.Ignored })
-				.RunInline_PerEntity(&Linker->EntityManager, FEvaluateFloatPerlinNoiseChannels());
+				.RunInline_PerAllocation(&Linker->EntityManager, EvaluateTask);
 		}
 	}
 	else if (Runner->GetCurrentPhase() == ESystemPhase::Evaluation)
@@ -109,7 +111,7 @@ void UFloatPerlinNoiseChannelEvaluatorSystem::OnRun(FSystemTaskPrerequisites& In
 				.Write(BuiltInComponents->DoubleResult[i])
 				.FilterNone({ BuiltInComponents->Tags.Ignored })
 				.SetStat(GET_STATID(MovieSceneEval_EvaluateFloatPerlinNoiseChannelTask))
-				.Dispatch_PerEntity<FEvaluateFloatPerlinNoiseChannels>(&Linker->EntityManager, InPrerequisites, &Subsequents);
+				.Dispatch_PerAllocation<FEvaluateFloatPerlinNoiseChannels>(&Linker->EntityManager, InPrerequisites, &Subsequents);
 		}
 	}
 }
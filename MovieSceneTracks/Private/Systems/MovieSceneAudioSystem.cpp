@@ -2,6 +2,7 @@
 
 #include "Systems/MovieSceneAudioSystem.h"
 
+#include "Algo/AnyOf.h"
 #include "AudioDevice.h"
 #include "Components/AudioComponent.h"
 #include "Engine/Engine.h"
@@ -12,7 +13,10 @@
 #include "Evaluation/PreAnimatedState/MovieScenePreAnimatedStorageID.inl"
 #include "GameFramework/WorldSettings.h"
 #include "IMovieScenePlayer.h"
+#include "Kismet/GameplayStatics.h"
 #include "MovieScene.h"
+#include "MovieSceneBinding.h"
+#include "MovieSceneSequence.h"
 #include "Decorations/MovieSceneScalingAnchors.h"
 #include "Decorations/MovieSceneSectionAnchorsDecoration.h"
 #include "MovieSceneTracksComponentTypes.h"
@@ -24,6 +28,7 @@
 #include UE_INLINE_GENERATED_CPP_BY_NAME(MovieSceneAudioSystem)
 
 DECLARE_CYCLE_STAT(TEXT("Audio System Evaluate"), MovieSceneEval_AudioTasks, STATGROUP_MovieSceneECS);
+DECLARE_CYCLE_STAT(TEXT("Audio System Look-Ahead"), MovieSceneEval_AudioLookAhead, STATGROUP_MovieSceneECS);
 
 static float MaxSequenceAudioDesyncToleranceCVar = 0.5f;
 FAutoConsoleVariableRef CVarMaxSequenceAudioDesyncTolerance(
@@ -83,6 +88,20 @@ FAutoConsoleVariableRef CVarEnableGranularScrubbingWhileStationary(
 	TEXT("Whether or not to use granular scrubbing while holding the playhead still.\n"),
 	ECVF_Default);
 
+static float AudioLookAheadSecondsCVar = 0.f;
+FAutoConsoleVariableRef CVarAudioLookAheadSeconds(
+	TEXT("Sequencer.Audio.LookAheadSeconds"),
+	AudioLookAheadSecondsCVar,
+	TEXT("When greater than zero, audio sections that begin within this many seconds of the current time of a playing sequence have their audio component created and their sound primed ahead of time, so that starting them does not allocate.\n"),
+	ECVF_Default);
+
+static int32 AudioLookAheadMaxPerFrameCVar = 4;
+FAutoConsoleVariableRef CVarAudioLookAheadMaxPerFrame(
+	TEXT("Sequencer.Audio.LookAheadMaxPerFrame"),
+	AudioLookAheadMaxPerFrameCVar,
+	TEXT("The maximum number of audio components to create ahead of time each frame when Sequencer.Audio.LookAheadSeconds is enabled.\n"),
+	ECVF_Default);
+
 namespace UE::MovieScene
 {
 
@@ -401,28 +420,13 @@ private:
 				// Initialize the sound
 				UWorld* World = PlaybackContext ? PlaybackContext->GetWorld() : nullptr;
 				EvaluationData = AudioSystem->AddRootAudioComponent(InstanceHandle, AudioSection, World);
-				UAudioComponent* AudioComponent = EvaluationData ? EvaluationData->AudioComponent.Get() : nullptr;
-
-				if (ensure(AudioComponent))
-				{
-					AudioSystem->PreAnimatedStorage->BeginTrackingEntity(EntityID, bWantsRestoreState, RootInstanceHandle, AudioComponent);
-					AudioSystem->PreAnimatedStorage->CachePreAnimatedValue(
-						FCachePreAnimatedValueParams(), AudioComponent,
-						[](FObjectKey InKey) { return EPreAnimatedAudioStateType::AudioComponentLifespan; });
+				ensure(EvaluationData && EvaluationData->AudioComponent.IsValid());
+			}
 
-					if (AudioSection->GetOnQueueSubtitles().IsBound())
-					{
-						AudioComponent->OnQueueSubtitles = AudioSection->GetOnQueueSubtitles();
-					}
-					if (AudioSection->GetOnAudioFinished().IsBound())
-					{
-						AudioComponent->OnAudioFinished = AudioSection->GetOnAudioFinished();
-					}
-					if (AudioSection->GetOnAudioPlaybackPercent().IsBound())
-					{
-						AudioComponent->OnAudioPlaybackPercent = AudioSection->GetOnAudioPlaybackPercent();
-					}
-				}
+			// Components may have been created ahead of time by the look-ahead, in which case they are initialized the first time they are evaluated
+			if (EvaluationData && EvaluationData->bNeedsInitialization)
+			{
+				InitializeAudioComponent(EntityID, RootInstanceHandle, *AudioSection, *EvaluationData, bWantsRestoreState);
 			}
 
 			if (EvaluationData)
@@ -456,28 +460,11 @@ private:
 			{
 				// Initialize the sound
 				EvaluationData = AudioSystem->AddBoundObjectAudioComponent(InstanceHandle, AudioSection, BoundObject);
-				UAudioComponent* AudioComponent = EvaluationData ? EvaluationData->AudioComponent.Get() : nullptr;
-
-				if (AudioComponent)
-				{
-					AudioSystem->PreAnimatedStorage->BeginTrackingEntity(EntityID, bWantsRestoreState, RootInstanceHandle, AudioComponent);
-					AudioSystem->PreAnimatedStorage->CachePreAnimatedValue(
-						FCachePreAnimatedValueParams(), AudioComponent,
-						[](FObjectKey InKey) { return EPreAnimatedAudioStateType::AudioComponentLifespan; });
+			}
 
-					if (AudioSection->GetOnQueueSubtitles().IsBound())
-					{
-						AudioComponent->OnQueueSubtitles = AudioSection->GetOnQueueSubtitles();
-					}
-					if (AudioSection->GetOnAudioFinished().IsBound())
-					{
-						AudioComponent->OnAudioFinished = AudioSection->GetOnAudioFinished();
-					}
-					if (AudioSection->GetOnAudioPlaybackPercent().IsBound())
-					{
-						AudioComponent->OnAudioPlaybackPercent = AudioSection->GetOnAudioPlaybackPercent();
-					}
-				}
+			if (EvaluationData && EvaluationData->bNeedsInitialization)
+			{
+				InitializeAudioComponent(EntityID, RootInstanceHandle, *AudioSection, *EvaluationData, bWantsRestoreState);
 			}
 
 			if (EvaluationData)
@@ -490,6 +477,41 @@ private:
 		}
 	}
 
+	void InitializeAudioComponent(
+			const FMovieSceneEntityID& EntityID,
+			const FRootInstanceHandle& RootInstanceHandle,
+			UMovieSceneAudioSection& AudioSection,
+			FAudioComponentEvaluationData& EvaluationData,
+			bool bWantsRestoreState) const
+	{
+		UAudioComponent* AudioComponent = EvaluationData.AudioComponent.Get();
+		if (!AudioComponent)
+		{
+			return;
+		}
+
+		EvaluationData.bNeedsInitialization = false;
+		EvaluationData.bReserved = false;
+
+		AudioSystem->PreAnimatedStorage->BeginTrackingEntity(EntityID, bWantsRestoreState, RootInstanceHandle, AudioComponent);
+		AudioSystem->PreAnimatedStorage->CachePreAnimatedValue(
+			FCachePreAnimatedValueParams(), AudioComponent,
+			[](FObjectKey InKey) { return EPreAnimatedAudioStateType::AudioComponentLifespan; });
+
+		if (AudioSection.GetOnQueueSubtitles().IsBound())
+		{
+			AudioComponent->OnQueueSubtitles = AudioSection.GetOnQueueSubtitles();
+		}
+		if (AudioSection.GetOnAudioFinished().IsBound())
+		{
+			AudioComponent->OnAudioFinished = AudioSection.GetOnAudioFinished();
+		}
+		if (AudioSection.GetOnAudioPlaybackPercent().IsBound())
+		{
+			AudioComponent->OnAudioPlaybackPercent = AudioSection.GetOnAudioPlaybackPercent();
+		}
+	}
+
 	void EnsureAudioIsPlaying(
 			UObject* BoundObject,
 			FInstanceHandle InstanceHandle,
@@ -950,7 +972,12 @@ void UMovieSceneAudioSystem::OnUnlink()
 		for (const TPair<FInstanceObjectKey, FAudioComponentEvaluationData>& AudioComponentForSection : AudioComponentsForActor.Value)
 		{
 			UAudioComponent* AudioComponent = AudioComponentForSection.Value.AudioComponent.Get();
-			if (AudioComponent)
+			if (AudioComponent && AudioComponentForSection.Value.bNeedsInitialization)
+			{
+				// Components that were created ahead of time but never used are not tracked by pre-animated state, so must be destroyed here
+				AudioComponent->DestroyComponent();
+			}
+			else if (AudioComponent)
 			{
 				UObject* Actor = AudioComponentsForActor.Key.ResolveObjectPtr();
 				UObject* Section = AudioComponentForSection.Key.Value.ResolveObjectPtr();
@@ -1010,9 +1037,14 @@ void UMovieSceneAudioSystem::OnSchedulePersistentTasks(UE::MovieScene::IEntitySy
 	const FBuiltInComponentTypes* BuiltInComponents = FBuiltInComponentTypes::Get();
 	const FMovieSceneTracksComponentTypes* TrackComponents = FMovieSceneTracksComponentTypes::Get();
 
+	// Prepare upcoming audio on the game thread. This adds audio components, so must complete before anything else touches them.
+	FTaskID PrewarmAudioTask = TaskScheduler->AddMemberFunctionTask(FTaskParams(TEXT("Prewarm Upcoming Audio")).ForceGameThread(), this, &UMovieSceneAudioSystem::PrewarmUpcomingAudio);
+
 	// Reset shared data.
 	FTaskID ResetSharedDataTask = TaskScheduler->AddMemberFunctionTask(FTaskParams(TEXT("Reset Audio Data")), this, &UMovieSceneAudioSystem::ResetSharedData);
 
+	TaskScheduler->AddPrerequisite(PrewarmAudioTask, ResetSharedDataTask);
+
 	// Gather audio input values computed by the channel evaluators.
 	FTaskID GatherInputsTask = FEntityTaskBuilder()
 	.Read(BuiltInComponents->InstanceHandle)
@@ -1072,6 +1104,8 @@ void UMovieSceneAudioSystem::OnRun(FSystemTaskPrerequisites& InPrerequisites, FS
 	// Reset shared data.
 	ResetSharedData();
 
+	PrewarmUpcomingAudio();
+
 	// Gather audio input values computed by the channel evaluators.
 	FSystemTaskPrerequisites Prereqs;
 
@@ -1115,45 +1149,179 @@ void UMovieSceneAudioSystem::OnRun(FSystemTaskPrerequisites& InPrerequisites, FS
 	.template Dispatch_PerAllocation<FEvaluateAudio>(&Linker->EntityManager, Prereqs, &Subsequents, this);
 }
 
-UMovieSceneAudioSystem::FAudioComponentEvaluationData* UMovieSceneAudioSystem::GetAudioComponentEvaluationData(FInstanceHandle InstanceHandle, FObjectKey ActorKey, FObjectKey SectionKey)
+void UMovieSceneAudioSystem::PrewarmUpcomingAudio()
 {
-	FAudioComponentBySectionKey* Map = AudioComponentsByActorKey.Find(ActorKey);
-	if (Map != nullptr)
+	using namespace UE::MovieScene;
+
+	if (AudioLookAheadSecondsCVar <= 0.f || AudioLookAheadMaxPerFrameCVar <= 0)
 	{
-		// First, check for an exact match for this entity
-		FInstanceObjectKey DataKey{ InstanceHandle, SectionKey };
-		FAudioComponentEvaluationData* ExistingData = Map->Find(DataKey);
-		if (ExistingData != nullptr)
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(MovieSceneEval_AudioLookAhead);
+
+	int32 RemainingBudget = AudioLookAheadMaxPerFrameCVar;
+
+	const FInstanceRegistry* InstanceRegistry = Linker->GetInstanceRegistry();
+	for (const FSequenceInstance& Instance : InstanceRegistry->GetSparseInstances())
+	{
+		// Audio only plays forwards, and only sequences that are playing will reach their upcoming sections
+		const FMovieSceneContext& Context = Instance.GetContext();
+		if (Context.GetStatus() != EMovieScenePlayerStatus::Playing || Context.GetDirection() != EPlayDirection::Forwards)
 		{
-			if (ExistingData->AudioComponent.IsValid())
+			continue;
+		}
+
+		TSharedRef<FSharedPlaybackState> SharedPlaybackState = Instance.GetSharedPlaybackState();
+
+		const UMovieSceneSequence* Sequence = SharedPlaybackState->GetSequence(Instance.GetSequenceID());
+		UMovieScene* MovieScene = Sequence ? Sequence->GetMovieScene() : nullptr;
+		UObject* PlaybackContext = SharedPlaybackState->GetPlaybackContext();
+		UWorld* World = PlaybackContext ? PlaybackContext->GetWorld() : nullptr;
+		if (!MovieScene || !World)
+		{
+			continue;
+		}
+
+		// Sections that have already started are handled by regular evaluation
+		const FFrameNumber LookAheadTime = Context.GetOffsetTime(Context.GetFrameRate().AsFrameTime(AudioLookAheadSecondsCVar)).FrameNumber;
+		const TRange<FFrameNumber> LookAheadRange(TRangeBound<FFrameNumber>::Exclusive(Context.GetTime().FrameNumber), TRangeBound<FFrameNumber>::Inclusive(LookAheadTime));
+
+		auto PrewarmTrack = [this, &Instance, &LookAheadRange, &RemainingBudget, World](const UMovieSceneTrack* Track, UObject* PrincipalObject)
+		{
+			const UMovieSceneAudioTrack* AudioTrack = Cast<const UMovieSceneAudioTrack>(Track);
+			if (!AudioTrack || AudioTrack->IsEvalDisabled())
 			{
-				return ExistingData;
+				return;
 			}
+
+			for (UMovieSceneSection* Section : AudioTrack->GetAudioSections())
+			{
+				UMovieSceneAudioSection* AudioSection = Cast<UMovieSceneAudioSection>(Section);
+				if (RemainingBudget > 0 && AudioSection && AudioSection->IsActive() && AudioSection->HasStartFrame() && LookAheadRange.Contains(AudioSection->GetInclusiveStartFrame()))
+				{
+					RemainingBudget -= PrewarmAudioSection(Instance.GetInstanceHandle(), AudioSection, PrincipalObject, World) ? 1 : 0;
+				}
+			}
+		};
+
+		for (const UMovieSceneTrack* Track : MovieScene->GetTracks())
+		{
+			PrewarmTrack(Track, nullptr);
 		}
 
-		// If no exact match, check for any AudioComponent that isn't busy
-		for (FAudioComponentBySectionKey::ElementType& Pair : *Map)
+		FMovieSceneEvaluationState* State = SharedPlaybackState->FindCapability<FMovieSceneEvaluationState>();
+		if (!State)
 		{
-			UAudioComponent* ExistingComponent = Pair.Value.AudioComponent.Get();
-			if (ExistingComponent && !ExistingComponent->IsPlaying())
-			{
-				// Replace this entry with the new entity ID to claim it
-				FAudioComponentEvaluationData MovedData(Pair.Value);
-				Map->Remove(Pair.Key);
-				MovedData.PartialDesyncComputation.Reset();
+			continue;
+		}
 
-				MovedData.LastAudioTime.Reset();
-				MovedData.LastContextTime.Reset();
+		for (const FMovieSceneBinding& Binding : MovieScene->GetBindings())
+		{
+			if (!Algo::AnyOf(Binding.GetTracks(), [](const UMovieSceneTrack* Track) { return Track && Track->IsA<UMovieSceneAudioTrack>(); }))
+			{
+				continue;
+			}
 
-				return &Map->Add(DataKey, MovedData);
+			// Objects that do not exist yet (ie, spawnables that have not spawned) cannot be prewarmed
+			for (TWeakObjectPtr<> WeakBoundObject : State->FindBoundObjects(Binding.GetObjectGuid(), Instance.GetSequenceID(), SharedPlaybackState))
+			{
+				if (UObject* BoundObject = WeakBoundObject.Get())
+				{
+					for (const UMovieSceneTrack* Track : Binding.GetTracks())
+					{
+						PrewarmTrack(Track, BoundObject);
+					}
+				}
 			}
 		}
 	}
+}
+
+bool UMovieSceneAudioSystem::PrewarmAudioSection(FInstanceHandle InstanceHandle, UMovieSceneAudioSection* Section, UObject* PrincipalObject, UWorld* World)
+{
+	USoundBase* Sound = Section->GetPlaybackSound();
+	if (!Sound)
+	{
+		return false;
+	}
+
+	// Nothing to do if a component already exists for this section
+	if (GetAudioComponentEvaluationData(InstanceHandle, FObjectKey(PrincipalObject), FObjectKey(Section), false))
+	{
+		return false;
+	}
+
+	// Start streaming in the first chunk of the sound so that it can play immediately
+	UGameplayStatics::PrimeSound(Sound);
+
+	// Always create a new component rather than claiming an idle one, since idle components may still be needed by
+	// the sections that own them. The new component is then reserved so that no other section can claim it either.
+	FAudioComponentEvaluationData* EvaluationData = PrincipalObject
+		? AddBoundObjectAudioComponent(InstanceHandle, Section, PrincipalObject, false)
+		: AddRootAudioComponent(InstanceHandle, Section, World, false);
+
+	UAudioComponent* AudioComponent = EvaluationData ? EvaluationData->AudioComponent.Get() : nullptr;
+	if (!AudioComponent)
+	{
+		return false;
+	}
+
+	EvaluationData->bReserved = true;
+
+	if (AudioComponent->Sound != Sound)
+	{
+		AudioComponent->SetSound(Sound);
+	}
+	return EvaluationData->bNeedsInitialization;
+}
+
+UMovieSceneAudioSystem::FAudioComponentEvaluationData* UMovieSceneAudioSystem::GetAudioComponentEvaluationData(FInstanceHandle InstanceHandle, FObjectKey ActorKey, FObjectKey SectionKey, bool bClaimIdleComponent)
+{
+	FAudioComponentBySectionKey* Map = AudioComponentsByActorKey.Find(ActorKey);
+	return Map ? FindAudioComponentEvaluationData(*Map, InstanceHandle, SectionKey, bClaimIdleComponent) : nullptr;
+}
+
+UMovieSceneAudioSystem::FAudioComponentEvaluationData* UMovieSceneAudioSystem::FindAudioComponentEvaluationData(FAudioComponentBySectionKey& AudioComponents, FInstanceHandle InstanceHandle, FObjectKey SectionKey, bool bClaimIdleComponent)
+{
+	// First, check for an exact match for this entity
+	FInstanceObjectKey DataKey{ InstanceHandle, SectionKey };
+	FAudioComponentEvaluationData* ExistingData = AudioComponents.Find(DataKey);
+	if (ExistingData != nullptr)
+	{
+		if (ExistingData->AudioComponent.IsValid())
+		{
+			return ExistingData;
+		}
+	}
+
+	if (!bClaimIdleComponent)
+	{
+		return nullptr;
+	}
+
+	// If no exact match, check for any AudioComponent that isn't busy or reserved for an upcoming section
+	for (FAudioComponentBySectionKey::ElementType& Pair : AudioComponents)
+	{
+		UAudioComponent* ExistingComponent = Pair.Value.AudioComponent.Get();
+		if (ExistingComponent && !Pair.Value.bReserved && !ExistingComponent->IsPlaying())
+		{
+			// Replace this entry with the new entity ID to claim it
+			FAudioComponentEvaluationData MovedData(Pair.Value);
+			AudioComponents.Remove(Pair.Key);
+			MovedData.PartialDesyncComputation.Reset();
+
+			MovedData.LastAudioTime.Reset();
+			MovedData.LastContextTime.Reset();
+
+			return &AudioComponents.Add(DataKey, MovedData);
+		}
+	}
 
 	return nullptr;
 }
 
-UMovieSceneAudioSystem::FAudioComponentEvaluationData* UMovieSceneAudioSystem::AddBoundObjectAudioComponent(FInstanceHandle InstanceHandle, UMovieSceneAudioSection* Section, UObject* PrincipalObject)
+UMovieSceneAudioSystem::FAudioComponentEvaluationData* UMovieSceneAudioSystem::AddBoundObjectAudioComponent(FInstanceHandle InstanceHandle, UMovieSceneAudioSection* Section, UObject* PrincipalObject, bool bClaimIdleComponent)
 {
 	using namespace UE::MovieScene;
 
@@ -1162,7 +1330,7 @@ UMovieSceneAudioSystem::FAudioComponentEvaluationData* UMovieSceneAudioSystem::A
 
 	FAudioComponentBySectionKey& ActorAudioComponentMap = AudioComponentsByActorKey.FindOrAdd(ObjectKey);
 
-	FAudioComponentEvaluationData* ExistingData = GetAudioComponentEvaluationData(InstanceHandle, ObjectKey, SectionKey);
+	FAudioComponentEvaluationData* ExistingData = GetAudioComponentEvaluationData(InstanceHandle, ObjectKey, SectionKey, bClaimIdleComponent);
 	if (!ExistingData)
 	{
 		USoundCue* TempPlaybackAudioCue = NewObject<USoundCue>();
@@ -1214,6 +1382,7 @@ UMovieSceneAudioSystem::FAudioComponentEvaluationData* UMovieSceneAudioSystem::A
 		ExistingData = &ActorAudioComponentMap.Add(DataKey);
 		ExistingData->AudioComponent = NewComponent;
 		ExistingData->bAudioComponentHasBeenPlayed = false;
+		ExistingData->bNeedsInitialization = true;
 
 #if WITH_EDITOR
 		static int32 ScrubSoundCounter = 0;
@@ -1235,7 +1404,7 @@ UMovieSceneAudioSystem::FAudioComponentEvaluationData* UMovieSceneAudioSystem::A
 	return ExistingData;
 }
 
-UMovieSceneAudioSystem::FAudioComponentEvaluationData* UMovieSceneAudioSystem::AddRootAudioComponent(FInstanceHandle InstanceHandle, UMovieSceneAudioSection* Section, UWorld* World)
+UMovieSceneAudioSystem::FAudioComponentEvaluationData* UMovieSceneAudioSystem::AddRootAudioComponent(FInstanceHandle InstanceHandle, UMovieSceneAudioSection* Section, UWorld* World, bool bClaimIdleComponent)
 {
 	using namespace UE::MovieScene;
 
@@ -1244,7 +1413,7 @@ UMovieSceneAudioSystem::FAudioComponentEvaluationData* UMovieSceneAudioSystem::A
 
 	FAudioComponentBySectionKey& RootAudioComponentMap = AudioComponentsByActorKey.FindOrAdd(NullKey);
 
-	FAudioComponentEvaluationData* ExistingData = GetAudioComponentEvaluationData(InstanceHandle, NullKey, SectionKey);
+	FAudioComponentEvaluationData* ExistingData = GetAudioComponentEvaluationData(InstanceHandle, NullKey, SectionKey, bClaimIdleComponent);
 	if (!ExistingData)
 	{
 		USoundCue* TempPlaybackAudioCue = NewObject<USoundCue>();
@@ -1266,6 +1435,7 @@ UMovieSceneAudioSystem::FAudioComponentEvaluationData* UMovieSceneAudioSystem::A
 		ExistingData = &RootAudioComponentMap.Add(DataKey);
 		ExistingData->AudioComponent = NewComponent;
 		ExistingData->bAudioComponentHasBeenPlayed = false;
+		ExistingData->bNeedsInitialization = true;
 
 #if WITH_EDITOR
 		static int32 ScrubSoundCounter = 0;
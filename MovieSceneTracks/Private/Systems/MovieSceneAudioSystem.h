@@ -67,6 +67,18 @@ namespace UE::MovieScene
 
 		/** Flag to keep track of if the audio component was played in a previous frame. */
 		bool bAudioComponentHasBeenPlayed = false;
+
+		/**
+		 * Set when the audio component has been created, but its lifespan is not yet tracked by pre-animated state.
+		 * Components created ahead of time by the look-ahead remain in this state until their section is first evaluated.
+		 */
+		bool bNeedsInitialization = false;
+
+		/**
+		 * Set while the component has been created ahead of time for an upcoming section by the look-ahead, until that section is first evaluated.
+		 * Reserved components are never claimed by other sections, even while they are idle.
+		 */
+		bool bReserved = false;
 	};
 }
 
@@ -85,6 +97,9 @@ public:
 	using FAudioComponentEvaluationData = UE::MovieScene::FAudioComponentEvaluationData;
 	using FAudioComponentInputEvaluationData = UE::MovieScene::FAudioComponentInputEvaluationData;
 
+	using FInstanceObjectKey = TTuple<FInstanceHandle, FObjectKey>;
+	using FAudioComponentBySectionKey = TMap<FInstanceObjectKey, FAudioComponentEvaluationData>;
+
 	UMovieSceneAudioSystem(const FObjectInitializer& ObjInit);
 
 	//~ UMovieSceneEntitySystem members
@@ -95,20 +110,26 @@ public:
 
 	/**
 	 * Get the evaluation data for the given actor and section. Pass a null actor key for root (world) audio.
+	 * Unless bClaimIdleComponent is false, an idle component belonging to another section on the same actor will be claimed if the section has none.
 	 */
-	FAudioComponentEvaluationData* GetAudioComponentEvaluationData(FInstanceHandle InstanceHandle, FObjectKey ActorKey, FObjectKey SectionKey);
+	FAudioComponentEvaluationData* GetAudioComponentEvaluationData(FInstanceHandle InstanceHandle, FObjectKey ActorKey, FObjectKey SectionKey, bool bClaimIdleComponent = true);
+
+	/**
+	 * Find the evaluation data for the given section within the audio components of a single actor, optionally claiming an idle, unreserved component from another section.
+	 */
+	static FAudioComponentEvaluationData* FindAudioComponentEvaluationData(FAudioComponentBySectionKey& AudioComponents, FInstanceHandle InstanceHandle, FObjectKey SectionKey, bool bClaimIdleComponent);
 
 	/**
 	 * Adds an audio component to the given bound sequencer object.
 	 * WARNING: Only to be called on the game thread.
 	 */
-	FAudioComponentEvaluationData* AddBoundObjectAudioComponent(FInstanceHandle InstanceHandle, UMovieSceneAudioSection* Section, UObject* PrincipalObject);
+	FAudioComponentEvaluationData* AddBoundObjectAudioComponent(FInstanceHandle InstanceHandle, UMovieSceneAudioSection* Section, UObject* PrincipalObject, bool bClaimIdleComponent = true);
 
 	/**
 	 * Adds an audio component to the world, for playing root audio tracks.
 	 * WARNING: Only to be called on the game thread.
 	 */
-	FAudioComponentEvaluationData* AddRootAudioComponent(FInstanceHandle InstanceHandle, UMovieSceneAudioSection* Section, UWorld* World);
+	FAudioComponentEvaluationData* AddRootAudioComponent(FInstanceHandle InstanceHandle, UMovieSceneAudioSection* Section, UWorld* World, bool bClaimIdleComponent = true);
 
 	/**
 	 * Stop the audio on the audio component associated with the given audio section.
@@ -120,15 +141,22 @@ public:
 	 */
 	void ResetSharedData();
 
+	/**
+	 * Create audio components and prime sounds for any audio sections that will begin within Sequencer.Audio.LookAheadSeconds
+	 * of the current time of playing sequences, so that starting them does not need to allocate.
+	 * WARNING: Only to be called on the game thread.
+	 */
+	void PrewarmUpcomingAudio();
+
 	// To expose the class to GC //
 	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
 
 private:
 
-	using FInstanceObjectKey = TTuple<FInstanceHandle, FObjectKey>;
+	/** Prewarm a single audio section for the specified object, or for root audio if PrincipalObject is null. Returns true if a new component was created. */
+	bool PrewarmAudioSection(FInstanceHandle InstanceHandle, UMovieSceneAudioSection* Section, UObject* PrincipalObject, UWorld* World);
 
 	/** Map of all created audio components */
-	using FAudioComponentBySectionKey = TMap<FInstanceObjectKey, FAudioComponentEvaluationData>;
 	using FAudioComponentsByActorKey = TMap<FObjectKey, FAudioComponentBySectionKey>;
 	FAudioComponentsByActorKey AudioComponentsByActorKey;
 
@@ -1,7 +1,8 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Systems/MovieSceneEventSystems.h"
-#include "Algo/RemoveIf.h"
+#include "Algo/Sort.h"
+#include "Algo/StableSort.h"
 #include "EntitySystem/MovieSceneEntitySystemLinker.h"
 #include "EntitySystem/MovieSceneEntitySystemRunner.h"
 #include "EntitySystem/MovieSceneEntitySystemTask.h"
@@ -32,6 +33,72 @@
 DECLARE_CYCLE_STAT(TEXT("Event Systems"),  MovieSceneEval_Events,        STATGROUP_MovieSceneECS);
 DECLARE_CYCLE_STAT(TEXT("Trigger Events"), MovieSceneEval_TriggerEvents, STATGROUP_MovieSceneECS);
 
+namespace UE::MovieScene
+{
+
+void FEventParameterLayout::Build(const UFunction* Function)
+{
+	ParamsToInitialize.Reset();
+	ParamsToDestroy.Reset();
+	ChildProperties = Function->ChildProperties;
+	ParmsSize = Function->ParmsSize;
+
+	// CPF_Param properties are aways at the head of the list
+	for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+	{
+		FProperty* LocalProp = *It;
+		checkSlow(LocalProp);
+		if (!LocalProp->HasAnyPropertyFlags(CPF_ZeroConstructor))
+		{
+			ParamsToInitialize.Add(LocalProp);
+		}
+		if (!LocalProp->HasAnyPropertyFlags(CPF_NoDestructor))
+		{
+			ParamsToDestroy.Add(LocalProp);
+		}
+	}
+}
+
+const FEventParameterLayout& FEventDispatchBuffers::FindOrAddParameterLayout(UFunction* Function)
+{
+	FEventParameterLayout& Layout = ParameterLayouts.FindOrAdd(Function);
+	if (!Layout.IsValidFor(Function))
+	{
+		Layout.Build(Function);
+	}
+	return Layout;
+}
+
+bool FEventDispatchBuffers::FindBoundObjects(const FMovieSceneEvaluationOperand& Operand, uint32 SerialNumber, TArrayView<const TWeakObjectPtr<>>& OutBoundObjects)
+{
+	if (SerialNumber != BoundObjectSerial)
+	{
+		ResetBoundObjects();
+		BoundObjectSerial = SerialNumber;
+		return false;
+	}
+
+	if (const TTuple<int32, int32>* Range = BoundObjectRanges.Find(Operand))
+	{
+		OutBoundObjects = MakeArrayView(BoundObjectStorage.GetData() + Range->Get<0>(), Range->Get<1>());
+		return true;
+	}
+	return false;
+}
+
+TArrayView<const TWeakObjectPtr<>> FEventDispatchBuffers::AddBoundObjects(const FMovieSceneEvaluationOperand& Operand, uint32 SerialNumber, TArrayView<const TWeakObjectPtr<>> BoundObjects)
+{
+	BoundObjectSerial = SerialNumber;
+
+	const int32 StartIndex = BoundObjectStorage.Num();
+	BoundObjectStorage.Append(BoundObjects.GetData(), BoundObjects.Num());
+	BoundObjectRanges.Add(Operand, MakeTuple(StartIndex, BoundObjects.Num()));
+
+	return MakeArrayView(BoundObjectStorage.GetData() + StartIndex, BoundObjects.Num());
+}
+
+} // namespace UE::MovieScene
+
 UMovieSceneEventSystem::UMovieSceneEventSystem(const FObjectInitializer& ObjInit)
 	: Super(ObjInit)
 {
@@ -40,12 +107,12 @@ UMovieSceneEventSystem::UMovieSceneEventSystem(const FObjectInitializer& ObjInit
 void UMovieSceneEventSystem::AddEvent(UE::MovieScene::FInstanceHandle RootInstance, const FMovieSceneEventTriggerData& TriggerData)
 {
 	check(TriggerData.Ptrs.Function != nullptr);
-	EventsByRoot.FindOrAdd(RootInstance).Add(TriggerData);
+	PendingEvents.Add(UE::MovieScene::FPendingEventTrigger{ RootInstance, TriggerData });
 }
 
 bool UMovieSceneEventSystem::HasEvents() const
 {
-	return EventsByRoot.Num() != 0;
+	return PendingEvents.Num() != 0;
 }
 
 bool UMovieSceneEventSystem::IsRelevantImpl(UMovieSceneEntitySystemLinker* InLinker) const
@@ -55,7 +122,7 @@ bool UMovieSceneEventSystem::IsRelevantImpl(UMovieSceneEntitySystemLinker* InLin
 
 void UMovieSceneEventSystem::OnRun(FSystemTaskPrerequisites& InPrerequisites, FSystemSubsequentTasks& Subsequents)
 {
-	if (EventsByRoot.Num() > 0)
+	if (PendingEvents.Num() > 0)
 	{
 		TriggerAllEvents();
 	}
@@ -63,10 +130,11 @@ void UMovieSceneEventSystem::OnRun(FSystemTaskPrerequisites& InPrerequisites, FS
 
 void UMovieSceneEventSystem::OnUnlink()
 {
-	if (!ensure(EventsByRoot.Num() == 0))
+	if (!ensure(PendingEvents.Num() == 0))
 	{
-		EventsByRoot.Reset();
+		PendingEvents.Reset();
 	}
+	DispatchBuffers = FEventDispatchBuffers();
 }
 
 void UMovieSceneEventSystem::TriggerAllEvents()
@@ -75,19 +143,38 @@ void UMovieSceneEventSystem::TriggerAllEvents()
 
 	SCOPE_CYCLE_COUNTER(MovieSceneEval_Events);
 
+	// Triggering an event can re-enter this function (for instance, by starting play on another sequence that
+	// evaluates synchronously), in which case the retained buffers are already in use
+	FEventDispatchBuffers ReentrantBuffers;
+	FEventDispatchBuffers& Buffers = bTriggeringEvents ? ReentrantBuffers : DispatchBuffers;
+	TGuardValue<bool> TriggeringEvents(bTriggeringEvents, true);
+
+	// We need to clean our state before actually triggering the events because one of those events could
+	// call back into an evaluation (for instance, by starting play on another sequence). If we don't clean
+	// this before, would would re-enter and re-trigger past events, resulting in an infinite loop!
+	// Swapping hands the previous flush's (empty) allocation back to PendingEvents.
+	Buffers.Reset();
+	Swap(Buffers.Events, PendingEvents);
+
+	TArray<FPendingEventTrigger>& Events = Buffers.Events;
+
+	// Group events by root instance, retaining the order in which they were added within each root
+	Algo::StableSortBy(Events, &FPendingEventTrigger::RootInstance);
+
 	FInstanceRegistry* InstanceRegistry = Linker->GetInstanceRegistry();
 
-	struct FTriggerBatch
+	int32 WriteIndex = 0;
+	for (int32 StartIndex = 0; StartIndex < Events.Num(); )
 	{
-		FTriggerBatch(TSharedRef<const FSharedPlaybackState> InSharedPlaybackState) : SharedPlaybackState(InSharedPlaybackState) {}
-		TArray<FMovieSceneEventTriggerData> Triggers;
-		TSharedRef<const FSharedPlaybackState> SharedPlaybackState;
-	};
-	TArray<FTriggerBatch> TriggerBatches;
+		const FInstanceHandle RootHandle = Events[StartIndex].RootInstance;
 
-	for (TPair<FInstanceHandle, TArray<FMovieSceneEventTriggerData>>& Pair : EventsByRoot)
-	{
-		const FSequenceInstance& RootInstance = InstanceRegistry->GetInstance(Pair.Key);
+		int32 EndIndex = StartIndex + 1;
+		while (EndIndex < Events.Num() && Events[EndIndex].RootInstance == RootHandle)
+		{
+			++EndIndex;
+		}
+
+		const FSequenceInstance& RootInstance = InstanceRegistry->GetInstance(RootHandle);
 		TSharedRef<const FSharedPlaybackState> SharedPlaybackState = RootInstance.GetSharedPlaybackState();
 
 		FFrameTime SkipUntil;
@@ -101,39 +188,53 @@ void UMovieSceneEventSystem::TriggerAllEvents()
 			bSkipTrigger = Player->IsDisablingEventTriggers(SkipUntil);
 		}
 
-		if (RootInstance.GetContext().GetDirection() == EPlayDirection::Forwards)
+		const bool bForwards = RootInstance.GetContext().GetDirection() == EPlayDirection::Forwards;
+
+		// Compact the events that should still trigger down to the end of the previous batch
+		const int32 BatchStartIndex = WriteIndex;
+		for (int32 Index = StartIndex; Index < EndIndex; ++Index)
 		{
-			if (bSkipTrigger)
+			const FFrameTime RootTime = Events[Index].TriggerData.RootTime;
+			if (bSkipTrigger && (bForwards ? RootTime <= SkipUntil : RootTime >= SkipUntil))
+			{
+				continue;
+			}
+			if (Index != WriteIndex)
 			{
-				Pair.Value.SetNum(Algo::RemoveIf(Pair.Value, [SkipUntil](FMovieSceneEventTriggerData& Data) { return Data.RootTime <= SkipUntil; }));
+				Events[WriteIndex] = MoveTemp(Events[Index]);
 			}
-			Algo::SortBy(Pair.Value, &FMovieSceneEventTriggerData::RootTime);
+			++WriteIndex;
+		}
+
+		TArrayView<FPendingEventTrigger> BatchEvents = MakeArrayView(Events.GetData() + BatchStartIndex, WriteIndex - BatchStartIndex);
+		if (bForwards)
+		{
+			Algo::SortBy(BatchEvents, [](const FPendingEventTrigger& Event) { return Event.TriggerData.RootTime; });
 		}
 		else
 		{
-			if (bSkipTrigger)
-			{
-				Pair.Value.SetNum(Algo::RemoveIf(Pair.Value, [SkipUntil](FMovieSceneEventTriggerData& Data) { return Data.RootTime >= SkipUntil; }));
-			}
-			Algo::SortBy(Pair.Value, &FMovieSceneEventTriggerData::RootTime, TGreater<>());
+			Algo::SortBy(BatchEvents, [](const FPendingEventTrigger& Event) { return Event.TriggerData.RootTime; }, TGreater<>());
 		}
 
-		FTriggerBatch& TriggerBatch = TriggerBatches.Emplace_GetRef(SharedPlaybackState);
-		TriggerBatch.Triggers = Pair.Value;
-	}
+		if (BatchEvents.Num() != 0)
+		{
+			Buffers.Batches.Add(FEventTriggerBatch{ BatchStartIndex, BatchEvents.Num(), SharedPlaybackState });
+		}
 
-	// We need to clean our state before actually triggering the events because one of those events could
-	// call back into an evaluation (for instance, by starting play on another sequence). If we don't clean
-	// this before, would would re-enter and re-trigger past events, resulting in an infinite loop!
-	EventsByRoot.Empty();
+		StartIndex = EndIndex;
+	}
+	Events.SetNum(WriteIndex, EAllowShrinking::No);
 
-	for (const FTriggerBatch& TriggerBatch : TriggerBatches)
+	for (const FEventTriggerBatch& TriggerBatch : Buffers.Batches)
 	{
-		TriggerEvents(TriggerBatch.Triggers, TriggerBatch.SharedPlaybackState);
+		TriggerEvents(MakeArrayView(Events.GetData() + TriggerBatch.StartIndex, TriggerBatch.Num), TriggerBatch.SharedPlaybackState.ToSharedRef(), Buffers);
 	}
+
+	// Keep the allocations for the next flush, but do not hold on to any objects
+	Buffers.Reset();
 }
 
-void UMovieSceneEventSystem::TriggerEvents(TArrayView<const FMovieSceneEventTriggerData> Events, TSharedRef<const FSharedPlaybackState> SharedPlaybackState)
+void UMovieSceneEventSystem::TriggerEvents(TArrayView<const UE::MovieScene::FPendingEventTrigger> Events, TSharedRef<const FSharedPlaybackState> SharedPlaybackState, UE::MovieScene::FEventDispatchBuffers& Buffers)
 {
 	using namespace UE::MovieScene;
 
@@ -152,25 +253,38 @@ void UMovieSceneEventSystem::TriggerEvents(TArrayView<const FMovieSceneEventTrig
 		DirectorCapability = &MutableState->AddCapability<FSequenceDirectorPlaybackCapability>();
 	}
 
-	TArray<UObject*> GlobalContexts;
+	// Bound objects and global contexts are only valid for this root instance
+	Buffers.ResetBoundObjects();
+	Buffers.GlobalContexts.Reset();
 	if (IEventContextsPlaybackCapability* EventContextsCapability = SharedPlaybackState->FindCapability<IEventContextsPlaybackCapability>())
 	{
 		// Query the playback capability first.
-		GlobalContexts = EventContextsCapability->GetEventContexts();
+		Buffers.GlobalContexts = EventContextsCapability->GetEventContexts();
 	}
 	else if (IMovieScenePlayer* Player = FPlayerIndexPlaybackCapability::GetPlayer(SharedPlaybackState))
 	{
 		// Check the player interface first. If implemented, we get what we want. If not, it will fall back to the default
 		// implementation that queries the playback capabality (see below), which covers the cases of a player that uses
 		// the new API.
-		GlobalContexts = Player->GetEventContexts();
+		Buffers.GlobalContexts = Player->GetEventContexts();
 	}
 
-	for (const FMovieSceneEventTriggerData& Event : Events)
+	// Events from the same sequence are commonly consecutive, so avoid looking up the same director instance repeatedly
+	FMovieSceneSequenceID DirectorSequenceID = MovieSceneSequenceID::Invalid;
+	UObject* DirectorInstance = nullptr;
+
+	for (const FPendingEventTrigger& PendingEvent : Events)
 	{
 		SCOPE_CYCLE_COUNTER(MovieSceneEval_TriggerEvents);
 
-		UObject* DirectorInstance = DirectorCapability->GetOrCreateDirectorInstance(SharedPlaybackState, Event.SequenceID);
+		const FMovieSceneEventTriggerData& Event = PendingEvent.TriggerData;
+
+		if (Event.SequenceID != DirectorSequenceID || !DirectorInstance)
+		{
+			DirectorInstance   = DirectorCapability->GetOrCreateDirectorInstance(SharedPlaybackState, Event.SequenceID);
+			DirectorSequenceID = Event.SequenceID;
+		}
+
 		if (!DirectorInstance)
 		{
 #if !NO_LOGGING
@@ -209,13 +323,15 @@ void UMovieSceneEventSystem::TriggerEvents(TArrayView<const FMovieSceneEventTrig
 		}
 		else
 		{
-			TriggerEventWithParameters(DirectorInstance, Event, GlobalContexts, SharedPlaybackState);
+			TriggerEventWithParameters(DirectorInstance, Event, SharedPlaybackState, Buffers);
 		}
 	}
 }
 
-void UMovieSceneEventSystem::TriggerEventWithParameters(UObject* DirectorInstance, const FMovieSceneEventTriggerData& Event, TArrayView<UObject* const> GlobalContexts, TSharedRef<const FSharedPlaybackState> SharedPlaybackState)
+void UMovieSceneEventSystem::TriggerEventWithParameters(UObject* DirectorInstance, const FMovieSceneEventTriggerData& Event, TSharedRef<const FSharedPlaybackState> SharedPlaybackState, UE::MovieScene::FEventDispatchBuffers& Buffers)
 {
+	using namespace UE::MovieScene;
+
 	const FMovieSceneEventPtrs& EventPtrs = Event.Ptrs;
 	if (!ensureMsgf(
 				!EventPtrs.BoundObjectProperty.Get() || 
@@ -233,6 +349,9 @@ void UMovieSceneEventSystem::TriggerEventWithParameters(UObject* DirectorInstanc
 		return;
 	}
 
+	// Buffers are never shared with re-entrant calls, so the layout remains valid while the event is triggered
+	const FEventParameterLayout& Layout = Buffers.FindOrAddParameterLayout(EventPtrs.Function);
+
 	// Parse all function parameters.
 	uint8* Parameters = (uint8*)FMemory_Alloca(EventPtrs.Function->ParmsSize + EventPtrs.Function->MinAlignment);
 	Parameters = Align(Parameters, EventPtrs.Function->MinAlignment);
@@ -240,15 +359,9 @@ void UMovieSceneEventSystem::TriggerEventWithParameters(UObject* DirectorInstanc
 	// Mem zero the parameter list
 	FMemory::Memzero(Parameters, EventPtrs.Function->ParmsSize);
 
-	// Initialize all CPF_Param properties - these are aways at the head of the list
-	for (TFieldIterator<FProperty> It(EventPtrs.Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+	for (FProperty* LocalProp : Layout.ParamsToInitialize)
 	{
-		FProperty* LocalProp = *It;
-		checkSlow(LocalProp);
-		if (!LocalProp->HasAnyPropertyFlags(CPF_ZeroConstructor))
-		{
-			LocalProp->InitializeValue_InContainer(Parameters);
-		}
+		LocalProp->InitializeValue_InContainer(Parameters);
 	}
 
 	FProperty* BoundObjectProperty = EventPtrs.BoundObjectProperty.Get();
@@ -256,12 +369,23 @@ void UMovieSceneEventSystem::TriggerEventWithParameters(UObject* DirectorInstanc
 	// If the event exists on an object binding, only call the events for those bindings (never for the global contexts)
 	if (Event.ObjectBindingID.IsValid())
 	{
-		for (TWeakObjectPtr<> WeakBoundObject : State->FindBoundObjects(Event.ObjectBindingID, Event.SequenceID, SharedPlaybackState))
+		// Resolve each binding once per batch rather than once per event, unless a previous event has invalidated any bindings
+		const FMovieSceneEvaluationOperand Operand(Event.SequenceID, Event.ObjectBindingID);
+
+		TArrayView<const TWeakObjectPtr<>> BoundObjects;
+		if (!Buffers.FindBoundObjects(Operand, State->GetSerialNumber(), BoundObjects))
+		{
+			TArrayView<TWeakObjectPtr<>> ResolvedObjects = State->FindBoundObjects(Event.ObjectBindingID, Event.SequenceID, SharedPlaybackState);
+			// Resolving the binding can itself update the serial number, so it must be retrieved afterwards
+			BoundObjects = Buffers.AddBoundObjects(Operand, State->GetSerialNumber(), ResolvedObjects);
+		}
+
+		for (TWeakObjectPtr<> WeakBoundObject : BoundObjects)
 		{
 			if (UObject* BoundObject = WeakBoundObject.Get())
 			{
 				// Attempt to bind the object to the function parameters
-				if (PatchBoundObject(Parameters, BoundObject, EventPtrs.BoundObjectProperty.Get(), SharedPlaybackState, Event.SequenceID))
+				if (PatchBoundObject(Parameters, BoundObject, BoundObjectProperty, SharedPlaybackState, Event.SequenceID))
 				{
 					DirectorInstance->ProcessEvent(EventPtrs.Function, Parameters);
 				}
@@ -270,11 +394,11 @@ void UMovieSceneEventSystem::TriggerEventWithParameters(UObject* DirectorInstanc
 	}
 
 	// At this point we know the event is a track with parameters - either trigger for global contexts, or just on its own
-	else if (GlobalContexts.Num() != 0)
+	else if (Buffers.GlobalContexts.Num() != 0)
 	{
-		for (UObject* Context : GlobalContexts)
+		for (UObject* Context : Buffers.GlobalContexts)
 		{
-			if (PatchBoundObject(Parameters, Context, EventPtrs.BoundObjectProperty.Get(), SharedPlaybackState, Event.SequenceID))
+			if (PatchBoundObject(Parameters, Context, BoundObjectProperty, SharedPlaybackState, Event.SequenceID))
 			{
 				DirectorInstance->ProcessEvent(EventPtrs.Function, Parameters);
 			}
@@ -286,9 +410,9 @@ void UMovieSceneEventSystem::TriggerEventWithParameters(UObject* DirectorInstanc
 	}
 
 	// Destroy all parameter properties one by one
-	for (TFieldIterator<FProperty> It(EventPtrs.Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+	for (FProperty* LocalProp : Layout.ParamsToDestroy)
 	{
-		It->DestroyValue_InContainer(Parameters);
+		LocalProp->DestroyValue_InContainer(Parameters);
 	}
 }
 
@@ -16,8 +16,15 @@
 #include "Materials/MaterialParameterCollectionInstance.h"
 #include "Materials/MaterialInstanceDynamic.h"
 
+#include "Algo/Sort.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(MovieSceneMaterialParameterSystem)
 
+DECLARE_CYCLE_STAT(TEXT("Apply Material Parameters"), MovieSceneEval_ApplyMaterialParameters, STATGROUP_MovieSceneECS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Animated Materials"), MovieSceneEval_NumBatchedMaterials, STATGROUP_MovieSceneECS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Material Parameters Applied"), MovieSceneEval_NumMaterialParametersApplied, STATGROUP_MovieSceneECS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Material Parameter Updates Avoided"), MovieSceneEval_NumMaterialParameterUpdatesAvoided, STATGROUP_MovieSceneECS);
+
 namespace UE::MovieScene
 {
 
@@ -71,13 +78,19 @@ FAnimatedMaterialParameterInfo::~FAnimatedMaterialParameterInfo()
 	}
 }
 
-/** Apply scalar material parameters */
-struct FApplyScalarParameters
+/** Gather scalar material parameters for batched application */
+struct FGatherScalarParameters
 {
-	static void ForEachAllocation(FEntityAllocationIteratorItem Item,
+	FMaterialParameterBatches* Batches;
+
+	explicit FGatherScalarParameters(FMaterialParameterBatches* InBatches)
+		: Batches(InBatches)
+	{}
+
+	void ForEachAllocation(FEntityAllocationIteratorItem Item,
 		TRead<FObjectComponent> BoundMaterials,
 		TReadOneOrMoreOf<FMaterialParameterInfo, FName> ScalarParameterInfosOrNames,
-		TRead<double> ScalarValues)
+		TRead<double> ScalarValues) const
 	{
 		const int32 Num = Item.GetAllocation()->Num();
 		const FMaterialParameterInfo* ParameterInfos = ScalarParameterInfosOrNames.Get<0>();
@@ -90,42 +103,28 @@ struct FApplyScalarParameters
 				continue;
 			}
 
-			// WARNING: BoundMaterial may be nullptr here
-			if (UMaterialInstanceDynamic* MID = Cast<UMaterialInstanceDynamic>(BoundMaterial.GetObject()))
-			{
-				if (ParameterInfos)
-				{
-					MID->SetScalarParameterValueByInfo(ParameterInfos[Index], (float)ScalarValues[Index]);
-				}
-				else
-				{
-					MID->SetScalarParameterValue(ParameterNames[Index], (float)ScalarValues[Index]);
-				}
-			}
-			else if (UMaterialParameterCollectionInstance* MPCI = Cast<UMaterialParameterCollectionInstance>(BoundMaterial.GetObject()))
-			{
-				if (ParameterInfos)
-				{
-					MPCI->SetScalarParameterValue(ParameterInfos[Index].Name, (float)ScalarValues[Index]);
-				}
-				else
-				{
-					MPCI->SetScalarParameterValue(ParameterNames[Index], (float)ScalarValues[Index]);
-				}
-			}
-
-
+			Batches->Scalars.Add(FPendingScalarMaterialParameter{
+				BoundMaterial.GetObject(),
+				ParameterInfos ? ParameterInfos[Index] : FMaterialParameterInfo(ParameterNames[Index]),
+				(float)ScalarValues[Index]
+			});
 		}
 	}
 };
 
-/** Apply vector material parameters */
-struct FApplyVectorParameters
+/** Gather vector material parameters for batched application */
+struct FGatherVectorParameters
 {
-	static void ForEachAllocation(FEntityAllocationIteratorItem Item,
+	FMaterialParameterBatches* Batches;
+
+	explicit FGatherVectorParameters(FMaterialParameterBatches* InBatches)
+		: Batches(InBatches)
+	{}
+
+	void ForEachAllocation(FEntityAllocationIteratorItem Item,
 		TRead<FObjectComponent> BoundMaterials,
 		TReadOneOrMoreOf<FMaterialParameterInfo, FMaterialParameterInfo, FName, FName> VectorOrColorParameterInfosOrNames,
-		TReadOneOrMoreOf<double, double, double, double> VectorChannels)
+		TReadOneOrMoreOf<double, double, double, double> VectorChannels) const
 	{
 		const int32 Num = Item.GetAllocation()->Num();
 		// Use either the vector parameter name, or the color parameter name
@@ -135,7 +134,12 @@ struct FApplyVectorParameters
 		const double* RESTRICT G = VectorChannels.Get<1>();
 		const double* RESTRICT B = VectorChannels.Get<2>();
 		const double* RESTRICT A = VectorChannels.Get<3>();
-		
+
+		if (!ParameterInfos && !ParameterNames)
+		{
+			return;
+		}
+
 		for (int32 Index = 0; Index < Num; ++Index)
 		{
 			const FObjectComponent& BoundMaterial = BoundMaterials[Index];
@@ -151,31 +155,125 @@ struct FApplyVectorParameters
 				B ? (float)B[Index] : 1.f,
 				A ? (float)A[Index] : 1.f
 			);
-			if (UMaterialInstanceDynamic* MID = Cast<UMaterialInstanceDynamic>(BoundMaterial.GetObject()))
+
+			Batches->Vectors.Add(FPendingVectorMaterialParameter{
+				BoundMaterial.GetObject(),
+				ParameterInfos ? ParameterInfos[Index] : FMaterialParameterInfo(ParameterNames[Index]),
+				Color
+			});
+		}
+	}
+};
+
+/** Apply all gathered material parameters once both gather tasks have completed */
+struct FApplyMaterialParameterBatches
+{
+	FMaterialParameterBatches* Batches;
+
+	void Run(FEntityAllocationWriteContext WriteContext) const
+	{
+		Run();
+	}
+	void Run() const
+	{
+		Batches->Apply();
+	}
+};
+
+void FMaterialParameterBatches::Apply()
+{
+	SCOPE_CYCLE_COUNTER(MovieSceneEval_ApplyMaterialParameters);
+
+	// Group values by material so that each material is only resolved and visited once
+	Algo::SortBy(Scalars, &FPendingScalarMaterialParameter::BoundMaterial);
+	Algo::SortBy(Vectors, &FPendingVectorMaterialParameter::BoundMaterial);
+
+	int32 NumMaterials = 0;
+	int32 NumApplied   = 0;
+	int32 NumSkipped   = 0;
+
+	int32 ScalarIndex = 0;
+	int32 VectorIndex = 0;
+	while (ScalarIndex < Scalars.Num() || VectorIndex < Vectors.Num())
+	{
+		UObject* BoundMaterial = nullptr;
+		if (ScalarIndex < Scalars.Num() && VectorIndex < Vectors.Num())
+		{
+			BoundMaterial = FMath::Min(Scalars[ScalarIndex].BoundMaterial, Vectors[VectorIndex].BoundMaterial);
+		}
+		else
+		{
+			BoundMaterial = ScalarIndex < Scalars.Num() ? Scalars[ScalarIndex].BoundMaterial : Vectors[VectorIndex].BoundMaterial;
+		}
+
+		++NumMaterials;
+
+		// WARNING: BoundMaterial may be nullptr here
+		UMaterialInstanceDynamic* MID = Cast<UMaterialInstanceDynamic>(BoundMaterial);
+		UMaterialParameterCollectionInstance* MPCI = MID ? nullptr : Cast<UMaterialParameterCollectionInstance>(BoundMaterial);
+
+		for ( ; ScalarIndex < Scalars.Num() && Scalars[ScalarIndex].BoundMaterial == BoundMaterial; ++ScalarIndex)
+		{
+			const FPendingScalarMaterialParameter& Scalar = Scalars[ScalarIndex];
+
+			float CurrentValue = 0.f;
+			if (MID)
 			{
-				if (ParameterInfos)
+				if (MID->GetScalarParameterValue(Scalar.ParameterInfo, CurrentValue, true) && CurrentValue == Scalar.Value)
 				{
-					MID->SetVectorParameterValueByInfo(ParameterInfos[Index], Color);
+					++NumSkipped;
+					continue;
 				}
-				else if (ParameterNames)
+				MID->SetScalarParameterValueByInfo(Scalar.ParameterInfo, Scalar.Value);
+				++NumApplied;
+			}
+			else if (MPCI)
+			{
+				if (MPCI->GetScalarParameterValue(Scalar.ParameterInfo.Name, CurrentValue) && CurrentValue == Scalar.Value)
 				{
-					MID->SetVectorParameterValue(ParameterNames[Index], Color);
+					++NumSkipped;
+					continue;
 				}
+				MPCI->SetScalarParameterValue(Scalar.ParameterInfo.Name, Scalar.Value);
+				++NumApplied;
 			}
-			else if (UMaterialParameterCollectionInstance* MPCI = Cast<UMaterialParameterCollectionInstance>(BoundMaterial.GetObject()))
+		}
+
+		for ( ; VectorIndex < Vectors.Num() && Vectors[VectorIndex].BoundMaterial == BoundMaterial; ++VectorIndex)
+		{
+			const FPendingVectorMaterialParameter& Vector = Vectors[VectorIndex];
+
+			FLinearColor CurrentValue;
+			if (MID)
 			{
-				if (ParameterInfos)
+				if (MID->GetVectorParameterValue(Vector.ParameterInfo, CurrentValue, true) && CurrentValue == Vector.Value)
 				{
-					MPCI->SetVectorParameterValue(ParameterInfos[Index].Name, Color);
+					++NumSkipped;
+					continue;
 				}
-				else if (ParameterNames)
+				MID->SetVectorParameterValueByInfo(Vector.ParameterInfo, Vector.Value);
+				++NumApplied;
+			}
+			else if (MPCI)
+			{
+				if (MPCI->GetVectorParameterValue(Vector.ParameterInfo.Name, CurrentValue) && CurrentValue == Vector.Value)
 				{
-					MPCI->SetVectorParameterValue(ParameterNames[Index], Color);
+					++NumSkipped;
+					continue;
 				}
+				MPCI->SetVectorParameterValue(Vector.ParameterInfo.Name, Vector.Value);
+				++NumApplied;
 			}
 		}
 	}
-};
+
+	SET_DWORD_STAT(MovieSceneEval_NumBatchedMaterials, NumMaterials);
+	SET_DWORD_STAT(MovieSceneEval_NumMaterialParametersApplied, NumApplied);
+	SET_DWORD_STAT(MovieSceneEval_NumMaterialParameterUpdatesAvoided, NumSkipped);
+
+	Scalars.Reset();
+	Vectors.Reset();
+}
 
 struct FScalarMixin
 {
@@ -619,24 +717,32 @@ void UMovieSceneMaterialParameterEvaluationSystem::OnSchedulePersistentTasks(UE:
 	FBuiltInComponentTypes* BuiltInComponents = FBuiltInComponentTypes::Get();
 	FMovieSceneTracksComponentTypes* TracksComponents = FMovieSceneTracksComponentTypes::Get();
 
-	FEntityTaskBuilder()
+	FTaskID GatherScalarsTask = FEntityTaskBuilder()
 	.Read(TracksComponents->BoundMaterial)
 	// Handle both new parameter info and old parameter names for backwards compatibility with MovieSceneParameterSection
 	.ReadOneOrMoreOf(TracksComponents->ScalarMaterialParameterInfo, TracksComponents->ScalarParameterName)
 	.Read(BuiltInComponents->DoubleResult[0])
 	.FilterNone({ BuiltInComponents->BlendChannelInput })
-	.SetDesiredThread(Linker->EntityManager.GetDispatchThread())
-	.Fork_PerAllocation<FApplyScalarParameters>(&Linker->EntityManager, TaskScheduler);
+	.Schedule_PerAllocation<FGatherScalarParameters>(&Linker->EntityManager, TaskScheduler, &ParameterBatches);
 
 	// Vectors and colors use the same API
-	FEntityTaskBuilder()
+	FTaskID GatherVectorsTask = FEntityTaskBuilder()
 	.Read(TracksComponents->BoundMaterial)
 	// Handle both new parameter info and old parameter names for backwards compatibility with MovieSceneParameterSection
 	.ReadOneOrMoreOf(TracksComponents->VectorMaterialParameterInfo, TracksComponents->ColorMaterialParameterInfo, TracksComponents->VectorParameterName, TracksComponents->ColorParameterName)
 	.ReadOneOrMoreOf(BuiltInComponents->DoubleResult[0], BuiltInComponents->DoubleResult[1], BuiltInComponents->DoubleResult[2], BuiltInComponents->DoubleResult[3])
 	.FilterNone({ BuiltInComponents->BlendChannelInput })
-	.SetDesiredThread(Linker->EntityManager.GetDispatchThread())
-	.Fork_PerAllocation<FApplyVectorParameters>(&Linker->EntityManager, TaskScheduler);
+	.Schedule_PerAllocation<FGatherVectorParameters>(&Linker->EntityManager, TaskScheduler, &ParameterBatches);
+
+	FTaskParams ApplyParams(TEXT("Apply Material Parameters"));
+	if (Linker->EntityManager.GetDispatchThread() == ENamedThreads::GameThread)
+	{
+		ApplyParams.ForceGameThread();
+	}
+
+	FTaskID ApplyTask = TaskScheduler->AddTask<FApplyMaterialParameterBatches>(ApplyParams, &ParameterBatches);
+	TaskScheduler->AddPrerequisite(GatherScalarsTask, ApplyTask);
+	TaskScheduler->AddPrerequisite(GatherVectorsTask, ApplyTask);
 }
 
 void UMovieSceneMaterialParameterEvaluationSystem::OnRun(FSystemTaskPrerequisites& InPrerequisites, FSystemSubsequentTasks& Subsequents)
@@ -646,16 +752,22 @@ void UMovieSceneMaterialParameterEvaluationSystem::OnRun(FSystemTaskPrerequisite
 	FBuiltInComponentTypes* BuiltInComponents = FBuiltInComponentTypes::Get();
 	FMovieSceneTracksComponentTypes* TracksComponents = FMovieSceneTracksComponentTypes::Get();
 
+	FSystemTaskPrerequisites ApplyPrereqs;
+
 	if (Linker->EntityManager.ContainsComponent(TracksComponents->ScalarMaterialParameterInfo) || Linker->EntityManager.ContainsComponent(TracksComponents->ScalarParameterName))
 	{
-		FEntityTaskBuilder()
+		FGraphEventRef GatherScalarsTask = FEntityTaskBuilder()
 		.Read(TracksComponents->BoundMaterial)	
 		// Handle both new parameter info and old parameter names for backwards compatibility with MovieSceneParameterSection
 		.ReadOneOrMoreOf(TracksComponents->ScalarMaterialParameterInfo, TracksComponents->ScalarParameterName)
 		.Read(BuiltInComponents->DoubleResult[0])
 		.FilterNone({ BuiltInComponents->BlendChannelInput })
-		.SetDesiredThread(Linker->EntityManager.GetDispatchThread())
-		.Dispatch_PerAllocation<FApplyScalarParameters>(&Linker->EntityManager, InPrerequisites, &Subsequents);
+		.Dispatch_PerAllocation<FGatherScalarParameters>(&Linker->EntityManager, InPrerequisites, nullptr, &ParameterBatches);
+
+		if (GatherScalarsTask)
+		{
+			ApplyPrereqs.AddRootTask(GatherScalarsTask);
+		}
 	}
 
 	// Vectors and colors use the same API
@@ -664,13 +776,20 @@ void UMovieSceneMaterialParameterEvaluationSystem::OnRun(FSystemTaskPrerequisite
 		|| Linker->EntityManager.ContainsComponent(TracksComponents->VectorParameterName)
 		|| Linker->EntityManager.ContainsComponent(TracksComponents->ColorParameterName))
 	{
-		FEntityTaskBuilder()
+		FGraphEventRef GatherVectorsTask = FEntityTaskBuilder()
 		.Read(TracksComponents->BoundMaterial)
 		.ReadOneOrMoreOf(TracksComponents->VectorMaterialParameterInfo, TracksComponents->ColorMaterialParameterInfo, TracksComponents->VectorParameterName, TracksComponents->ColorParameterName)
 		.ReadOneOrMoreOf(BuiltInComponents->DoubleResult[0], BuiltInComponents->DoubleResult[1], BuiltInComponents->DoubleResult[2], BuiltInComponents->DoubleResult[3])
 		.FilterNone({ BuiltInComponents->BlendChannelInput })
-		.SetDesiredThread(Linker->EntityManager.GetDispatchThread())
-		.Dispatch_PerAllocation<FApplyVectorParameters>(&Linker->EntityManager, InPrerequisites, &Subsequents);
+		.Dispatch_PerAllocation<FGatherVectorParameters>(&Linker->EntityManager, InPrerequisites, nullptr, &ParameterBatches);
+
+		if (GatherVectorsTask)
+		{
+			ApplyPrereqs.AddRootTask(GatherVectorsTask);
+		}
 	}
-}
 
+	TEntityTaskComponents<>()
+	.SetDesiredThread(Linker->EntityManager.GetDispatchThread())
+	.Dispatch<FApplyMaterialParameterBatches>(&Linker->EntityManager, ApplyPrereqs, &Subsequents, &ParameterBatches);
+}
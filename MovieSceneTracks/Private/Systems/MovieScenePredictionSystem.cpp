@@ -31,6 +31,213 @@ DECLARE_CYCLE_STAT(TEXT("Prediction Initialization"), MovieSceneEval_PredictionI
 DECLARE_CYCLE_STAT(TEXT("Prediction Finalization"),   MovieSceneEval_PredictionFinalization,  STATGROUP_MovieSceneECS);
 DECLARE_CYCLE_STAT(TEXT("Prediction Report Results"), MovieSceneEval_PredictionReportResults, STATGROUP_MovieSceneECS);
 
+namespace UE::MovieScene
+{
+
+/**
+ * Imports transform track entities for predictions. Object binding lookups are cached so that
+ * the same importer can be used to import many times for the same objects.
+ */
+struct FPredictionEntityImporter
+{
+	FPredictionEntityImporter(UMovieSceneSequencePlayer* InSequencePlayer, TArray<FMovieSceneEntityID>& OutImportedEntities)
+		: SequencePlayer(InSequencePlayer)
+		, ImportedEntities(OutImportedEntities)
+	{
+		const FMovieSceneRootEvaluationTemplateInstance& RootTemplate = static_cast<IMovieScenePlayer*>(SequencePlayer)->GetEvaluationTemplate();
+
+		Linker              = RootTemplate.GetEntitySystemLinker();
+		CompiledDataManager = RootTemplate.GetCompiledDataManager();
+		CompiledDataID      = RootTemplate.GetCompiledDataID();
+	}
+
+	/**
+	 * Import all the transform entities that relate to the specified object at the specified root time, from the root sequence and any sub-sequences
+	 *
+	 * @return The number of entities that were imported
+	 */
+	int32 ImportTransformEntities(UObject* PredicateObject, FFrameTime RootPredictedTime, const FInterrogationKey& InterrogationKey)
+	{
+		FEntityImportSequenceParams ImportParams;
+
+		int32 TotalNumEntities = 0;
+
+		const FMovieSceneCompiledDataEntry& CompiledEntry = CompiledDataManager->GetEntryRef(CompiledDataID);
+
+		if (UMovieSceneSequence* Sequence = CompiledEntry.GetSequence())
+		{
+			FGuid FoundID = FindBinding(PredicateObject, Sequence, MovieSceneSequenceID::Root);
+			if (FoundID.IsValid())
+			{
+				const FMovieSceneEntityComponentField* ComponentField = CompiledDataManager->FindEntityComponentField(CompiledDataID);
+				if (ComponentField)
+				{
+					TotalNumEntities += ImportTransformEntities(ImportParams, FoundID, RootPredictedTime, ComponentField, InterrogationKey);
+				}
+			}
+		}
+
+		// Also check all the sub-sequences at the predicted time
+		const FMovieSceneSequenceHierarchy* Hierarchy = CompiledDataManager->FindHierarchy(CompiledDataID);
+		if (Hierarchy)
+		{
+			FMovieSceneEvaluationTreeRangeIterator NodeIt = Hierarchy->GetTree().IterateFromTime(RootPredictedTime.FrameNumber);
+			TMovieSceneEvaluationTreeDataIterator<FMovieSceneSubSequenceTreeEntry> SubSequenceIt = Hierarchy->GetTree().GetAllData(NodeIt.Node());
+			for ( ; SubSequenceIt; ++SubSequenceIt)
+			{
+				if (SubSequenceIt->Flags == ESectionEvaluationFlags::None)
+				{
+					const FMovieSceneSubSequenceData* SubData = Hierarchy->FindSubData(SubSequenceIt->SequenceID);
+					if (SubData)
+					{
+						if (UMovieSceneSequence* SubSequence = SubData->GetSequence())
+						{
+							FMovieSceneCompiledDataID SubDataID = CompiledDataManager->FindDataID(SubSequence);
+							if (SubDataID.IsValid())
+							{
+								FGuid FoundID = FindBinding(PredicateObject, SubSequence, SubSequenceIt->SequenceID);
+								if (FoundID.IsValid())
+								{
+									const FMovieSceneEntityComponentField* ComponentField = CompiledDataManager->FindEntityComponentField(SubDataID);
+									if (ComponentField)
+									{
+										ImportParams.HierarchicalBias = SubData->HierarchicalBias;
+
+										FFrameTime SubPredictedTime = RootPredictedTime * SubData->RootToSequenceTransform;
+										TotalNumEntities += ImportTransformEntities(ImportParams, FoundID, SubPredictedTime, ComponentField, InterrogationKey);
+									}
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+
+		return TotalNumEntities;
+	}
+
+private:
+
+	int32 ImportTransformEntities(const FEntityImportSequenceParams& ImportParams, const FGuid& ObjectGuid, FFrameTime PredictedTime, const FMovieSceneEntityComponentField* ComponentField, const FInterrogationKey& InterrogationKey)
+	{
+		int32 NumEntities = 0;
+
+		auto QueryCallback = [this, ImportParams, ObjectGuid, ComponentField, InterrogationKey, &NumEntities](const FMovieSceneEvaluationFieldEntityQuery& InQuery)
+		{
+			UMovieScene3DTransformSection* TransformSection = Cast<UMovieScene3DTransformSection>(InQuery.Entity.Key.EntityOwner.Get());
+			if (TransformSection == nullptr)
+			{
+				return true;
+			}
+
+			if (!MovieSceneHelpers::IsSectionKeyable(TransformSection))
+			{
+				return true;
+			}
+
+			const FMovieSceneEvaluationFieldSharedEntityMetaData* SharedMetaData = ComponentField->FindSharedMetaData(InQuery);
+			if (!SharedMetaData || SharedMetaData->ObjectBindingID != ObjectGuid)
+			{
+				return true;
+			}
+
+			UObject* EntityOwner = InQuery.Entity.Key.EntityOwner.Get();
+			IMovieSceneEntityProvider* Provider = Cast<IMovieSceneEntityProvider>(EntityOwner);
+			if (!Provider)
+			{
+				return true;
+			}
+
+			FEntityImportParams Params;
+			Params.Sequence = ImportParams;
+			Params.EntityID = InQuery.Entity.Key.EntityID;
+			Params.EntityMetaData = ComponentField->FindMetaData(InQuery);
+			Params.SharedMetaData = SharedMetaData;
+			Params.InterrogationKey = InterrogationKey;
+
+			FImportedEntity ImportedEntity;
+			Provider->InterrogateEntity(Linker, Params, &ImportedEntity);
+
+			if (!ImportedEntity.IsEmpty())
+			{
+				TransformSection->BuildDefaultComponents(Linker, Params, &ImportedEntity);
+
+				const FMovieSceneEntityID NewEntityID = ImportedEntity.Manufacture(Params, &Linker->EntityManager);
+				this->ImportedEntities.Add(NewEntityID);
+
+				++NumEntities;
+			}
+
+			return true;
+		};
+
+		// Query any transform track entities at the specified time that relate to the object binding ID
+		TRange<FFrameNumber> Unused;
+		ComponentField->QueryPersistentEntities(PredictedTime.FrameNumber, QueryCallback, Unused);
+
+		return NumEntities;
+	}
+
+	FGuid FindBinding(UObject* PredicateObject, UMovieSceneSequence* Sequence, FMovieSceneSequenceID SequenceID)
+	{
+		if (const FGuid* CachedID = BindingCache.Find(MakeTuple(PredicateObject, SequenceID)))
+		{
+			return *CachedID;
+		}
+
+		TOptional<FMovieSceneSpawnableAnnotation> SpawnableAnnotation = FindSpawnableAnnotation(PredicateObject);
+
+		const bool bIsSpawnable = SpawnableAnnotation && SpawnableAnnotation->SequenceID == SequenceID;
+		FGuid FoundID = bIsSpawnable ? SpawnableAnnotation->ObjectBindingID : Sequence->FindBindingFromObject(PredicateObject, SequencePlayer->GetSharedPlaybackState());
+
+		BindingCache.Add(MakeTuple(PredicateObject, SequenceID), FoundID);
+		return FoundID;
+	}
+
+	TOptional<FMovieSceneSpawnableAnnotation> FindSpawnableAnnotation(UObject* PredicateObject)
+	{
+		if (const TOptional<FMovieSceneSpawnableAnnotation>* CachedAnnotation = SpawnableAnnotationCache.Find(PredicateObject))
+		{
+			return *CachedAnnotation;
+		}
+
+		TOptional<FMovieSceneSpawnableAnnotation> SpawnableAnnotation;
+
+		if (AActor* Actor = Cast<AActor>(PredicateObject))
+		{
+			SpawnableAnnotation = FMovieSceneSpawnableAnnotation::Find(Actor);
+			if (SpawnableAnnotation)
+			{
+				FMovieSceneSpawnRegister& SpawnRegister = static_cast<IMovieScenePlayer*>(SequencePlayer)->GetSpawnRegister();
+
+				// Verify that the spawnable came from this sequence
+				if (SpawnRegister.FindSpawnedObject(SpawnableAnnotation->ObjectBindingID, SpawnableAnnotation->SequenceID).Get() != Actor)
+				{
+					SpawnableAnnotation.Reset();
+				}
+			}
+		}
+
+		SpawnableAnnotationCache.Add(PredicateObject, SpawnableAnnotation);
+		return SpawnableAnnotation;
+	}
+
+private:
+
+	UMovieSceneSequencePlayer* SequencePlayer;
+	TArray<FMovieSceneEntityID>& ImportedEntities;
+
+	UMovieSceneEntitySystemLinker* Linker;
+	UMovieSceneCompiledDataManager* CompiledDataManager;
+	FMovieSceneCompiledDataID CompiledDataID;
+
+	TMap<TTuple<UObject*, FMovieSceneSequenceID>, FGuid> BindingCache;
+	TMap<UObject*, TOptional<FMovieSceneSpawnableAnnotation>> SpawnableAnnotationCache;
+};
+
+} // namespace UE::MovieScene
+
 UMovieSceneAsyncAction_SequencePrediction* UMovieSceneAsyncAction_SequencePrediction::PredictWorldTransformAtTime(UMovieSceneSequencePlayer* Player, USceneComponent* TargetComponent, float TimeInSeconds)
 {
 	return MakePredictionImpl(Player, TargetComponent, TimeInSeconds, true);
@@ -174,210 +381,287 @@ void UMovieSceneAsyncAction_SequencePrediction::ImportEntities(UE::MovieScene::F
 	}
 }
 
-int32 UMovieSceneAsyncAction_SequencePrediction::ImportTransformEntities(UMovieSceneEntitySystemLinker* Linker, const UE::MovieScene::FEntityImportSequenceParams& ImportParams, const FGuid& ObjectGuid, FFrameTime PredictedTime, const FMovieSceneEntityComponentField* ComponentField, const UE::MovieScene::FInterrogationKey& InterrogationKey)
+void UMovieSceneAsyncAction_SequencePrediction::ImportLocalTransforms(UE::MovieScene::FInterrogationChannels* Channels, USceneComponent* InSceneComponent)
 {
 	using namespace UE::MovieScene;
 
-	int32 NumEntities = 0;
+	check(InSceneComponent);
 
-	auto QueryCallback = [this, Linker, ImportParams, ObjectGuid, ComponentField, InterrogationKey, &NumEntities](const FMovieSceneEvaluationFieldEntityQuery& InQuery)
+	FInterrogationChannel ParentChannel;
+	if (USceneComponent* AttachParent = InSceneComponent->GetAttachParent())
 	{
-		UMovieScene3DTransformSection* TransformSection = Cast<UMovieScene3DTransformSection>(InQuery.Entity.Key.EntityOwner.Get());
-		if (TransformSection == nullptr)
-		{
-			return true;
-		}
+		ParentChannel = Channels->FindChannel(AttachParent);
+	}
 
-		if (!MovieSceneHelpers::IsSectionKeyable(TransformSection))
-		{
-			return true;
-		}
+	FInterrogationChannel Channel = Channels->FindChannel(InSceneComponent);
+	if (!Channel.IsValid())
+	{
+		Channel = Channels->AllocateChannel(InSceneComponent, ParentChannel, FMovieScenePropertyBinding("Transform", TEXT("Transform")));
+	}
 
-		const FMovieSceneEvaluationFieldSharedEntityMetaData* SharedMetaData = ComponentField->FindSharedMetaData(InQuery);
-		if (!SharedMetaData || SharedMetaData->ObjectBindingID != ObjectGuid)
-		{
-			return true;
-		}
+	if (!Channel.IsValid())
+	{
+		return;
+	}
 
-		UObject* EntityOwner = InQuery.Entity.Key.EntityOwner.Get();
-		IMovieSceneEntityProvider* Provider = Cast<IMovieSceneEntityProvider>(EntityOwner);
-		if (!Provider)
-		{
-			return true;
-		}
+	FInterrogationKey Key{ Channel, InterrogationIndex };
+	FPredictionEntityImporter Importer(SequencePlayer, ImportedEntities);
 
-		FEntityImportParams Params;
-		Params.Sequence = ImportParams;
-		Params.EntityID = InQuery.Entity.Key.EntityID;
-		Params.EntityMetaData = ComponentField->FindMetaData(InQuery);
-		Params.SharedMetaData = SharedMetaData;
-		Params.InterrogationKey = InterrogationKey;
+	// Query for any transform tracks relating to the scene component at the predicted time
+	int32 NumEntities = Importer.ImportTransformEntities(InSceneComponent, RootPredictedTime, Key);
 
-		FImportedEntity ImportedEntity;
-		Provider->InterrogateEntity(Linker, Params, &ImportedEntity);
+	// Also blend in any transforms that exist for this scene component's actor as well (if it is the root)
+	AActor* Owner = InSceneComponent->GetOwner();
+	if (Owner && InSceneComponent == Owner->GetRootComponent())
+	{
+		NumEntities += Importer.ImportTransformEntities(Owner, RootPredictedTime, Key);
+	}
 
-		if (!ImportedEntity.IsEmpty())
-		{
-			TransformSection->BuildDefaultComponents(Linker, Params, &ImportedEntity);
+	if (NumEntities > 0)
+	{
+		Channels->ActivateChannel(Channel);
+	}
+}
+
+void UMovieSceneAsyncAction_SequencePrediction::ImportTransformHierarchy(UE::MovieScene::FInterrogationChannels* Channels, USceneComponent* InSceneComponent)
+{
+	check(InSceneComponent);
 
-			const FMovieSceneEntityID NewEntityID = ImportedEntity.Manufacture(Params, &Linker->EntityManager);
-			this->ImportedEntities.Add(NewEntityID);
+	// Ensure the parent is imported first
+	if (USceneComponent* AttachParent = InSceneComponent->GetAttachParent())
+	{
+		ImportTransformHierarchy(Channels, AttachParent);
+	}
 
-			++NumEntities;
-		}
+	ImportLocalTransforms(Channels, InSceneComponent);
+}
 
-		return true;
-	};
+UMovieSceneAsyncAction_SequenceBatchPrediction* UMovieSceneAsyncAction_SequenceBatchPrediction::PredictWorldTransformsAtTimes(UMovieSceneSequencePlayer* Player, const TArray<USceneComponent*>& TargetComponents, const TArray<float>& TimesInSeconds)
+{
+	if (!Player || !Player->GetSequence() || !Player->GetSequence()->GetMovieScene())
+	{
+		return nullptr;
+	}
 
-	// Query any transform track entities at the specified time that relate to the object binding ID
-	TRange<FFrameNumber> Unused;
-	ComponentField->QueryPersistentEntities(PredictedTime.FrameNumber, QueryCallback, Unused);
+	const FFrameRate TickResolution = Player->GetSequence()->GetMovieScene()->GetTickResolution();
 
-	return NumEntities;
+	TArray<FFrameTime, TInlineAllocator<16>> TickResolutionTimes;
+	for (float TimeInSeconds : TimesInSeconds)
+	{
+		TickResolutionTimes.Add(TimeInSeconds * TickResolution);
+	}
+	return MakePredictionImpl(Player, TargetComponents, TickResolutionTimes, true);
 }
 
+UMovieSceneAsyncAction_SequenceBatchPrediction* UMovieSceneAsyncAction_SequenceBatchPrediction::PredictLocalTransformsAtTimes(UMovieSceneSequencePlayer* Player, const TArray<USceneComponent*>& TargetComponents, const TArray<float>& TimesInSeconds)
+{
+	if (!Player || !Player->GetSequence() || !Player->GetSequence()->GetMovieScene())
+	{
+		return nullptr;
+	}
+
+	const FFrameRate TickResolution = Player->GetSequence()->GetMovieScene()->GetTickResolution();
+
+	TArray<FFrameTime, TInlineAllocator<16>> TickResolutionTimes;
+	for (float TimeInSeconds : TimesInSeconds)
+	{
+		TickResolutionTimes.Add(TimeInSeconds * TickResolution);
+	}
+	return MakePredictionImpl(Player, TargetComponents, TickResolutionTimes, false);
+}
 
-int32 UMovieSceneAsyncAction_SequencePrediction::ImportTransformEntities(UObject* PredicateObject, UObject* ObjectContext, const UE::MovieScene::FInterrogationKey& InterrogationKey)
+UMovieSceneAsyncAction_SequenceBatchPrediction* UMovieSceneAsyncAction_SequenceBatchPrediction::PredictWorldTransformsAtFrames(UMovieSceneSequencePlayer* Player, const TArray<USceneComponent*>& TargetComponents, const TArray<FFrameTime>& FrameTimes)
 {
-	using namespace UE::MovieScene;
+	if (!Player || !Player->GetSequence() || !Player->GetSequence()->GetMovieScene())
+	{
+		return nullptr;
+	}
 
-	FEntityImportSequenceParams ImportParams;
+	UMovieScene* MovieScene = Player->GetSequence()->GetMovieScene();
 
-	int32 TotalNumEntities = 0;
-	const FMovieSceneRootEvaluationTemplateInstance& RootTemplate = static_cast<IMovieScenePlayer*>(SequencePlayer)->GetEvaluationTemplate();
+	TArray<FFrameTime, TInlineAllocator<16>> TickResolutionTimes;
+	for (FFrameTime FrameTime : FrameTimes)
+	{
+		TickResolutionTimes.Add(ConvertFrameTime(FrameTime, MovieScene->GetDisplayRate(), MovieScene->GetTickResolution()));
+	}
+	return MakePredictionImpl(Player, TargetComponents, TickResolutionTimes, true);
+}
 
-	TOptional<FMovieSceneSpawnableAnnotation> SpawnableAnnotation;
+UMovieSceneAsyncAction_SequenceBatchPrediction* UMovieSceneAsyncAction_SequenceBatchPrediction::PredictLocalTransformsAtFrames(UMovieSceneSequencePlayer* Player, const TArray<USceneComponent*>& TargetComponents, const TArray<FFrameTime>& FrameTimes)
+{
+	if (!Player || !Player->GetSequence() || !Player->GetSequence()->GetMovieScene())
+	{
+		return nullptr;
+	}
 
-	if (AActor* Actor = Cast<AActor>(PredicateObject))
+	UMovieScene* MovieScene = Player->GetSequence()->GetMovieScene();
+
+	TArray<FFrameTime, TInlineAllocator<16>> TickResolutionTimes;
+	for (FFrameTime FrameTime : FrameTimes)
 	{
-		SpawnableAnnotation = FMovieSceneSpawnableAnnotation::Find(Actor);
-		if (SpawnableAnnotation)
-		{
-			FMovieSceneSpawnRegister& SpawnRegister = static_cast<IMovieScenePlayer*>(SequencePlayer)->GetSpawnRegister();
+		TickResolutionTimes.Add(ConvertFrameTime(FrameTime, MovieScene->GetDisplayRate(), MovieScene->GetTickResolution()));
+	}
+	return MakePredictionImpl(Player, TargetComponents, TickResolutionTimes, false);
+}
 
-			// Verify that the spawnable came from this sequence
-			if (SpawnRegister.FindSpawnedObject(SpawnableAnnotation->ObjectBindingID, SpawnableAnnotation->SequenceID).Get() != Actor)
-			{
-				SpawnableAnnotation.Reset();
-			}
+UMovieSceneAsyncAction_SequenceBatchPrediction* UMovieSceneAsyncAction_SequenceBatchPrediction::MakePredictionImpl(UMovieSceneSequencePlayer* Player, const TArray<USceneComponent*>& TargetComponents, TArrayView<const FFrameTime> TickResolutionTimes, bool bInWorldSpace)
+{
+	check(Player);
+
+	UMovieSceneEntitySystemLinker* Linker           = static_cast<IMovieScenePlayer*>(Player)->GetEvaluationTemplate().GetEntitySystemLinker();
+	UMovieScenePredictionSystem*   PredictionSystem = Linker->LinkSystem<UMovieScenePredictionSystem>();
+
+	UMovieSceneAsyncAction_SequenceBatchPrediction* NewPrediction = NewObject<UMovieSceneAsyncAction_SequenceBatchPrediction>(PredictionSystem);
+
+	NewPrediction->SequencePlayer  = Player;
+	NewPrediction->SceneComponents = TargetComponents;
+	NewPrediction->bWorldSpace     = bInWorldSpace;
+
+	// Only make a single interrogation for each unique time
+	for (FFrameTime Time : TickResolutionTimes)
+	{
+		int32 TimeIndex = NewPrediction->RootPredictedTimes.IndexOfByKey(Time);
+		if (TimeIndex == INDEX_NONE)
+		{
+			TimeIndex = NewPrediction->RootPredictedTimes.Add(Time);
+			NewPrediction->InterrogationIndices.Add(PredictionSystem->MakeNewInterrogation(Time));
 		}
+		NewPrediction->RequestedTimeIndices.Add(TimeIndex);
 	}
 
-	UMovieSceneEntitySystemLinker*  Linker              = RootTemplate.GetEntitySystemLinker();
-	UMovieSceneCompiledDataManager* CompiledDataManager = RootTemplate.GetCompiledDataManager();
-	FMovieSceneCompiledDataID       CompiledDataID      = RootTemplate.GetCompiledDataID();
+	PredictionSystem->AddPendingPrediction(NewPrediction);
+	return NewPrediction;
+}
 
-	const FMovieSceneCompiledDataEntry& CompiledEntry = CompiledDataManager->GetEntryRef(CompiledDataID);
+void UMovieSceneAsyncAction_SequenceBatchPrediction::ImportEntities(UE::MovieScene::FInterrogationChannels* Channels)
+{
+	using namespace UE::MovieScene;
 
-	if (UMovieSceneSequence* Sequence = CompiledEntry.GetSequence())
+	// Gather every component along with its attach parents, ordered such that parents are always imported before their children
+	TArray<USceneComponent*, TInlineAllocator<16>> ComponentsToImport;
+	for (USceneComponent* SceneComponent : SceneComponents)
 	{
-		const bool bIsSpawnable = SpawnableAnnotation && SpawnableAnnotation->SequenceID == MovieSceneSequenceID::Root;
-		FGuid FoundID = bIsSpawnable ? SpawnableAnnotation->ObjectBindingID : Sequence->FindBindingFromObject(PredicateObject, SequencePlayer->GetSharedPlaybackState());
-
-		if (FoundID.IsValid())
+		const int32 InsertIndex = ComponentsToImport.Num();
+		for (USceneComponent* Current = SceneComponent; Current && !ComponentsToImport.Contains(Current); Current = Current->GetAttachParent())
 		{
-			const FMovieSceneEntityComponentField* ComponentField = CompiledDataManager->FindEntityComponentField(CompiledDataID);
-			if (ComponentField)
-			{
-				TotalNumEntities += ImportTransformEntities(Linker, ImportParams, FoundID, RootPredictedTime, ComponentField, InterrogationKey);
-			}
+			ComponentsToImport.Insert(Current, InsertIndex);
 		}
 	}
 
-	// Also check all the sub-sequences at the predicted time
-	const FMovieSceneSequenceHierarchy* Hierarchy = CompiledDataManager->FindHierarchy(CompiledDataID);
-	if (Hierarchy)
+	FPredictionEntityImporter Importer(SequencePlayer, ImportedEntities);
+
+	for (USceneComponent* SceneComponent : ComponentsToImport)
 	{
-		FMovieSceneEvaluationTreeRangeIterator NodeIt = Hierarchy->GetTree().IterateFromTime(RootPredictedTime.FrameNumber);
-		TMovieSceneEvaluationTreeDataIterator<FMovieSceneSubSequenceTreeEntry> SubSequenceIt = Hierarchy->GetTree().GetAllData(NodeIt.Node());
-		for ( ; SubSequenceIt; ++SubSequenceIt)
+		FInterrogationChannel ParentChannel;
+		if (USceneComponent* AttachParent = SceneComponent->GetAttachParent())
+		{
+			ParentChannel = Channels->FindChannel(AttachParent);
+		}
+
+		FInterrogationChannel Channel = Channels->FindChannel(SceneComponent);
+		if (!Channel.IsValid())
 		{
-			if (SubSequenceIt->Flags == ESectionEvaluationFlags::None)
+			Channel = Channels->AllocateChannel(SceneComponent, ParentChannel, FMovieScenePropertyBinding("Transform", TEXT("Transform")));
+		}
+
+		if (!Channel.IsValid())
+		{
+			continue;
+		}
+
+		// Also blend in any transforms that exist for this scene component's actor as well (if it is the root)
+		AActor* Owner = SceneComponent->GetOwner();
+		const bool bIsRootComponent = Owner && SceneComponent == Owner->GetRootComponent();
+
+		int32 NumEntities = 0;
+		for (int32 TimeIndex = 0; TimeIndex < RootPredictedTimes.Num(); ++TimeIndex)
+		{
+			if (InterrogationIndices[TimeIndex] == INDEX_NONE)
 			{
-				const FMovieSceneSubSequenceData* SubData = Hierarchy->FindSubData(SubSequenceIt->SequenceID);
-				if (SubData)
-				{
-					if (UMovieSceneSequence* SubSequence = SubData->GetSequence())
-					{
-						FMovieSceneCompiledDataID SubDataID = CompiledDataManager->FindDataID(SubSequence);
-						if (SubDataID.IsValid())
-						{
-							const bool bIsSpawnable = SpawnableAnnotation && SpawnableAnnotation->SequenceID == SubSequenceIt->SequenceID;
-							FGuid FoundID = bIsSpawnable ? SpawnableAnnotation->ObjectBindingID : SubSequence->FindBindingFromObject(PredicateObject, SequencePlayer->GetSharedPlaybackState());
+				continue;
+			}
 
-							if (FoundID.IsValid())
-							{
-								const FMovieSceneEntityComponentField* ComponentField = CompiledDataManager->FindEntityComponentField(SubDataID);
-								if (ComponentField)
-								{
-									ImportParams.HierarchicalBias = SubData->HierarchicalBias;
+			FInterrogationKey Key{ Channel, InterrogationIndices[TimeIndex] };
 
-									FFrameTime SubPredictedTime = RootPredictedTime * SubData->RootToSequenceTransform;
-									TotalNumEntities += ImportTransformEntities(Linker, ImportParams, FoundID, SubPredictedTime, ComponentField, InterrogationKey);
-								}
-							}
-						}
-					}
-				}
+			NumEntities += Importer.ImportTransformEntities(SceneComponent, RootPredictedTimes[TimeIndex], Key);
+			if (bIsRootComponent)
+			{
+				NumEntities += Importer.ImportTransformEntities(Owner, RootPredictedTimes[TimeIndex], Key);
 			}
 		}
-	}
 
-	return TotalNumEntities;
+		if (NumEntities > 0)
+		{
+			Channels->ActivateChannel(Channel);
+		}
+	}
 }
 
-void UMovieSceneAsyncAction_SequencePrediction::ImportLocalTransforms(UE::MovieScene::FInterrogationChannels* Channels, USceneComponent* InSceneComponent)
+void UMovieSceneAsyncAction_SequenceBatchPrediction::Reset(UMovieSceneEntitySystemLinker* Linker)
 {
 	using namespace UE::MovieScene;
 
-	check(InSceneComponent);
+	FComponentTypeID NeedsUnlink = FBuiltInComponentTypes::Get()->Tags.NeedsUnlink;
 
-	FInterrogationChannel ParentChannel;
-	if (USceneComponent* AttachParent = InSceneComponent->GetAttachParent())
+	for (FMovieSceneEntityID EntityID : ImportedEntities)
 	{
-		ParentChannel = Channels->FindChannel(AttachParent);
+		Linker->EntityManager.AddComponent(EntityID, NeedsUnlink, EEntityRecursion::Full);
 	}
+	ImportedEntities.Empty();
+}
 
-	FInterrogationChannel Channel = Channels->FindChannel(InSceneComponent);
-	if (!Channel.IsValid())
-	{
-		Channel = Channels->AllocateChannel(InSceneComponent, ParentChannel, FMovieScenePropertyBinding("Transform", TEXT("Transform")));
-	}
+void UMovieSceneAsyncAction_SequenceBatchPrediction::ReportResult(UE::MovieScene::FInterrogationChannels* Channels, const TSparseArray<TArray<FTransform>>& AllResults)
+{
+	ReportResultImpl(Channels, AllResults);
+}
 
-	if (!Channel.IsValid())
-	{
-		return;
-	}
+void UMovieSceneAsyncAction_SequenceBatchPrediction::ReportResult(UE::MovieScene::FInterrogationChannels* Channels, const TSparseArray<TArray<UE::MovieScene::FIntermediate3DTransform>>& AllResults)
+{
+	ReportResultImpl(Channels, AllResults);
+}
 
-	FInterrogationKey Key{ Channel, InterrogationIndex };
+template<typename TransformType>
+void UMovieSceneAsyncAction_SequenceBatchPrediction::ReportResultImpl(UE::MovieScene::FInterrogationChannels* Channels, const TSparseArray<TArray<TransformType>>& AllResults)
+{
+	using namespace UE::MovieScene;
 
-	// Query for any transform tracks relating to the scene component at the predicted time
-	int32 NumEntities = ImportTransformEntities(InSceneComponent, InSceneComponent->GetOwner(), Key);
+	const int32 NumTimes = RequestedTimeIndices.Num();
 
-	// Also blend in any transforms that exist for this scene component's actor as well (if it is the root)
-	AActor* Owner = InSceneComponent->GetOwner();
-	if (Owner && InSceneComponent == Owner->GetRootComponent())
-	{
-		NumEntities += ImportTransformEntities(Owner, Owner->GetWorld(), Key);
-	}
+	TArray<FTransform> PredictedTransforms;
+	TArray<bool> Succeeded;
+	PredictedTransforms.SetNum(SceneComponents.Num() * NumTimes);
+	Succeeded.SetNumZeroed(SceneComponents.Num() * NumTimes);
 
-	if (NumEntities > 0)
+	for (int32 ComponentIndex = 0; ComponentIndex < SceneComponents.Num(); ++ComponentIndex)
 	{
-		Channels->ActivateChannel(Channel);
-	}
-}
-
-void UMovieSceneAsyncAction_SequencePrediction::ImportTransformHierarchy(UE::MovieScene::FInterrogationChannels* Channels, USceneComponent* InSceneComponent)
-{
-	check(InSceneComponent);
+		FInterrogationChannel Channel = SceneComponents[ComponentIndex] ? Channels->FindChannel(SceneComponents[ComponentIndex]) : FInterrogationChannel();
+		if (!Channel || !AllResults.IsValidIndex(Channel.AsIndex()))
+		{
+			continue;
+		}
 
-	// Ensure the parent is imported first
-	if (USceneComponent* AttachParent = InSceneComponent->GetAttachParent())
-	{
-		ImportTransformHierarchy(Channels, AttachParent);
+		const TArray<TransformType>& ChannelResults = AllResults[Channel.AsIndex()];
+		for (int32 TimeIndex = 0; TimeIndex < NumTimes; ++TimeIndex)
+		{
+			const int32 InterrogationIndex = InterrogationIndices[RequestedTimeIndices[TimeIndex]];
+			if (ChannelResults.IsValidIndex(InterrogationIndex))
+			{
+				const int32 ResultIndex = ComponentIndex * NumTimes + TimeIndex;
+				if constexpr (std::is_same_v<TransformType, FTransform>)
+				{
+					PredictedTransforms[ResultIndex] = ChannelResults[InterrogationIndex];
+				}
+				else
+				{
+					const FIntermediate3DTransform& Transform = ChannelResults[InterrogationIndex];
+					PredictedTransforms[ResultIndex] = FTransform(Transform.GetRotation(), Transform.GetTranslation(), Transform.GetScale());
+				}
+				Succeeded[ResultIndex] = true;
+			}
+		}
 	}
 
-	ImportLocalTransforms(Channels, InSceneComponent);
+	Result.Broadcast(PredictedTransforms, Succeeded);
 }
 
 UMovieScenePredictionSystem::UMovieScenePredictionSystem(const FObjectInitializer& ObjInit)
@@ -401,7 +685,7 @@ UMovieScenePredictionSystem::UMovieScenePredictionSystem(const FObjectInitialize
 bool UMovieScenePredictionSystem::IsRelevantImpl(UMovieSceneEntitySystemLinker* InLinker) const
 {
 	// This system is always relevant as long as it has pending or processing predictions in-flight
-	return PendingPredictions.Num() + ProcessingPredictions.Num() != 0;
+	return PendingPredictions.Num() + ProcessingPredictions.Num() + PendingBatchPredictions.Num() + ProcessingBatchPredictions.Num() != 0;
 }
 
 void UMovieScenePredictionSystem::OnRun(FSystemTaskPrerequisites& InPrerequisites, FSystemSubsequentTasks& Subsequents)
@@ -417,25 +701,33 @@ void UMovieScenePredictionSystem::OnRun(FSystemTaskPrerequisites& InPrerequisite
 	// ------------------------------------------------------------------
 	// Instantiation Phase - import the necessary entities to interrogate
 	// pending predictions
-	if (CurrentPhase == ESystemPhase::Spawn && PendingPredictions.Num())
+	if (CurrentPhase == ESystemPhase::Spawn && (PendingPredictions.Num() || PendingBatchPredictions.Num()))
 	{
 		SCOPE_CYCLE_COUNTER(MovieSceneEval_PredictionIntialization)
 
-		ensure(ProcessingPredictions.Num() == 0);
+		ensure(ProcessingPredictions.Num() == 0 && ProcessingBatchPredictions.Num() == 0);
 
 		Swap(ProcessingPredictions, PendingPredictions);
 		PendingPredictions.Empty();
 
+		Swap(ProcessingBatchPredictions, PendingBatchPredictions);
+		PendingBatchPredictions.Empty();
+
 		for (int32 Index = 0; Index < ProcessingPredictions.Num(); ++Index)
 		{
 			UMovieSceneAsyncAction_SequencePrediction* Pending = ProcessingPredictions[Index];
 			Pending->ImportEntities(&InterrogationChannels);
 		}
+		for (int32 Index = 0; Index < ProcessingBatchPredictions.Num(); ++Index)
+		{
+			UMovieSceneAsyncAction_SequenceBatchPrediction* Pending = ProcessingBatchPredictions[Index];
+			Pending->ImportEntities(&InterrogationChannels);
+		}
 
 		// Add mutual components for any interrogation entities
 		Linker->EntityManager.AddMutualComponents(FEntityComponentFilter().All({ FBuiltInComponentTypes::Get()->Interrogation.InputKey }));
 	}
-	else if (CurrentPhase == ESystemPhase::Instantiation && ProcessingPredictions.Num())
+	else if (CurrentPhase == ESystemPhase::Instantiation && (ProcessingPredictions.Num() || ProcessingBatchPredictions.Num()))
 	{
 		// Initialize evaluation times
 		TArrayView<const FInterrogationParams> Interrogations = InterrogationChannels.GetInterrogations();
@@ -489,7 +781,7 @@ void UMovieScenePredictionSystem::OnRun(FSystemTaskPrerequisites& InPrerequisite
 			}
 		}
 	}
-	else if (CurrentPhase == ESystemPhase::Finalization && ProcessingPredictions.Num())
+	else if (CurrentPhase == ESystemPhase::Finalization && (ProcessingPredictions.Num() || ProcessingBatchPredictions.Num()))
 	{
 		bool bNeedsWorldSpace = false, bNeedsLocalSpace = false;
 
@@ -498,6 +790,11 @@ void UMovieScenePredictionSystem::OnRun(FSystemTaskPrerequisites& InPrerequisite
 			bNeedsWorldSpace |= Prediction->bWorldSpace;
 			bNeedsLocalSpace |= !Prediction->bWorldSpace;
 		}
+		for (UMovieSceneAsyncAction_SequenceBatchPrediction* Prediction : ProcessingBatchPredictions)
+		{
+			bNeedsWorldSpace |= Prediction->bWorldSpace;
+			bNeedsLocalSpace |= !Prediction->bWorldSpace;
+		}
 
 		TSparseArray<TArray<FTransform>> WorldTransforms;
 		TSparseArray<TArray<UE::MovieScene::FIntermediate3DTransform>> LocalTransforms;
@@ -530,10 +827,25 @@ void UMovieScenePredictionSystem::OnRun(FSystemTaskPrerequisites& InPrerequisite
 
 				Prediction->Reset(Linker);
 			}
+
+			for (UMovieSceneAsyncAction_SequenceBatchPrediction* Prediction : ProcessingBatchPredictions)
+			{
+				if (Prediction->bWorldSpace)
+				{
+					Prediction->ReportResult(&InterrogationChannels, WorldTransforms);
+				}
+				else
+				{
+					Prediction->ReportResult(&InterrogationChannels, LocalTransforms);
+				}
+
+				Prediction->Reset(Linker);
+			}
 		}
 
 		Linker->EntityManager.MimicStructureChanged();
 		ProcessingPredictions.Empty();
+		ProcessingBatchPredictions.Empty();
 
 		InterrogationChannels.Reset();
 	}
@@ -547,6 +859,14 @@ void UMovieScenePredictionSystem::AddPendingPrediction(UMovieSceneAsyncAction_Se
 	Linker->EntityManager.MimicStructureChanged();
 }
 
+void UMovieScenePredictionSystem::AddPendingPrediction(UMovieSceneAsyncAction_SequenceBatchPrediction* Prediction)
+{
+	PendingBatchPredictions.Add(Prediction);
+
+	// Mimic structure changed to ensure that the instantiation phase runs
+	Linker->EntityManager.MimicStructureChanged();
+}
+
 int32 UMovieScenePredictionSystem::MakeNewInterrogation(FFrameTime InTime)
 {
 	UE::MovieScene::FInterrogationParams Params{ InTime };
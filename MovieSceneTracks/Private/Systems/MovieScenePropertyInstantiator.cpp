@@ -634,6 +634,7 @@ void UMovieScenePropertyInstantiatorSystem::UpdatePropertyInfo(const FPropertyPa
 	bool bWantsRestoreState = false;
 	bool bNeedsInitialValue = false;
 	bool bBlendHierarchicalBias = false;
+	bool bAllSkipUnchangedValues = true;
 
 	// Iterate all contributors for this property to re-generate the meta-data
 	for (auto ContributorIt = Contributors.CreateConstKeyIterator(AnyContributor); ContributorIt; ++ContributorIt)
@@ -670,6 +671,12 @@ void UMovieScenePropertyInstantiatorSystem::UpdatePropertyInfo(const FPropertyPa
 			bWantsRestoreState = true;
 		}
 
+		// Unchanged values may only be skipped if every contributor has explicitly opted in
+		if (bAllSkipUnchangedValues && !Type.Contains(BuiltInComponents->Tags.SkipUnchangedPropertyValues))
+		{
+			bAllSkipUnchangedValues = false;
+		}
+
 		// Update whether this meta-data entry needs an initial value or not
 		if (!bNeedsInitialValue && Type.Contains(BuiltInComponents->Tags.AlwaysCacheInitialValue))
 		{
@@ -723,6 +730,8 @@ void UMovieScenePropertyInstantiatorSystem::UpdatePropertyInfo(const FPropertyPa
 	Params.PropertyInfo->bSupportsFastPath      = bSupportsFastPath;
 	Params.PropertyInfo->bWantsRestoreState     = bWantsRestoreState;
 	Params.PropertyInfo->bNeedsInitialValue     = bNeedsInitialValue;
+	// Partially animated properties are combined with the object's current value so never skip unchanged values
+	Params.PropertyInfo->bSkipUnchangedValues   = NumContributors > 0 && bAllSkipUnchangedValues && !bIsPartial;
 }
 
 void UMovieScenePropertyInstantiatorSystem::InitializeFastPath(const FPropertyParameters& Params)
@@ -744,6 +753,18 @@ void UMovieScenePropertyInstantiatorSystem::InitializeFastPath(const FPropertyPa
 			SoleContributorMutation.AddMask.Set(Params.PropertyDefinition->InitialValueType);
 		}
 
+		if (FComponentTypeID LastAppliedValueType = Params.PropertyDefinition->LastAppliedValueType)
+		{
+			if (Params.PropertyInfo->bSkipUnchangedValues)
+			{
+				SoleContributorMutation.AddMask.Set(LastAppliedValueType);
+			}
+			else
+			{
+				SoleContributorMutation.RemoveMask.Set(LastAppliedValueType);
+			}
+		}
+
 		if (Params.PropertyDefinition->MetaDataTypes.Num() > 0)
 		{
 			InitializePropertyMetaDataTasks.PadToNum(Params.PropertyInfo->PropertyDefinitionIndex+1, false);
@@ -956,6 +977,10 @@ void UMovieScenePropertyInstantiatorSystem::InitializeBlendPath(const FPropertyP
 	InputMutation.RemoveMask = CleanFastPathMask;
 	InputMutation.RemoveMask.Set(Params.PropertyDefinition->InitialValueType);
 	InputMutation.RemoveMask.Set(BuiltInComponents->Tags.HasAssignedInitialValue);
+	if (Params.PropertyDefinition->LastAppliedValueType)
+	{
+		InputMutation.RemoveMask.Set(Params.PropertyDefinition->LastAppliedValueType);
+	}
 	for (FComponentTypeID Component : Params.PropertyDefinition->MetaDataTypes)
 	{
 		InputMutation.RemoveMask.Set(Component);
@@ -1022,6 +1047,11 @@ void UMovieScenePropertyInstantiatorSystem::InitializeBlendPath(const FPropertyP
 		}
 		NewMask.Set(Params.PropertyDefinition->PropertyType);
 
+		if (Params.PropertyDefinition->LastAppliedValueType && Params.PropertyInfo->bSkipUnchangedValues)
+		{
+			NewMask.Set(Params.PropertyDefinition->LastAppliedValueType);
+		}
+
 		FMovieSceneEntityID NewOutputEntityID;
 
 		auto NewOutputEntity = FEntityBuilder()
@@ -1212,6 +1242,19 @@ void UMovieScenePropertyInstantiatorSystem::FPropertyParameters::MakeOutputCompo
 	}
 	OutComponentType.Set(PropertyDefinition->PropertyType);
 
+	// Only record last applied values for properties that have opted in to skipping unchanged values
+	if (FComponentTypeID LastAppliedValueType = PropertyDefinition->LastAppliedValueType)
+	{
+		if (PropertyInfo->bSkipUnchangedValues)
+		{
+			OutComponentType.Set(LastAppliedValueType);
+		}
+		else
+		{
+			OutComponentType.Remove(LastAppliedValueType);
+		}
+	}
+
 	// Set the restore state tag appropriately
 	if (PropertyInfo->bWantsRestoreState)
 	{
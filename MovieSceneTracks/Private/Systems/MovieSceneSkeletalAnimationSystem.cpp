@@ -3,6 +3,7 @@
 #include "Systems/MovieSceneSkeletalAnimationSystem.h"
 
 #include "Decorations/MovieSceneScalingAnchors.h"
+#include "Async/ParallelFor.h"
 #include "Async/TaskGraphInterfaces.h"
 #include "EntitySystem/BuiltInComponentTypes.h"
 #include "EntitySystem/Interrogation/MovieSceneInterrogationLinker.h"
@@ -16,6 +17,7 @@
 #include "MovieSceneExecutionToken.h"
 #include "MovieSceneTracksComponentTypes.h"
 #include "Sections/MovieSceneSkeletalAnimationSection.h"
+#include "Tracks/MovieSceneCommonAnimationTrack.h"
 
 #include "Evaluation/PreAnimatedState/IMovieScenePreAnimatedStorage.h"
 #include "Evaluation/PreAnimatedState/MovieScenePreAnimatedObjectStorage.h"
@@ -56,6 +58,7 @@
 #include UE_INLINE_GENERATED_CPP_BY_NAME(MovieSceneSkeletalAnimationSystem)
 
 DECLARE_CYCLE_STAT(TEXT("Gather skeletal animations"), MovieSceneEval_GatherSkeletalAnimations, STATGROUP_MovieSceneECS);
+DECLARE_CYCLE_STAT(TEXT("Compute skeletal root motion"), MovieSceneEval_ComputeSkeletalRootMotion, STATGROUP_MovieSceneECS);
 DECLARE_CYCLE_STAT(TEXT("Evaluate skeletal animations"), MovieSceneEval_EvaluateSkeletalAnimations, STATGROUP_MovieSceneECS);
 
 namespace UE::MovieScene
@@ -74,6 +77,13 @@ FAutoConsoleVariableRef CVarAnimationUIFlickerFix(
 	TEXT("(Default: true. Fixes pre-animated state ordering that was causing excessive UI flicker. Known to cause issues when animating Anim Class so should be disabled if a crash is encountered.")
 	);
 
+bool GSkeletalAnimationParallelRootMotion = true;
+FAutoConsoleVariableRef CVarSkeletalAnimationParallelRootMotion(
+	TEXT("Sequencer.Animation.ParallelRootMotion"),
+	GSkeletalAnimationParallelRootMotion,
+	TEXT("(Default: true. Computes root motion for skeletal animation tracks in parallel before animations are applied on the game thread.")
+	);
+
 /** Helper function to get our sequencer animation node from a skeletal mesh component */
 UAnimSequencerInstance* GetAnimSequencerInstance(USkeletalMeshComponent* SkeletalMeshComponent)
 {
@@ -385,6 +395,67 @@ void FSkeletalAnimationSystemData::ResetSkeletalAnimations()
 	SkeletalAnimations.Reset();
 }
 
+void FSkeletalAnimationSystemData::PrepareRootMotion()
+{
+	check(IsInGameThread());
+
+	RootMotionBatches.Reset();
+
+	// Root motion is computed by the owning track, which lazily sets up root motions, sorts its sections and updates its evaluation field.
+	// Do all of that here, once per track, so that the parallel computation is read-only.
+	TMap<UMovieSceneCommonAnimationTrack*, int32> TrackToBatch;
+
+	auto AddAnimations = [this, &TrackToBatch](FBoundObjectActiveSkeletalAnimations::FAnimationArray& Animations)
+	{
+		for (FActiveSkeletalAnimation& Animation : Animations)
+		{
+			UMovieSceneCommonAnimationTrack* Track = Animation.AnimSection->GetTypedOuter<UMovieSceneCommonAnimationTrack>();
+			if (Track)
+			{
+				const int32 BatchIndex = TrackToBatch.FindOrAdd(Track, RootMotionBatches.Num());
+				if (BatchIndex == RootMotionBatches.Num())
+				{
+					RootMotionBatches.Emplace_GetRef().EvaluationField = &Track->PrepareRootMotionEvaluation();
+				}
+				RootMotionBatches[BatchIndex].Animations.Add(&Animation);
+			}
+		}
+	};
+
+	for (TTuple<TWeakObjectPtr<USkeletalMeshComponent>, FBoundObjectActiveSkeletalAnimations>& Pair : SkeletalAnimations)
+	{
+		if (Pair.Key.IsValid())
+		{
+			AddAnimations(Pair.Value.Animations);
+			AddAnimations(Pair.Value.SimulatedAnimations);
+		}
+	}
+}
+
+void FSkeletalAnimationSystemData::ComputeRootMotion()
+{
+	ParallelFor(RootMotionBatches.Num(), [this](int32 BatchIndex)
+	{
+		const FSkeletalRootMotionBatch& Batch = RootMotionBatches[BatchIndex];
+		for (FActiveSkeletalAnimation* Animation : Batch.Animations)
+		{
+			const FFrameTime FrameTime = Animation->EvalFrameTime.RoundToFrame();
+			Animation->AnimSection->EvaluateRootMotion(FrameTime, *Batch.EvaluationField, Animation->FrameRootMotion);
+			if (FrameTime == Animation->EvalFrameTime)
+			{
+				Animation->RootMotion = Animation->FrameRootMotion;
+			}
+			else
+			{
+				Animation->AnimSection->EvaluateRootMotion(Animation->EvalFrameTime, *Batch.EvaluationField, Animation->RootMotion);
+			}
+			Animation->bHasRootMotion = true;
+		}
+	}, GSkeletalAnimationParallelRootMotion ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+	RootMotionBatches.Reset();
+}
+
 /** ------------------------------------------------------------------------- */
 /** Task for gathering active skeletal animations */
 struct FGatherSkeletalAnimations
@@ -521,6 +592,7 @@ struct FGatherSkeletalAnimations
 			Animation.bResetDynamics     = bResetDynamics;
 			Animation.bWantsRestoreState = bWantsRestoreState;
 			Animation.bPreviewPlayback   = bPreviewPlayback;
+			Animation.bHasRootMotion     = false;
 
 			BoundObjectAnimations.Animations.Add(Animation);
 
@@ -556,6 +628,46 @@ private:
 	}
 };
 
+/** Task for preparing animation tracks on the game thread so that their root motion can be computed in parallel */
+struct FPrepareSkeletalRootMotion
+{
+	FSkeletalAnimationSystemData* SystemData;
+
+	explicit FPrepareSkeletalRootMotion(FSkeletalAnimationSystemData* InSystemData)
+		: SystemData(InSystemData)
+	{
+	}
+
+	void Run(FEntityAllocationWriteContext WriteContext) const
+	{
+		Run();
+	}
+	void Run() const
+	{
+		SystemData->PrepareRootMotion();
+	}
+};
+
+/** Task for computing root motion for gathered skeletal animations off the game thread */
+struct FComputeSkeletalRootMotion
+{
+	FSkeletalAnimationSystemData* SystemData;
+
+	explicit FComputeSkeletalRootMotion(FSkeletalAnimationSystemData* InSystemData)
+		: SystemData(InSystemData)
+	{
+	}
+
+	void Run(FEntityAllocationWriteContext WriteContext) const
+	{
+		Run();
+	}
+	void Run() const
+	{
+		SystemData->ComputeRootMotion();
+	}
+};
+
 /** Task for evaluating skeletal animations */
 struct FEvaluateSkeletalAnimations
 {
@@ -568,6 +680,10 @@ private:
 	TSharedPtr<FPreAnimatedSkeletalAnimationMontageStorage> PreAnimatedMontageStorage;
 	TSharedPtr<FPreAnimatedSkeletalAnimationAnimInstanceStorage> PreAnimatedAnimInstanceStorage;
 
+	/** Bound objects that have a component transform, gathered on demand once per evaluation */
+	mutable TSet<UObject*> TransformedObjects;
+	mutable bool bGatheredTransformedObjects = false;
+
 public:
 
 	FEvaluateSkeletalAnimations(UMovieSceneEntitySystemLinker* InLinker, FSkeletalAnimationSystemData* InSystemData)
@@ -585,6 +701,9 @@ public:
 	}
 	void Run() const
 	{
+		TransformedObjects.Reset();
+		bGatheredTransformedObjects = false;
+
 		for (const TTuple<TWeakObjectPtr<USkeletalMeshComponent>, FBoundObjectActiveSkeletalAnimations>& Pair : SystemData->SkeletalAnimations)
 		{
 			if (Pair.Key.IsValid())
@@ -740,6 +859,9 @@ private:
 		const UMovieSceneSkeletalAnimationSection* Section = nullptr;
 		USkeletalMeshComponent* SkeletalMeshComponent = nullptr;
 
+		/** Root motion at CurrentTime if it has already been computed */
+		const UMovieSceneSkeletalAnimationSection::FRootMotionParams* RootMotion = nullptr;
+
 		FFrameTime CurrentTime;
 		float FromPosition;
 		float ToPosition;
@@ -778,7 +900,14 @@ private:
 			const UMovieSceneSkeletalAnimationSection* AnimSection = SkeletalAnimation.AnimSection;
 			const FMovieSceneSkeletalAnimationParams& AnimParams = AnimSection->Params;
 			UMovieSceneSkeletalAnimationSection::FRootMotionParams RootMotionParams;
-			AnimSection->GetRootMotion(SkeletalAnimation.EvalFrameTime.RoundToFrame(), RootMotionParams);
+			if (SkeletalAnimation.bHasRootMotion)
+			{
+				RootMotionParams = SkeletalAnimation.FrameRootMotion;
+			}
+			else
+			{
+				AnimSection->GetRootMotion(SkeletalAnimation.EvalFrameTime.RoundToFrame(), RootMotionParams);
+			}
 			//set up root motion/bone transform delegates
 			if (AnimSection->Params.SwapRootBone != ESwapRootBone::SwapRootBone_None)
 			{
@@ -817,6 +946,7 @@ private:
 			SetAnimPositionParams.bPlaying = SkeletalAnimation.bPlaying;
 			SetAnimPositionParams.bFireNotifies = (SkeletalAnimation.bFireNotifies && !AnimParams.bSkipAnimNotifiers && !bLooped);
 			SetAnimPositionParams.bResetDynamics = SkeletalAnimation.bResetDynamics;
+			SetAnimPositionParams.RootMotion = SkeletalAnimation.bHasRootMotion ? &SkeletalAnimation.RootMotion : nullptr;
 
 			if (SkeletalAnimation.bPreviewPlayback)
 			{
@@ -834,28 +964,29 @@ private:
 	{
 		using namespace UE::MovieScene;
 
-		bool bContainsTransform = false;
-
-		auto HarvestTransforms = [InBoundObject, &bContainsTransform](UObject* BoundObject)
+		// Harvest all transformed objects the first time this is called rather than iterating every transform for each animation
+		if (!bGatheredTransformedObjects)
 		{
-			if (BoundObject == InBoundObject)
+			auto HarvestTransforms = [this](UObject* BoundObject)
 			{
-				bContainsTransform = true;
-			}
-		};
-				
-		FBuiltInComponentTypes* BuiltInComponents = FBuiltInComponentTypes::Get();
-
-		FMovieSceneTracksComponentTypes* Components = FMovieSceneTracksComponentTypes::Get();
-		FEntityTaskBuilder()
-			.Read(BuiltInComponents->BoundObject)
-			// Only include component transforms
-			.FilterAll({ Components->ComponentTransform.PropertyTag })
-			// Only read things with the resolved properties on - this ensures we do not read any intermediate component transforms for blended properties
-			.FilterAny({ BuiltInComponents->CustomPropertyIndex, BuiltInComponents->FastPropertyOffset, BuiltInComponents->SlowProperty })
-			.Iterate_PerEntity(&Linker->EntityManager, HarvestTransforms);
-
-		return bContainsTransform;
+				TransformedObjects.Add(BoundObject);
+			};
+
+			FBuiltInComponentTypes* BuiltInComponents = FBuiltInComponentTypes::Get();
+
+			FMovieSceneTracksComponentTypes* Components = FMovieSceneTracksComponentTypes::Get();
+			FEntityTaskBuilder()
+				.Read(BuiltInComponents->BoundObject)
+				// Only include component transforms
+				.FilterAll({ Components->ComponentTransform.PropertyTag })
+				// Only read things with the resolved properties on - this ensures we do not read any intermediate component transforms for blended properties
+				.FilterAny({ BuiltInComponents->CustomPropertyIndex, BuiltInComponents->FastPropertyOffset, BuiltInComponents->SlowProperty })
+				.Iterate_PerEntity(&Linker->EntityManager, HarvestTransforms);
+
+			bGatheredTransformedObjects = true;
+		}
+
+		return TransformedObjects.Contains(InBoundObject);
 	}
 
 	// Get the current transform for the component that the root bone will be swaped to
@@ -886,6 +1017,18 @@ private:
 		return CurrentTransform;
 	}
 
+	static void GetRootMotion(const FSetAnimPositionParams& Params, UMovieSceneSkeletalAnimationSection::FRootMotionParams& OutRootMotionParams)
+	{
+		if (Params.RootMotion)
+		{
+			OutRootMotionParams = *Params.RootMotion;
+		}
+		else
+		{
+			Params.Section->GetRootMotion(Params.CurrentTime, OutRootMotionParams);
+		}
+	}
+
 	void SetAnimPosition(const FSetAnimPositionParams& Params) const
 	{
 		static const bool bLooping = false;
@@ -906,7 +1049,7 @@ private:
 			TOptional <FRootMotionOverride> RootMotion;
 			UMovieSceneSkeletalAnimationSection::FRootMotionParams RootMotionParams;
 
-			Params.Section->GetRootMotion(Params.CurrentTime, RootMotionParams);
+			GetRootMotion(Params, RootMotionParams);
 			if (RootMotionParams.Transform.IsSet())
 			{
 				RootMotion = FRootMotionOverride();
@@ -997,7 +1140,7 @@ private:
 
 			TOptional <FRootMotionOverride> RootMotion;
 			UMovieSceneSkeletalAnimationSection::FRootMotionParams RootMotionParams;
-			Params.Section->GetRootMotion(Params.CurrentTime, RootMotionParams);
+			GetRootMotion(Params, RootMotionParams);
 			if (RootMotionParams.Transform.IsSet())
 			{
 				RootMotion = FRootMotionOverride();
@@ -1279,13 +1422,23 @@ void UMovieSceneSkeletalAnimationSystem::OnSchedulePersistentTasks(UE::MovieScen
 	.Schedule_PerAllocation<FGatherSkeletalAnimations>(&Linker->EntityManager, TaskScheduler, 
 			Linker->GetInstanceRegistry(), &SystemData);
 
+	// Tracks lazily update cached root motion state, so prepare them on the game thread before computing root motion in parallel
+	FTaskParams PrepareParams(GET_STATID(MovieSceneEval_ComputeSkeletalRootMotion));
+	PrepareParams.ForceGameThread();
+	FTaskID PrepareRootMotionTask = TaskScheduler->AddTask<FPrepareSkeletalRootMotion>(PrepareParams, &SystemData);
+
+	// Compute root motion for the gathered animations in parallel so that the game thread task only has to apply it
+	FTaskID RootMotionTask = TaskScheduler->AddTask<FComputeSkeletalRootMotion>(FTaskParams(GET_STATID(MovieSceneEval_ComputeSkeletalRootMotion)), &SystemData);
+
 	// Now evaluate gathered animations. We need to do this on the game thread (when in multi-threaded mode)
 	// because this task will call into a lot of animation system code that needs to be called there.
 	FTaskParams Params(GET_STATID(MovieSceneEval_EvaluateSkeletalAnimations));
 	Params.ForceGameThread();
 	FTaskID EvaluateTask = TaskScheduler->AddTask<FEvaluateSkeletalAnimations>(Params, Linker, &SystemData);
 
-	TaskScheduler->AddPrerequisite(GatherTask, EvaluateTask);
+	TaskScheduler->AddPrerequisite(GatherTask, PrepareRootMotionTask);
+	TaskScheduler->AddPrerequisite(PrepareRootMotionTask, RootMotionTask);
+	TaskScheduler->AddPrerequisite(RootMotionTask, EvaluateTask);
 	TaskScheduler->AddPrerequisite(WaitForAllTransforms, EvaluateTask);
 	TaskScheduler->AddPrerequisite(WaitForObjectProperties, EvaluateTask);
 }
@@ -1333,10 +1486,34 @@ void UMovieSceneSkeletalAnimationSystem::OnRun(FSystemTaskPrerequisites& InPrere
 	.Dispatch_PerAllocation<FGatherSkeletalAnimations>(&Linker->EntityManager, InPrerequisites, nullptr, 
 			Linker->GetInstanceRegistry(), &SystemData);
 
-	FSystemTaskPrerequisites EvalPrereqs;
+	FSystemTaskPrerequisites PrepareRootMotionPrereqs;
 	if (GatherTask)
 	{
-		EvalPrereqs.AddRootTask(GatherTask);
+		PrepareRootMotionPrereqs.AddRootTask(GatherTask);
+	}
+
+	// Tracks lazily update cached root motion state, so prepare them on the game thread before computing root motion in parallel
+	FGraphEventRef PrepareRootMotionTask = FEntityTaskBuilder()
+	.SetStat(GET_STATID(MovieSceneEval_ComputeSkeletalRootMotion))
+	.SetDesiredThread(Linker->EntityManager.GetGatherThread())
+	.Dispatch<FPrepareSkeletalRootMotion>(&Linker->EntityManager, PrepareRootMotionPrereqs, nullptr, &SystemData);
+
+	FSystemTaskPrerequisites RootMotionPrereqs;
+	if (PrepareRootMotionTask)
+	{
+		RootMotionPrereqs.AddRootTask(PrepareRootMotionTask);
+	}
+
+	// Compute root motion for the gathered animations in parallel so that the game thread task only has to apply it
+	FGraphEventRef RootMotionTask = FEntityTaskBuilder()
+	.SetStat(GET_STATID(MovieSceneEval_ComputeSkeletalRootMotion))
+	.SetDesiredThread(Linker->EntityManager.GetDispatchThread())
+	.Dispatch<FComputeSkeletalRootMotion>(&Linker->EntityManager, RootMotionPrereqs, nullptr, &SystemData);
+
+	FSystemTaskPrerequisites EvalPrereqs;
+	if (RootMotionTask)
+	{
+		EvalPrereqs.AddRootTask(RootMotionTask);
 	}
 
 	// Now evaluate gathered animations. We need to do this on the game thread (when in multi-threaded mode)
@@ -0,0 +1,66 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Systems/MovieSceneAudioSystem.h"
+#include "Components/AudioComponent.h"
+#include "Misc/AutomationTest.h"
+#include "Sections/MovieSceneAudioSection.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneAudioComponentReservationTest,
+		"System.Engine.Sequencer.Audio.ComponentReservation",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneAudioComponentReservationTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+
+	using FAudioComponentBySectionKey = UMovieSceneAudioSystem::FAudioComponentBySectionKey;
+	using FInstanceObjectKey = UMovieSceneAudioSystem::FInstanceObjectKey;
+
+	const FInstanceHandle InstanceHandle(0, 0);
+
+	UMovieSceneAudioSection* IdleSection     = NewObject<UMovieSceneAudioSection>(GetTransientPackage());
+	UMovieSceneAudioSection* UpcomingSection = NewObject<UMovieSceneAudioSection>(GetTransientPackage());
+	UMovieSceneAudioSection* OtherSection    = NewObject<UMovieSceneAudioSection>(GetTransientPackage());
+	UMovieSceneAudioSection* LastSection     = NewObject<UMovieSceneAudioSection>(GetTransientPackage());
+
+	// Neither component is playing, but the upcoming section's component has been reserved by the look-ahead
+	UAudioComponent* IdleComponent     = NewObject<UAudioComponent>(GetTransientPackage());
+	UAudioComponent* ReservedComponent = NewObject<UAudioComponent>(GetTransientPackage());
+
+	FAudioComponentBySectionKey AudioComponents;
+	AudioComponents.Add(FInstanceObjectKey(InstanceHandle, FObjectKey(IdleSection))).AudioComponent = IdleComponent;
+
+	FAudioComponentEvaluationData& ReservedData = AudioComponents.Add(FInstanceObjectKey(InstanceHandle, FObjectKey(UpcomingSection)));
+	ReservedData.AudioComponent = ReservedComponent;
+	ReservedData.bReserved = true;
+
+	// Exact lookups, as used when prewarming, must never take another section's component
+	UTEST_NULL("Exact lookup does not claim an idle component", UMovieSceneAudioSystem::FindAudioComponentEvaluationData(AudioComponents, InstanceHandle, FObjectKey(OtherSection), false));
+	UTEST_TRUE("Idle component still belongs to its section", AudioComponents.Contains(FInstanceObjectKey(InstanceHandle, FObjectKey(IdleSection))));
+
+	FAudioComponentEvaluationData* UpcomingData = UMovieSceneAudioSystem::FindAudioComponentEvaluationData(AudioComponents, InstanceHandle, FObjectKey(UpcomingSection), false);
+	UTEST_NOT_NULL("Exact lookup finds the reserved component", UpcomingData);
+	UTEST_EQUAL("Exact lookup returns the reserved component", UpcomingData->AudioComponent.Get(), ReservedComponent);
+
+	// Claiming lookups may take idle components, but never reserved ones
+	FAudioComponentEvaluationData* ClaimedData = UMovieSceneAudioSystem::FindAudioComponentEvaluationData(AudioComponents, InstanceHandle, FObjectKey(OtherSection), true);
+	UTEST_NOT_NULL("Idle component was claimed", ClaimedData);
+	UTEST_EQUAL("The idle component was claimed", ClaimedData->AudioComponent.Get(), IdleComponent);
+	UTEST_FALSE("Claimed component was moved to the new section", AudioComponents.Contains(FInstanceObjectKey(InstanceHandle, FObjectKey(IdleSection))));
+
+	UTEST_NULL("Reserved component cannot be claimed", UMovieSceneAudioSystem::FindAudioComponentEvaluationData(AudioComponents, InstanceHandle, FObjectKey(LastSection), true));
+	UTEST_TRUE("Reserved component still belongs to its section", AudioComponents.Contains(FInstanceObjectKey(InstanceHandle, FObjectKey(UpcomingSection))));
+
+	// Once the reservation is released (ie, the section has been evaluated and stopped), the component can be reused again
+	AudioComponents.FindChecked(FInstanceObjectKey(InstanceHandle, FObjectKey(UpcomingSection))).bReserved = false;
+
+	ClaimedData = UMovieSceneAudioSystem::FindAudioComponentEvaluationData(AudioComponents, InstanceHandle, FObjectKey(LastSection), true);
+	UTEST_NOT_NULL("Released component was claimed", ClaimedData);
+	UTEST_EQUAL("The released component was claimed", ClaimedData->AudioComponent.Get(), ReservedComponent);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
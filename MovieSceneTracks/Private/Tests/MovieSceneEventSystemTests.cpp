@@ -0,0 +1,98 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Kismet/KismetStringLibrary.h"
+#include "Misc/AutomationTest.h"
+#include "Systems/MovieSceneEventSystems.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneEventDispatchBoundObjectsTest,
+		"System.Engine.Sequencer.Events.DispatchBoundObjects",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneEventDispatchBoundObjectsTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+
+	UObject* Objects[] = {
+		NewObject<UObject>(GetTransientPackage()),
+		NewObject<UObject>(GetTransientPackage()),
+		NewObject<UObject>(GetTransientPackage()),
+	};
+	TWeakObjectPtr<> BindingA[] = { Objects[0], Objects[1] };
+	TWeakObjectPtr<> BindingB[] = { Objects[2] };
+
+	const FMovieSceneEvaluationOperand OperandA(MovieSceneSequenceID::Root, FGuid::NewGuid());
+	const FMovieSceneEvaluationOperand OperandB(MovieSceneSequenceID::Root, FGuid::NewGuid());
+
+	FEventDispatchBuffers Buffers;
+	TArrayView<const TWeakObjectPtr<>> BoundObjects;
+
+	UTEST_FALSE("Nothing is cached initially", Buffers.FindBoundObjects(OperandA, 1, BoundObjects));
+
+	Buffers.AddBoundObjects(OperandA, 1, BindingA);
+	Buffers.AddBoundObjects(OperandB, 1, BindingB);
+
+	UTEST_TRUE("Binding A is cached", Buffers.FindBoundObjects(OperandA, 1, BoundObjects));
+	UTEST_TRUE("Binding A objects", BoundObjects.Num() == 2 && BoundObjects[0] == Objects[0] && BoundObjects[1] == Objects[1]);
+	UTEST_TRUE("Binding B is cached", Buffers.FindBoundObjects(OperandB, 1, BoundObjects));
+	UTEST_TRUE("Binding B objects", BoundObjects.Num() == 1 && BoundObjects[0] == Objects[2]);
+
+	// An event that spawns or rebinds objects changes the serial number, which must discard every cached binding
+	UTEST_FALSE("Binding A is re-resolved after the serial number changes", Buffers.FindBoundObjects(OperandA, 2, BoundObjects));
+	UTEST_FALSE("Binding B is re-resolved after the serial number changes", Buffers.FindBoundObjects(OperandB, 2, BoundObjects));
+
+	TWeakObjectPtr<> ReboundA[] = { Objects[2] };
+	Buffers.AddBoundObjects(OperandA, 2, ReboundA);
+
+	UTEST_TRUE("Rebound binding A is cached", Buffers.FindBoundObjects(OperandA, 2, BoundObjects));
+	UTEST_TRUE("Rebound binding A objects", BoundObjects.Num() == 1 && BoundObjects[0] == Objects[2]);
+
+	// Flushing again must reuse the existing storage rather than allocating
+	const TWeakObjectPtr<>* StorageData = Buffers.BoundObjectStorage.GetData();
+	for (int32 Flush = 0; Flush < 4; ++Flush)
+	{
+		Buffers.Reset();
+		Buffers.AddBoundObjects(OperandA, 2, BindingA);
+		Buffers.AddBoundObjects(OperandB, 2, BindingB);
+	}
+	UTEST_EQUAL("Bound object storage was reused", Buffers.BoundObjectStorage.GetData(), StorageData);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneEventDispatchParameterLayoutTest,
+		"System.Engine.Sequencer.Events.DispatchParameterLayouts",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneEventDispatchParameterLayoutTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+
+	UFunction* Function = UKismetStringLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UKismetStringLibrary, Concat_StrStr));
+	UTEST_NOT_NULL("Test function", Function);
+
+	FEventDispatchBuffers Buffers;
+
+	const FEventParameterLayout* Layout = &Buffers.FindOrAddParameterLayout(Function);
+	UTEST_TRUE("Layout is valid", Layout->IsValidFor(Function));
+	UTEST_EQUAL("String parameters and return value need destroying", Layout->ParamsToDestroy.Num(), 3);
+
+	// Layouts must survive between flushes
+	Buffers.Reset();
+	UTEST_EQUAL("Layout is retained between flushes", &Buffers.FindOrAddParameterLayout(Function), Layout);
+	UTEST_EQUAL("Only one layout was built", Buffers.ParameterLayouts.Num(), 1);
+
+	// A layout that no longer matches its function (ie, after the function was recompiled in-place) must be rebuilt
+	FEventParameterLayout& StoredLayout = Buffers.ParameterLayouts.FindChecked(Function);
+	StoredLayout.ParmsSize = -1;
+	StoredLayout.ParamsToDestroy.Reset();
+
+	Layout = &Buffers.FindOrAddParameterLayout(Function);
+	UTEST_TRUE("Stale layout was rebuilt", Layout->IsValidFor(Function));
+	UTEST_EQUAL("Rebuilt layout parameters", Layout->ParamsToDestroy.Num(), 3);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,101 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Systems/MovieSceneMaterialParameterSystem.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneMaterialParameterBatchesTest,
+		"System.Engine.Sequencer.MaterialParameters.Batches",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneMaterialParameterBatchesTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+
+	constexpr int32 NumMaterials  = 4;
+	constexpr int32 NumParameters = 8;
+
+	UMaterialInterface* ParentMaterial = UMaterial::GetDefaultMaterial(MD_Surface);
+	UTEST_NOT_NULL("Default material", ParentMaterial);
+
+	// Each batched material has an unbatched twin that has the same values applied one at a time, in gather order
+	TArray<UMaterialInstanceDynamic*> BatchedMaterials;
+	TArray<UMaterialInstanceDynamic*> UnbatchedMaterials;
+	for (int32 Index = 0; Index < NumMaterials; ++Index)
+	{
+		BatchedMaterials.Add(UMaterialInstanceDynamic::Create(ParentMaterial, GetTransientPackage()));
+		UnbatchedMaterials.Add(UMaterialInstanceDynamic::Create(ParentMaterial, GetTransientPackage()));
+	}
+
+	auto GetScalarInfo = [](int32 ParameterIndex)
+	{
+		return FMaterialParameterInfo(*FString::Printf(TEXT("Scalar%d"), ParameterIndex));
+	};
+	auto GetVectorInfo = [](int32 ParameterIndex)
+	{
+		return FMaterialParameterInfo(*FString::Printf(TEXT("Vector%d"), ParameterIndex));
+	};
+
+	FMaterialParameterBatches Batches;
+	FRandomStream Random(0x4D50);
+
+	for (int32 Frame = 0; Frame < 3; ++Frame)
+	{
+		// Gather one value for every parameter of every material, interleaving materials as separate allocations would.
+		// Every other frame leaves half of the values unchanged to exercise skipping values that are already up to date.
+		for (int32 ParameterIndex = 0; ParameterIndex < NumParameters; ++ParameterIndex)
+		{
+			for (int32 MaterialIndex = NumMaterials - 1; MaterialIndex >= 0; --MaterialIndex)
+			{
+				const bool bKeepValue = (Frame % 2) == 1 && (ParameterIndex % 2) == 0;
+
+				float Scalar = Random.FRandRange(-10.f, 10.f);
+				FLinearColor Vector(Random.FRand(), Random.FRand(), Random.FRand(), Random.FRand());
+				if (bKeepValue)
+				{
+					UnbatchedMaterials[MaterialIndex]->GetScalarParameterValue(GetScalarInfo(ParameterIndex), Scalar, true);
+					UnbatchedMaterials[MaterialIndex]->GetVectorParameterValue(GetVectorInfo(ParameterIndex), Vector, true);
+				}
+
+				Batches.Scalars.Add(FPendingScalarMaterialParameter{ BatchedMaterials[MaterialIndex], GetScalarInfo(ParameterIndex), Scalar });
+				Batches.Vectors.Add(FPendingVectorMaterialParameter{ BatchedMaterials[MaterialIndex], GetVectorInfo(ParameterIndex), Vector });
+
+				UnbatchedMaterials[MaterialIndex]->SetScalarParameterValueByInfo(GetScalarInfo(ParameterIndex), Scalar);
+				UnbatchedMaterials[MaterialIndex]->SetVectorParameterValueByInfo(GetVectorInfo(ParameterIndex), Vector);
+			}
+		}
+
+		// Values for a material that no longer exists must be ignored
+		Batches.Scalars.Add(FPendingScalarMaterialParameter{ nullptr, GetScalarInfo(0), 1.f });
+		Batches.Vectors.Add(FPendingVectorMaterialParameter{ nullptr, GetVectorInfo(0), FLinearColor::White });
+
+		Batches.Apply();
+
+		UTEST_EQUAL("Scalar batch was reset", Batches.Scalars.Num(), 0);
+		UTEST_EQUAL("Vector batch was reset", Batches.Vectors.Num(), 0);
+
+		for (int32 MaterialIndex = 0; MaterialIndex < NumMaterials; ++MaterialIndex)
+		{
+			for (int32 ParameterIndex = 0; ParameterIndex < NumParameters; ++ParameterIndex)
+			{
+				float BatchedScalar = 0.f, UnbatchedScalar = 0.f;
+				UTEST_TRUE("Batched scalar was applied", BatchedMaterials[MaterialIndex]->GetScalarParameterValue(GetScalarInfo(ParameterIndex), BatchedScalar, true));
+				UnbatchedMaterials[MaterialIndex]->GetScalarParameterValue(GetScalarInfo(ParameterIndex), UnbatchedScalar, true);
+				UTEST_EQUAL("Batched scalar matches unbatched result", BatchedScalar, UnbatchedScalar);
+
+				FLinearColor BatchedVector, UnbatchedVector;
+				UTEST_TRUE("Batched vector was applied", BatchedMaterials[MaterialIndex]->GetVectorParameterValue(GetVectorInfo(ParameterIndex), BatchedVector, true));
+				UnbatchedMaterials[MaterialIndex]->GetVectorParameterValue(GetVectorInfo(ParameterIndex), UnbatchedVector, true);
+				UTEST_EQUAL("Batched vector matches unbatched result", BatchedVector, UnbatchedVector);
+			}
+		}
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
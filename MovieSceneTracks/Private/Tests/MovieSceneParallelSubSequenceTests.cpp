@@ -0,0 +1,187 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Tests/MovieScenePartialEvaluationTests.h"
+#include "Tests/MovieSceneTestDataBuilders.h"
+#include "Compilation/MovieSceneCompiledDataManager.h"
+#include "EntitySystem/MovieSceneEntitySystemLinker.h"
+#include "EntitySystem/MovieSceneEntitySystemRunner.h"
+#include "EntitySystem/MovieSceneInstanceRegistry.h"
+#include "EntitySystem/MovieSceneSequenceInstance.h"
+#include "Evaluation/MovieSceneEvaluationTemplateInstance.h"
+#include "HAL/IConsoleManager.h"
+#include "IMovieScenePlayer.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeExit.h"
+#include "MovieSceneSequence.h"
+#include "Sections/MovieSceneSubSection.h"
+#include "Tracks/MovieSceneFloatTrack.h"
+#include "Tracks/MovieSceneSubTrack.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneParallelSubSequenceUpdateTest,
+		"System.Engine.Sequencer.ParallelSubSequenceUpdate",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneParallelSubSequenceUpdateTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+	using namespace UE::MovieScene::Test;
+
+	constexpr int32 NumSubSequences = 12;
+
+	IConsoleVariable* ParallelThreshold = IConsoleManager::Get().FindConsoleVariable(TEXT("Sequencer.ParallelSubSequenceThreshold"));
+	UTEST_NOT_NULL("Parallel sub sequence threshold console variable", ParallelThreshold);
+
+	const int32 OldParallelThreshold = ParallelThreshold->GetInt();
+	ON_SCOPE_EXIT
+	{
+		ParallelThreshold->Set(OldParallelThreshold, ECVF_SetByCode);
+	};
+
+	// Each sub sequence animates its own object, and the sub sections begin at staggered times so that the set of active sub sequences changes over time
+	TArray<TStrongObjectPtr<UMovieScenePartialEvaluationTestObject>> TestObjects;
+	TArray<UMovieSceneSection*> FloatSections;
+	TArray<TStrongObjectPtr<UMovieSceneSequence>> SubSequences;
+
+	for (int32 Index = 0; Index < NumSubSequences; ++Index)
+	{
+		TestObjects.Emplace(NewObject<UMovieScenePartialEvaluationTestObject>());
+
+		UMovieSceneSection* FloatSection = nullptr;
+		SubSequences.Emplace(FSequenceBuilder()
+			.AddObjectBinding(TestObjects.Last().Get())
+			.AddPropertyTrack<UMovieSceneFloatTrack>(GET_MEMBER_NAME_CHECKED(UMovieScenePartialEvaluationTestObject, FloatProperty))
+				.AddSection(0, 5000)
+					.Assign(FloatSection)
+					.AddKeys<FMovieSceneFloatChannel, float>(0, { 0, 5000 }, { 0.f, 100.f + Index })
+				.Pop()
+			.Pop()
+		.Sequence.Get());
+
+		FloatSections.Add(FloatSection);
+	}
+
+	FSequenceBuilder RootBuilder;
+	{
+		auto SubTrackBuilder = RootBuilder.AddRootTrack<UMovieSceneSubTrack>();
+		for (int32 Index = 0; Index < NumSubSequences; ++Index)
+		{
+			UMovieSceneSequence* SubSequence = SubSequences[Index].Get();
+			SubTrackBuilder
+				.AddSection(Index * 100, 5000, Index)
+					.Do<UMovieSceneSubSection>([SubSequence](UMovieSceneSubSection* SubSection){ SubSection->SetSequence(SubSequence); })
+				.Pop();
+		}
+	}
+	TStrongObjectPtr<UMovieSceneSequence> RootSequence(RootBuilder.Sequence.Get());
+
+	struct FLocalPlayer : IMovieScenePlayer
+	{
+		FMovieSceneRootEvaluationTemplateInstance Template;
+		virtual FMovieSceneRootEvaluationTemplateInstance& GetEvaluationTemplate() override { return Template; }
+		virtual UMovieSceneEntitySystemLinker* ConstructEntitySystemLinker() override { return TestLinker; }
+		virtual void UpdateCameraCut(UObject* CameraObject, const EMovieSceneCameraCutParams& CameraCutParams) override {}
+		virtual void SetViewportSettings(const TMap<FViewportClient*, EMovieSceneViewportParams>& ViewportParamsMap) override {}
+		virtual void GetViewportSettings(TMap<FViewportClient*, EMovieSceneViewportParams>& ViewportParamsMap) const override {}
+		virtual EMovieScenePlayerStatus::Type GetPlaybackStatus() const override { return EMovieScenePlayerStatus::Playing; }
+		virtual void SetPlaybackStatus(EMovieScenePlayerStatus::Type InPlaybackStatus) override {}
+
+		UMovieSceneEntitySystemLinker* TestLinker;
+	};
+
+	/** The state of every sub sequence's ledger and animated object at a given time */
+	struct FEvaluationSnapshot
+	{
+		TArray<float> Values;
+		TArray<TArray<TPair<FMovieSceneSequenceID, FMovieSceneEntityID>>> ImportedEntities;
+	};
+
+	const FFrameNumber Times[] = { 0, 150, 650, 1150, 3000, 400, 4999 };
+
+	auto Evaluate = [&](int32 Threshold)
+	{
+		ParallelThreshold->Set(Threshold, ECVF_SetByCode);
+
+		UMovieSceneCompiledDataManager* CompiledDataManager = UMovieSceneCompiledDataManager::GetPrecompiledData();
+		TStrongObjectPtr<UMovieSceneEntitySystemLinker> Linker(NewObject<UMovieSceneEntitySystemLinker>(GetTransientPackage()));
+		TSharedPtr<FMovieSceneEntitySystemRunner> Runner = Linker->GetRunner();
+		FInstanceRegistry* InstanceRegistry = Linker->GetInstanceRegistry();
+
+		FLocalPlayer Player;
+		Player.TestLinker = Linker.Get();
+
+		CompiledDataManager->Compile(RootSequence.Get());
+		Player.Template.Initialize(*RootSequence, Player, CompiledDataManager);
+
+		const FFrameRate TickResolution = RootSequence->GetMovieScene()->GetTickResolution();
+
+		TArray<FEvaluationSnapshot> Snapshots;
+		for (FFrameNumber Time : Times)
+		{
+			Runner->QueueUpdate(FMovieSceneContext(FMovieSceneEvaluationRange(FFrameTime(Time), TickResolution), EMovieScenePlayerStatus::Playing), Player.Template.GetRootInstanceHandle());
+			Runner->Flush();
+
+			FEvaluationSnapshot& Snapshot = Snapshots.Emplace_GetRef();
+			for (const TStrongObjectPtr<UMovieScenePartialEvaluationTestObject>& TestObject : TestObjects)
+			{
+				Snapshot.Values.Add(TestObject->FloatProperty);
+			}
+
+			for (UMovieSceneSection* FloatSection : FloatSections)
+			{
+				TArray<TPair<FMovieSceneSequenceID, FMovieSceneEntityID>>& SectionEntities = Snapshot.ImportedEntities.Emplace_GetRef();
+				for (const FSequenceInstance& Instance : InstanceRegistry->GetSparseInstances())
+				{
+					TArray<FMovieSceneEntityID> EntityIDs;
+					Instance.Ledger.FindImportedEntities(FloatSection, EntityIDs);
+					for (FMovieSceneEntityID EntityID : EntityIDs)
+					{
+						SectionEntities.Emplace(Instance.GetSequenceID(), EntityID);
+					}
+				}
+				SectionEntities.Sort([](const TPair<FMovieSceneSequenceID, FMovieSceneEntityID>& A, const TPair<FMovieSceneSequenceID, FMovieSceneEntityID>& B)
+				{
+					return A.Key.GetInternalValue() < B.Key.GetInternalValue() || (A.Key == B.Key && A.Value.AsIndex() < B.Value.AsIndex());
+				});
+			}
+		}
+
+		Player.Template.TearDown();
+		return Snapshots;
+	};
+
+	// Evaluate the same sequence serially, and then in parallel with every active sub sequence counting towards the threshold
+	const TArray<FEvaluationSnapshot> Serial   = Evaluate(0);
+	const TArray<FEvaluationSnapshot> Parallel = Evaluate(1);
+
+	UTEST_EQUAL("Snapshot count", Parallel.Num(), Serial.Num());
+
+	for (int32 TimeIndex = 0; TimeIndex < Serial.Num(); ++TimeIndex)
+	{
+		const FEvaluationSnapshot& Expected = Serial[TimeIndex];
+		const FEvaluationSnapshot& Actual   = Parallel[TimeIndex];
+
+		for (int32 Index = 0; Index < NumSubSequences; ++Index)
+		{
+			const FString Context = FString::Printf(TEXT("sub sequence %d at time %d"), Index, Times[TimeIndex].Value);
+
+			UTEST_EQUAL(*FString::Printf(TEXT("Animated value for %s"), *Context), Actual.Values[Index], Expected.Values[Index]);
+			UTEST_EQUAL(*FString::Printf(TEXT("Imported entity count for %s"), *Context), Actual.ImportedEntities[Index].Num(), Expected.ImportedEntities[Index].Num());
+			UTEST_TRUE(*FString::Printf(TEXT("Imported entities for %s"), *Context), Actual.ImportedEntities[Index] == Expected.ImportedEntities[Index]);
+		}
+	}
+
+	// Sanity check that sub sequences were actually activated and deactivated over time
+	UTEST_EQUAL("Only the first sub sequence is active at time 0", Serial[0].ImportedEntities[1].Num(), 0);
+	for (int32 Index = 0; Index < NumSubSequences; ++Index)
+	{
+		UTEST_NOT_EQUAL(*FString::Printf(TEXT("Sub sequence %d is active at time 3000"), Index), Serial[4].ImportedEntities[Index].Num(), 0);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
+
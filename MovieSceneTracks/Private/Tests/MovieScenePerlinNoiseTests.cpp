@@ -0,0 +1,72 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Channels/MovieSceneDoublePerlinNoiseChannel.h"
+#include "Channels/MovieSceneFloatPerlinNoiseChannel.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieScenePerlinNoiseBatchTest,
+		"System.Engine.Sequencer.PerlinNoise.BatchMatchesScalar",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieScenePerlinNoiseBatchTest::RunTest(const FString& Parameters)
+{
+	// Use an odd number of values to exercise the scalar tail of the vectorized kernel as well as multiple chunks
+	constexpr int32 NumValues = 1027;
+
+	FRandomStream Random(0x5EED);
+
+	TArray<FPerlinNoiseParams> Params;
+	TArray<double> Seconds;
+	Params.Reserve(NumValues);
+	Seconds.Reserve(NumValues);
+
+	for (int32 Index = 0; Index < NumValues; ++Index)
+	{
+		FPerlinNoiseParams& NewParams = Params.Emplace_GetRef(Random.FRandRange(0.1f, 20.f), Random.FRandRange(0.1f, 100.f));
+		NewParams.Offset = Random.FRandRange(-50.f, 50.f);
+
+		Seconds.Add(Random.FRandRange(-600.f, 600.f));
+	}
+
+	TArray<double> DoubleResults;
+	TArray<double> FloatResults;
+	DoubleResults.SetNumUninitialized(NumValues);
+	FloatResults.SetNumUninitialized(NumValues);
+
+	FMovieSceneDoublePerlinNoiseChannel::EvaluateBatch(Params, Seconds, DoubleResults);
+	FMovieSceneFloatPerlinNoiseChannel::EvaluateBatch(Params, Seconds, FloatResults);
+
+	int32 NumDoubleErrors = 0;
+	int32 NumFloatErrors = 0;
+	for (int32 Index = 0; Index < NumValues; ++Index)
+	{
+		// Noise is computed in single precision so allow for rounding relative to the amplitude
+		const double Tolerance = Params[Index].Amplitude * 1e-5;
+
+		const double ExpectedDouble = FMovieSceneDoublePerlinNoiseChannel::Evaluate(Params[Index], Seconds[Index]);
+		if (!FMath::IsNearlyEqual(DoubleResults[Index], ExpectedDouble, Tolerance))
+		{
+			++NumDoubleErrors;
+			AddError(FString::Printf(TEXT("Double noise mismatch at index %d (t=%f): expected %f, got %f"), Index, Seconds[Index], ExpectedDouble, DoubleResults[Index]));
+		}
+
+		const double ExpectedFloat = FMovieSceneFloatPerlinNoiseChannel::Evaluate(Params[Index], Seconds[Index]);
+		if (!FMath::IsNearlyEqual(FloatResults[Index], ExpectedFloat, Tolerance))
+		{
+			++NumFloatErrors;
+			AddError(FString::Printf(TEXT("Float noise mismatch at index %d (t=%f): expected %f, got %f"), Index, Seconds[Index], ExpectedFloat, FloatResults[Index]));
+		}
+
+		if (NumDoubleErrors + NumFloatErrors > 10)
+		{
+			break;
+		}
+	}
+
+	return NumDoubleErrors == 0 && NumFloatErrors == 0;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,139 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Tests/MovieScenePredictionSystemTests.h"
+#include "Tests/MovieSceneTestDataBuilders.h"
+#include "Channels/MovieSceneDoubleChannel.h"
+#include "Components/SceneComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeExit.h"
+#include "Systems/MovieScenePredictionSystem.h"
+#include "Tracks/MovieScene3DTransformTrack.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(MovieScenePredictionSystemTests)
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneBatchPredictionTest,
+		"System.Engine.Sequencer.Prediction.BatchMatchesSingle",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneBatchPredictionTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+	using namespace UE::MovieScene::Test;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	ON_SCOPE_EXIT
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	};
+
+	// Child is attached to Parent so that world space predictions have to compose the whole hierarchy
+	TStrongObjectPtr<USceneComponent> Parent(NewObject<USceneComponent>(GetTransientPackage()));
+	TStrongObjectPtr<USceneComponent> Child(NewObject<USceneComponent>(GetTransientPackage()));
+	TStrongObjectPtr<USceneComponent> Unanimated(NewObject<USceneComponent>(GetTransientPackage()));
+	Child->SetupAttachment(Parent.Get());
+
+	TStrongObjectPtr<UMovieSceneSequence> Sequence(FSequenceBuilder()
+		.AddObjectBinding(Parent.Get())
+			.AddTrack<UMovieScene3DTransformTrack>()
+				.AddSection(0, 48000)
+					.AddKeys<FMovieSceneDoubleChannel, double>(0, { 0, 48000 }, { 0.0, 200.0 })
+					.AddKeys<FMovieSceneDoubleChannel, double>(5, { 0, 48000 }, { 0.0, 90.0 })
+				.Pop()
+			.Pop()
+		.AddObjectBinding(Child.Get())
+			.AddTrack<UMovieScene3DTransformTrack>()
+				.AddSection(0, 48000)
+					.AddKeys<FMovieSceneDoubleChannel, double>(1, { 0, 48000 }, { 50.0, -50.0 })
+				.Pop()
+			.Pop()
+		.Pop()
+	.Sequence.Get());
+
+	TStrongObjectPtr<UMovieScenePredictionTestPlayer> Player(NewObject<UMovieScenePredictionTestPlayer>(World));
+	Player->World = World;
+	Player->Initialize(Sequence.Get());
+
+	ON_SCOPE_EXIT
+	{
+		Player->Stop();
+	};
+
+	const FFrameRate TickResolution = Sequence->GetMovieScene()->GetTickResolution();
+	const FFrameRate DisplayRate    = Sequence->GetMovieScene()->GetDisplayRate();
+
+	Player->SetPlaybackPosition(FMovieSceneSequencePlaybackParams(FFrameTime(0), EUpdatePositionMethod::Jump));
+
+	TArray<USceneComponent*> Components = { Child.Get(), Parent.Get(), Unanimated.Get() };
+	TArray<FFrameTime> Frames = {
+		ConvertFrameTime(FFrameTime(12000), TickResolution, DisplayRate),
+		ConvertFrameTime(FFrameTime(36000), TickResolution, DisplayRate),
+		ConvertFrameTime(FFrameTime(12000), TickResolution, DisplayRate),
+		ConvertFrameTime(FFrameTime(48000), TickResolution, DisplayRate),
+	};
+
+	for (const bool bWorldSpace : { true, false })
+	{
+		// Dispatch a single prediction for every component and time, in the same order as the batch reports its results
+		TStrongObjectPtr<UMovieScenePredictionTestResults> SingleResults(NewObject<UMovieScenePredictionTestResults>());
+		for (USceneComponent* Component : Components)
+		{
+			for (FFrameTime Frame : Frames)
+			{
+				UMovieSceneAsyncAction_SequencePrediction* Prediction = bWorldSpace
+					? UMovieSceneAsyncAction_SequencePrediction::PredictWorldTransformAtFrame(Player.Get(), Component, Frame)
+					: UMovieSceneAsyncAction_SequencePrediction::PredictLocalTransformAtFrame(Player.Get(), Component, Frame);
+
+				UTEST_NOT_NULL("Single prediction", Prediction);
+				Prediction->Result.AddDynamic(SingleResults.Get(), &UMovieScenePredictionTestResults::OnPredictionResult);
+				Prediction->Failure.AddDynamic(SingleResults.Get(), &UMovieScenePredictionTestResults::OnPredictionFailure);
+			}
+		}
+
+		TStrongObjectPtr<UMovieScenePredictionTestResults> BatchResults(NewObject<UMovieScenePredictionTestResults>());
+		UMovieSceneAsyncAction_SequenceBatchPrediction* BatchPrediction = bWorldSpace
+			? UMovieSceneAsyncAction_SequenceBatchPrediction::PredictWorldTransformsAtFrames(Player.Get(), Components, Frames)
+			: UMovieSceneAsyncAction_SequenceBatchPrediction::PredictLocalTransformsAtFrames(Player.Get(), Components, Frames);
+
+		UTEST_NOT_NULL("Batch prediction", BatchPrediction);
+		BatchPrediction->Result.AddDynamic(BatchResults.Get(), &UMovieScenePredictionTestResults::OnBatchPredictionResult);
+
+		// Predictions are run on the next evaluation
+		Player->SetPlaybackPosition(FMovieSceneSequencePlaybackParams(FFrameTime(bWorldSpace ? 1 : 2), EUpdatePositionMethod::Jump));
+
+		const int32 NumResults = Components.Num() * Frames.Num();
+		UTEST_EQUAL("All single predictions were reported", SingleResults->Transforms.Num(), NumResults);
+		UTEST_EQUAL("All batch predictions were reported", BatchResults->Transforms.Num(), NumResults);
+		UTEST_EQUAL("All batch prediction flags were reported", BatchResults->Succeeded.Num(), NumResults);
+
+		for (int32 Index = 0; Index < NumResults; ++Index)
+		{
+			const FString Context = FString::Printf(TEXT("%s space result %d"), bWorldSpace ? TEXT("World") : TEXT("Local"), Index);
+
+			UTEST_EQUAL(*FString::Printf(TEXT("%s succeeded"), *Context), BatchResults->Succeeded[Index], SingleResults->Succeeded[Index]);
+			if (SingleResults->Succeeded[Index])
+			{
+				UTEST_TRUE(*FString::Printf(TEXT("%s transform"), *Context), BatchResults->Transforms[Index].Equals(SingleResults->Transforms[Index], UE_KINDA_SMALL_NUMBER));
+			}
+		}
+
+		// Sanity check that the predictions actually produced something meaningful for the animated components
+		UTEST_TRUE("Child prediction succeeded", BatchResults->Succeeded[0]);
+		UTEST_TRUE("Parent prediction succeeded", BatchResults->Succeeded[Frames.Num()]);
+		UTEST_FALSE("Child predictions differ over time", BatchResults->Transforms[0].Equals(BatchResults->Transforms[1]));
+		UTEST_TRUE("Duplicate times predict the same transform", BatchResults->Transforms[0].Equals(BatchResults->Transforms[2]));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
+
@@ -0,0 +1,61 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "MovieSceneSequencePlayer.h"
+
+#include "MovieScenePredictionSystemTests.generated.h"
+
+class UWorld;
+
+/** Sequence player that plays back in a specific world */
+UCLASS(MinimalAPI)
+class UMovieScenePredictionTestPlayer : public UMovieSceneSequencePlayer
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual UObject* GetPlaybackContext() const override
+	{
+		return World;
+	}
+
+	UPROPERTY()
+	TObjectPtr<UWorld> World;
+};
+
+/** Collects the results that are broadcast by single and batch predictions */
+UCLASS(MinimalAPI)
+class UMovieScenePredictionTestResults : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	UFUNCTION()
+	void OnPredictionResult(FTransform PredictedTransform)
+	{
+		Transforms.Add(PredictedTransform);
+		Succeeded.Add(true);
+	}
+
+	UFUNCTION()
+	void OnPredictionFailure()
+	{
+		Transforms.Add(FTransform::Identity);
+		Succeeded.Add(false);
+	}
+
+	UFUNCTION()
+	void OnBatchPredictionResult(const TArray<FTransform>& PredictedTransforms, const TArray<bool>& InSucceeded)
+	{
+		Transforms.Append(PredictedTransforms);
+		Succeeded.Append(InSucceeded);
+	}
+
+	TArray<FTransform> Transforms;
+	TArray<bool> Succeeded;
+};
+
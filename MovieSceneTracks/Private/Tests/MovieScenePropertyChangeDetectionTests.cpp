@@ -0,0 +1,122 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Tests/MovieScenePropertyChangeDetectionTests.h"
+#include "Tests/MovieSceneTestDataBuilders.h"
+#include "Channels/MovieSceneBoolChannel.h"
+#include "Compilation/MovieSceneCompiledDataManager.h"
+#include "EntitySystem/MovieSceneEntitySystemLinker.h"
+#include "EntitySystem/MovieSceneEntitySystemRunner.h"
+#include "Evaluation/MovieSceneEvaluationTemplateInstance.h"
+#include "IMovieScenePlayer.h"
+#include "Misc/AutomationTest.h"
+#include "MovieSceneSequence.h"
+#include "Tracks/MovieSceneBoolTrack.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(MovieScenePropertyChangeDetectionTests)
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UE::MovieScene::Test
+{
+
+/** Animates a bool property to true then false, evaluates it at each of the specified times and returns the number of setter calls after each evaluation */
+TArray<int32> EvaluateBoolPropertyChangeDetection(bool bSkipUnchangedValues, TArrayView<const int32> EvaluationTimes)
+{
+	TStrongObjectPtr<UMovieScenePropertyChangeDetectionTestObject> TestObject(NewObject<UMovieScenePropertyChangeDetectionTestObject>());
+
+	UMovieSceneBoolTrack* Track = nullptr;
+
+	// Animate the property to true for the first 2000 ticks, then false
+	TStrongObjectPtr<UMovieSceneSequence> Sequence(FSequenceBuilder()
+		.AddObjectBinding(TestObject.Get())
+			.AddPropertyTrack<UMovieSceneBoolTrack>(GET_MEMBER_NAME_CHECKED(UMovieScenePropertyChangeDetectionTestObject, bBoolProperty))
+				.Assign(Track)
+				.AddSection(0, 5000)
+					.AddKeys<FMovieSceneBoolChannel, bool>(0, { 0, 2000 }, { true, false })
+				.Pop()
+			.Pop()
+		.Pop()
+	.Sequence.Get());
+
+	Track->SetSkipUnchangedValues(bSkipUnchangedValues);
+
+	UMovieSceneCompiledDataManager* CompiledDataManager = UMovieSceneCompiledDataManager::GetPrecompiledData();
+	TStrongObjectPtr<UMovieSceneEntitySystemLinker> Linker(NewObject<UMovieSceneEntitySystemLinker>(GetTransientPackage()));
+	TSharedPtr<FMovieSceneEntitySystemRunner> Runner = Linker->GetRunner();
+
+	struct FLocalPlayer : IMovieScenePlayer
+	{
+		FMovieSceneRootEvaluationTemplateInstance Template;
+		virtual FMovieSceneRootEvaluationTemplateInstance& GetEvaluationTemplate() override { return Template; }
+		virtual UMovieSceneEntitySystemLinker* ConstructEntitySystemLinker() override { return TestLinker; }
+		virtual void UpdateCameraCut(UObject* CameraObject, const EMovieSceneCameraCutParams& CameraCutParams) override {}
+		virtual void SetViewportSettings(const TMap<FViewportClient*, EMovieSceneViewportParams>& ViewportParamsMap) override {}
+		virtual void GetViewportSettings(TMap<FViewportClient*, EMovieSceneViewportParams>& ViewportParamsMap) const override {}
+		virtual EMovieScenePlayerStatus::Type GetPlaybackStatus() const override { return EMovieScenePlayerStatus::Playing; }
+		virtual void SetPlaybackStatus(EMovieScenePlayerStatus::Type InPlaybackStatus) override {}
+
+		UMovieSceneEntitySystemLinker* TestLinker;
+	};
+
+	FLocalPlayer Player;
+	Player.TestLinker = Linker.Get();
+
+	CompiledDataManager->Compile(Sequence.Get());
+	Player.Template.Initialize(*Sequence, Player, CompiledDataManager);
+
+	const FFrameRate TickResolution = Sequence->GetMovieScene()->GetTickResolution();
+
+	TArray<int32> NumSets;
+	for (int32 Time : EvaluationTimes)
+	{
+		Runner->QueueUpdate(FMovieSceneContext(FMovieSceneEvaluationRange(FFrameTime(Time), TickResolution), EMovieScenePlayerStatus::Playing), Player.Template.GetRootInstanceHandle());
+		Runner->Flush();
+
+		NumSets.Add(TestObject->NumBoolPropertySets);
+	}
+
+	Player.Template.TearDown();
+
+	return NumSets;
+}
+
+} // namespace UE::MovieScene::Test
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieScenePropertyChangeDetectionTest,
+		"System.Engine.Sequencer.PropertyChangeDetection",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieScenePropertyChangeDetectionTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene::Test;
+
+	// Evaluate true 4 times, false twice, then true again
+	const int32 EvaluationTimes[] = { 0, 500, 1000, 1500, 2500, 3000, 0 };
+
+	// Tracks that have not opted in must always apply their value, even when it has not changed
+	{
+		TArray<int32> NumSets = EvaluateBoolPropertyChangeDetection(false, EvaluationTimes);
+		UTEST_EQUAL("Number of evaluations", NumSets.Num(), 7);
+		UTEST_EQUAL("Setter was called for the first evaluation", NumSets[0], 1);
+		UTEST_EQUAL("Setter was called for every unchanged value", NumSets[3], 4);
+		UTEST_EQUAL("Setter was called for every evaluation", NumSets[6], 7);
+	}
+
+	// Tracks that opt in must skip values identical to the one last applied
+	{
+		TArray<int32> NumSets = EvaluateBoolPropertyChangeDetection(true, EvaluationTimes);
+		UTEST_EQUAL("Number of evaluations", NumSets.Num(), 7);
+		UTEST_EQUAL("Setter was called for the first evaluation", NumSets[0], 1);
+		UTEST_EQUAL("Redundant sets were skipped", NumSets[3], 1);
+		UTEST_EQUAL("Setter was called for the changed value", NumSets[4], 2);
+		UTEST_EQUAL("Redundant set of the changed value was skipped", NumSets[5], 2);
+		// Changing back must apply again, even though the value matches one that was applied previously
+		UTEST_EQUAL("Setter was called when changing back", NumSets[6], 3);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
+
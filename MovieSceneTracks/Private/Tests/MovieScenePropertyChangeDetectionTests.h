@@ -0,0 +1,29 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+
+#include "MovieScenePropertyChangeDetectionTests.generated.h"
+
+UCLASS(MinimalAPI)
+class UMovieScenePropertyChangeDetectionTestObject : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	UFUNCTION()
+	void SetBoolProperty(bool bInValue)
+	{
+		bBoolProperty = bInValue;
+		++NumBoolPropertySets;
+	}
+
+	UPROPERTY()
+	bool bBoolProperty = false;
+
+	/** The number of times SetBoolProperty has been called */
+	int32 NumBoolPropertySets = 0;
+};
+
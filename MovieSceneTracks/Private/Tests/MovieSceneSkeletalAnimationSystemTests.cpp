@@ -0,0 +1,182 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Systems/MovieSceneSkeletalAnimationSystem.h"
+#include "Tests/MovieSceneTestDataBuilders.h"
+#include "Tracks/MovieSceneSkeletalAnimationTrack.h"
+#include "Sections/MovieSceneSkeletalAnimationSection.h"
+#include "Animation/AnimSequence.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "MovieSceneFwd.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UE::MovieScene::Test
+{
+
+/** Animation used for root motion tests. Can be overridden with -RootMotionTestAnimation=/Path/To.Asset */
+static const TCHAR* DefaultRootMotionTestAnimation = TEXT("/Engine/Tutorial/SubEditors/TutorialAssets/Character/Tutorial_Walk_Fwd.Tutorial_Walk_Fwd");
+
+UAnimSequence* LoadRootMotionTestAnimation()
+{
+	FString AnimationPath = DefaultRootMotionTestAnimation;
+	FParse::Value(FCommandLine::Get(), TEXT("RootMotionTestAnimation="), AnimationPath);
+
+	return LoadObject<UAnimSequence>(nullptr, *AnimationPath);
+}
+
+/** A set of skeletal mesh components, each with their own animation track that has root motion, and the gathered animations for them */
+struct FRootMotionTestFixture
+{
+	FSequenceBuilder Builder;
+	FSkeletalAnimationSystemData SystemData;
+	TArray<TStrongObjectPtr<USkeletalMeshComponent>> Components;
+	TArray<UMovieSceneSkeletalAnimationTrack*> Tracks;
+
+	FRootMotionTestFixture(UAnimSequence* Animation, int32 NumCharacters)
+	{
+		for (int32 Index = 0; Index < NumCharacters; ++Index)
+		{
+			USkeletalMeshComponent* Component = NewObject<USkeletalMeshComponent>(GetTransientPackage());
+			Components.Emplace(Component);
+
+			// Two consecutive sections, added in reverse order so that the track has to sort them
+			UMovieSceneSkeletalAnimationTrack* Track = nullptr;
+			UMovieSceneSkeletalAnimationSection* FirstSection = nullptr;
+			UMovieSceneSkeletalAnimationSection* SecondSection = nullptr;
+			Builder.AddObjectBinding(Component)
+				.AddTrack<UMovieSceneSkeletalAnimationTrack>()
+					.Assign(Track)
+					.AddSection(2500, 5000)
+						.Assign(SecondSection)
+					.Pop()
+					.AddSection(0, 2500)
+						.Assign(FirstSection)
+					.Pop()
+				.Pop();
+
+			Tracks.Add(Track);
+
+			for (UMovieSceneSkeletalAnimationSection* Section : { FirstSection, SecondSection })
+			{
+				// Root motion is only computed for tracks with offset sections
+				Section->Params.Animation = Animation;
+				Section->StartLocationOffset = FVector(100.0 * Index, 0.0, 0.0);
+				Section->StartRotationOffset = FRotator(0.0, 10.0 * Index, 0.0);
+
+				FActiveSkeletalAnimation ActiveAnimation;
+				ActiveAnimation.AnimSection    = Section;
+				ActiveAnimation.EvalFrameTime  = FFrameTime(Section->GetInclusiveStartFrame() + Index * 10, 0.5f);
+				ActiveAnimation.EntityID       = FMovieSceneEntityID::Invalid();
+				ActiveAnimation.BlendWeight    = 1.0;
+				ActiveAnimation.FromEvalTime   = 0.f;
+				ActiveAnimation.ToEvalTime     = 0.f;
+				ActiveAnimation.PlayerStatus   = EMovieScenePlayerStatus::Playing;
+				ActiveAnimation.bHasRootMotion = false;
+
+				SystemData.SkeletalAnimations.FindOrAdd(Component).Animations.Add(ActiveAnimation);
+			}
+
+			Track->SetRootMotionsDirty();
+		}
+	}
+};
+
+} // namespace UE::MovieScene::Test
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneSkeletalAnimationParallelRootMotionTest,
+		"System.Engine.Sequencer.SkeletalAnimation.ParallelRootMotion",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneSkeletalAnimationParallelRootMotionTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+	using namespace UE::MovieScene::Test;
+
+	UAnimSequence* Animation = LoadRootMotionTestAnimation();
+	UTEST_NOT_NULL("Root motion test animation", Animation);
+
+	FRootMotionTestFixture Fixture(Animation, 16);
+
+	// Preparing on the game thread sets up root motion and sorts sections ahead of time
+	Fixture.SystemData.PrepareRootMotion();
+	for (UMovieSceneSkeletalAnimationTrack* Track : Fixture.Tracks)
+	{
+		UTEST_FALSE("Root motion is no longer dirty", Track->RootMotionParams.bRootMotionsDirty);
+		UTEST_TRUE("Track has root motion", Track->RootMotionParams.bHaveRootMotion);
+		UTEST_EQUAL("Sections were sorted", Track->AnimationSections[0]->GetInclusiveStartFrame(), FFrameNumber(0));
+	}
+
+	// Parallel computation must produce exactly the same results as the game thread path
+	Fixture.SystemData.ComputeRootMotion();
+	for (const TTuple<TWeakObjectPtr<USkeletalMeshComponent>, FBoundObjectActiveSkeletalAnimations>& Pair : Fixture.SystemData.SkeletalAnimations)
+	{
+		for (const FActiveSkeletalAnimation& ActiveAnimation : Pair.Value.Animations)
+		{
+			UTEST_TRUE("Root motion was computed", ActiveAnimation.bHasRootMotion);
+
+			UMovieSceneSkeletalAnimationSection::FRootMotionParams Expected;
+			ActiveAnimation.AnimSection->GetRootMotion(ActiveAnimation.EvalFrameTime, Expected);
+
+			UTEST_TRUE("Root motion transform is set", ActiveAnimation.RootMotion.Transform.IsSet() && Expected.Transform.IsSet());
+			UTEST_TRUE("Root motion matches the game thread result", ActiveAnimation.RootMotion.Transform->Equals(Expected.Transform.GetValue(), 0.0));
+			UTEST_EQUAL("Child bone index matches the game thread result", ActiveAnimation.RootMotion.ChildBoneIndex, Expected.ChildBoneIndex);
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneSkeletalAnimationRootMotionPerfTest,
+		"System.Engine.Sequencer.SkeletalAnimation.RootMotion.Perf",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter | EAutomationTestFlags::Disabled)
+bool FMovieSceneSkeletalAnimationRootMotionPerfTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+	using namespace UE::MovieScene::Test;
+
+	constexpr int32 NumIterations = 100;
+
+	UAnimSequence* Animation = LoadRootMotionTestAnimation();
+	UTEST_NOT_NULL("Root motion test animation", Animation);
+
+	IConsoleVariable* ParallelRootMotion = IConsoleManager::Get().FindConsoleVariable(TEXT("Sequencer.Animation.ParallelRootMotion"));
+	UTEST_NOT_NULL("Parallel root motion console variable", ParallelRootMotion);
+
+	const bool bWasParallel = ParallelRootMotion->GetBool();
+
+	for (int32 NumCharacters : { 10, 50, 150 })
+	{
+		FRootMotionTestFixture Fixture(Animation, NumCharacters);
+
+		auto RunBenchmark = [&Fixture, ParallelRootMotion](bool bParallel)
+		{
+			ParallelRootMotion->Set(bParallel, ECVF_SetByCode);
+
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				Fixture.SystemData.PrepareRootMotion();
+				Fixture.SystemData.ComputeRootMotion();
+			}
+			return FPlatformTime::Seconds() - StartTime;
+		};
+
+		const double SerialSeconds   = RunBenchmark(false);
+		const double ParallelSeconds = RunBenchmark(true);
+
+		UE_LOG(LogMovieScene, Display, TEXT("Computed root motion for %d characters %d times. Serial: %.3fms, parallel: %.3fms"),
+			NumCharacters, NumIterations, SerialSeconds * 1000.0, ParallelSeconds * 1000.0);
+	}
+
+	ParallelRootMotion->Set(bWasParallel, ECVF_SetByCode);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -28,3 +28,9 @@ void UMovieSceneTestSequence::LocateBoundObjects(const FGuid& ObjectId, UObject*
 	}
 }
 
+FGuid UMovieSceneTestSequence::FindBindingFromObject(UObject* InObject, TSharedRef<const UE::MovieScene::FSharedPlaybackState> SharedPlaybackState) const
+{
+	int32 Index = BoundObjects.IndexOfByKey(InObject);
+	return Index != INDEX_NONE ? BindingGuids[Index] : FGuid();
+}
+
@@ -330,6 +330,25 @@ static float GetBestBlendPointTimeAtStart(UAnimSequenceBase* FirstAnimSeq, UAnim
 }
 
 TOptional<FTransform>  UMovieSceneCommonAnimationTrack::GetRootMotion(FFrameTime CurrentTime)
+{
+	const FMovieSceneTrackEvaluationField& Field = PrepareRootMotionEvaluation();
+	return EvaluateRootMotion(CurrentTime, Field);
+}
+
+const FMovieSceneTrackEvaluationField& UMovieSceneCommonAnimationTrack::PrepareRootMotionEvaluation()
+{
+	if (RootMotionParams.bRootMotionsDirty) 
+	{
+		SetUpRootMotions(true);
+	}
+	if (RootMotionParams.bHaveRootMotion)
+	{
+		SortSections();
+	}
+	return GetEvaluationField();
+}
+
+TOptional<FTransform> UMovieSceneCommonAnimationTrack::EvaluateRootMotion(FFrameTime CurrentTime, const FMovieSceneTrackEvaluationField& EvaluationField) const
 {
 	TOptional<FTransform> Transform;
 
@@ -340,15 +359,10 @@ TOptional<FTransform>  UMovieSceneCommonAnimationTrack::GetRootMotion(FFrameTime
 	}
 	FFrameRate TickResolution = MovieScene->GetTickResolution();
 	
-	if (RootMotionParams.bRootMotionsDirty) 
-	{
-		SetUpRootMotions(true);
-	}
 	if (RootMotionParams.bHaveRootMotion == false)
 	{
 		return Transform;
 	}
-	SortSections();
 	TArray<FTransform> CurrentTransforms;
 	TArray<float> CurrentWeights;
 	TArray<FTransform> CurrentAdditiveTransforms;
@@ -356,11 +370,11 @@ TOptional<FTransform>  UMovieSceneCommonAnimationTrack::GetRootMotion(FFrameTime
 	FTransform CurrentTransform = FTransform::Identity;
 
 	// Use evaluation field to iterate, as it will take into account 'Evaluate Nearest Section'.
-	for (const FMovieSceneTrackEvaluationFieldEntry& FieldEntry : GetEvaluationField().Entries)
+	for (const FMovieSceneTrackEvaluationFieldEntry& FieldEntry : EvaluationField.Entries)
 	{
 		if (FieldEntry.Range.Contains(CurrentTime.FrameNumber))
 		{
-			if (UMovieSceneSkeletalAnimationSection* AnimSection = Cast<UMovieSceneSkeletalAnimationSection>(FieldEntry.Section))
+			if (const UMovieSceneSkeletalAnimationSection* AnimSection = Cast<const UMovieSceneSkeletalAnimationSection>(FieldEntry.Section))
 			{
 				FFrameNumber EvaluationFrame = FieldEntry.ForcedTime == TNumericLimits<int32>::Lowest() ? CurrentTime.FrameNumber : FieldEntry.ForcedTime;
 				if (AnimSection->Params.Animation)
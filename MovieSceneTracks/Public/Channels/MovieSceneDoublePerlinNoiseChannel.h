@@ -47,6 +47,16 @@ struct FMovieSceneDoublePerlinNoiseChannel : public FMovieSceneChannel
 	 * @return					The evaluated noise value
 	 */
 	static MOVIESCENETRACKS_API double Evaluate(const FPerlinNoiseParams& InParams, double InSeconds);
+
+	/**
+	 * Evaluate perlin noise for a batch of parameters and times using a vectorized noise kernel.
+	 * Produces the same results as calling Evaluate(InParams[Index], InSeconds[Index]) for each index.
+	 *
+	 * @params InParams			Perlin noise parameters for each value
+	 * @params InSeconds		The time at which to evaluate each value
+	 * @params OutResults		Array to receive the evaluated noise values. Must be the same size as InParams and InSeconds.
+	 */
+	static MOVIESCENETRACKS_API void EvaluateBatch(TArrayView<const FPerlinNoiseParams> InParams, TArrayView<const double> InSeconds, TArrayView<double> OutResults);
 };
 
 template<>
@@ -13,6 +13,7 @@
 #include "MovieSceneSkeletalAnimationSection.generated.h"
 
 struct FMovieSceneSkeletalAnimRootMotionTrackParams;
+struct FMovieSceneTrackEvaluationField;
 struct FAnimationPoseData;
 class UMirrorDataTable;
 enum class ESwapRootBone : uint8;
@@ -287,6 +288,12 @@ public:
 	
 	MOVIESCENETRACKS_API void GetRootMotion(FFrameTime CurrentTime, FRootMotionParams& OutRootMotionParams) const;
 
+	/**
+	 * Variant of GetRootMotion that does not modify the owning track, and so is safe to call from any thread.
+	 * UMovieSceneCommonAnimationTrack::PrepareRootMotionEvaluation must have been called on the owning track first.
+	 */
+	MOVIESCENETRACKS_API void EvaluateRootMotion(FFrameTime CurrentTime, const FMovieSceneTrackEvaluationField& EvaluationField, FRootMotionParams& OutRootMotionParams) const;
+
 	MOVIESCENETRACKS_API void ToggleMatchTranslation();
 
 	MOVIESCENETRACKS_API void ToggleMatchIncludeZHeight();
@@ -5,6 +5,8 @@
 #include "EntitySystem/MovieSceneEntitySystem.h"
 #include "Channels/MovieSceneEvent.h"
 #include "Evaluation/IMovieScenePlaybackCapability.h"
+#include "Evaluation/MovieSceneEvaluationOperand.h"
+#include "UObject/ObjectKey.h"
 #include "MovieSceneEventSystems.generated.h"
 
 namespace UE::MovieScene
@@ -30,6 +32,98 @@ struct FMovieSceneEventTriggerData
 	FFrameTime RootTime;
 };
 
+namespace UE::MovieScene
+{
+
+/** An event that is waiting to be triggered, along with the root sequence instance that it was added for */
+struct FPendingEventTrigger
+{
+	FInstanceHandle RootInstance;
+	FMovieSceneEventTriggerData TriggerData;
+};
+
+/** A contiguous range of FEventDispatchBuffers::Events that all belong to the same root sequence instance, sorted in the order they should trigger */
+struct FEventTriggerBatch
+{
+	int32 StartIndex = 0;
+	int32 Num = 0;
+	TSharedPtr<const FSharedPlaybackState> SharedPlaybackState;
+};
+
+/** Cached information about the parameters of an event function */
+struct FEventParameterLayout
+{
+	/** Parameters that are not zero-constructed and so must be explicitly initialized */
+	TArray<FProperty*, TInlineAllocator<2>> ParamsToInitialize;
+	/** Parameters that have a destructor */
+	TArray<FProperty*, TInlineAllocator<2>> ParamsToDestroy;
+	/** The function's property list and parameter size when this layout was built, used to detect the function being recompiled in-place */
+	const FField* ChildProperties = nullptr;
+	int32 ParmsSize = 0;
+
+	/** (Re)build this layout from the specified function's parameters */
+	MOVIESCENETRACKS_API void Build(const UFunction* Function);
+
+	/** Check whether this layout was built from the specified function's current parameters */
+	bool IsValidFor(const UFunction* Function) const
+	{
+		return ChildProperties == Function->ChildProperties && ParmsSize == Function->ParmsSize;
+	}
+};
+
+/**
+ * Buffers used for triggering events that are retained between flushes so that dispatching events does not allocate.
+ * Parameter layouts are retained between flushes, bound objects and global contexts are only cached for a single root instance.
+ */
+struct FEventDispatchBuffers
+{
+	/** All the events being triggered, grouped by root instance */
+	TArray<FPendingEventTrigger> Events;
+	/** One batch for each root instance */
+	TArray<FEventTriggerBatch> Batches;
+	/** Parameter layouts for each event function. Keyed on the object key so that a recompiled function never matches a stale layout. */
+	TMap<TObjectKey<UFunction>, FEventParameterLayout> ParameterLayouts;
+	/** Ranges within BoundObjectStorage of the objects bound to each event binding within the current batch */
+	TMap<FMovieSceneEvaluationOperand, TTuple<int32, int32>> BoundObjectRanges;
+	/** Flat storage for all the bound objects within the current batch */
+	TArray<TWeakObjectPtr<>> BoundObjectStorage;
+	/** The evaluation state serial number that the cached bound objects were resolved at */
+	uint32 BoundObjectSerial = 0;
+	/** Global event contexts for the current batch */
+	TArray<UObject*> GlobalContexts;
+
+	/** Find the parameter layout for the specified function, (re)building it if it has not been seen or has changed since it was built */
+	MOVIESCENETRACKS_API const FEventParameterLayout& FindOrAddParameterLayout(UFunction* Function);
+
+	/**
+	 * Find the cached objects bound to the specified binding.
+	 * All cached bindings are discarded if the specified serial number does not match the one they were resolved at,
+	 * since triggering an event can spawn or rebind objects.
+	 */
+	MOVIESCENETRACKS_API bool FindBoundObjects(const FMovieSceneEvaluationOperand& Operand, uint32 SerialNumber, TArrayView<const TWeakObjectPtr<>>& OutBoundObjects);
+
+	/** Cache the objects bound to the specified binding, that were resolved at the specified serial number */
+	MOVIESCENETRACKS_API TArrayView<const TWeakObjectPtr<>> AddBoundObjects(const FMovieSceneEvaluationOperand& Operand, uint32 SerialNumber, TArrayView<const TWeakObjectPtr<>> BoundObjects);
+
+	/** Discard all cached bound objects, retaining their allocations */
+	void ResetBoundObjects()
+	{
+		BoundObjectRanges.Reset();
+		BoundObjectStorage.Reset();
+	}
+
+	/** Reset everything apart from the parameter layouts, retaining all allocations */
+	void Reset()
+	{
+		Events.Reset();
+		Batches.Reset();
+		ResetBoundObjects();
+		GlobalContexts.Reset();
+	}
+};
+
+} // namespace UE::MovieScene
+
 /**
  * Systems that triggers events based on one-shot FMovieSceneEventComponent components
  * Works by iterating all pending instances of TMovieSceneComponentID<FMovieSceneEventComponent> and triggering inline.
@@ -59,12 +153,18 @@ private:
 	MOVIESCENETRACKS_API virtual bool IsRelevantImpl(UMovieSceneEntitySystemLinker* InLinker) const override;
 	MOVIESCENETRACKS_API virtual void OnUnlink() override final;
 
-	static void TriggerEvents(TArrayView<const FMovieSceneEventTriggerData> Events, TSharedRef<const FSharedPlaybackState> SharedPlaybackState);
-	static void TriggerEventWithParameters(UObject* DirectorInstance, const FMovieSceneEventTriggerData& Event, TArrayView<UObject* const> GlobalContexts, TSharedRef<const FSharedPlaybackState> SharedPlaybackState);
+	static void TriggerEvents(TArrayView<const UE::MovieScene::FPendingEventTrigger> Events, TSharedRef<const FSharedPlaybackState> SharedPlaybackState, UE::MovieScene::FEventDispatchBuffers& Buffers);
+	static void TriggerEventWithParameters(UObject* DirectorInstance, const FMovieSceneEventTriggerData& Event, TSharedRef<const FSharedPlaybackState> SharedPlaybackState, UE::MovieScene::FEventDispatchBuffers& Buffers);
 	static bool PatchBoundObject(uint8* Parameters, UObject* BoundObject, FProperty* BoundObjectProperty, TSharedRef<const FSharedPlaybackState> SharedPlaybackState, FMovieSceneSequenceID SequenceID);
 
-	/** Events grouped by root sequence instance handle */
-	TMap< UE::MovieScene::FInstanceHandle, TArray<FMovieSceneEventTriggerData> > EventsByRoot;
+	/** Events that have been added since the last time events were triggered, in the order they were added */
+	TArray<UE::MovieScene::FPendingEventTrigger> PendingEvents;
+
+	/** Buffers that are reused for every call to TriggerAllEvents, unless it is re-entered */
+	UE::MovieScene::FEventDispatchBuffers DispatchBuffers;
+
+	/** Whether DispatchBuffers are currently in use for triggering events */
+	bool bTriggeringEvents = false;
 };
 
 /** System that triggers events before any spawnables */
@@ -34,6 +34,38 @@ struct FAnimatedMaterialParameterInfo
 
 MOVIESCENETRACKS_API void CollectGarbageForOutput(FAnimatedMaterialParameterInfo* Output);
 
+/** A scalar parameter value that has been evaluated for a bound material, but not yet applied */
+struct FPendingScalarMaterialParameter
+{
+	UObject* BoundMaterial;
+	FMaterialParameterInfo ParameterInfo;
+	float Value;
+};
+
+/** A vector or color parameter value that has been evaluated for a bound material, but not yet applied */
+struct FPendingVectorMaterialParameter
+{
+	UObject* BoundMaterial;
+	FMaterialParameterInfo ParameterInfo;
+	FLinearColor Value;
+};
+
+/**
+ * Material parameter values gathered from all entities in a frame so that each bound material is visited once,
+ * with all of its changes applied together and any values that are already up to date skipped.
+ */
+struct FMaterialParameterBatches
+{
+	/** Scalar values, written only by the scalar gather task */
+	TArray<FPendingScalarMaterialParameter> Scalars;
+	/** Vector and color values, written only by the vector gather task */
+	TArray<FPendingVectorMaterialParameter> Vectors;
+
+	/** Apply all gathered values grouped by bound material, and reset the batches for the next frame */
+	void Apply();
+};
+
+
 } // namespace UE::MovieScene
 
 
@@ -98,4 +130,9 @@ private:
 
 	virtual void OnSchedulePersistentTasks(UE::MovieScene::IEntitySystemScheduler* TaskScheduler) override;
 	virtual void OnRun(FSystemTaskPrerequisites& InPrerequisites, FSystemSubsequentTasks& Subsequents) override;
+
+private:
+
+	/** Parameter values gathered this frame, retained between frames to avoid reallocating */
+	UE::MovieScene::FMaterialParameterBatches ParameterBatches;
 };
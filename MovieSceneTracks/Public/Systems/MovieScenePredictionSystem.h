@@ -21,19 +21,9 @@ class USceneComponent;
 class UMovieSceneSequencePlayer;
 class UMovieSceneEntitySystemLinker;
 
-namespace UE
-{
-namespace MovieScene
-{
-
-struct FEntityImportSequenceParams;
-
-} // namespace MovieScene
-} // namespace UE
-
-
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FMovieSceneActorPredictionResult, FTransform, PredictedTransform);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FMovieSceneActorPredictionFailure);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FMovieSceneBatchPredictionResult, const TArray<FTransform>&, PredictedTransforms, const TArray<bool>&, Succeeded);
 
 /**
  * Async BP action that represents a pending prediction that is dispatched on a playing sequence.
@@ -129,9 +119,6 @@ private:
 	static UMovieSceneAsyncAction_SequencePrediction* MakePredictionImpl(UMovieSceneSequencePlayer* Player, USceneComponent* TargetComponent, float TimeInSeconds, bool bInWorldSpace);
 	static UMovieSceneAsyncAction_SequencePrediction* MakePredictionImpl(UMovieSceneSequencePlayer* Player, USceneComponent* TargetComponent, FFrameTime TickResolutionTime, bool bInWorldSpace);
 
-	int32 ImportTransformEntities(UMovieSceneEntitySystemLinker* Linker, const UE::MovieScene::FEntityImportSequenceParams& ImportParams, const FGuid& ObjectGuid, FFrameTime PredictedTime, const FMovieSceneEntityComponentField* ComponentField, const UE::MovieScene::FInterrogationKey& InterrogationKey);
-	int32 ImportTransformEntities(UObject* PredicateObject, UObject* ObjectContext, const UE::MovieScene::FInterrogationKey& InterrogationKey);
-
 	void ImportLocalTransforms(UE::MovieScene::FInterrogationChannels* Channels, USceneComponent* InSceneComponent);
 	void ImportTransformHierarchy(UE::MovieScene::FInterrogationChannels* Channels, USceneComponent* InSceneComponent);
 
@@ -171,6 +158,139 @@ private:
 };
 
 
+/**
+ * Async BP action that represents a pending batch of predictions for many components at many times that is dispatched on a playing sequence.
+ * Object bindings are resolved once per object and every requested time is interrogated in the same pass, which is considerably
+ * cheaper than dispatching a UMovieSceneAsyncAction_SequencePrediction for each component and time.
+ */
+UCLASS(BlueprintType, meta=(ExposedAsyncProxy = "AsyncTask", HasDedicatedAsyncNode))
+class UMovieSceneAsyncAction_SequenceBatchPrediction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * Initiate an asynchronous prediction for each of the specified components' world transforms at each of the specified times in a sequence
+	 * Changes in attachment between the sequence's current time, and the predicted times are not accounted for
+	 * Calling this function on a stopped sequence player is undefined.
+	 *
+	 * @param Player           An active, currently playing sequence player to use for predicting the transforms
+	 * @param TargetComponents The components to predict world transforms for
+	 * @param TimesInSeconds   The times within the sequence to predict the transforms at
+	 * @return An asynchronous prediction object that contains a Result delegate. Results are ordered by component, then by time.
+	 */
+	UFUNCTION(BlueprintCallable, Category=Cinematics)
+	static UMovieSceneAsyncAction_SequenceBatchPrediction* PredictWorldTransformsAtTimes(UMovieSceneSequencePlayer* Player, const TArray<USceneComponent*>& TargetComponents, const TArray<float>& TimesInSeconds);
+
+
+	/**
+	 * Initiate an asynchronous prediction for each of the specified components' world transforms at each of the specified frames in a sequence
+	 * Changes in attachment between the sequence's current time, and the predicted times are not accounted for
+	 * Calling this function on a stopped sequence player is undefined.
+	 *
+	 * @param Player           An active, currently playing sequence player to use for predicting the transforms
+	 * @param TargetComponents The components to predict world transforms for
+	 * @param FrameTimes       The frame times to predict at in the sequence's display rate
+	 * @return An asynchronous prediction object that contains a Result delegate. Results are ordered by component, then by time.
+	 */
+	UFUNCTION(BlueprintCallable, Category=Cinematics)
+	static UMovieSceneAsyncAction_SequenceBatchPrediction* PredictWorldTransformsAtFrames(UMovieSceneSequencePlayer* Player, const TArray<USceneComponent*>& TargetComponents, const TArray<FFrameTime>& FrameTimes);
+
+
+	/**
+	 * Initiate an asynchronous prediction for each of the specified components' local transforms at each of the specified times in a sequence
+	 * Changes in attachment between the sequence's current time, and the predicted times are not accounted for
+	 * Calling this function on a stopped sequence player is undefined.
+	 *
+	 * @param Player           An active, currently playing sequence player to use for predicting the transforms
+	 * @param TargetComponents The components to predict local transforms for
+	 * @param TimesInSeconds   The times within the sequence to predict the transforms at
+	 * @return An asynchronous prediction object that contains a Result delegate. Results are ordered by component, then by time.
+	 */
+	UFUNCTION(BlueprintCallable, Category=Cinematics)
+	static UMovieSceneAsyncAction_SequenceBatchPrediction* PredictLocalTransformsAtTimes(UMovieSceneSequencePlayer* Player, const TArray<USceneComponent*>& TargetComponents, const TArray<float>& TimesInSeconds);
+
+
+	/**
+	 * Initiate an asynchronous prediction for each of the specified components' local transforms at each of the specified frames in a sequence
+	 * Changes in attachment between the sequence's current time, and the predicted times are not accounted for
+	 * Calling this function on a stopped sequence player is undefined.
+	 *
+	 * @param Player           An active, currently playing sequence player to use for predicting the transforms
+	 * @param TargetComponents The components to predict local transforms for
+	 * @param FrameTimes       The frame times to predict at in the sequence's display rate
+	 * @return An asynchronous prediction object that contains a Result delegate. Results are ordered by component, then by time.
+	 */
+	UFUNCTION(BlueprintCallable, Category=Cinematics)
+	static UMovieSceneAsyncAction_SequenceBatchPrediction* PredictLocalTransformsAtFrames(UMovieSceneSequencePlayer* Player, const TArray<USceneComponent*>& TargetComponents, const TArray<FFrameTime>& FrameTimes);
+
+	/**
+	 * Called during the instantiation phase to query the sequence for any transform track entities in the field
+	 * for every component and time, and import the necessary entities into the Entity Manager.
+	 *
+	 * @param Channels Interrogation channel map for tracking channels for objects
+	 */
+	void ImportEntities(UE::MovieScene::FInterrogationChannels* Channels);
+
+
+	/**
+	 * Reset this prediction by marking all its entities for unlink
+	 */
+	void Reset(UMovieSceneEntitySystemLinker* Linker);
+
+
+	/**
+	 * Report the results for this prediction to any observers
+	 *
+	 * @param Channels    Interrogation channel map for retrieving channels for objects
+	 * @param AllResults  The interrogation results for all predictions, in the space requested by this prediction
+	 */
+	void ReportResult(UE::MovieScene::FInterrogationChannels* Channels, const TSparseArray<TArray<FTransform>>& AllResults);
+	void ReportResult(UE::MovieScene::FInterrogationChannels* Channels, const TSparseArray<TArray<UE::MovieScene::FIntermediate3DTransform>>& AllResults);
+
+private:
+
+	static UMovieSceneAsyncAction_SequenceBatchPrediction* MakePredictionImpl(UMovieSceneSequencePlayer* Player, const TArray<USceneComponent*>& TargetComponents, TArrayView<const FFrameTime> TickResolutionTimes, bool bInWorldSpace);
+
+	template<typename TransformType>
+	void ReportResultImpl(UE::MovieScene::FInterrogationChannels* Channels, const TSparseArray<TArray<TransformType>>& AllResults);
+
+public:
+
+	/** Called with the predicted transforms for every component and time once the prediction has run, ordered by component, then by time */
+	UPROPERTY(BlueprintAssignable)
+	FMovieSceneBatchPredictionResult Result;
+
+private:
+
+	friend class UMovieScenePredictionSystem;
+
+	/** Cached array of all the entities created by this prediction */
+	TArray<UE::MovieScene::FMovieSceneEntityID> ImportedEntities;
+
+	/** The sequence player we're interrogating */
+	UPROPERTY()
+	TObjectPtr<UMovieSceneSequencePlayer> SequencePlayer;
+
+	/** The target scene components we're interrogating */
+	UPROPERTY()
+	TArray<TObjectPtr<USceneComponent>> SceneComponents;
+
+	/** The unique times at which the interrogation should run */
+	TArray<FFrameTime> RootPredictedTimes;
+
+	/** The interrogation index for each of RootPredictedTimes */
+	TArray<int32> InterrogationIndices;
+
+	/** Index into RootPredictedTimes for each of the requested times, in the order they were requested */
+	TArray<int32> RequestedTimeIndices;
+
+	/** Whether we're capturing world space or local space transforms */
+	bool bWorldSpace;
+};
+
+
 /**
  * System responsible for managing and reporting on pending UMovieSceneAsyncAction_SequencePrediction tasks
  */
@@ -184,6 +304,7 @@ public:
 	UMovieScenePredictionSystem(const FObjectInitializer& ObjInit);
 
 	void AddPendingPrediction(UMovieSceneAsyncAction_SequencePrediction* Prediction);
+	void AddPendingPrediction(UMovieSceneAsyncAction_SequenceBatchPrediction* Prediction);
 
 	int32 MakeNewInterrogation(FFrameTime InTime);
 
@@ -199,4 +320,10 @@ private:
 
 	UPROPERTY()
 	TArray<TObjectPtr<UMovieSceneAsyncAction_SequencePrediction>> ProcessingPredictions;
+
+	UPROPERTY()
+	TArray<TObjectPtr<UMovieSceneAsyncAction_SequenceBatchPrediction>> PendingBatchPredictions;
+
+	UPROPERTY()
+	TArray<TObjectPtr<UMovieSceneAsyncAction_SequenceBatchPrediction>> ProcessingBatchPredictions;
 };
@@ -142,6 +142,7 @@ private:
 			, bNeedsInitialValue( false)
 			, bMaxHBiasHasChanged(false)
 			, bIsPartiallyAnimated(false)
+			, bSkipUnchangedValues(false)
 		{}
 
 		/** Variant of the property itself as either a pointer offset, a custom property index, or slow track instance bindings object */
@@ -169,6 +170,8 @@ private:
 		uint8 bNeedsInitialValue : 1;
 		uint8 bMaxHBiasHasChanged : 1;
 		uint8 bIsPartiallyAnimated : 1;
+		/** Whether every contributor has opted in to skipping unchanged values, and the property is fully animated */
+		uint8 bSkipUnchangedValues : 1;
 	};
 
 private:
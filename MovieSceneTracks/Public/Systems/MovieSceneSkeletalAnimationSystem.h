@@ -7,12 +7,12 @@
 #include "EntitySystem/MovieSceneSequenceInstanceHandle.h"
 #include "Evaluation/MovieScenePlayback.h"
 #include "MovieSceneTracksComponentTypes.h"
+#include "Sections/MovieSceneSkeletalAnimationSection.h"
 #include "UObject/ObjectKey.h"
 #include "MovieSceneSkeletalAnimationSystem.generated.h"
 
 class IMovieScenePlayer;
 class UAnimMontage;
-class UMovieSceneSkeletalAnimationSection;
 enum class ESwapRootBone : uint8;
 
 namespace UE::MovieScene
@@ -35,6 +35,13 @@ struct FActiveSkeletalAnimation
 	uint8 bResetDynamics : 1;
 	uint8 bWantsRestoreState : 1;
 	uint8 bPreviewPlayback : 1;
+	/** Whether FrameRootMotion and RootMotion have been computed by FSkeletalAnimationSystemData::ComputeRootMotion */
+	uint8 bHasRootMotion : 1;
+
+	/** Root motion at EvalFrameTime rounded to the nearest frame */
+	UMovieSceneSkeletalAnimationSection::FRootMotionParams FrameRootMotion;
+	/** Root motion at EvalFrameTime */
+	UMovieSceneSkeletalAnimationSection::FRootMotionParams RootMotion;
 };
 
 /** DelegateHandle and Skeletal Mesh for bone transform finalized */
@@ -81,10 +88,34 @@ struct FMontagePlayerPerSectionData
 	int32 MontageInstanceId;
 };
 
+/** Gathered skeletal animations that share the same track, and so the same root motion evaluation */
+struct FSkeletalRootMotionBatch
+{
+	/** The evaluation field of the owning track, as returned by UMovieSceneCommonAnimationTrack::PrepareRootMotionEvaluation */
+	const FMovieSceneTrackEvaluationField* EvaluationField = nullptr;
+	/** All gathered animations from the owning track */
+	TArray<FActiveSkeletalAnimation*, TInlineAllocator<4>> Animations;
+};
+
 struct FSkeletalAnimationSystemData
 {
 	void ResetSkeletalAnimations();
 
+	/**
+	 * Bring the root motion of every track with gathered animations up to date so that it can be computed in parallel.
+	 * Updates cached state on the tracks, so must be called on the game thread.
+	 */
+	void PrepareRootMotion();
+
+	/**
+	 * Compute root motion for all gathered animations ahead of applying them on the game thread.
+	 * Only performs read-only evaluation of the tracks prepared by PrepareRootMotion, so each track is computed in parallel.
+	 */
+	void ComputeRootMotion();
+
+	/** Animations to compute root motion for, grouped by track. Populated by PrepareRootMotion. */
+	TArray<FSkeletalRootMotionBatch> RootMotionBatches;
+
 	/** Map of active skeletal animations for each bound object */
 	TMap<TWeakObjectPtr<USkeletalMeshComponent>, FBoundObjectActiveSkeletalAnimations> SkeletalAnimations;
 
@@ -51,6 +51,7 @@ public:
 	virtual void BindPossessableObject(const FGuid& ObjectId, UObject& PossessedObject, UObject* Context) override {}
 	virtual bool CanPossessObject(UObject& Object, UObject* InPlaybackContext) const override { return true; }
 	MOVIESCENETRACKS_API virtual void LocateBoundObjects(const FGuid& ObjectId, UObject* Context, TArray<UObject*, TInlineAllocator<1>>& OutObjects) const override;
+	MOVIESCENETRACKS_API virtual FGuid FindBindingFromObject(UObject* InObject, TSharedRef<const UE::MovieScene::FSharedPlaybackState> SharedPlaybackState) const override;
 	virtual UMovieScene* GetMovieScene() const override { return MovieScene; }
 	virtual UObject* GetParentObject(UObject* Object) const override { return nullptr; }
 	virtual void UnbindPossessableObjects(const FGuid& ObjectId) override {}
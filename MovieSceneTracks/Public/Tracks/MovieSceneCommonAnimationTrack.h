@@ -81,6 +81,23 @@ public:
 	UE_API void SetRootMotionsDirty();
 	UE_API void SetUpRootMotions(bool bForce);
 	UE_API TOptional<FTransform>  GetRootMotion(FFrameTime CurrentTime);
+
+	/**
+	 * Bring root motion and the evaluation field up to date so that EvaluateRootMotion can be called from any thread.
+	 * Modifies this track, so must be called on the game thread.
+	 *
+	 * @return The evaluation field to pass to EvaluateRootMotion
+	 */
+	UE_API const FMovieSceneTrackEvaluationField& PrepareRootMotionEvaluation();
+
+	/**
+	 * Evaluate root motion without modifying this track or its sections. Safe to call concurrently once PrepareRootMotionEvaluation
+	 * has been called on the game thread since the track last changed.
+	 *
+	 * @param CurrentTime      The time to evaluate at
+	 * @param EvaluationField  The evaluation field returned by PrepareRootMotionEvaluation
+	 */
+	UE_API TOptional<FTransform> EvaluateRootMotion(FFrameTime CurrentTime, const FMovieSceneTrackEvaluationField& EvaluationField) const;
 	UE_API void MatchSectionByBoneTransform(bool bMatchWithPrevious, USkeletalMeshComponent* SkelMeshComp, UMovieSceneSkeletalAnimationSection* CurrentSection, FFrameTime CurrentFrame, FFrameRate FrameRate,
 		const FName& BoneName, FTransform& SecondSectionRootDiff, FVector& TranslationDiff, FQuat& RotationDiff); //add options for z and for rotation.
 #if WITH_EDITORONLY_DATA
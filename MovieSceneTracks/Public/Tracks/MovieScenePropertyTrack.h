@@ -73,6 +73,16 @@ public:
 	/** Access the property binding for this track */
 	const FMovieScenePropertyBinding& GetPropertyBinding() const { return PropertyBinding; }
 
+	/** @return Whether this track skips applying values that are identical to the ones it last applied */
+	bool ShouldSkipUnchangedValues() const { return bSkipUnchangedValues; }
+
+	/**
+	 * Sets whether this track skips applying values that are identical to the ones it last applied.
+	 * Only enable this for properties that are exclusively driven by this track while it is animating: values written by gameplay code or
+	 * restored pre-animated state are not detected, so an unchanged animated value will not be re-applied over them.
+	 */
+	void SetSkipUnchangedValues(bool bInSkipUnchangedValues) { bSkipUnchangedValues = bInSkipUnchangedValues; }
+
 	template <typename ValueType>
 	TOptional<ValueType> GetCurrentValue(const UObject* Object) const
 	{
@@ -154,6 +164,10 @@ protected:
 	UPROPERTY()
 	FMovieScenePropertyBinding PropertyBinding;
 
+	/** When true, values identical to the ones last applied by this track are not re-applied. Only supported by some property types (ie, bool). */
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category="Track")
+	bool bSkipUnchangedValues = false;
+
 	/** All the sections in this list */
 	UPROPERTY()
 	TArray<TObjectPtr<UMovieSceneSection>> Sections;
@@ -222,7 +236,8 @@ struct TPropertyTrackEntityImportHelperImpl
 					Builder
 					.Add(BuiltInComponents->PropertyBinding, PropertyTrack->GetPropertyBinding())
 					.AddConditional(BuiltInComponents->GenericObjectBinding, ObjectBindingID, ObjectBindingID.IsValid())
-					.AddConditional(TracksComponents->PropertyNotify, FPropertyNotifyComponentData{ NotifyFunctionName }, !NotifyFunctionName.IsNone()));
+					.AddConditional(TracksComponents->PropertyNotify, FPropertyNotifyComponentData{ NotifyFunctionName }, !NotifyFunctionName.IsNone())
+					.AddTagConditional(BuiltInComponents->Tags.SkipUnchangedPropertyValues, PropertyTrack->ShouldSkipUnchangedValues()));
 			}
 			else if (ensure(FMovieScenePropertyTrackEntityImportHelper::IsEditConditionToggleID(Params)))
 			{
@@ -351,7 +366,8 @@ struct TPropertyTrackWithOverridableChannelsEntityImportHelperImpl
 					Builder
 					.Add(BuiltInComponents->PropertyBinding, PropertyTrack->GetPropertyBinding())
 					.AddConditional(BuiltInComponents->GenericObjectBinding, ObjectBindingID, ObjectBindingID.IsValid())
-					.AddConditional(TracksComponents->PropertyNotify, FPropertyNotifyComponentData{ NotifyFunctionName }, !NotifyFunctionName.IsNone()));
+					.AddConditional(TracksComponents->PropertyNotify, FPropertyNotifyComponentData{ NotifyFunctionName }, !NotifyFunctionName.IsNone())
+					.AddTagConditional(BuiltInComponents->Tags.SkipUnchangedPropertyValues, PropertyTrack->ShouldSkipUnchangedValues()));
 			}
 			else if (FMovieScenePropertyTrackEntityImportHelper::IsEditConditionToggleID(Params))
 			{
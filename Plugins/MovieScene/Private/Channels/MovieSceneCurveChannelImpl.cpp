@@ -4,6 +4,7 @@
 #include "Channels/MovieSceneDoubleChannel.h"
 #include "Channels/MovieSceneFloatChannel.h"
 #include "Channels/MovieSceneInterpolation.h"
+#include "Channels/MovieSceneStreamedChannelData.h"
 #include "HAL/ConsoleManager.h"
 #include "MovieSceneDrawBezierCurve.h"
 #include "MovieSceneFrameMigration.h"
@@ -921,6 +922,237 @@ void TMovieSceneCurveChannelImpl<ChannelType>::Optimize(ChannelType* InChannel,
 }
 
 
+template<typename ChannelType>
+UE::MovieScene::FCurveSimplificationResult TMovieSceneCurveChannelImpl<ChannelType>::Simplify(ChannelType* InChannel, const UE::MovieScene::FCurveSimplificationParams& InParameters)
+{
+	using namespace UE::MovieScene;
+
+	FCurveSimplificationResult Result;
+
+	TMovieSceneChannelData<ChannelValueType> ChannelData = InChannel->GetData();
+	TArrayView<const FFrameNumber> Times = ChannelData.GetTimes();
+	TArrayView<ChannelValueType> Values = ChannelData.GetValues();
+
+	// Find the contiguous block of keys that lie within the range
+	int32 FirstIndex = INDEX_NONE;
+	int32 LastIndex = INDEX_NONE;
+	for (int32 Index = 0; Index < Times.Num(); ++Index)
+	{
+		if (InParameters.Range.Contains(Times[Index]))
+		{
+			FirstIndex = FirstIndex == INDEX_NONE ? Index : FirstIndex;
+			LastIndex = Index;
+		}
+	}
+
+	if (FirstIndex == INDEX_NONE)
+	{
+		return Result;
+	}
+
+	const int32 NumKeys = LastIndex - FirstIndex + 1;
+	Result.NumKeysBefore = NumKeys;
+	Result.NumKeysAfter = NumKeys;
+
+	if (NumKeys <= 2)
+	{
+		return Result;
+	}
+
+	struct FSample
+	{
+		FFrameNumber Time;
+		double Value;
+	};
+
+	// Sample the original curve at every key and at regular intervals between them.
+	// SampleOffsets[Key] is the index of the sample at that key's time, with the samples for the following segment immediately after it.
+	const int32 NumSamplesPerSegment = FMath::Max(InParameters.NumSamplesPerSegment, 0);
+
+	TArray<FSample> Samples;
+	TArray<int32> SampleOffsets;
+	Samples.Reserve(NumKeys * (NumSamplesPerSegment + 1));
+	SampleOffsets.SetNumUninitialized(NumKeys);
+
+	for (int32 Key = 0; Key < NumKeys; ++Key)
+	{
+		const FFrameNumber KeyTime = Times[FirstIndex + Key];
+
+		SampleOffsets[Key] = Samples.Num();
+		Samples.Add(FSample{ KeyTime, (double)Values[FirstIndex + Key].Value });
+
+		if (Key < NumKeys - 1)
+		{
+			const int64 SegmentLength = int64(Times[FirstIndex + Key + 1].Value) - int64(KeyTime.Value);
+
+			FFrameNumber PreviousTime = KeyTime;
+			for (int32 SampleIndex = 1; SampleIndex <= NumSamplesPerSegment; ++SampleIndex)
+			{
+				const FFrameNumber SampleTime = KeyTime + FFrameNumber(static_cast<int32>(SegmentLength * SampleIndex / (NumSamplesPerSegment + 1)));
+				if (SampleTime > PreviousTime)
+				{
+					CurveValueType SampleValue = 0;
+					Evaluate(InChannel, SampleTime, SampleValue);
+
+					Samples.Add(FSample{ SampleTime, (double)SampleValue });
+					PreviousTime = SampleTime;
+				}
+			}
+		}
+	}
+
+	// Working copy of the keys within the range. Only the sides of each key that face a re-fit span are ever changed,
+	// so spans between keys that were adjacent in the original curve reproduce it exactly.
+	TArray<ChannelValueType> NewValues(&Values[FirstIndex], NumKeys);
+	TBitArray<> KeepKeys(false, NumKeys);
+	TBitArray<> RefitKeys(false, NumKeys);
+	KeepKeys[0] = true;
+	KeepKeys[NumKeys - 1] = true;
+
+	const FFrameRate TickResolution = InChannel->GetTickResolution();
+
+	// Refine coarse-to-fine, starting with a single span covering the whole range
+	TArray<TTuple<int32, int32>, TInlineAllocator<64>> Spans;
+	Spans.Emplace(0, NumKeys - 1);
+
+	while (Spans.Num() > 0)
+	{
+		const TTuple<int32, int32> Span = Spans.Pop(EAllowShrinking::No);
+		const int32 Start = Span.Get<0>();
+		const int32 End   = Span.Get<1>();
+
+		if (End - Start <= 1)
+		{
+			continue;
+		}
+
+		const FFrameNumber StartTime = Times[FirstIndex + Start];
+		const FFrameNumber EndTime   = Times[FirstIndex + End];
+		const double       DX        = double(EndTime.Value) - double(StartTime.Value);
+
+		ChannelValueType FitStart = NewValues[Start];
+		ChannelValueType FitEnd   = NewValues[End];
+
+		const bool bIsCubic = FitStart.InterpMode == RCIM_Cubic
+			|| (FitStart.InterpMode == RCIM_Linear && GSequencerLinearCubicInterpolation && FitEnd.InterpMode == RCIM_Cubic);
+
+		if (bIsCubic)
+		{
+			// Least-squares fit of the leave and arrive tangents of this span's bezier, which is linear in both tangents
+			const double StartValue = FitStart.Value;
+			const double EndValue   = FitEnd.Value;
+
+			double AA = 0.0, AC = 0.0, CC = 0.0, AR = 0.0, CR = 0.0;
+			for (int32 SampleIndex = SampleOffsets[Start] + 1; SampleIndex < SampleOffsets[End]; ++SampleIndex)
+			{
+				const double U  = (double(Samples[SampleIndex].Time.Value) - double(StartTime.Value)) / DX;
+				const double V  = 1.0 - U;
+				const double B1 = 3.0 * U * V * V;
+				const double B2 = 3.0 * U * U * V;
+
+				const double A = B1 * DX / 3.0;
+				const double C = -B2 * DX / 3.0;
+				const double R = Samples[SampleIndex].Value - (StartValue * (V*V*V + B1) + EndValue * (B2 + U*U*U));
+
+				AA += A*A;
+				AC += A*C;
+				CC += C*C;
+				AR += A*R;
+				CR += C*R;
+			}
+
+			double LeaveTangent  = (EndValue - StartValue) / DX;
+			double ArriveTangent = LeaveTangent;
+
+			const double Determinant = AA*CC - AC*AC;
+			if (Determinant > KINDA_SMALL_NUMBER * AA * CC)
+			{
+				LeaveTangent  = (AR*CC - CR*AC) / Determinant;
+				ArriveTangent = (CR*AA - AR*AC) / Determinant;
+			}
+
+			FitStart.Tangent.LeaveTangent = static_cast<float>(LeaveTangent);
+			FitStart.TangentMode = RCTM_Break;
+			if (FitStart.Tangent.TangentWeightMode == RCTWM_WeightedBoth || FitStart.Tangent.TangentWeightMode == RCTWM_WeightedLeave)
+			{
+				FitStart.Tangent.TangentWeightMode = FitStart.Tangent.TangentWeightMode == RCTWM_WeightedBoth ? RCTWM_WeightedArrive : RCTWM_WeightedNone;
+			}
+
+			FitEnd.Tangent.ArriveTangent = static_cast<float>(ArriveTangent);
+			FitEnd.TangentMode = RCTM_Break;
+			if (FitEnd.Tangent.TangentWeightMode == RCTWM_WeightedBoth || FitEnd.Tangent.TangentWeightMode == RCTWM_WeightedArrive)
+			{
+				FitEnd.Tangent.TangentWeightMode = FitEnd.Tangent.TangentWeightMode == RCTWM_WeightedBoth ? RCTWM_WeightedLeave : RCTWM_WeightedNone;
+			}
+		}
+
+		// Measure the error of the fit against every sample strictly within the span
+		double SpanError = 0.0;
+		int32  WorstSample = INDEX_NONE;
+		for (int32 SampleIndex = SampleOffsets[Start] + 1; SampleIndex < SampleOffsets[End]; ++SampleIndex)
+		{
+			const double FitValue = EvalForTwoKeys<ChannelType>(FitStart, StartTime, FitEnd, EndTime, Samples[SampleIndex].Time, TickResolution);
+			const double Error = FMath::Abs(FitValue - Samples[SampleIndex].Value);
+			if (Error > SpanError)
+			{
+				SpanError = Error;
+				WorstSample = SampleIndex;
+			}
+		}
+
+		if (SpanError <= InParameters.MaxError)
+		{
+			NewValues[Start] = FitStart;
+			NewValues[End]   = FitEnd;
+			RefitKeys[Start] = RefitKeys[Start] || bIsCubic;
+			RefitKeys[End]   = RefitKeys[End] || bIsCubic;
+
+			Result.MaxError = FMath::Max(Result.MaxError, SpanError);
+			continue;
+		}
+
+		// Subdivide at the original key closest to the worst sample. Spans between adjacent keys are exact, so this always terminates within tolerance.
+		const int32 SegmentKey = Algo::UpperBound(SampleOffsets, WorstSample) - 1;
+
+		int32 SplitKey = SegmentKey;
+		if (SampleOffsets[SegmentKey] != WorstSample)
+		{
+			const FFrameNumber WorstTime = Samples[WorstSample].Time;
+			const bool bCloserToNext = (Times[FirstIndex + SegmentKey + 1] - WorstTime) < (WorstTime - Times[FirstIndex + SegmentKey]);
+			if (SegmentKey == Start || (bCloserToNext && SegmentKey + 1 < End))
+			{
+				SplitKey = SegmentKey + 1;
+			}
+		}
+
+		check(SplitKey > Start && SplitKey < End);
+
+		KeepKeys[SplitKey] = true;
+		Spans.Emplace(Start, SplitKey);
+		Spans.Emplace(SplitKey, End);
+	}
+
+	// Apply re-fit tangents, then remove all the keys that were not retained
+	TArray<FKeyHandle> KeysToRemove;
+	for (int32 Key = 0; Key < NumKeys; ++Key)
+	{
+		if (!KeepKeys[Key])
+		{
+			KeysToRemove.Add(ChannelData.GetHandle(FirstIndex + Key));
+		}
+		else if (RefitKeys[Key])
+		{
+			Values[FirstIndex + Key] = NewValues[Key];
+		}
+	}
+
+	ChannelData.DeleteKeys(KeysToRemove);
+
+	Result.NumKeysAfter = NumKeys - KeysToRemove.Num();
+	return Result;
+}
+
+
 template<typename ChannelType>
 EMovieSceneKeyInterpolation TMovieSceneCurveChannelImpl<ChannelType>::GetInterpolationMode(ChannelType* InChannel, const FFrameNumber& InTime, EMovieSceneKeyInterpolation DefaultInterpolationMode)
 {
@@ -1324,3 +1556,7 @@ bool TMovieSceneCurveChannelImpl<ChannelType>::SerializeChannelValue(ChannelValu
 template struct MOVIESCENE_API TMovieSceneCurveChannelImpl<FMovieSceneFloatChannel>;
 template struct MOVIESCENE_API TMovieSceneCurveChannelImpl<FMovieSceneDoubleChannel>;
 
+// Streamed channel data shares the interpolation logic of double channels for each of its resident blocks
+template UE::MovieScene::Interpolation::FCachedInterpolation TMovieSceneCurveChannelImpl<UE::MovieScene::FStreamedDoubleChannelBlockView>::GetInterpolationForKey(const UE::MovieScene::FStreamedDoubleChannelBlockView*, int32, int32, const UE::MovieScene::FCycleParams*);
+template bool TMovieSceneCurveChannelImpl<UE::MovieScene::FStreamedDoubleChannelBlockView>::CacheExtrapolation(const UE::MovieScene::FStreamedDoubleChannelBlockView*, FFrameTime, UE::MovieScene::Interpolation::FCachedInterpolation&);
+
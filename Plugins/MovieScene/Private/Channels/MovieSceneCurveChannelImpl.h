@@ -7,6 +7,7 @@
 #include "Channels/MovieSceneChannelProxy.h"
 #include "Channels/MovieSceneChannelTraits.h"
 #include "Channels/MovieSceneCurveChannelCommon.h"
+#include "Channels/MovieSceneCurveSimplification.h"
 #include "Curves/RealCurve.h"
 #include "Curves/RichCurve.h"
 #include "KeyParams.h"
@@ -101,6 +102,9 @@ struct TMovieSceneCurveChannelImpl
 	/** Optimize the channel's curve */
 	static void Optimize(ChannelType* InChannel, const FKeyDataOptimizationParams& InParameters);
 
+	/** Reduce the channel's keys such that its curve remains within a maximum error of the original */
+	static UE::MovieScene::FCurveSimplificationResult Simplify(ChannelType* InChannel, const UE::MovieScene::FCurveSimplificationParams& InParameters);
+
 	/** Add a new key to a channel at a given time */
 	static FKeyHandle AddKeyToChannel(ChannelType* InChannel, FFrameNumber InFrameNumber, float InValue, EMovieSceneKeyInterpolation Interpolation);
 
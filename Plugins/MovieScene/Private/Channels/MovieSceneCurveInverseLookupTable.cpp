@@ -0,0 +1,262 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Channels/MovieSceneCurveInverseLookupTable.h"
+#include "Channels/MovieSceneCurveChannelImpl.h"
+#include "Channels/MovieSceneDoubleChannel.h"
+#include "Channels/MovieSceneInterpolation.h"
+#include "Algo/BinarySearch.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Optional.h"
+#include "Templates/Greater.h"
+
+namespace UE
+{
+namespace MovieScene
+{
+
+/** CVar that defines the number of keys required before a curve builds an inverse lookup table */
+int32 GSequencerCurveInverseLookupTableMinKeys = 16;
+static FAutoConsoleVariableRef CVarSequencerCurveInverseLookupTableMinKeys(
+	TEXT("Sequencer.CurveInverseLookupTableMinKeys"),
+	GSequencerCurveInverseLookupTableMinKeys,
+	TEXT("(Default: 16. The minimum number of keys a time-warp curve must have before an inverse lookup table is built to accelerate inverse evaluation. 0 disables inverse lookup tables.")
+	);
+
+TSharedPtr<const FCurveInverseLookupTable> FCurveInverseLookupTable::Build(const FMovieSceneDoubleChannel& Channel)
+{
+	using namespace UE::MovieScene::Interpolation;
+
+	TArrayView<const FFrameNumber>           Times  = Channel.GetTimes();
+	TArrayView<const FMovieSceneDoubleValue> Values = Channel.GetValues();
+
+	if (GSequencerCurveInverseLookupTableMinKeys <= 0 || Times.Num() < FMath::Max(GSequencerCurveInverseLookupTableMinKeys, 2))
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<FCurveInverseLookupTable> Table = MakeShared<FCurveInverseLookupTable>();
+
+	Table->NumKeys    = Times.Num();
+	Table->FirstTime  = Times[0];
+	Table->LastTime   = Times.Last();
+	Table->FirstValue = Values[0].Value;
+	Table->LastValue  = Values.Last().Value;
+
+	const int32 NumSpans = Times.Num() - 1;
+	Table->Spans.SetNumUninitialized(NumSpans);
+
+	for (int32 SpanIndex = 0; SpanIndex < NumSpans; ++SpanIndex)
+	{
+		FSpanExtents& Span = Table->Spans[SpanIndex];
+
+		// Weighted tangents do not report their turning points, so these spans must always be solved
+		if (Values[SpanIndex].Tangent.TangentWeightMode != RCTWM_WeightedNone || Values[SpanIndex+1].Tangent.TangentWeightMode != RCTWM_WeightedNone)
+		{
+			Span.MinValue = std::numeric_limits<double>::lowest();
+			Span.MaxValue = std::numeric_limits<double>::max();
+			continue;
+		}
+
+		const FCachedInterpolation Interp  = TMovieSceneCurveChannelImpl<FMovieSceneDoubleChannel>::GetInterpolationForKey(&Channel, SpanIndex, SpanIndex+1);
+		const FInterpolationExtents Extents = Interp.ComputeExtents();
+
+		// Widen the extents slightly such that solutions that only exist due to solver precision are never skipped
+		const double Tolerance = UE_KINDA_SMALL_NUMBER + UE_DOUBLE_KINDA_SMALL_NUMBER * FMath::Max(FMath::Abs(Extents.MinValue), FMath::Abs(Extents.MaxValue));
+		Span.MinValue = Extents.MinValue - Tolerance;
+		Span.MaxValue = Extents.MaxValue + Tolerance;
+	}
+
+	// Group spans into runs where both extents are monotonic
+	int32 RunStart = 0;
+	TOptional<bool> bRunDecreasing;
+
+	auto CloseRun = [&Table, &RunStart, &bRunDecreasing](int32 RunEnd)
+	{
+		FMonotonicRun& Run = Table->Runs.Emplace_GetRef();
+		Run.FirstSpan   = RunStart;
+		Run.NumSpans    = RunEnd - RunStart;
+		Run.MinValue    = std::numeric_limits<double>::max();
+		Run.MaxValue    = std::numeric_limits<double>::lowest();
+		Run.bDecreasing = bRunDecreasing.Get(false);
+
+		for (int32 SpanIndex = RunStart; SpanIndex < RunEnd; ++SpanIndex)
+		{
+			Run.MinValue = FMath::Min(Run.MinValue, Table->Spans[SpanIndex].MinValue);
+			Run.MaxValue = FMath::Max(Run.MaxValue, Table->Spans[SpanIndex].MaxValue);
+		}
+
+		RunStart = RunEnd;
+		bRunDecreasing.Reset();
+	};
+
+	for (int32 SpanIndex = 1; SpanIndex < NumSpans; ++SpanIndex)
+	{
+		const FSpanExtents& Prev = Table->Spans[SpanIndex-1];
+		const FSpanExtents& Next = Table->Spans[SpanIndex];
+
+		const bool bIncreasing = Next.MinValue >= Prev.MinValue && Next.MaxValue >= Prev.MaxValue;
+		const bool bDecreasing = Next.MinValue <= Prev.MinValue && Next.MaxValue <= Prev.MaxValue;
+
+		if (bIncreasing && bDecreasing)
+		{
+			// Identical extents fit either direction
+			continue;
+		}
+
+		if (!bRunDecreasing.IsSet() && (bIncreasing || bDecreasing))
+		{
+			bRunDecreasing = bDecreasing;
+		}
+		else if (!bRunDecreasing.IsSet() || bRunDecreasing.GetValue() != bDecreasing || (!bIncreasing && !bDecreasing))
+		{
+			CloseRun(SpanIndex);
+		}
+	}
+	CloseRun(NumSpans);
+
+	Table->Runs.Shrink();
+	return Table;
+}
+
+bool FCurveInverseLookupTable::IsValidFor(const FMovieSceneDoubleChannel& Channel) const
+{
+	TArrayView<const FFrameNumber>           Times  = Channel.GetTimes();
+	TArrayView<const FMovieSceneDoubleValue> Values = Channel.GetValues();
+
+	return Times.Num() == NumKeys
+		&& Times[0] == FirstTime
+		&& Times.Last() == LastTime
+		&& Values[0].Value == FirstValue
+		&& Values.Last().Value == LastValue;
+}
+
+FFrameNumber FCurveInverseLookupTable::SkipForwards(const FMovieSceneDoubleChannel& Channel, double Value, FFrameNumber NextTime, int32& OutNumSkipped) const
+{
+	OutNumSkipped = 0;
+
+	// Extrapolated and cycled regions are always visited
+	if (NextTime < FirstTime || NextTime >= LastTime)
+	{
+		return NextTime;
+	}
+
+	TArrayView<const FFrameNumber> Times = Channel.GetTimes();
+
+	const int32 StartSpan = Algo::UpperBound(Times, NextTime) - 1;
+	const int32 Candidate = FindNextCandidate(Value, StartSpan);
+
+	if (Candidate == StartSpan)
+	{
+		return NextTime;
+	}
+	else if (Candidate == INDEX_NONE)
+	{
+		// Nothing else within the keys can match - jump straight to the last key which leads onto post-extrapolation
+		OutNumSkipped = Spans.Num() - StartSpan;
+		return LastTime;
+	}
+
+	OutNumSkipped = Candidate - StartSpan;
+	return Times[Candidate];
+}
+
+FFrameNumber FCurveInverseLookupTable::SkipBackwards(const FMovieSceneDoubleChannel& Channel, double Value, FFrameNumber NextTime, int32& OutNumSkipped) const
+{
+	OutNumSkipped = 0;
+
+	// Extrapolated and cycled regions are always visited
+	if (NextTime < FirstTime || NextTime >= LastTime)
+	{
+		return NextTime;
+	}
+
+	TArrayView<const FFrameNumber> Times = Channel.GetTimes();
+
+	const int32 StartSpan = Algo::UpperBound(Times, NextTime) - 1;
+	const int32 Candidate = FindPreviousCandidate(Value, StartSpan);
+
+	if (Candidate == StartSpan)
+	{
+		return NextTime;
+	}
+	else if (Candidate == INDEX_NONE)
+	{
+		// Nothing else within the keys can match - jump straight to the first span which leads onto pre-extrapolation
+		OutNumSkipped = StartSpan;
+		return FirstTime;
+	}
+
+	OutNumSkipped = StartSpan - Candidate;
+	return Times[Candidate];
+}
+
+int32 FCurveInverseLookupTable::FindNextCandidate(double Value, int32 StartSpan) const
+{
+	for (int32 RunIndex = FindRun(StartSpan); RunIndex < Runs.Num(); ++RunIndex)
+	{
+		int32 FirstSpan = INDEX_NONE, LastSpan = INDEX_NONE;
+		if (FindCandidatesInRun(RunIndex, Value, FirstSpan, LastSpan) && LastSpan >= StartSpan)
+		{
+			return FMath::Max(FirstSpan, StartSpan);
+		}
+	}
+	return INDEX_NONE;
+}
+
+int32 FCurveInverseLookupTable::FindPreviousCandidate(double Value, int32 StartSpan) const
+{
+	for (int32 RunIndex = FindRun(StartSpan); RunIndex >= 0; --RunIndex)
+	{
+		int32 FirstSpan = INDEX_NONE, LastSpan = INDEX_NONE;
+		if (FindCandidatesInRun(RunIndex, Value, FirstSpan, LastSpan) && FirstSpan <= StartSpan)
+		{
+			return FMath::Min(LastSpan, StartSpan);
+		}
+	}
+	return INDEX_NONE;
+}
+
+bool FCurveInverseLookupTable::FindCandidatesInRun(int32 RunIndex, double Value, int32& OutFirstSpan, int32& OutLastSpan) const
+{
+	const FMonotonicRun& Run = Runs[RunIndex];
+	if (Value < Run.MinValue || Value > Run.MaxValue)
+	{
+		return false;
+	}
+
+	// Since both extents are sorted, spans containing the value are contiguous:
+	//   for increasing runs they start at the first span whose max >= Value and end before the first span whose min > Value,
+	//   for decreasing runs they start at the first span whose min <= Value and end before the first span whose max < Value
+	TArrayView<const FSpanExtents> RunSpans(Spans.GetData() + Run.FirstSpan, Run.NumSpans);
+
+	int32 Begin = 0, End = 0;
+	if (Run.bDecreasing)
+	{
+		Begin = Algo::LowerBoundBy(RunSpans, Value, &FSpanExtents::MinValue, TGreater<>());
+		End   = Algo::UpperBoundBy(RunSpans, Value, &FSpanExtents::MaxValue, TGreater<>());
+	}
+	else
+	{
+		Begin = Algo::LowerBoundBy(RunSpans, Value, &FSpanExtents::MaxValue);
+		End   = Algo::UpperBoundBy(RunSpans, Value, &FSpanExtents::MinValue);
+	}
+
+	if (Begin >= End)
+	{
+		return false;
+	}
+
+	OutFirstSpan = Run.FirstSpan + Begin;
+	OutLastSpan  = Run.FirstSpan + End - 1;
+	return true;
+}
+
+int32 FCurveInverseLookupTable::FindRun(int32 SpanIndex) const
+{
+	const int32 RunIndex = Algo::UpperBoundBy(Runs, SpanIndex, &FMonotonicRun::FirstSpan) - 1;
+	check(Runs.IsValidIndex(RunIndex));
+	return RunIndex;
+}
+
+} // namespace MovieScene
+} // namespace UE
@@ -0,0 +1,102 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Channels/MovieSceneCurveSimplification.h"
+#include "Channels/MovieSceneCurveChannelImpl.h"
+#include "Channels/MovieSceneDoubleChannel.h"
+#include "Channels/MovieSceneFloatChannel.h"
+#include "Async/ParallelFor.h"
+#include "AutoRTFM.h"
+#include "HAL/IConsoleManager.h"
+#include "MovieSceneSection.h"
+
+namespace UE
+{
+namespace MovieScene
+{
+
+/** CVar that defines the number of channels required before simplification is distributed across worker threads */
+int32 GSequencerParallelCurveSimplificationThreshold = 4;
+static FAutoConsoleVariableRef CVarSequencerParallelCurveSimplificationThreshold(
+	TEXT("Sequencer.ParallelCurveSimplificationThreshold"),
+	GSequencerParallelCurveSimplificationThreshold,
+	TEXT("(Default: 4. The minimum number of channels that must be simplified together before the work is distributed across worker threads. 0 disables parallel simplification.")
+	);
+
+template<typename ChannelType>
+FCurveSimplificationResult SimplifyCurvesImpl(TArrayView<ChannelType* const> Channels, const FCurveSimplificationParams& Params)
+{
+	TArray<FCurveSimplificationResult, TInlineAllocator<16>> Results;
+	Results.SetNum(Channels.Num());
+
+	auto SimplifyChannel = [&Channels, &Results, &Params](int32 Index)
+	{
+		if (ChannelType* Channel = Channels[Index])
+		{
+			Results[Index] = TMovieSceneCurveChannelImpl<ChannelType>::Simplify(Channel, Params);
+		}
+	};
+
+	// Each channel is entirely independent so there is no synchronization required beyond the results array
+	if (GSequencerParallelCurveSimplificationThreshold > 0 && Channels.Num() >= GSequencerParallelCurveSimplificationThreshold && !AutoRTFM::IsTransactional())
+	{
+		ParallelFor(Channels.Num(), SimplifyChannel);
+	}
+	else
+	{
+		for (int32 Index = 0; Index < Channels.Num(); ++Index)
+		{
+			SimplifyChannel(Index);
+		}
+	}
+
+	FCurveSimplificationResult Total;
+	for (const FCurveSimplificationResult& Result : Results)
+	{
+		Total.Accumulate(Result);
+	}
+	return Total;
+}
+
+FCurveSimplificationResult SimplifyCurve(FMovieSceneDoubleChannel* Channel, const FCurveSimplificationParams& Params)
+{
+	check(Channel);
+	return TMovieSceneCurveChannelImpl<FMovieSceneDoubleChannel>::Simplify(Channel, Params);
+}
+
+FCurveSimplificationResult SimplifyCurve(FMovieSceneFloatChannel* Channel, const FCurveSimplificationParams& Params)
+{
+	check(Channel);
+	return TMovieSceneCurveChannelImpl<FMovieSceneFloatChannel>::Simplify(Channel, Params);
+}
+
+FCurveSimplificationResult SimplifyCurves(TArrayView<FMovieSceneDoubleChannel* const> Channels, const FCurveSimplificationParams& Params)
+{
+	return SimplifyCurvesImpl(Channels, Params);
+}
+
+FCurveSimplificationResult SimplifyCurves(TArrayView<FMovieSceneFloatChannel* const> Channels, const FCurveSimplificationParams& Params)
+{
+	return SimplifyCurvesImpl(Channels, Params);
+}
+
+FCurveSimplificationResult SimplifySectionCurves(UMovieSceneSection* Section, const FCurveSimplificationParams& Params)
+{
+	check(IsInGameThread() && Section);
+
+	FCurveSimplificationResult Result;
+
+	TArrayView<FMovieSceneDoubleChannel*> DoubleChannels = Section->GetChannelProxy().GetChannels<FMovieSceneDoubleChannel>();
+	TArrayView<FMovieSceneFloatChannel*>  FloatChannels  = Section->GetChannelProxy().GetChannels<FMovieSceneFloatChannel>();
+
+	if (DoubleChannels.Num() + FloatChannels.Num() == 0 || !Section->TryModify())
+	{
+		return Result;
+	}
+
+	Result.Accumulate(SimplifyCurves(DoubleChannels, Params));
+	Result.Accumulate(SimplifyCurves(FloatChannels, Params));
+	return Result;
+}
+
+} // namespace MovieScene
+} // namespace UE
@@ -3,10 +3,12 @@
 #include "Channels/MovieSceneDoubleChannel.h"
 #include "Channels/MovieSceneChannelProxy.h"
 #include "Channels/MovieSceneCurveChannelImpl.h"
+#include "Channels/MovieSceneCurveInverseLookupTable.h"
 #include "Channels/MovieSceneFloatChannel.h"
 #include "Channels/MovieSceneInterpolation.h"
 #include "Channels/MovieScenePiecewiseCurve.h"
 #include "Channels/MovieScenePiecewiseCurveUtils.inl"
+#include "Channels/MovieSceneStreamedChannelData.h"
 #include "HAL/Platform.h"
 #include "MovieSceneFrameMigration.h"
 #include "MovieSceneFwd.h"
@@ -161,6 +163,10 @@ int32 FMovieSceneDoubleChannel::AddCubicKey(FFrameNumber InTime, double InValue,
 
 bool FMovieSceneDoubleChannel::Evaluate(FFrameTime InTime,  double& OutValue) const
 {
+	if (StreamedData)
+	{
+		return StreamedData->Evaluate(InTime, OutValue);
+	}
 	return FMovieSceneDoubleChannelImpl::Evaluate(this, InTime, OutValue);
 }
 
@@ -174,9 +180,18 @@ bool FMovieSceneDoubleChannel::Evaluate(FFrameTime InTime, float& OutValue) cons
 
 UE::MovieScene::Interpolation::FCachedInterpolation FMovieSceneDoubleChannel::GetInterpolationForTime(FFrameTime InTime) const
 {
+	if (StreamedData)
+	{
+		return StreamedData->GetInterpolationForTime(InTime);
+	}
 	return FMovieSceneDoubleChannelImpl::GetInterpolationForTime(this, InTime);
 }
 
+void FMovieSceneDoubleChannel::SetStreamedData(TSharedPtr<const UE::MovieScene::FStreamedDoubleChannelData> InStreamedData)
+{
+	StreamedData = MoveTemp(InStreamedData);
+}
+
 void FMovieSceneDoubleChannel::Set(TArray<FFrameNumber> InTimes, TArray<FMovieSceneDoubleValue> InValues)
 {
 	FMovieSceneDoubleChannelImpl::Set(this, InTimes, InValues);
@@ -351,6 +366,11 @@ TRange<FFrameNumber> FMovieSceneDoubleChannel::GetCycleRange(int32 InCycleCount)
 }
 
 bool FMovieSceneDoubleChannel::InverseEvaluateBetween(double InValue, FFrameTime StartTime, FFrameTime EndTime, const TFunctionRef<bool(FFrameTime)>& VisitorCallback) const
+{
+	return InverseEvaluateBetween(InValue, StartTime, EndTime, nullptr, VisitorCallback);
+}
+
+bool FMovieSceneDoubleChannel::InverseEvaluateBetween(double InValue, FFrameTime StartTime, FFrameTime EndTime, const UE::MovieScene::FCurveInverseLookupTable* LookupTable, const TFunctionRef<bool(FFrameTime)>& VisitorCallback) const
 {
 	using namespace UE::MovieScene;
 
@@ -397,7 +417,17 @@ bool FMovieSceneDoubleChannel::InverseEvaluateBetween(double InValue, FFrameTime
 		FFrameNumber ThisInterpEnd = Interp.GetRange().End;
 		if (ThisInterpEnd != TNumericLimits<FFrameNumber>::Max() && ThisInterpEnd < EndTime)
 		{
-			Interp = FMovieSceneDoubleChannelImpl::GetInterpolationForTime(this, ThisInterpEnd+1);
+			FFrameNumber NextTime = ThisInterpEnd+1;
+			int32 NumSkipped = 0;
+			if (LookupTable)
+			{
+				NextTime = LookupTable->SkipForwards(*this, InValue, NextTime, NumSkipped);
+			}
+
+			// Stop if the next span that could hold a solution lies entirely outside of the range
+			Interp = (NumSkipped == 0 || NextTime <= EndTime)
+				? FMovieSceneDoubleChannelImpl::GetInterpolationForTime(this, NextTime)
+				: Interpolation::FCachedInterpolation();
 		}
 		else
 		{
@@ -409,6 +439,11 @@ bool FMovieSceneDoubleChannel::InverseEvaluateBetween(double InValue, FFrameTime
 }
 
 TOptional<FFrameTime> FMovieSceneDoubleChannel::InverseEvaluate(double InValue, FFrameTime InTimeHint, UE::MovieScene::EInverseEvaluateFlags Flags) const
+{
+	return InverseEvaluate(InValue, InTimeHint, Flags, nullptr);
+}
+
+TOptional<FFrameTime> FMovieSceneDoubleChannel::InverseEvaluate(double InValue, FFrameTime InTimeHint, UE::MovieScene::EInverseEvaluateFlags Flags, const UE::MovieScene::FCurveInverseLookupTable* LookupTable) const
 {
 	using namespace UE::MovieScene;
 
@@ -542,7 +577,16 @@ TOptional<FFrameTime> FMovieSceneDoubleChannel::InverseEvaluate(double InValue,
 			FFrameNumber ThisInterpEnd = NextInterp.GetRange().End;
 			if (ThisInterpEnd < TNumericLimits<FFrameNumber>::Max())
 			{
-				NextInterp = FMovieSceneDoubleChannelImpl::GetInterpolationForTime(this, ThisInterpEnd+1);
+				FFrameNumber NextTime = ThisInterpEnd+1;
+				if (LookupTable)
+				{
+					// Skipped spans count towards the iteration limit as if they had been visited
+					int32 NumSkipped = 0;
+					NextTime = LookupTable->SkipForwards(*this, InValue, NextTime, NumSkipped);
+					IterationCount += NumSkipped;
+				}
+
+				NextInterp = FMovieSceneDoubleChannelImpl::GetInterpolationForTime(this, NextTime);
 				continue;
 			}
 		}
@@ -568,7 +612,15 @@ TOptional<FFrameTime> FMovieSceneDoubleChannel::InverseEvaluate(double InValue,
 			FFrameNumber ThisInterpStart = PrevInterp.GetRange().Start;
 			if (ThisInterpStart > TNumericLimits<FFrameNumber>::Lowest())
 			{
-				PrevInterp = FMovieSceneDoubleChannelImpl::GetInterpolationForTime(this, ThisInterpStart-1);
+				FFrameNumber NextTime = ThisInterpStart-1;
+				if (LookupTable)
+				{
+					int32 NumSkipped = 0;
+					NextTime = LookupTable->SkipBackwards(*this, InValue, NextTime, NumSkipped);
+					IterationCount += NumSkipped;
+				}
+
+				PrevInterp = FMovieSceneDoubleChannelImpl::GetInterpolationForTime(this, NextTime);
 				continue;
 			}
 		}
@@ -0,0 +1,484 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Channels/MovieSceneStreamedChannelData.h"
+#include "Channels/MovieSceneCurveChannelImpl.h"
+#include "Algo/BinarySearch.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/ScopeLock.h"
+#include "MovieSceneFwd.h"
+#include "Templates/AlignmentTemplates.h"
+
+namespace UE
+{
+namespace MovieScene
+{
+
+namespace StreamedChannelData
+{
+	static constexpr uint32 Magic   = 0x5344434D; // 'MCDS'
+	static constexpr uint32 Version = 2;
+
+	/** File header, written verbatim at the start of the file */
+	struct FHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		uint32 SizeOfValue;
+		int32  NumKeys;
+		int32  NumBlocks;
+		int32  TickResolutionNumerator;
+		int32  TickResolutionDenominator;
+		uint8  PreInfinityExtrap;
+		uint8  PostInfinityExtrap;
+		uint8  bHasDefaultValue;
+		uint8  Padding;
+		double DefaultValue;
+		double FirstValue;
+		double LastValue;
+	};
+
+	/** Block data is aligned such that values can be read in-place from the mapped region */
+	static constexpr int64 BlockAlignment = 16;
+
+	int64 GetValuesOffset(int32 NumBlockKeys)
+	{
+		return Align(int64(NumBlockKeys) * sizeof(FFrameNumber), BlockAlignment);
+	}
+
+	int64 GetBlockSize(int32 NumBlockKeys)
+	{
+		return Align(GetValuesOffset(NumBlockKeys) + int64(NumBlockKeys) * sizeof(FMovieSceneDoubleValue), BlockAlignment);
+	}
+}
+
+FStreamedDoubleChannelData::~FStreamedDoubleChannelData()
+{
+	// Regions must be released before the file handle that they were mapped from
+	RetiredRegions.Empty();
+	BlockRegions.Empty();
+	FileHandle.Reset();
+}
+
+bool FStreamedDoubleChannelData::WriteToFile(const FMovieSceneDoubleChannel& Channel, const TCHAR* Filename, int32 KeysPerBlock)
+{
+	using namespace StreamedChannelData;
+
+	check(KeysPerBlock > 0);
+
+	TArrayView<const FFrameNumber>           Times  = Channel.GetTimes();
+	TArrayView<const FMovieSceneDoubleValue> Values = Channel.GetValues();
+
+	const int32 NumKeys = Times.Num();
+
+	// Each block shares its last key with the first key of the next block
+	const int32 NumBlocks = NumKeys == 0 ? 0 : FMath::Max(1, FMath::DivideAndRoundUp(NumKeys - 1, KeysPerBlock));
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(Filename));
+	if (!Writer)
+	{
+		return false;
+	}
+
+	TOptional<double> DefaultValue = Channel.GetDefault();
+
+	FHeader Header;
+	FMemory::Memzero(Header);
+	Header.Magic                     = Magic;
+	Header.Version                   = Version;
+	Header.SizeOfValue               = sizeof(FMovieSceneDoubleValue);
+	Header.NumKeys                   = NumKeys;
+	Header.NumBlocks                 = NumBlocks;
+	Header.TickResolutionNumerator   = Channel.GetTickResolution().Numerator;
+	Header.TickResolutionDenominator = Channel.GetTickResolution().Denominator;
+	Header.PreInfinityExtrap         = Channel.PreInfinityExtrap;
+	Header.PostInfinityExtrap        = Channel.PostInfinityExtrap;
+	Header.bHasDefaultValue          = DefaultValue.IsSet();
+	Header.DefaultValue              = DefaultValue.Get(0.0);
+	Header.FirstValue                = NumKeys > 0 ? Values[0].Value : 0.0;
+	Header.LastValue                 = NumKeys > 0 ? Values.Last().Value : 0.0;
+
+	// Lay out the block index
+	TArray<FBlockEntry> BlockEntries;
+	BlockEntries.SetNumUninitialized(NumBlocks);
+
+	int64 FileOffset = Align(int64(sizeof(FHeader)) + int64(NumBlocks) * sizeof(FBlockEntry), BlockAlignment);
+	for (int32 BlockIndex = 0; BlockIndex < NumBlocks; ++BlockIndex)
+	{
+		const int32 FirstKey = BlockIndex * KeysPerBlock;
+		const int32 LastKey  = FMath::Min(FirstKey + KeysPerBlock, NumKeys - 1);
+
+		FBlockEntry& Entry = BlockEntries[BlockIndex];
+		FMemory::Memzero(Entry);
+		Entry.FirstTime  = Times[FirstKey];
+		Entry.LastTime   = Times[LastKey];
+		Entry.NumKeys    = LastKey - FirstKey + 1;
+		Entry.FileOffset = FileOffset;
+
+		FileOffset += StreamedChannelData::GetBlockSize(Entry.NumKeys);
+	}
+
+	static const uint8 Zeros[BlockAlignment] = {};
+	auto PadTo = [&Writer](int64 Offset)
+	{
+		const int64 Padding = Offset - Writer->Tell();
+		check(Padding >= 0 && Padding < BlockAlignment);
+		Writer->Serialize(const_cast<uint8*>(Zeros), Padding);
+	};
+
+	Writer->Serialize(&Header, sizeof(FHeader));
+	Writer->Serialize(BlockEntries.GetData(), BlockEntries.Num() * sizeof(FBlockEntry));
+
+	for (int32 BlockIndex = 0; BlockIndex < NumBlocks; ++BlockIndex)
+	{
+		const FBlockEntry& Entry    = BlockEntries[BlockIndex];
+		const int32        FirstKey = BlockIndex * KeysPerBlock;
+
+		PadTo(Entry.FileOffset);
+		Writer->Serialize(const_cast<FFrameNumber*>(&Times[FirstKey]), Entry.NumKeys * sizeof(FFrameNumber));
+
+		PadTo(Entry.FileOffset + GetValuesOffset(Entry.NumKeys));
+		Writer->Serialize(const_cast<FMovieSceneDoubleValue*>(&Values[FirstKey]), Entry.NumKeys * sizeof(FMovieSceneDoubleValue));
+	}
+
+	if (NumBlocks > 0)
+	{
+		PadTo(FileOffset);
+	}
+
+	return Writer->Close() && !Writer->IsError();
+}
+
+TUniquePtr<FStreamedDoubleChannelData> FStreamedDoubleChannelData::Open(const TCHAR* Filename)
+{
+	using namespace StreamedChannelData;
+
+	TUniquePtr<IMappedFileHandle> FileHandle(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(Filename));
+	if (!FileHandle || FileHandle->GetFileSize() < int64(sizeof(FHeader)))
+	{
+		return nullptr;
+	}
+
+	// Read the header and block index, which are small enough to always remain in memory
+	FHeader Header;
+	{
+		TUniquePtr<IMappedFileRegion> HeaderRegion(FileHandle->MapRegion(0, sizeof(FHeader)));
+		if (!HeaderRegion)
+		{
+			return nullptr;
+		}
+		FMemory::Memcpy(&Header, HeaderRegion->GetMappedPtr(), sizeof(FHeader));
+	}
+
+	if (Header.Magic != Magic || Header.Version != Version || Header.SizeOfValue != sizeof(FMovieSceneDoubleValue))
+	{
+		UE_LOG(LogMovieScene, Warning, TEXT("%s is not a compatible streamed channel file."), Filename);
+		return nullptr;
+	}
+
+	const int64 IndexSize = int64(Header.NumBlocks) * sizeof(FBlockEntry);
+	if (Header.NumBlocks < 0 || int64(sizeof(FHeader)) + IndexSize > FileHandle->GetFileSize())
+	{
+		UE_LOG(LogMovieScene, Warning, TEXT("%s is truncated or corrupt."), Filename);
+		return nullptr;
+	}
+
+	TUniquePtr<FStreamedDoubleChannelData> Data(new FStreamedDoubleChannelData());
+	Data->NumKeys            = Header.NumKeys;
+	Data->TickResolution     = FFrameRate(Header.TickResolutionNumerator, Header.TickResolutionDenominator);
+	Data->PreInfinityExtrap  = static_cast<ERichCurveExtrapolation>(Header.PreInfinityExtrap);
+	Data->PostInfinityExtrap = static_cast<ERichCurveExtrapolation>(Header.PostInfinityExtrap);
+	Data->bHasDefaultValue   = Header.bHasDefaultValue != 0;
+	Data->DefaultValue       = Header.DefaultValue;
+	Data->FirstValue         = Header.FirstValue;
+	Data->LastValue          = Header.LastValue;
+
+	if (Header.NumBlocks > 0)
+	{
+		TUniquePtr<IMappedFileRegion> IndexRegion(FileHandle->MapRegion(sizeof(FHeader), IndexSize));
+		if (!IndexRegion)
+		{
+			return nullptr;
+		}
+
+		Data->Blocks.SetNumUninitialized(Header.NumBlocks);
+		FMemory::Memcpy(Data->Blocks.GetData(), IndexRegion->GetMappedPtr(), IndexSize);
+
+		for (const FBlockEntry& Entry : Data->Blocks)
+		{
+			if (Entry.NumKeys <= 0 || Entry.FileOffset + StreamedChannelData::GetBlockSize(Entry.NumKeys) > FileHandle->GetFileSize())
+			{
+				UE_LOG(LogMovieScene, Warning, TEXT("%s is truncated or corrupt."), Filename);
+				return nullptr;
+			}
+		}
+	}
+
+	Data->BlockRegions.SetNum(Header.NumBlocks);
+	Data->BlockStates = MakeUnique<FBlockState[]>(Header.NumBlocks);
+	Data->FileHandle = MoveTemp(FileHandle);
+	return Data;
+}
+
+int64 FStreamedDoubleChannelData::GetBlockSize(int32 BlockIndex) const
+{
+	return StreamedChannelData::GetBlockSize(Blocks[BlockIndex].NumKeys);
+}
+
+int32 FStreamedDoubleChannelData::FindBlock(FFrameTime InTime) const
+{
+	// Find the last block that starts at or before the time. Blocks share their boundary keys, so a time that lies
+	// exactly on a boundary is evaluated using the later block.
+	const int32 BlockIndex = Algo::UpperBoundBy(Blocks, InTime.FrameNumber, &FBlockEntry::FirstTime) - 1;
+	return FMath::Clamp(BlockIndex, 0, Blocks.Num() - 1);
+}
+
+void FStreamedDoubleChannelData::MapBlock(int32 BlockIndex, bool bPreload) const
+{
+	if (BlockRegions[BlockIndex])
+	{
+		return;
+	}
+
+	IMappedFileRegion* Region = FileHandle->MapRegion(Blocks[BlockIndex].FileOffset, GetBlockSize(BlockIndex), bPreload ? EMappedFileFlags::EPreloadHint : EMappedFileFlags::ENone);
+	if (ensureMsgf(Region, TEXT("Failed to map streamed channel block %d"), BlockIndex))
+	{
+		BlockRegions[BlockIndex].Reset(Region);
+		ResidentBlocks.Add(BlockIndex);
+
+		BlockStates[BlockIndex].MappedData.store(Region->GetMappedPtr());
+	}
+}
+
+void FStreamedDoubleChannelData::UnmapBlock(int32 BlockIndex) const
+{
+	// Lock-free readers increment their reader count before loading the mapped data, and this clears the mapped data before
+	// checking the reader count, so any reader that has not been seen by ReleaseRetiredRegions is guaranteed to see null
+	BlockStates[BlockIndex].MappedData.store(nullptr);
+	RetiredRegions.Emplace(BlockIndex, MoveTemp(BlockRegions[BlockIndex]));
+}
+
+void FStreamedDoubleChannelData::ReleaseRetiredRegions() const
+{
+	for (int32 Index = RetiredRegions.Num() - 1; Index >= 0; --Index)
+	{
+		if (BlockStates[RetiredRegions[Index].Key].NumReaders.load() == 0)
+		{
+			RetiredRegions.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		}
+	}
+}
+
+FStreamedDoubleChannelBlockView FStreamedDoubleChannelData::MakeBlockResident(int32 BlockIndex) const
+{
+	const int32 PreviousBlock = CurrentBlock.load(std::memory_order_relaxed);
+	if (BlockIndex != PreviousBlock)
+	{
+		if (PreviousBlock != INDEX_NONE)
+		{
+			PlaybackDirection = BlockIndex >= PreviousBlock ? 1 : -1;
+		}
+
+		const int32 WindowStart = PlaybackDirection > 0 ? BlockIndex - NumBlocksBehind : BlockIndex - NumBlocksAhead;
+		const int32 WindowEnd   = PlaybackDirection > 0 ? BlockIndex + NumBlocksAhead  : BlockIndex + NumBlocksBehind;
+
+		// Unmap anything that has fallen outside of the window
+		for (int32 Index = ResidentBlocks.Num() - 1; Index >= 0; --Index)
+		{
+			const int32 ResidentBlock = ResidentBlocks[Index];
+			if (ResidentBlock < WindowStart || ResidentBlock > WindowEnd)
+			{
+				UnmapBlock(ResidentBlock);
+				ResidentBlocks.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			}
+		}
+		ReleaseRetiredRegions();
+
+		MapBlock(BlockIndex, false);
+
+		// Prefetch blocks in the direction of playback
+		for (int32 Offset = 1; Offset <= NumBlocksAhead; ++Offset)
+		{
+			const int32 PrefetchBlock = BlockIndex + Offset * PlaybackDirection;
+			if (Blocks.IsValidIndex(PrefetchBlock))
+			{
+				MapBlock(PrefetchBlock, true);
+			}
+		}
+
+		// Only publish the new current block once it is mapped
+		CurrentBlock.store(BlockIndex, std::memory_order_relaxed);
+	}
+
+	const IMappedFileRegion* Region = BlockRegions[BlockIndex].Get();
+	check(Region);
+
+	return MakeBlockView(BlockIndex, Region->GetMappedPtr());
+}
+
+FStreamedDoubleChannelBlockView FStreamedDoubleChannelData::MakeBlockView(int32 BlockIndex, const uint8* BlockData) const
+{
+	const FBlockEntry& Entry = Blocks[BlockIndex];
+
+	FStreamedDoubleChannelBlockView View;
+	View.Times              = MakeArrayView(reinterpret_cast<const FFrameNumber*>(BlockData), Entry.NumKeys);
+	View.Values             = MakeArrayView(reinterpret_cast<const FMovieSceneDoubleValue*>(BlockData + StreamedChannelData::GetValuesOffset(Entry.NumKeys)), Entry.NumKeys);
+	View.TickResolution     = TickResolution;
+	View.PreInfinityExtrap  = PreInfinityExtrap;
+	View.PostInfinityExtrap = PostInfinityExtrap;
+	return View;
+}
+
+Interpolation::FCachedInterpolation FStreamedDoubleChannelData::GetInterpolationForTime(FFrameTime InTime) const
+{
+	using namespace UE::MovieScene::Interpolation;
+
+	if (NumKeys == 0)
+	{
+		return bHasDefaultValue
+			? FCachedInterpolation(FCachedInterpolationRange::Infinite(), FConstantValue(0, DefaultValue))
+			: FCachedInterpolation();
+	}
+
+	const FCycleParams Params = ComputeCycleParams(InTime);
+	const int32 BlockIndex = FindBlock(Params.Time);
+
+	// Evaluating within the current block does not change the streaming window, so it can read the mapped data without
+	// taking the lock provided that the block is not unmapped while it is being read
+	if (BlockIndex == CurrentBlock.load(std::memory_order_relaxed))
+	{
+		FBlockState& State = BlockStates[BlockIndex];
+
+		State.NumReaders.fetch_add(1);
+		if (const uint8* BlockData = State.MappedData.load())
+		{
+			FCachedInterpolation Result = GetInterpolationForBlock(InTime, Params, MakeBlockView(BlockIndex, BlockData));
+			State.NumReaders.fetch_sub(1);
+			return Result;
+		}
+		State.NumReaders.fetch_sub(1);
+	}
+
+	FScopeLock Lock(&CriticalSection);
+	return GetInterpolationForBlock(InTime, Params, MakeBlockResident(BlockIndex));
+}
+
+FCycleParams FStreamedDoubleChannelData::ComputeCycleParams(FFrameTime InTime) const
+{
+	const FFrameNumber MinFrame = Blocks[0].FirstTime;
+	const FFrameNumber MaxFrame = Blocks.Last().LastTime;
+
+	const bool bBeforeFirstKey = InTime < FFrameTime(MinFrame);
+	const bool bAfterLastKey   = InTime > FFrameTime(MaxFrame);
+	if (!bBeforeFirstKey && !bAfterLastKey)
+	{
+		return FCycleParams(InTime, 0);
+	}
+
+	// Constant and linear extrapolation are computed from the first or last block directly. Everything else cycles, matching FMovieSceneDoubleChannel.
+	const ERichCurveExtrapolation Extrapolation = bBeforeFirstKey ? PreInfinityExtrap : PostInfinityExtrap;
+	if (Extrapolation == RCCE_Constant || Extrapolation == RCCE_Linear)
+	{
+		return FCycleParams(InTime, 0);
+	}
+
+	FCycleParams Params = CycleTime(MinFrame, MaxFrame, InTime);
+	if (Extrapolation == RCCE_CycleWithOffset)
+	{
+		if (bBeforeFirstKey)
+		{
+			Params.ComputePreValueOffset(FirstValue, LastValue);
+		}
+		else
+		{
+			Params.ComputePostValueOffset(FirstValue, LastValue);
+		}
+	}
+	else if (Extrapolation == RCCE_Oscillate)
+	{
+		Params.Oscillate(MinFrame.Value, MaxFrame.Value);
+	}
+	return Params;
+}
+
+Interpolation::FCachedInterpolation FStreamedDoubleChannelData::GetInterpolationForBlock(FFrameTime InTime, const FCycleParams& Params, const FStreamedDoubleChannelBlockView& View) const
+{
+	using namespace UE::MovieScene::Interpolation;
+	using FImpl = TMovieSceneCurveChannelImpl<FStreamedDoubleChannelBlockView>;
+
+	if (NumKeys == 1)
+	{
+		return FCachedInterpolation(FCachedInterpolationRange::Infinite(), FConstantValue(View.Times[0], View.Values[0].Value));
+	}
+
+	// For constant and linear extrapolation the first or last block is resident and contains at least two keys, so extrapolation can be
+	// computed exactly as the channel would. Cycling extrapolation modes are not cached here, and are evaluated from the cycled time below.
+	{
+		FCachedInterpolation Extrapolated;
+		if (FImpl::CacheExtrapolation(&View, InTime, Extrapolated))
+		{
+			return Extrapolated;
+		}
+	}
+
+	// Evaluating directly on the last key only caches that single frame, matching FMovieSceneDoubleChannel
+	if (Params.Time.FrameNumber >= View.Times.Last())
+	{
+		return FCachedInterpolation(FCachedInterpolationRange::Only(Params.Time.GetFrame()), FConstantValue(View.Times.Last(), Params.ValueOffset + View.Values.Last().Value));
+	}
+
+	const int32 Index1 = Algo::UpperBound(View.Times, Params.Time.FrameNumber) - 1;
+	if (!Params.ShouldMirrorCurve())
+	{
+		return FImpl::GetInterpolationForKey(&View, Index1, Index1 + 1, &Params);
+	}
+
+	// Oscillating cycles are mirrored about the first and last times of the view, which for a block are not those of the whole channel.
+	// Fold the difference into the cycle offset so that the keys are mirrored about the bounds of the channel instead.
+	const int64 MirrorOffset = int64(Blocks[0].FirstTime.Value) + int64(Blocks.Last().LastTime.Value) - int64(View.Times[0].Value) - int64(View.Times.Last().Value);
+
+	FCycleParams BlockParams = Params;
+	BlockParams.CycleCount = 1;
+	BlockParams.Duration   = static_cast<int32>(int64(Params.CycleCount) * int64(Params.Duration) + MirrorOffset);
+	return FImpl::GetInterpolationForKey(&View, Index1, Index1 + 1, &BlockParams);
+}
+
+bool FStreamedDoubleChannelData::Evaluate(FFrameTime InTime, double& OutValue) const
+{
+	return GetInterpolationForTime(InTime).Evaluate(InTime, OutValue);
+}
+
+void FStreamedDoubleChannelData::SetStreamingWindow(int32 InNumBlocksBehind, int32 InNumBlocksAhead)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	NumBlocksBehind = FMath::Max(InNumBlocksBehind, 0);
+	NumBlocksAhead  = FMath::Max(InNumBlocksAhead, 0);
+
+	// Force the window to be recomputed on the next evaluation
+	CurrentBlock.store(INDEX_NONE, std::memory_order_relaxed);
+}
+
+void FStreamedDoubleChannelData::ReleaseResidentBlocks()
+{
+	FScopeLock Lock(&CriticalSection);
+
+	CurrentBlock.store(INDEX_NONE, std::memory_order_relaxed);
+
+	for (int32 ResidentBlock : ResidentBlocks)
+	{
+		UnmapBlock(ResidentBlock);
+	}
+	ResidentBlocks.Reset();
+	ReleaseRetiredRegions();
+}
+
+int32 FStreamedDoubleChannelData::GetNumResidentBlocks() const
+{
+	FScopeLock Lock(&CriticalSection);
+	return ResidentBlocks.Num();
+}
+
+} // namespace MovieScene
+} // namespace UE
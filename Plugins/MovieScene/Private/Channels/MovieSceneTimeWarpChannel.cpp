@@ -1,9 +1,95 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Channels/MovieSceneTimeWarpChannel.h"
+#include "Channels/MovieSceneCurveInverseLookupTable.h"
+#include "MovieSceneTransformTypes.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(MovieSceneTimeWarpChannel)
 
+TOptional<FFrameTime> FMovieSceneTimeWarpChannel::InverseEvaluate(double Value, FFrameTime TimeHint, UE::MovieScene::EInverseEvaluateFlags Flags) const
+{
+	const UE::MovieScene::FCurveInverseLookupTable* LookupTable = InverseLookupTable.IsValid() && InverseLookupTable->IsValidFor(*this) ? InverseLookupTable.Get() : nullptr;
+	return FMovieSceneDoubleChannel::InverseEvaluate(Value, TimeHint, Flags, LookupTable);
+}
+
+bool FMovieSceneTimeWarpChannel::InverseEvaluateBetween(double Value, FFrameTime StartTime, FFrameTime EndTime, const TFunctionRef<bool(FFrameTime)>& Visitor) const
+{
+	const UE::MovieScene::FCurveInverseLookupTable* LookupTable = InverseLookupTable.IsValid() && InverseLookupTable->IsValidFor(*this) ? InverseLookupTable.Get() : nullptr;
+	return FMovieSceneDoubleChannel::InverseEvaluateBetween(Value, StartTime, EndTime, LookupTable, Visitor);
+}
+
+void FMovieSceneTimeWarpChannel::UpdateInverseLookupTable()
+{
+	// Play-rate channels are inverted through their integral rather than directly
+	if (Domain == UE::MovieScene::ETimeWarpChannelDomain::Time)
+	{
+		InverseLookupTable = UE::MovieScene::FCurveInverseLookupTable::Build(*this);
+	}
+	else
+	{
+		InverseLookupTable = nullptr;
+	}
+}
+
+void FMovieSceneTimeWarpChannel::InvalidateInverseLookupTable()
+{
+	InverseLookupTable = nullptr;
+}
+
+void FMovieSceneTimeWarpChannel::SetKeyTimes(TArrayView<const FKeyHandle> InHandles, TArrayView<const FFrameNumber> InKeyTimes)
+{
+	FMovieSceneDoubleChannel::SetKeyTimes(InHandles, InKeyTimes);
+	UpdateInverseLookupTable();
+}
+
+void FMovieSceneTimeWarpChannel::DuplicateKeys(TArrayView<const FKeyHandle> InHandles, TArrayView<FKeyHandle> OutNewHandles)
+{
+	FMovieSceneDoubleChannel::DuplicateKeys(InHandles, OutNewHandles);
+	UpdateInverseLookupTable();
+}
+
+void FMovieSceneTimeWarpChannel::DeleteKeys(TArrayView<const FKeyHandle> InHandles)
+{
+	FMovieSceneDoubleChannel::DeleteKeys(InHandles);
+	UpdateInverseLookupTable();
+}
+
+void FMovieSceneTimeWarpChannel::DeleteKeysFrom(FFrameNumber InTime, bool bDeleteKeysBefore)
+{
+	FMovieSceneDoubleChannel::DeleteKeysFrom(InTime, bDeleteKeysBefore);
+	UpdateInverseLookupTable();
+}
+
+void FMovieSceneTimeWarpChannel::RemapTimes(const UE::MovieScene::IRetimingInterface& Retimer)
+{
+	FMovieSceneDoubleChannel::RemapTimes(Retimer);
+	UpdateInverseLookupTable();
+}
+
+void FMovieSceneTimeWarpChannel::Reset()
+{
+	FMovieSceneDoubleChannel::Reset();
+	InvalidateInverseLookupTable();
+}
+
+void FMovieSceneTimeWarpChannel::Offset(FFrameNumber DeltaPosition)
+{
+	FMovieSceneDoubleChannel::Offset(DeltaPosition);
+	UpdateInverseLookupTable();
+}
+
+void FMovieSceneTimeWarpChannel::Optimize(const FKeyDataOptimizationParams& InParameters)
+{
+	FMovieSceneDoubleChannel::Optimize(InParameters);
+	UpdateInverseLookupTable();
+}
+
+void FMovieSceneTimeWarpChannel::PostEditChange()
+{
+	FMovieSceneDoubleChannel::PostEditChange();
+	UpdateInverseLookupTable();
+}
+
 void Dilate(FMovieSceneTimeWarpChannel* InChannel, FFrameNumber Origin, double DilationFactor)
 {
 	if (InChannel->Domain == UE::MovieScene::ETimeWarpChannelDomain::PlayRate)
@@ -17,4 +103,6 @@ void Dilate(FMovieSceneTimeWarpChannel* InChannel, FFrameNumber Origin, double D
 
 	// The default implementation dilates the keytimes
 	Dilate(static_cast<FMovieSceneDoubleChannel*>(InChannel), Origin, DilationFactor);
+
+	InChannel->UpdateInverseLookupTable();
 }
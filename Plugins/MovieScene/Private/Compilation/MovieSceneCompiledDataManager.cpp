@@ -503,6 +503,7 @@ UMovieSceneCompiledDataManager::UMovieSceneCompiledDataManager()
 					this->TrackTemplates.Remove(DataID.Value);
 					this->TrackTemplateFields.Remove(DataID.Value);
 					this->EntityComponentFields.Remove(DataID.Value);
+					this->RootDeterminismTables.Remove(DataID.Value);
 
 					++this->ReallocationVersion;
 				}
@@ -552,6 +553,7 @@ void UMovieSceneCompiledDataManager::DestroyAllData()
 	TrackTemplates.Empty();
 	TrackTemplateFields.Empty();
 	EntityComponentFields.Empty();
+	RootDeterminismTables.Empty();
 }
 
 void UMovieSceneCompiledDataManager::ConsoleVariableSink()
@@ -787,6 +789,7 @@ void UMovieSceneCompiledDataManager::DestroyData(FMovieSceneCompiledDataID DataI
 	TrackTemplates.Remove(DataID.Value);
 	TrackTemplateFields.Remove(DataID.Value);
 	EntityComponentFields.Remove(DataID.Value);
+	RootDeterminismTables.Remove(DataID.Value);
 
 	CompiledDataEntries.RemoveAt(DataID.Value);
 }
@@ -1085,6 +1088,91 @@ void UMovieSceneCompiledDataManager::Compile(FMovieSceneCompiledDataID DataID, U
 }
 
 
+const UE::MovieScene::FRootDeterminismTable& UMovieSceneCompiledDataManager::GetRootDeterminismTable(FMovieSceneCompiledDataID DataID)
+{
+	check(DataID.IsValid() && CompiledDataEntries.IsValidIndex(DataID.Value));
+
+	// Any (re)compilation of this sequence or its sub sequences increments the reallocation version, which invalidates the table
+	UE::MovieScene::FRootDeterminismTable& Table = RootDeterminismTables.FindOrAdd(DataID.Value);
+	if (!Table.bIsValid || Table.ReallocationVersion != ReallocationVersion)
+	{
+		BuildRootDeterminismTable(DataID, &Table);
+	}
+	return Table;
+}
+
+void UMovieSceneCompiledDataManager::BuildRootDeterminismTable(FMovieSceneCompiledDataID DataID, UE::MovieScene::FRootDeterminismTable* OutTable) const
+{
+	using namespace UE::MovieScene;
+
+	OutTable->Fences.Reset();
+	OutTable->DynamicRanges.Reset();
+	OutTable->ReallocationVersion = ReallocationVersion;
+	OutTable->bIsValid = true;
+
+	for (const FMovieSceneDeterminismFence& Fence : CompiledDataEntries[DataID.Value].DeterminismFences)
+	{
+		OutTable->Fences.Add(FMovieSceneDeterminismFenceWithSubframe{ Fence.FrameNumber, Fence.bInclusive });
+	}
+
+	if (const FMovieSceneSequenceHierarchy* Hierarchy = FindHierarchy(DataID))
+	{
+		for (FMovieSceneEvaluationTreeRangeIterator SubSequenceIt(Hierarchy->GetTree()); SubSequenceIt; ++SubSequenceIt)
+		{
+			const TRange<FFrameNumber> RootRange = SubSequenceIt.Range();
+			const TRange<FFrameTime>   RootTimeRange = ConvertToFrameTimeRange(RootRange);
+
+			for (const FMovieSceneSubSequenceTreeEntry& Entry : Hierarchy->GetTree().GetAllData(SubSequenceIt.Node()))
+			{
+				const FMovieSceneSubSequenceData* SubData = Hierarchy->FindSubData(Entry.SequenceID);
+				checkf(SubData, TEXT("Sub data does not exist for a SequenceID that exists in the hierarchical tree - this indicates a corrupt compilation product."));
+
+				UMovieSceneSequence*      SubSequence = SubData->GetSequence();
+				FMovieSceneCompiledDataID SubDataID   = SubSequence ? FindDataID(SubSequence) : FMovieSceneCompiledDataID();
+				if (!SubDataID.IsValid())
+				{
+					continue;
+				}
+
+				const TArray<FMovieSceneDeterminismFence>& SubDeterminismFences = CompiledDataEntries[SubDataID.Value].DeterminismFences;
+				if (SubDeterminismFences.Num() == 0)
+				{
+					continue;
+				}
+
+				// Time-warped or looping sub sequences can map the same fence to many (or no) root times depending on the evaluated range,
+				// so these are left to be transformed at runtime within this range only
+				const bool bCanFlatten = SubData->RootToSequenceTransform.IsLinear() && !FMath::IsNearlyZero(SubData->RootToSequenceTransform.AsLinear().TimeScale);
+				if (!bCanFlatten)
+				{
+					OutTable->DynamicRanges.Add(FRootDeterminismTable::FDynamicRange{ RootRange, Entry.SequenceID });
+					continue;
+				}
+
+				const FMovieSceneTimeTransform InverseTransform = SubData->RootToSequenceTransform.AsLinear().Inverse();
+				for (const FMovieSceneDeterminismFence& Fence : SubDeterminismFences)
+				{
+					const FFrameTime RootTime = FFrameTime(Fence.FrameNumber) * InverseTransform;
+					if (RootTimeRange.Contains(RootTime))
+					{
+						OutTable->Fences.Add(FMovieSceneDeterminismFenceWithSubframe{ RootTime, Fence.bInclusive });
+					}
+				}
+			}
+		}
+	}
+
+	if (OutTable->Fences.Num() > 0)
+	{
+		Algo::SortBy(OutTable->Fences, &FMovieSceneDeterminismFenceWithSubframe::FrameTime);
+		const int32 NewNum = Algo::UniqueBy(OutTable->Fences, &FMovieSceneDeterminismFenceWithSubframe::FrameTime);
+		if (NewNum != OutTable->Fences.Num())
+		{
+			OutTable->Fences.SetNum(NewNum);
+		}
+	}
+}
+
 void UMovieSceneCompiledDataManager::Gather(const FMovieSceneCompiledDataEntry& Entry, UMovieSceneSequence* Sequence, const FTrackGatherParameters& Params, FMovieSceneGatheredCompilerData* OutCompilerData) const
 {
 	const FMovieSceneEvaluationTemplate* TrackTemplate = FindTrackTemplate(Entry.DataID);
@@ -430,6 +430,7 @@ FBuiltInComponentTypes::FBuiltInComponentTypes()
 	Tags.SectionPreRoll          = ComponentRegistry->NewTag(TEXT("Section Pre Roll"));
 	Tags.AlwaysCacheInitialValue = ComponentRegistry->NewTag(TEXT("Always Cache Initial Value"), EComponentTypeFlags::CopyToOutput);
 	Tags.OldStyleSpawnable       = ComponentRegistry->NewTag(TEXT("Old Style Spawnable"));
+	Tags.SkipUnchangedPropertyValues = ComponentRegistry->NewTag(TEXT("Skip Unchanged Property Values"), EComponentTypeFlags::CopyToOutput);
 	Tags.ExternalBlending        = ComponentRegistry->NewTag(TEXT("External Blending"));
 
 	SymbolicTags.CreatesEntities = ComponentRegistry->NewTag(TEXT("~~ SYMBOLIC ~~ Creates Entities"));
@@ -461,6 +462,7 @@ FBuiltInComponentTypes::FBuiltInComponentTypes()
 	ComponentRegistry->Factories.DefineChildComponent(Tags.PreRoll,       Tags.PreRoll);
 	ComponentRegistry->Factories.DefineChildComponent(Tags.SectionPreRoll,Tags.SectionPreRoll);
 	ComponentRegistry->Factories.DefineChildComponent(Tags.AlwaysCacheInitialValue,Tags.AlwaysCacheInitialValue);
+	ComponentRegistry->Factories.DefineChildComponent(Tags.SkipUnchangedPropertyValues,Tags.SkipUnchangedPropertyValues);
 
 	ComponentRegistry->Factories.DefineMutuallyInclusiveComponent(Tags.SectionPreRoll,Tags.PreRoll);
 
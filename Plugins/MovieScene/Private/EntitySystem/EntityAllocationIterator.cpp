@@ -12,15 +12,20 @@ namespace MovieScene
 
 FEntityAllocationIterator::FEntityAllocationIterator(const FEntityManager* InManager)
 	: Filter(nullptr)
+	, MatchingAllocations(nullptr)
+	, NextMatchingAllocation(0)
 	, Manager(InManager)
 	, AllocationIndex(Manager->EntityAllocationMasks.GetMaxIndex())
 {}
 
 FEntityAllocationIterator::FEntityAllocationIterator(const FEntityManager* InManager, const FEntityComponentFilter* InFilter)
 	: Filter(InFilter)
+	, MatchingAllocations(nullptr)
+	, NextMatchingAllocation(0)
 	, Manager(InManager)
 {
 	Manager->EnterIteration();
+	MatchingAllocations = Manager->FindMatchingAllocations(*Filter);
 	AllocationIndex = FindMatchingAllocationStartingAt(0);
 }
 
@@ -33,6 +38,8 @@ FEntityAllocationIterator& FEntityAllocationIterator::operator=(FEntityAllocatio
 {
 	Manager = RHS.Manager;
 	Filter = RHS.Filter;
+	MatchingAllocations = RHS.MatchingAllocations;
+	NextMatchingAllocation = RHS.NextMatchingAllocation;
 	AllocationIndex = RHS.AllocationIndex;
 
 	// Wipe out the filter so it doesn't decrement the iteration count on destruction
@@ -66,8 +73,22 @@ FEntityAllocationIteratorItem FEntityAllocationIterator::operator*() const
 }
 
 
-int32 FEntityAllocationIterator::FindMatchingAllocationStartingAt(int32 Index) const
+int32 FEntityAllocationIterator::FindMatchingAllocationStartingAt(int32 Index)
 {
+	if (MatchingAllocations)
+	{
+		// Cached allocations already match the filter, so only need to be checked for being empty
+		while (NextMatchingAllocation < MatchingAllocations->Num())
+		{
+			const int32 MatchIndex = (*MatchingAllocations)[NextMatchingAllocation++];
+			if (MatchIndex >= Index && Manager->EntityAllocations.IsAllocated(MatchIndex) && Manager->EntityAllocations[MatchIndex]->Num() > 0)
+			{
+				return MatchIndex;
+			}
+		}
+		return Manager->EntityAllocationMasks.GetMaxIndex();
+	}
+
 	const FEntityComponentFilter& GlobalIterationFilter = Manager->GetGlobalIterationFilter();
 	const bool bHasGlobalFilter = GlobalIterationFilter.IsValid();
 	for ( ; Index < Manager->EntityAllocationMasks.GetMaxIndex(); ++Index)
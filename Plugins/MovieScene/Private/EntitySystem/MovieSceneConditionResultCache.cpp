@@ -0,0 +1,171 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EntitySystem/MovieSceneConditionResultCache.h"
+#include "EntitySystem/MovieSceneSharedPlaybackState.h"
+#include "Conditions/MovieSceneCondition.h"
+#include "CoreGlobals.h"
+
+namespace UE
+{
+namespace MovieScene
+{
+
+FConditionResultKey FConditionResultCache::MakeKey(const UMovieSceneCondition* Condition, const FGuid& BindingID, FMovieSceneSequenceID SequenceID, TSharedRef<const FSharedPlaybackState> SharedPlaybackState, UObject* EntityOwner, bool bCanCacheResult)
+{
+	check(Condition);
+
+	FConditionResultKey Key;
+	Key.ConditionHash = Condition->ComputeCacheKey(BindingID, SequenceID, SharedPlaybackState, EntityOwner);
+	Key.RootInstanceHandle = SharedPlaybackState->GetRootInstanceHandle();
+
+	const bool bGlobalCondition = Condition->GetConditionScope() == EMovieSceneConditionScope::Global;
+	if (bGlobalCondition)
+	{
+		// Global conditions are shared between instances, but may still depend on the world they are evaluated within
+		Key.ConditionHash = HashCombineFast(Key.ConditionHash, GetTypeHash(SharedPlaybackState->GetPlaybackContext()));
+	}
+
+	if (!bCanCacheResult)
+	{
+		Key.Scope = EConditionResultScope::PerFrame;
+		if (!bGlobalCondition)
+		{
+			// Per-frame results for binding or owner scoped conditions are only valid for the instance that evaluated them
+			Key.ConditionHash = HashCombineFast(Key.ConditionHash, GetTypeHash(Key.RootInstanceHandle));
+		}
+	}
+	else
+	{
+		Key.Scope = bGlobalCondition ? EConditionResultScope::Global : EConditionResultScope::PerInstance;
+	}
+
+	return Key;
+}
+
+const bool* FConditionResultCache::Find(const FConditionResultKey& Key) const
+{
+	switch (Key.Scope)
+	{
+	case EConditionResultScope::Global:
+		if (const FGlobalResult* Result = GlobalResults.Find(Key.ConditionHash))
+		{
+			// Only share results that were computed since this instance last started or was invalidated.
+			// Instances that have never been seen before only trust results computed this frame.
+			const FInstanceResults* Instance = InstanceResults.Find(Key.RootInstanceHandle);
+			const uint64 ValidFromFrame = Instance ? Instance->ValidFromFrame : GFrameCounter;
+
+			if (Result->FrameNumber >= ValidFromFrame)
+			{
+				return &Result->bResult;
+			}
+		}
+		return nullptr;
+
+	case EConditionResultScope::PerInstance:
+		if (const FInstanceResults* Instance = InstanceResults.Find(Key.RootInstanceHandle))
+		{
+			return Instance->Results.Find(Key.ConditionHash);
+		}
+		return nullptr;
+
+	case EConditionResultScope::PerFrame:
+		// Per-frame results are only discarded lazily when adding, so ignore any left over from a previous frame
+		return CachedFrameNumber == GFrameCounter ? FrameResults.Find(Key.ConditionHash) : nullptr;
+	}
+
+	return nullptr;
+}
+
+void FConditionResultCache::Add(const FConditionResultKey& Key, bool bResult)
+{
+	switch (Key.Scope)
+	{
+	case EConditionResultScope::Global:
+		FindOrAddInstance(Key.RootInstanceHandle);
+		GlobalResults.Add(Key.ConditionHash, FGlobalResult{ GFrameCounter, bResult });
+		break;
+
+	case EConditionResultScope::PerInstance:
+		FindOrAddInstance(Key.RootInstanceHandle).Results.Add(Key.ConditionHash, bResult);
+		break;
+
+	case EConditionResultScope::PerFrame:
+		UpdateFrame();
+		FrameResults.Add(Key.ConditionHash, bResult);
+		break;
+	}
+}
+
+bool FConditionResultCache::FindOrEvaluate(const FConditionResultKey& Key, const UMovieSceneCondition* Condition, const FGuid& BindingID, FMovieSceneSequenceID SequenceID, TSharedRef<const FSharedPlaybackState> SharedPlaybackState)
+{
+	check(Condition);
+
+	// Start tracking the instance so that global results computed from now on remain valid for it on subsequent frames
+	if (Key.Scope == EConditionResultScope::Global)
+	{
+		FindOrAddInstance(Key.RootInstanceHandle);
+	}
+
+	if (const bool* CachedResult = Find(Key))
+	{
+		return *CachedResult;
+	}
+
+	const bool bResult = Condition->EvaluateCondition(BindingID, SequenceID, SharedPlaybackState);
+	Add(Key, bResult);
+	return bResult;
+}
+
+void FConditionResultCache::InvalidateInstance(FInstanceHandle RootInstanceHandle)
+{
+	FInstanceResults& Instance = FindOrAddInstance(RootInstanceHandle);
+	Instance.Results.Reset();
+	Instance.ValidFromFrame = GFrameCounter;
+}
+
+void FConditionResultCache::RemoveInstance(FInstanceHandle RootInstanceHandle)
+{
+	InstanceResults.Remove(RootInstanceHandle);
+}
+
+void FConditionResultCache::InvalidateFrame()
+{
+	FrameResults.Reset();
+}
+
+void FConditionResultCache::InvalidateGlobal()
+{
+	GlobalResults.Reset();
+}
+
+void FConditionResultCache::Reset()
+{
+	GlobalResults.Reset();
+	FrameResults.Reset();
+	InstanceResults.Reset();
+}
+
+void FConditionResultCache::UpdateFrame()
+{
+	if (CachedFrameNumber != GFrameCounter)
+	{
+		CachedFrameNumber = GFrameCounter;
+		FrameResults.Reset();
+	}
+}
+
+FConditionResultCache::FInstanceResults& FConditionResultCache::FindOrAddInstance(FInstanceHandle RootInstanceHandle)
+{
+	if (FInstanceResults* Existing = InstanceResults.Find(RootInstanceHandle))
+	{
+		return *Existing;
+	}
+
+	// Instances that have never been seen before only trust global results computed from this frame onwards
+	FInstanceResults& NewInstance = InstanceResults.Add(RootInstanceHandle);
+	NewInstance.ValidFromFrame = GFrameCounter;
+	return NewInstance;
+}
+
+} // namespace MovieScene
+} // namespace UE
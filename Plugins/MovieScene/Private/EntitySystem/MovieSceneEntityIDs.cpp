@@ -2,6 +2,8 @@
 
 #include "EntitySystem/MovieSceneEntityIDs.h"
 #include "EntitySystem/MovieSceneEntityManager.h"
+#include "Math/UnrealMathUtility.h"
+#include "Math/VectorRegister.h"
 
 namespace UE
 {
@@ -13,6 +15,135 @@ bool FEntityHandle::IsValid(const FEntityManager& InEntityManager) const
 	return InEntityManager.IsHandleValid(*this);
 }
 
+/** Number of mask DWORDs processed by each vector operation */
+static constexpr int32 NumMaskWordsPerVector = sizeof(VectorRegister4Int) / sizeof(uint32);
+
+/**
+ * Number of DWORDs that hold the specified number of bits. TBitArray guarantees that unused bits within the last
+ * DWORD are always zero, but DWORDs past this count may hold stale data from before the array was shrunk.
+ */
+static FORCEINLINE int32 NumMaskWords(int32 NumBits)
+{
+	return FMath::DivideAndRoundUp(NumBits, static_cast<int32>(NumBitsPerDWORD));
+}
+
+static FORCEINLINE bool IsVectorZero(const VectorRegister4Int& InVector)
+{
+	return VectorMaskBits(VectorCastIntToFloat(VectorIntCompareEQ(InVector, GlobalVectorConstants::IntZero))) == 0xF;
+}
+
+bool FComponentMask::ContainsAll(const FComponentMask& InComponentMask) const
+{
+	const uint32* TheseWords = Bits.GetData();
+	const uint32* OtherWords = InComponentMask.Bits.GetData();
+
+	const int32 NumOtherWords  = NumMaskWords(InComponentMask.Bits.Num());
+	const int32 NumCommonWords = FMath::Min(NumMaskWords(Bits.Num()), NumOtherWords);
+
+	// Accumulate (~This & Other) for all common words, which must be zero if every bit in Other is contained
+	int32 WordIndex = 0;
+	VectorRegister4Int Missing = GlobalVectorConstants::IntZero;
+	for ( ; WordIndex + NumMaskWordsPerVector <= NumCommonWords; WordIndex += NumMaskWordsPerVector)
+	{
+		Missing = VectorIntOr(Missing, VectorIntAndNot(VectorIntLoad(TheseWords + WordIndex), VectorIntLoad(OtherWords + WordIndex)));
+	}
+
+	if (!IsVectorZero(Missing))
+	{
+		return false;
+	}
+
+	for ( ; WordIndex < NumCommonWords; ++WordIndex)
+	{
+		if ((OtherWords[WordIndex] & ~TheseWords[WordIndex]) != 0)
+		{
+			return false;
+		}
+	}
+
+	// Any bits set past the end of this mask cannot be contained
+	for ( ; WordIndex < NumOtherWords; ++WordIndex)
+	{
+		if (OtherWords[WordIndex] != 0)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FComponentMask::ContainsAny(const FComponentMask& InComponentMask) const
+{
+	const uint32* TheseWords = Bits.GetData();
+	const uint32* OtherWords = InComponentMask.Bits.GetData();
+
+	const int32 NumCommonWords = FMath::Min(NumMaskWords(Bits.Num()), NumMaskWords(InComponentMask.Bits.Num()));
+
+	int32 WordIndex = 0;
+	VectorRegister4Int Common = GlobalVectorConstants::IntZero;
+	for ( ; WordIndex + NumMaskWordsPerVector <= NumCommonWords; WordIndex += NumMaskWordsPerVector)
+	{
+		Common = VectorIntOr(Common, VectorIntAnd(VectorIntLoad(TheseWords + WordIndex), VectorIntLoad(OtherWords + WordIndex)));
+	}
+
+	if (!IsVectorZero(Common))
+	{
+		return true;
+	}
+
+	for ( ; WordIndex < NumCommonWords; ++WordIndex)
+	{
+		if ((TheseWords[WordIndex] & OtherWords[WordIndex]) != 0)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool FComponentMask::ContainsExactlyOne(const FComponentMask& InComponentMask) const
+{
+	const uint32* TheseWords = Bits.GetData();
+	const uint32* OtherWords = InComponentMask.Bits.GetData();
+
+	const int32 NumCommonWords = FMath::Min(NumMaskWords(Bits.Num()), NumMaskWords(InComponentMask.Bits.Num()));
+
+	// Only vectors with any common bits need to be counted
+	int32 NumCommonBits = 0;
+	int32 WordIndex = 0;
+	for ( ; WordIndex + NumMaskWordsPerVector <= NumCommonWords; WordIndex += NumMaskWordsPerVector)
+	{
+		const VectorRegister4Int Common = VectorIntAnd(VectorIntLoad(TheseWords + WordIndex), VectorIntLoad(OtherWords + WordIndex));
+		if (!IsVectorZero(Common))
+		{
+			alignas(16) uint32 CommonWords[NumMaskWordsPerVector];
+			VectorIntStoreAligned(Common, CommonWords);
+
+			for (uint32 Word : CommonWords)
+			{
+				NumCommonBits += FMath::CountBits(Word);
+			}
+			if (NumCommonBits > 1)
+			{
+				return false;
+			}
+		}
+	}
+
+	for ( ; WordIndex < NumCommonWords; ++WordIndex)
+	{
+		NumCommonBits += FMath::CountBits(TheseWords[WordIndex] & OtherWords[WordIndex]);
+		if (NumCommonBits > 1)
+		{
+			return false;
+		}
+	}
+
+	return NumCommonBits == 1;
+}
+
 bool FComponentTypeIDFilter::Passes(const FComponentMask& Type) const
 {
 	FComponentTypeID ConditionComponent = GetComponentType();
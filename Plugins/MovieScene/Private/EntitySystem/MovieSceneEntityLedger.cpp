@@ -12,6 +12,9 @@
 
 #include "MovieSceneSection.h"
 
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
+
 namespace UE
 {
 namespace MovieScene
@@ -26,48 +29,129 @@ void FEntityLedger::UpdateEntities(UMovieSceneEntitySystemLinker* Linker, const
 
 void FEntityLedger::UpdateEntities(UMovieSceneEntitySystemLinker* Linker, const FEntityImportSequenceParams& ImportParams, const FMovieSceneEntityComponentField* EntityField, const FMovieSceneEvaluationFieldEntitySet& NewEntities, FMovieSceneEvaluationFieldEntitySet& OutConditionalEntities, TMap<uint32, bool>& ConditionResultCache)
 {
-	FInstanceRegistry* InstanceRegistry = Linker->GetInstanceRegistry();
-	if (NewEntities.Num() != 0)
+	if (NewEntities.Num() == 0)
 	{
-		// Destroy any entities that are no longer relevant
-		if (ImportedEntities.Num() != 0)
+		UnlinkEverything(Linker);
+
+		// Nothing is invalidated now
+		bInvalidated = false;
+		return;
+	}
+
+	DiffEntities(NewEntities);
+	CommitEntities(Linker, ImportParams, EntityField, OutConditionalEntities, ConditionResultCache);
+}
+
+void FEntityLedger::DiffEntities(const FMovieSceneEvaluationFieldEntitySet& NewEntities)
+{
+	// Sort the new entities by key hash so they can be merge-joined with our (already sorted) imported entities.
+	// This way only entities that actually differ between the two sets incur any entity-manager work.
+	SortedQueryScratch.Reset();
+	SortedQueryScratch.Reserve(NewEntities.Num());
+	for (const FMovieSceneEvaluationFieldEntityQuery& Query : NewEntities)
+	{
+		SortedQueryScratch.Add(FSortedEntityQuery{ GetTypeHash(Query.Entity.Key), &Query });
+	}
+	Algo::SortBy(SortedQueryScratch, &FSortedEntityQuery::KeyHash);
+
+	// Reserve up-front so that entries are never relocated while imports hold references to them
+	MergedEntityScratch.Reset();
+	MergedEntityScratch.Reserve(SortedQueryScratch.Num());
+	PendingImportScratch.Reset();
+	ExpiredEntityScratch.Reset();
+
+	const int32 NumOld = ImportedEntities.Num();
+	const int32 NumNew = SortedQueryScratch.Num();
+
+	int32 OldIndex = 0;
+	int32 NewIndex = 0;
+	while (OldIndex < NumOld || NewIndex < NumNew)
+	{
+		const uint32 OldHash = OldIndex < NumOld ? ImportedEntities[OldIndex].KeyHash : MAX_uint32;
+		const uint32 NewHash = NewIndex < NumNew ? SortedQueryScratch[NewIndex].KeyHash : MAX_uint32;
+
+		// Find the runs of entries in both arrays that share the lowest hash
+		const bool bOldValid = OldIndex < NumOld && (NewIndex >= NumNew || OldHash <= NewHash);
+		const bool bNewValid = NewIndex < NumNew && (OldIndex >= NumOld || NewHash <= OldHash);
+		const uint32 RunHash = bOldValid ? OldHash : NewHash;
+
+		int32 OldEnd = OldIndex;
+		while (bOldValid && OldEnd < NumOld && ImportedEntities[OldEnd].KeyHash == RunHash)
 		{
-			FComponentMask FinishedMask = FBuiltInComponentTypes::Get()->FinishedMask;
+			++OldEnd;
+		}
+		int32 NewEnd = NewIndex;
+		while (bNewValid && NewEnd < NumNew && SortedQueryScratch[NewEnd].KeyHash == RunHash)
+		{
+			++NewEnd;
+		}
 
-			for (auto It = ImportedEntities.CreateIterator(); It; ++It)
+		// Record any entities that are no longer relevant so they can be destroyed on commit
+		for (int32 OldRunIndex = OldIndex; OldRunIndex < OldEnd; ++OldRunIndex)
+		{
+			const FImportedEntityEntry& OldEntry = ImportedEntities[OldRunIndex];
+
+			bool bStillRelevant = false;
+			for (int32 NewRunIndex = NewIndex; NewRunIndex < NewEnd && !bStillRelevant; ++NewRunIndex)
 			{
-				if (!NewEntities.Contains(It.Key()))
-				{
-					if (It.Value().EntityID)
-					{
-						Linker->EntityManager.AddComponents(It.Value().EntityID, FinishedMask, EEntityRecursion::Full);
-					}
-					It.RemoveCurrent();
-				}
+				bStillRelevant = SortedQueryScratch[NewRunIndex].Query->Entity.Key == OldEntry.Key;
 			}
-		}
 
-		// If we've invalidated or we haven't imported anything yet, we can simply (re)import everything
-		if (ImportedEntities.Num() == 0 || bInvalidated)
-		{
-			for (const FMovieSceneEvaluationFieldEntityQuery& Query : NewEntities)
+			if (!bStillRelevant && OldEntry.Data.EntityID)
 			{
-				ImportEntity(Linker, ImportParams, EntityField, Query, OutConditionalEntities, ConditionResultCache);
+				ExpiredEntityScratch.Add(OldEntry.Data.EntityID);
 			}
 		}
-		else for (const FMovieSceneEvaluationFieldEntityQuery& Query : NewEntities)
+
+		// Carry over or add entries for all the new entities, recording those that need (re)importing
+		for (int32 NewRunIndex = NewIndex; NewRunIndex < NewEnd; ++NewRunIndex)
 		{
-			FImportedEntityData Existing = ImportedEntities.FindRef(Query.Entity.Key);
-			if (!Existing.EntityID || Existing.MetaDataIndex != Query.MetaDataIndex)
+			const FMovieSceneEvaluationFieldEntityQuery* Query = SortedQueryScratch[NewRunIndex].Query;
+
+			const FImportedEntityEntry* Existing = nullptr;
+			for (int32 OldRunIndex = OldIndex; OldRunIndex < OldEnd && !Existing; ++OldRunIndex)
+			{
+				if (ImportedEntities[OldRunIndex].Key == Query->Entity.Key)
+				{
+					Existing = &ImportedEntities[OldRunIndex];
+				}
+			}
+
+			const int32 MergedIndex = Existing
+				? MergedEntityScratch.Add(*Existing)
+				: MergedEntityScratch.Add(FImportedEntityEntry{ Query->Entity.Key, RunHash, FImportedEntityData{} });
+
+			// If we've invalidated we simply re-import everything
+			const FImportedEntityData& Data = MergedEntityScratch[MergedIndex].Data;
+			if (bInvalidated || !Data.EntityID || Data.MetaDataIndex != Query->MetaDataIndex)
 			{
-				ImportEntity(Linker, ImportParams, EntityField, Query, OutConditionalEntities, ConditionResultCache);
+				PendingImportScratch.Emplace(MergedIndex, Query);
 			}
 		}
+
+		OldIndex = OldEnd;
+		NewIndex = NewEnd;
+	}
+}
+
+void FEntityLedger::CommitEntities(UMovieSceneEntitySystemLinker* Linker, const FEntityImportSequenceParams& ImportParams, const FMovieSceneEntityComponentField* EntityField, FMovieSceneEvaluationFieldEntitySet& OutConditionalEntities, TMap<uint32, bool>& ConditionResultCache)
+{
+	// Destroy any entities that are no longer relevant
+	FComponentMask FinishedMask = FBuiltInComponentTypes::Get()->FinishedMask;
+	for (FMovieSceneEntityID ExpiredEntityID : ExpiredEntityScratch)
+	{
+		Linker->EntityManager.AddComponents(ExpiredEntityID, FinishedMask, EEntityRecursion::Full);
 	}
-	else
+	ExpiredEntityScratch.Reset();
+
+	Swap(ImportedEntities, MergedEntityScratch);
+	MergedEntityScratch.Reset();
+
+	for (const TPair<int32, const FMovieSceneEvaluationFieldEntityQuery*>& PendingImport : PendingImportScratch)
 	{
-		UnlinkEverything(Linker);
+		ImportEntityImpl(Linker, ImportParams, EntityField, *PendingImport.Value, OutConditionalEntities, ConditionResultCache, ImportedEntities[PendingImport.Key].Data);
 	}
+	PendingImportScratch.Reset();
 
 	// Nothing is invalidated now
 	bInvalidated = false;
@@ -175,7 +259,7 @@ void FEntityLedger::UpdateConditionalEntities(UMovieSceneEntitySystemLinker* Lin
 		// We cache all results here in the temp cache we've made so at least we won't re-run the same condition multiple times each tick
 		bool bConditionPassed = CanImportEntity(Linker, ImportParams, EntityField, Query, DummyEntitySet, ConditionResultCache, true);
 
-		FImportedEntityData& EntityData = ImportedEntities.FindOrAdd(Query.Entity.Key);
+		FImportedEntityData& EntityData = FindOrAddImportedEntity(Query.Entity.Key);
 		if (bConditionPassed && (!EntityData.EntityID || EntityData.MetaDataIndex != Query.MetaDataIndex))
 		{
 			// A previously failing condition has now passed. Attempt to properly import the entity.
@@ -234,23 +318,51 @@ bool FEntityLedger::IsEmpty() const
 	return ImportedEntities.Num() == 0;
 }
 
+int32 FEntityLedger::FindImportedEntityIndex(const FMovieSceneEvaluationFieldEntityKey& EntityKey, uint32 KeyHash) const
+{
+	for (int32 Index = Algo::LowerBoundBy(ImportedEntities, KeyHash, &FImportedEntityEntry::KeyHash); Index < ImportedEntities.Num() && ImportedEntities[Index].KeyHash == KeyHash; ++Index)
+	{
+		if (ImportedEntities[Index].Key == EntityKey)
+		{
+			return Index;
+		}
+	}
+	return INDEX_NONE;
+}
+
+FEntityLedger::FImportedEntityData& FEntityLedger::FindOrAddImportedEntity(const FMovieSceneEvaluationFieldEntityKey& EntityKey)
+{
+	const uint32 KeyHash = GetTypeHash(EntityKey);
+
+	const int32 ExistingIndex = FindImportedEntityIndex(EntityKey, KeyHash);
+	if (ExistingIndex != INDEX_NONE)
+	{
+		return ImportedEntities[ExistingIndex].Data;
+	}
+
+	const int32 InsertIndex = Algo::UpperBoundBy(ImportedEntities, KeyHash, &FImportedEntityEntry::KeyHash);
+	ImportedEntities.Insert(FImportedEntityEntry{ EntityKey, KeyHash, FImportedEntityData{} }, InsertIndex);
+	return ImportedEntities[InsertIndex].Data;
+}
+
 bool FEntityLedger::HasImportedEntity(const FMovieSceneEvaluationFieldEntityKey& EntityKey) const
 {
-	return ImportedEntities.Contains(EntityKey);
+	return FindImportedEntityIndex(EntityKey, GetTypeHash(EntityKey)) != INDEX_NONE;
 }
 
 FMovieSceneEntityID FEntityLedger::FindImportedEntity(const FMovieSceneEvaluationFieldEntityKey& EntityKey) const
 {
-	return ImportedEntities.FindRef(EntityKey).EntityID;
+	const int32 Index = FindImportedEntityIndex(EntityKey, GetTypeHash(EntityKey));
+	return Index != INDEX_NONE ? ImportedEntities[Index].Data.EntityID : FMovieSceneEntityID();
 }
 
 void FEntityLedger::FindImportedEntities(TWeakObjectPtr<UObject> EntityOwner, TArray<FMovieSceneEntityID>& OutEntityIDs) const
 {
-	for (const TPair<FMovieSceneEvaluationFieldEntityKey, FImportedEntityData>& Pair : ImportedEntities)
+	for (const FImportedEntityEntry& Entry : ImportedEntities)
 	{
-		if (Pair.Key.EntityOwner == EntityOwner)
+		if (Entry.Key.EntityOwner == EntityOwner)
 		{
-			OutEntityIDs.Add(Pair.Value.EntityID);
+			OutEntityIDs.Add(Entry.Data.EntityID);
 		}
 	}
 }
@@ -299,16 +411,18 @@ bool FEntityLedger::CanImportEntity(UMovieSceneEntitySystemLinker* Linker, const
 	{
 		return *CachedResult;
 	}
-	else
+
+	// Check the linker-wide cache next, which allows other instances of the same sequence to share results for global conditions, and per-tick conditions to be evaluated only once per frame
+	const FConditionResultKey LinkerCacheKey = FConditionResultCache::MakeKey(EntityMetadata->Condition, BindingID, ImportParams.SequenceID, SequenceInstance.GetSharedPlaybackState(), Query.Entity.Key.EntityOwner.Get(), bCanCacheResult);
+
+	const bool bResult = Linker->ConditionResultCache.FindOrEvaluate(LinkerCacheKey, EntityMetadata->Condition, BindingID, ImportParams.SequenceID, SequenceInstance.GetSharedPlaybackState());
+
+	// We always cache the results for per tick entities as they get thrown away after the tick, and we might as well prevent the same condition from getting re-evaluated multiple times per tick.
+	if (bCanCacheResult || bUpdatingPerTickEntities)
 	{
-		bool bResult = EntityMetadata->Condition->EvaluateCondition(BindingID, ImportParams.SequenceID, SequenceInstance.GetSharedPlaybackState());
-		// We always cache the results for per tick entities as they get thrown away after the tick, and we might as well prevent the same condition from getting re-evaluated multiple times per tick.
-		if (bCanCacheResult || bUpdatingPerTickEntities)
-		{
-			ConditionResultCache.Add(CacheKey, bResult);
-		}
-		return bResult;
+		ConditionResultCache.Add(CacheKey, bResult);
 	}
+	return bResult;
 }
 
 void FEntityLedger::ImportEntity(UMovieSceneEntitySystemLinker* Linker, const FEntityImportSequenceParams& ImportParams, const FMovieSceneEntityComponentField* EntityField, const FMovieSceneEvaluationFieldEntityQuery& Query)
@@ -321,7 +435,12 @@ void FEntityLedger::ImportEntity(UMovieSceneEntitySystemLinker* Linker, const FE
 void FEntityLedger::ImportEntity(UMovieSceneEntitySystemLinker* Linker, const FEntityImportSequenceParams& ImportParams, const FMovieSceneEntityComponentField* EntityField, const FMovieSceneEvaluationFieldEntityQuery& Query, FMovieSceneEvaluationFieldEntitySet& OutPerTickConditionalEntities, TMap<uint32, bool>& ConditionResultCache)
 {
 	// We always add an entry even if no entity was imported by the provider to ensure that we do not repeatedly try and import the same entity every frame
-	FImportedEntityData& EntityData = ImportedEntities.FindOrAdd(Query.Entity.Key);
+	FImportedEntityData& EntityData = FindOrAddImportedEntity(Query.Entity.Key);
+	ImportEntityImpl(Linker, ImportParams, EntityField, Query, OutPerTickConditionalEntities, ConditionResultCache, EntityData);
+}
+
+void FEntityLedger::ImportEntityImpl(UMovieSceneEntitySystemLinker* Linker, const FEntityImportSequenceParams& ImportParams, const FMovieSceneEntityComponentField* EntityField, const FMovieSceneEvaluationFieldEntityQuery& Query, FMovieSceneEvaluationFieldEntitySet& OutPerTickConditionalEntities, TMap<uint32, bool>& ConditionResultCache, FImportedEntityData& EntityData)
+{
 	EntityData.MetaDataIndex = Query.MetaDataIndex;
 
 	UObject* EntityOwner = Query.Entity.Key.EntityOwner.Get();
@@ -407,15 +526,15 @@ void FEntityLedger::UnlinkEverything(UMovieSceneEntitySystemLinker* Linker, EUnl
 	FComponentTypeID NeedsLink = FBuiltInComponentTypes::Get()->Tags.NeedsLink;
 	FComponentMask FinishedMask = FBuiltInComponentTypes::Get()->FinishedMask;
 
-	for (TPair<FMovieSceneEvaluationFieldEntityKey, FImportedEntityData>& Pair : ImportedEntities)
+	for (const FImportedEntityEntry& Entry : ImportedEntities)
 	{
-		if (Pair.Value.EntityID)
+		if (Entry.Data.EntityID)
 		{
 			if (UnlinkMode == EUnlinkEverythingMode::CleanGarbage)
 			{
-				Linker->EntityManager.RemoveComponent(Pair.Value.EntityID, NeedsLink, EEntityRecursion::Full);
+				Linker->EntityManager.RemoveComponent(Entry.Data.EntityID, NeedsLink, EEntityRecursion::Full);
 			}
-			Linker->EntityManager.AddComponents(Pair.Value.EntityID, FinishedMask, EEntityRecursion::Full);
+			Linker->EntityManager.AddComponents(Entry.Data.EntityID, FinishedMask, EEntityRecursion::Full);
 		}
 	}
 	ImportedEntities.Empty();
@@ -441,14 +560,11 @@ void FEntityLedger::CleanupLinkerEntities(const TSet<FMovieSceneEntityID>& Linke
 			OneShotEntities.RemoveAtSwap(Index, EAllowShrinking::No);
 		}
 	}
-	for (auto It = ImportedEntities.CreateIterator(); It; ++It)
+	// RemoveAll is stable so this maintains the sort order
+	ImportedEntities.RemoveAll([&LinkerEntities](const FImportedEntityEntry& Entry)
 	{
-		FMovieSceneEntityID EntityID = It.Value().EntityID;
-		if (EntityID && LinkerEntities.Contains(EntityID))
-		{
-			It.RemoveCurrent();
-		}
-	}
+		return Entry.Data.EntityID && LinkerEntities.Contains(Entry.Data.EntityID);
+	});
 }
 
 void FEntityLedger::TagGarbage(UMovieSceneEntitySystemLinker* Linker)
@@ -456,18 +572,20 @@ void FEntityLedger::TagGarbage(UMovieSceneEntitySystemLinker* Linker)
 	FComponentTypeID NeedsLink = FBuiltInComponentTypes::Get()->Tags.NeedsLink;
 	FComponentTypeID NeedsUnlink = FBuiltInComponentTypes::Get()->Tags.NeedsUnlink;
 
-	for (auto It = ImportedEntities.CreateIterator(); It; ++It)
+	ImportedEntities.RemoveAll([Linker, NeedsLink, NeedsUnlink](const FImportedEntityEntry& Entry)
 	{
-		if (!It.Key().EntityOwner.IsValid())
+		if (Entry.Key.EntityOwner.IsValid())
 		{
-			if (It.Value().EntityID)
-			{
-				Linker->EntityManager.RemoveComponent(It.Value().EntityID, NeedsLink, EEntityRecursion::Full);
-				Linker->EntityManager.AddComponent(It.Value().EntityID, NeedsUnlink, EEntityRecursion::Full);
-			}
-			It.RemoveCurrent();
+			return false;
 		}
-	}
+
+		if (Entry.Data.EntityID)
+		{
+			Linker->EntityManager.RemoveComponent(Entry.Data.EntityID, NeedsLink, EEntityRecursion::Full);
+			Linker->EntityManager.AddComponent(Entry.Data.EntityID, NeedsUnlink, EEntityRecursion::Full);
+		}
+		return true;
+	});
 }
 
 bool FEntityLedger::Contains(UMovieSceneEntitySystemLinker* Linker, const FEntityComponentFilter& Filter) const
@@ -490,10 +608,10 @@ bool FEntityLedger::Contains(UMovieSceneEntitySystemLinker* Linker, const FEntit
 		}
 	}
 
-	for (const TPair<FMovieSceneEvaluationFieldEntityKey, FImportedEntityData>& Pair : ImportedEntities)
+	for (const FImportedEntityEntry& Entry : ImportedEntities)
 	{
-		Visit(Pair.Value.EntityID);
-		Linker->EntityManager.IterateChildren_ParentFirst(Pair.Value.EntityID, Visit);
+		Visit(Entry.Data.EntityID);
+		Linker->EntityManager.IterateChildren_ParentFirst(Entry.Data.EntityID, Visit);
 
 		if (bResult)
 		{
@@ -530,10 +648,10 @@ void FEntityLedger::MutateAll(UMovieSceneEntitySystemLinker* Linker, const FEnti
 		Linker->EntityManager.IterateChildren_ParentFirst(EntityID, Visit);
 	}
 
-	for (const TPair<FMovieSceneEvaluationFieldEntityKey, FImportedEntityData>& Pair : ImportedEntities)
+	for (const FImportedEntityEntry& Entry : ImportedEntities)
 	{
-		Visit(Pair.Value.EntityID);
-		Linker->EntityManager.IterateChildren_ParentFirst(Pair.Value.EntityID, Visit);
+		Visit(Entry.Data.EntityID);
+		Linker->EntityManager.IterateChildren_ParentFirst(Entry.Data.EntityID, Visit);
 	}
 }
 
@@ -13,6 +13,7 @@
 
 #include "HAL/PlatformProcess.h"
 #include "Misc/FeedbackContext.h"
+#include "Misc/ScopeRWLock.h"
 
 #include "EntitySystem/EntityAllocationIterator.h"
 
@@ -53,6 +54,16 @@ FAutoConsoleVariableRef CVarThreadedEvaluationEntityThreshold(
 	TEXT("(Default: 256) Defines the number of entities that need to exist to justify threaded evaluation.\n"),
 	ECVF_Default
 );
+int32 GAllocationMatchCacheThreshold = 16;
+FAutoConsoleVariableRef CVarAllocationMatchCacheThreshold(
+	TEXT("Sequencer.EntitySystem.AllocationMatchCacheThreshold"),
+	GAllocationMatchCacheThreshold,
+	TEXT("(Default: 16) Defines the number of entity allocations that need to exist before the allocations matching each iterated filter are cached rather than found by testing every allocation. 0 disables caching.\n"),
+	ECVF_Default
+);
+
+/** The maximum number of filters to cache matching allocations for before the cache is emptied */
+static constexpr int32 MaxCachedAllocationMatches = 1024;
 
 #if UE_MOVIESCENE_ENTITY_DEBUG
 bool GRichComponentDebuggingInitialized = false;
@@ -411,6 +422,7 @@ FEntityManager::FEntityManager()
 	LockdownState = ELockdownState::Unlocked;
 	SystemSerialNumber = 1;
 	StructureMutationSystemSerialNumber = 0;
+	AllocationLayoutSerial = 1;
 	ThreadingModel = EEntityThreadingModel::NoThreading;
 
 #if UE_MOVIESCENE_ENTITY_DEBUG
@@ -1115,6 +1127,9 @@ int32 FEntityManager::CreateEntityAllocationEntry(const FComponentMask& EntityCo
 
 	check(MaskIndex == AllocationIndex);
 
+	// Invalidate cached allocation matches immediately since callers may iterate before reporting the structural change
+	++AllocationLayoutSerial;
+
 	AllocationsWithCapacity.PadToNum(MaskIndex+1, false);
 	AllocationsWithCapacity[MaskIndex] = true;
 
@@ -1713,6 +1728,7 @@ int32 FEntityManager::MutateAll(const FEntityComponentFilter& Filter, const IMov
 		FComponentMask OldAllocationType = EntityAllocationMasks[AllocationIndex];
 		EntityAllocationMasks[AllocationIndex] = NewAllocationType;
 		EntityAllocations[AllocationIndex] = NewAllocation;
+		OnStructureChanged();
 
 		FEntityAllocationMutexGuard LockGuard(NewAllocation, EComponentHeaderLockMode::LockFree);
 
@@ -1853,6 +1869,7 @@ int32 FEntityManager::MutateConditional(const FEntityComponentFilter& Filter, co
 
 			EntityAllocationMasks[SourceAllocationIndex] = DesiredType;
 			EntityAllocations[SourceAllocationIndex] = NewAllocation;
+			OnStructureChanged();
 
 			FEntityRange Range { NewAllocation, 0, NewAllocation->Num() };
 
@@ -2507,7 +2524,60 @@ void FEntityManager::RemoveEntityFromAllocation(int32 AllocationIndex, int32 Ent
 void FEntityManager::OnStructureChanged()
 {
 	StructureMutationSystemSerialNumber = SystemSerialNumber;
+	++AllocationLayoutSerial;
 	bAccumulatedMaskStale = true;
+
+	// Cached matches are only ever discarded when there can be no iterators referencing them
+	if (CachedAllocationMatches.Num() > MaxCachedAllocationMatches && IterationCount.Load(ThreadingModel) == 0)
+	{
+		CachedAllocationMatches.Empty();
+	}
+}
+
+const TArray<uint16>* FEntityManager::FindMatchingAllocations(const FEntityComponentFilter& InFilter) const
+{
+	// The global iteration filter can be changed in-place at any time so iterations that use it are never cached
+	if (GAllocationMatchCacheThreshold <= 0 || EntityAllocationMasks.Num() < GAllocationMatchCacheThreshold || GlobalIterationFilter.IsValid())
+	{
+		return nullptr;
+	}
+
+	// Cached entries can only go out of date when the structure changes, which cannot happen while anything is being iterated,
+	// so any entry that is up to date here will remain so for the lifetime of the calling iterator
+	{
+		UE::TReadScopeLock ReadLock(CachedAllocationMatchesLock);
+
+		const TUniquePtr<FCachedAllocationMatches>* Existing = CachedAllocationMatches.Find(InFilter);
+		if (Existing && (*Existing)->LayoutSerial == AllocationLayoutSerial)
+		{
+			return &(*Existing)->AllocationIndices;
+		}
+	}
+
+	UE::TWriteScopeLock WriteLock(CachedAllocationMatchesLock);
+
+	TUniquePtr<FCachedAllocationMatches>& Entry = CachedAllocationMatches.FindOrAdd(InFilter);
+	if (!Entry)
+	{
+		Entry = MakeUnique<FCachedAllocationMatches>();
+	}
+	else if (Entry->LayoutSerial == AllocationLayoutSerial)
+	{
+		// Updated by another thread while we were waiting for the lock
+		return &Entry->AllocationIndices;
+	}
+
+	Entry->AllocationIndices.Reset();
+	for (auto It = EntityAllocationMasks.CreateConstIterator(); It; ++It)
+	{
+		if (InFilter.Match(*It))
+		{
+			Entry->AllocationIndices.Add(static_cast<uint16>(It.GetIndex()));
+		}
+	}
+	Entry->LayoutSerial = AllocationLayoutSerial;
+
+	return &Entry->AllocationIndices;
 }
 
 void FEntityManager::CheckInvariants()
@@ -190,6 +190,8 @@ void UMovieSceneEntitySystemLinker::Reset()
 	EntitySystemsByGlobalGraphID.Reset();
 
 	EntityManager.Destroy();
+
+	ConditionResultCache.Reset();
 }
 
 UMovieSceneEntitySystemLinker* UMovieSceneEntitySystemLinker::FindOrCreateLinker(UObject* PreferredOuter, UE::MovieScene::EEntitySystemLinkerRole LinkerRole, const TCHAR* Name)
@@ -362,6 +364,10 @@ void UMovieSceneEntitySystemLinker::HandlePostGarbageCollection()
 	// Increment the system serial number to ensure that any structural mutation that occurs in this function does so under a unique serial
 	EntityManager.IncrementSystemSerial();
 
+	// Shared condition results are keyed by condition pointer so must not outlive a garbage collection
+	ConditionResultCache.InvalidateGlobal();
+	ConditionResultCache.InvalidateFrame();
+
 	// All the instance registry to unlink garbage first
 	InstanceRegistry->TagGarbage();
 
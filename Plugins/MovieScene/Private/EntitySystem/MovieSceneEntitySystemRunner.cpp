@@ -5,6 +5,8 @@
 #include "EntitySystem/MovieSceneEntityMutations.h"
 #include "EntitySystem/BuiltInComponentTypes.h"
 #include "EntitySystem/MovieSceneEntitySystemTypes.h"
+#include "EntitySystem/MovieSceneEntitySystemTraceRecorder.h"
+#include "EntitySystem/MovieSceneSpawnablesSystem.h"
 #include "EntitySystem/MovieSceneTaskScheduler.h"
 #include "Evaluation/PreAnimatedState/MovieScenePreAnimatedCaptureSource.h"
 #include "Evaluation/MovieSceneEvaluationTemplateInstance.h"
@@ -651,6 +653,9 @@ UE::MovieScene::ERunnerFlushResult FMovieSceneEntitySystemRunner::GameThread_Con
 {
 	using namespace UE::MovieScene;
 
+	static const FName TracePhaseName(TEXT("Conditional Recompile"));
+	FEntitySystemTraceRecorder::FScopedPhase TracePhase(TracePhaseName, &Linker->EntityManager);
+
 	TRACE_CPUPROFILER_EVENT_SCOPE(FMovieSceneEntitySystemRunner::GameThread_ConditionalRecompile);
 
 	FInstanceRegistry* InstanceRegistry = GetInstanceRegistry();
@@ -716,6 +721,9 @@ UE::MovieScene::ERunnerFlushResult FMovieSceneEntitySystemRunner::GameThread_Upd
 {
 	using namespace UE::MovieScene;
 
+	static const FName TracePhaseName(TEXT("Import"));
+	FEntitySystemTraceRecorder::FScopedPhase TracePhase(TracePhaseName, &Linker->EntityManager);
+
 	TRACE_CPUPROFILER_EVENT_SCOPE(FMovieSceneEntitySystemRunner::GameThread_UpdateSequenceInstances);
 
 	// Also reset the capture source scope so that each group of sequences tied to a given linker starts
@@ -1007,6 +1015,9 @@ UE::MovieScene::ERunnerFlushResult FMovieSceneEntitySystemRunner::GameThread_Rei
 {
 	using namespace UE::MovieScene;
 
+	static const FName TracePhaseName(TEXT("Reimport"));
+	FEntitySystemTraceRecorder::FScopedPhase TracePhase(TracePhaseName, &Linker->EntityManager);
+
 	// Only called after a sequence has been recompiled after we have already updated the current instances
 	// This allows us to re-update all the sequence instances in case anything has changed
 
@@ -1061,6 +1072,9 @@ UE::MovieScene::ERunnerFlushResult FMovieSceneEntitySystemRunner::GameThread_Spa
 {
 	using namespace UE::MovieScene;
 
+	static const FName TracePhaseName(TEXT("Spawn Phase"));
+	FEntitySystemTraceRecorder::FScopedPhase TracePhase(TracePhaseName, &Linker->EntityManager);
+
 	check(GameThread == ENamedThreads::GameThread || GameThread == ENamedThreads::GameThread_Local);
 
 
@@ -1111,6 +1125,10 @@ UE::MovieScene::ERunnerFlushResult FMovieSceneEntitySystemRunner::GameThread_Spa
 		Linker->Events.PostSpawnEvent.Broadcast(Linker);
 	}
 
+	// Prepare any spawnables that are about to begin so that spawning them at the start of their range is cheap. This has to run every frame,
+	// not just when instantiation is dirty, so it cannot live in the spawnables system itself.
+	UMovieSceneSpawnablesSystem::PreSpawnUpcomingSpawnables(Linker);
+
 	// --------------------------------------------------------------------------------------------------------------------------------------------
 	// Only run the instantiation phase if there is anything to instantiate. This must come after the spawn phase because new instantiations may
 	// be created during the spawn phase
@@ -1127,6 +1145,9 @@ UE::MovieScene::ERunnerFlushResult FMovieSceneEntitySystemRunner::GameThread_Ins
 {
 	using namespace UE::MovieScene;
 
+	static const FName TracePhaseName(TEXT("Instantiation Phase"));
+	FEntitySystemTraceRecorder::FScopedPhase TracePhase(TracePhaseName, &Linker->EntityManager);
+
 	SCOPE_CYCLE_COUNTER(MovieSceneEval_InstantiationPhase);
 
 	check(GameThread == ENamedThreads::GameThread || GameThread == ENamedThreads::GameThread_Local);
@@ -1152,6 +1173,9 @@ UE::MovieScene::ERunnerFlushResult FMovieSceneEntitySystemRunner::GameThread_Pos
 {
 	using namespace UE::MovieScene;
 
+	static const FName TracePhaseName(TEXT("Post Instantiation"));
+	FEntitySystemTraceRecorder::FScopedPhase TracePhase(TracePhaseName, &Linker->EntityManager);
+
 	SCOPE_CYCLE_COUNTER(MovieSceneEval_PostInstantiation);
 
 	check(GameThread == ENamedThreads::GameThread || GameThread == ENamedThreads::GameThread_Local);
@@ -1189,6 +1213,9 @@ UE::MovieScene::ERunnerFlushResult FMovieSceneEntitySystemRunner::GameThread_Eva
 {
 	using namespace UE::MovieScene;
 
+	static const FName TracePhaseName(TEXT("Evaluation Phase"));
+	FEntitySystemTraceRecorder::FScopedPhase TracePhase(TracePhaseName, &Linker->EntityManager);
+
 	SCOPE_CYCLE_COUNTER(MovieSceneEval_EvaluationPhase);
 
 	CurrentPhase = ESystemPhase::Evaluation;
@@ -1233,6 +1260,9 @@ void FMovieSceneEntitySystemRunner::GameThread_EvaluationFinalizationPhase(UMovi
 {
 	using namespace UE::MovieScene;
 
+	static const FName TracePhaseName(TEXT("Finalization Phase"));
+	FEntitySystemTraceRecorder::FScopedPhase TracePhase(TracePhaseName, &Linker->EntityManager);
+
 	check(GameThread == ENamedThreads::GameThread || GameThread == ENamedThreads::GameThread_Local);
 
 	CurrentPhase = ESystemPhase::Finalization;
@@ -1276,6 +1306,9 @@ void FMovieSceneEntitySystemRunner::GameThread_EventTriggerPhase(UMovieSceneEnti
 {
 	using namespace UE::MovieScene;
 
+	static const FName TracePhaseName(TEXT("Event Trigger Phase"));
+	FEntitySystemTraceRecorder::FScopedPhase TracePhase(TracePhaseName, &Linker->EntityManager);
+
 	// Execute any queued events from the evaluation finalization phase.
 	if (EventTriggers.IsBound())
 	{
@@ -1296,6 +1329,9 @@ void FMovieSceneEntitySystemRunner::GameThread_PostEvaluationPhase(UMovieSceneEn
 {
 	using namespace UE::MovieScene;
 
+	static const FName TracePhaseName(TEXT("Post Evaluation Phase"));
+	FEntitySystemTraceRecorder::FScopedPhase TracePhase(TracePhaseName, &Linker->EntityManager);
+
 	SCOPE_CYCLE_COUNTER(MovieSceneEval_PostEvaluationPhase);
 
 	// Now run the post-evaluation logic so that we can safely handle broadcast events (like OnFinished)
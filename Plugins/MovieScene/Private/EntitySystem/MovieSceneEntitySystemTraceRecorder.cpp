@@ -0,0 +1,307 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EntitySystem/MovieSceneEntitySystemTraceRecorder.h"
+#include "EntitySystem/MovieSceneEntityManager.h"
+#include "MovieSceneFwd.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/ThreadManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/StringBuilder.h"
+
+namespace UE
+{
+namespace MovieScene
+{
+
+/** CVar that defines the default ring buffer size used by Sequencer.TraceRecorder.Start */
+int32 GSequencerTraceRecorderCapacity = 1 << 16;
+static FAutoConsoleVariableRef CVarSequencerTraceRecorderCapacity(
+	TEXT("Sequencer.TraceRecorder.Capacity"),
+	GSequencerTraceRecorderCapacity,
+	TEXT("(Default: 65536. The number of events retained by the entity system trace recorder when Sequencer.TraceRecorder.Start is called without a capacity.")
+	);
+
+static FAutoConsoleCommand CmdSequencerTraceRecorderStart(
+	TEXT("Sequencer.TraceRecorder.Start"),
+	TEXT("Begin recording entity system task and phase timings into a ring buffer. Optionally specify the number of events to retain."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		int32 Capacity = GSequencerTraceRecorderCapacity;
+		if (Args.Num() > 0)
+		{
+			LexFromString(Capacity, *Args[0]);
+		}
+		FEntitySystemTraceRecorder::Get().Start(Capacity);
+	})
+);
+
+static FAutoConsoleCommand CmdSequencerTraceRecorderStop(
+	TEXT("Sequencer.TraceRecorder.Stop"),
+	TEXT("Stop recording entity system task and phase timings."),
+	FConsoleCommandDelegate::CreateLambda([]
+	{
+		FEntitySystemTraceRecorder::Get().Stop();
+	})
+);
+
+static FAutoConsoleCommand CmdSequencerTraceRecorderExport(
+	TEXT("Sequencer.TraceRecorder.Export"),
+	TEXT("Export recorded entity system task and phase timings to a Chrome trace JSON file. Optionally specify the file name, otherwise the file is written to the profiling directory."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const FString Filename = Args.Num() > 0
+			? Args[0]
+			: FPaths::ProfilingDir() / TEXT("Sequencer") / FString::Printf(TEXT("EntitySystemTrace-%s.json"), *FDateTime::Now().ToString());
+
+		if (FEntitySystemTraceRecorder::Get().ExportChromeTrace(Filename))
+		{
+			UE_LOG(LogMovieSceneECS, Display, TEXT("Exported entity system trace to %s"), *FPaths::ConvertRelativePathToFull(Filename));
+		}
+		else
+		{
+			UE_LOG(LogMovieSceneECS, Warning, TEXT("Failed to export entity system trace to %s"), *Filename);
+		}
+	})
+);
+
+std::atomic<int32> FEntitySystemTraceRecorder::GlobalRecordingCount(0);
+
+FEntitySystemTraceRecorder& FEntitySystemTraceRecorder::Get()
+{
+	static FEntitySystemTraceRecorder GlobalRecorder;
+	return GlobalRecorder;
+}
+
+FEntitySystemTraceRecorder::FEntitySystemTraceRecorder()
+	: Capacity(0)
+	, WriteIndex(0)
+	, NumActiveWriters(0)
+	, bRecording(false)
+{
+}
+
+FEntitySystemTraceRecorder::~FEntitySystemTraceRecorder()
+{
+	StopAndWaitForWriters();
+}
+
+void FEntitySystemTraceRecorder::Start(int32 InCapacity)
+{
+	// Writers must have left the ring buffer before it can be reallocated
+	StopAndWaitForWriters();
+
+	{
+		FScopeLock Lock(&BufferLock);
+
+		Capacity = FMath::Max(InCapacity, 1);
+		Slots = MakeUnique<FSlot[]>(Capacity);
+		WriteIndex.store(0, std::memory_order_relaxed);
+	}
+
+	bRecording.store(true);
+	++GlobalRecordingCount;
+}
+
+void FEntitySystemTraceRecorder::Stop()
+{
+	if (bRecording.exchange(false))
+	{
+		--GlobalRecordingCount;
+	}
+}
+
+void FEntitySystemTraceRecorder::StopAndWaitForWriters()
+{
+	Stop();
+
+	// Any writer that registers after this point will see bRecording == false and leave without touching the ring buffer
+	while (NumActiveWriters.load() != 0)
+	{
+		FPlatformProcess::Yield();
+	}
+}
+
+void FEntitySystemTraceRecorder::Record(const FEntitySystemTraceEvent& Event)
+{
+	if (!bRecording.load(std::memory_order_relaxed))
+	{
+		return;
+	}
+
+	// Register as a writer before re-checking bRecording so that Start cannot reallocate the ring buffer underneath us
+	++NumActiveWriters;
+	if (bRecording.load())
+	{
+		const uint64 Index    = WriteIndex.fetch_add(1, std::memory_order_relaxed);
+		const uint64 Sequence = Index + 1;
+
+		FSlot& Slot = Slots[Index % Capacity];
+
+		// Take exclusive ownership of the slot. If another writer currently owns it, or has already written a newer event into it,
+		// this event has been overwritten before it was ever visible so it is dropped.
+		uint64 Current = Slot.Sequence.load(std::memory_order_relaxed);
+		while (Current != BusySequence && Current < Sequence)
+		{
+			if (Slot.Sequence.compare_exchange_weak(Current, BusySequence, std::memory_order_acquire, std::memory_order_relaxed))
+			{
+				Slot.Event = Event;
+				Slot.Sequence.store(Sequence, std::memory_order_release);
+				break;
+			}
+		}
+	}
+	--NumActiveWriters;
+}
+
+TArray<FEntitySystemTraceEvent> FEntitySystemTraceRecorder::GetEvents() const
+{
+	TArray<FEntitySystemTraceEvent> Result;
+
+	FScopeLock Lock(&BufferLock);
+
+	const uint64 NumWritten = WriteIndex.load(std::memory_order_acquire);
+	if (NumWritten == 0 || Capacity == 0)
+	{
+		return Result;
+	}
+
+	// Once the buffer has wrapped, the oldest event is the one that will be overwritten next
+	const int32  NumEvents   = static_cast<int32>(FMath::Min<uint64>(NumWritten, Capacity));
+	const uint64 FirstEvent  = NumWritten - NumEvents;
+
+	Result.Reserve(NumEvents);
+	for (uint64 EventIndex = FirstEvent; EventIndex < NumWritten; ++EventIndex)
+	{
+		const FSlot& Slot = Slots[EventIndex % Capacity];
+		const uint64 ExpectedSequence = EventIndex + 1;
+
+		// Skip slots that are still being written, or have since been overwritten
+		if (Slot.Sequence.load(std::memory_order_acquire) != ExpectedSequence)
+		{
+			continue;
+		}
+
+		FEntitySystemTraceEvent Event = Slot.Event;
+
+		// Discard the copy if a writer took ownership of the slot while it was being read
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (Slot.Sequence.load(std::memory_order_relaxed) == ExpectedSequence)
+		{
+			Result.Add(Event);
+		}
+	}
+	return Result;
+}
+
+uint64 FEntitySystemTraceRecorder::GetNumRecordedEvents() const
+{
+	return WriteIndex.load(std::memory_order_relaxed);
+}
+
+FString FEntitySystemTraceRecorder::ExportChromeTrace() const
+{
+	TArray<FEntitySystemTraceEvent> AllEvents = GetEvents();
+
+	uint64 BaseCycles = MAX_uint64;
+	for (const FEntitySystemTraceEvent& Event : AllEvents)
+	{
+		BaseCycles = FMath::Min(BaseCycles, Event.StartCycles);
+	}
+
+	const double MicrosecondsPerCycle = FPlatformTime::GetSecondsPerCycle64() * 1000000.0;
+
+	TStringBuilder<4096> Builder;
+	Builder << TEXT("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+	TArray<uint32, TInlineAllocator<16>> ThreadIDs;
+
+	bool bFirstEvent = true;
+	for (const FEntitySystemTraceEvent& Event : AllEvents)
+	{
+		ThreadIDs.AddUnique(Event.ThreadID);
+
+		FString Name = Event.Name.IsNone()
+			? FString::Printf(TEXT("Task %d"), Event.TaskIndex)
+			: Event.Name.ToString();
+		Name.ReplaceCharWithEscapedCharInline();
+
+		const bool bIsPhase = Event.Type == EEntitySystemTraceEventType::Phase;
+
+		Builder << (bFirstEvent ? TEXT("") : TEXT(","));
+		Builder.Appendf(TEXT("{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"entities\":%d,\"allocations\":%d"),
+			*Name,
+			bIsPhase ? TEXT("Phase") : TEXT("Task"),
+			Event.ThreadID,
+			(Event.StartCycles - BaseCycles) * MicrosecondsPerCycle,
+			(Event.EndCycles - Event.StartCycles) * MicrosecondsPerCycle,
+			Event.NumEntities,
+			Event.NumAllocations);
+
+		if (!bIsPhase)
+		{
+			Builder.Appendf(TEXT(",\"task\":%d"), Event.TaskIndex);
+		}
+		Builder << TEXT("}}");
+
+		bFirstEvent = false;
+	}
+
+	// Name each thread so that worker threads are identifiable in the viewer
+	for (uint32 ThreadID : ThreadIDs)
+	{
+		FString ThreadName = FThreadManager::GetThreadName(ThreadID);
+		if (ThreadName.IsEmpty())
+		{
+			ThreadName = FString::Printf(TEXT("Thread %u"), ThreadID);
+		}
+		ThreadName.ReplaceCharWithEscapedCharInline();
+
+		Builder << (bFirstEvent ? TEXT("") : TEXT(","));
+		Builder.Appendf(TEXT("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"%s\"}}"), ThreadID, *ThreadName);
+
+		bFirstEvent = false;
+	}
+
+	Builder << TEXT("]}");
+	return FString(Builder.ToView());
+}
+
+bool FEntitySystemTraceRecorder::ExportChromeTrace(const FString& Filename) const
+{
+	return FFileHelper::SaveStringToFile(ExportChromeTrace(), *Filename, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
+
+FEntitySystemTraceRecorder::FScopedPhase::FScopedPhase(FName InName, const FEntityManager* InEntityManager)
+	: Name(InName)
+	, EntityManager(InEntityManager)
+	, StartCycles(FEntitySystemTraceRecorder::IsRecordingEnabled() ? FPlatformTime::Cycles64() : 0)
+{
+}
+
+FEntitySystemTraceRecorder::FScopedPhase::~FScopedPhase()
+{
+	if (StartCycles == 0 || !FEntitySystemTraceRecorder::IsRecordingEnabled())
+	{
+		return;
+	}
+
+	FEntitySystemTraceEvent Event;
+	Event.Name           = Name;
+	Event.StartCycles    = StartCycles;
+	Event.EndCycles      = FPlatformTime::Cycles64();
+	Event.ThreadID       = FPlatformTLS::GetCurrentThreadId();
+	Event.NumEntities    = EntityManager ? EntityManager->GetNumEntities() : 0;
+	Event.NumAllocations = EntityManager ? EntityManager->GetNumAllocations() : 0;
+	Event.Type           = EEntitySystemTraceEventType::Phase;
+
+	FEntitySystemTraceRecorder::Get().Record(Event);
+}
+
+} // namespace MovieScene
+} // namespace UE
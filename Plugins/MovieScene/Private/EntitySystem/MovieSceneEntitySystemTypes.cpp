@@ -15,9 +15,7 @@ namespace MovieScene
  */
 bool InputMatchesAll(const FComponentMask& Input, const FComponentMask& Mask)
 {
-	FComponentMask Temp = Mask;
-	Temp.CombineWithBitwiseAND(Input, EBitwiseOperatorFlags::MaintainSize);
-	return Temp == Mask;
+	return Input.ContainsAll(Mask);
 }
 
 /**
@@ -25,9 +23,7 @@ bool InputMatchesAll(const FComponentMask& Input, const FComponentMask& Mask)
  */
 bool InputMatchesAny(const FComponentMask& Input, const FComponentMask& Mask)
 {
-	FComponentMask Temp = Mask;
-	Temp.CombineWithBitwiseAND(Input, EBitwiseOperatorFlags::MaintainSize);
-	return Temp.Find(true) != INDEX_NONE;
+	return Input.ContainsAny(Mask);
 }
 
 /**
@@ -35,9 +31,7 @@ bool InputMatchesAny(const FComponentMask& Input, const FComponentMask& Mask)
  */
 bool InputMatchesOne(const FComponentMask& Input, const FComponentMask& Mask)
 {
-	FComponentMask Temp = Mask;
-	Temp.CombineWithBitwiseAND(Input, EBitwiseOperatorFlags::MaintainSize);
-	return Temp.NumComponents() == 1;
+	return Input.ContainsExactlyOne(Mask);
 }
 
 bool FEntityComponentFilter::Match(const FComponentMask& Input) const
@@ -64,6 +64,14 @@ struct FInitialValueMutation : IMovieSceneEntityMutation
 		}
 	}
 
+	void ProcessDeferred()
+	{
+		for (TPair<FComponentTypeID, int32> Pair : InitialValueTypeToProcessor)
+		{
+			GInitialValueProcessors[Pair.Value].Processor->ProcessDeferred();
+		}
+	}
+
 	bool IsCached() const
 	{
 		return InitialValueCache != nullptr;
@@ -169,6 +177,9 @@ void UMovieSceneInitialValueSystem::OnRun(FSystemTaskPrerequisites& InPrerequisi
 			Filter.None({ BuiltInComponents->Tags.HasAssignedInitialValue, BuiltInComponents->Tags.Ignored });
 
 			Linker->EntityManager.MutateAll(Filter, Mutation);
+
+			// Populate any initial value slots that were reserved during the mutation
+			Mutation.ProcessDeferred();
 		}
 
 		// Clean up any stale cache entries
@@ -199,6 +210,7 @@ void UMovieSceneInitialValueSystem::OnRun(FSystemTaskPrerequisites& InPrerequisi
 		Filter.None({ BuiltInComponents->Tags.HasAssignedInitialValue, BuiltInComponents->Tags.Ignored });
 
 		Linker->EntityManager.MutateAll(Filter, Mutation);
+		Mutation.ProcessDeferred();
 	}
 }
 
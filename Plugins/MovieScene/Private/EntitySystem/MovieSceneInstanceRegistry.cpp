@@ -125,6 +125,8 @@ void FInstanceRegistry::DestroyInstance(FInstanceHandle InstanceHandle)
 		}
 		Instance.DestroyImmediately();
 		Instances.RemoveAt(InstanceHandle.InstanceID);
+
+		Linker->ConditionResultCache.RemoveInstance(InstanceHandle);
 	}
 }
 
@@ -1,11 +1,15 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "EntitySystem/MovieScenePropertySystemTypes.h"
+#include "EntitySystem/MovieScenePropertySystemTypes.inl"
 #include "UObject/ObjectKey.h"
 #include "UObject/NameTypes.h"
 #include "UObject/Class.h"
 #include "Templates/Tuple.h"
 
+DEFINE_STAT(MovieSceneEval_PropertyValuesApplied);
+DEFINE_STAT(MovieSceneEval_PropertyValuesSkipped);
+
 namespace UE::MovieScene
 {
 
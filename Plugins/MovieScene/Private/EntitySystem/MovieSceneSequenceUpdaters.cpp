@@ -26,19 +26,23 @@
 #include "Algo/IndexOf.h"
 #include "Algo/Transform.h"
 #include "Algo/Unique.h"
+#include "Async/ParallelFor.h"
+#include "AutoRTFM.h"
+#include "HAL/IConsoleManager.h"
 #include "Sections/MovieSceneSubSection.h"
 
+int32 GSequencerParallelSubSequenceThreshold = 8;
+static FAutoConsoleVariableRef CVarSequencerParallelSubSequenceThreshold(
+	TEXT("Sequencer.ParallelSubSequenceThreshold"),
+	GSequencerParallelSubSequenceThreshold,
+	TEXT("(Default: 8. The number of simultaneously active sub sequences above which their contexts and entity ledgers are updated in parallel. Entity creation and destruction is always committed in hierarchy order on the game thread. 0 disables parallel updates.")
+	);
+
 namespace UE
 {
 namespace MovieScene
 {
 
-struct FMovieSceneDeterminismFenceWithSubframe
-{
-	FFrameTime FrameTime;
-	uint8 bInclusive : 1;
-};
-
 /** Flat sequence updater (ie, no hierarchy) */
 struct FSequenceUpdater_Flat : ISequenceUpdater
 {
@@ -71,7 +75,8 @@ private:
 	FMovieSceneEvaluationFieldEntitySet CachedPerTickConditionalEntities;
 
 	// Cached results for conditions that only need to be checked once, stored by the cache key returned by the condition itself.
-	mutable TMap<uint32, bool> CachedConditionResults;
+	// Results are also stored in the linker's condition result cache which is used for lookups outside of the main evaluation path.
+	TMap<uint32, bool> CachedConditionResults;
 };
 
 /** Hierarchical sequence updater */
@@ -102,6 +107,26 @@ private:
 
 private:
 
+	/** Per-update data for an active sub sequence, computed (possibly in parallel) before being committed to the linker */
+	struct FSubSequenceUpdate
+	{
+		FMovieSceneSequenceID SequenceIDFromRoot;
+		FInstanceHandle InstanceHandle;
+		const FMovieSceneSubSequenceData* SubData = nullptr;
+		UMovieSceneSequence* SubSequence = nullptr;
+		const FMovieSceneEntityComponentField* SubComponentField = nullptr;
+
+		/** The entities required for the current time, stored in SubSequenceEntities. Referenced by the sub sequence's ledger until it is committed. */
+		FMovieSceneEvaluationFieldEntitySet* Entities = nullptr;
+		/** The range in root space for which Entities remains valid */
+		TRange<FFrameNumber> CachedRange = TRange<FFrameNumber>::All();
+
+		bool bPreRoll = false;
+		bool bPostRoll = false;
+		bool bUpdateEntities = false;
+	};
+
+
 	TRange<FFrameNumber> CachedEntityRange;
 
 	struct FSubInstanceData
@@ -120,8 +145,15 @@ private:
 	// Conditional entities per sequence ID in the hierarchy that need to be re-checked in between entity ranges.
 	TMap<FMovieSceneSequenceID, FMovieSceneEvaluationFieldEntitySet> CachedPerTickConditionalEntities;
 
+	// Scratch entity sets for each active sub sequence, retained between updates to avoid reallocating them every time entities are gathered.
+	TMap<FMovieSceneSequenceID, FMovieSceneEvaluationFieldEntitySet> SubSequenceEntities;
+
+	// Scratch array of the active sub sequences for the current update, retained between updates to avoid reallocating it
+	TArray<FSubSequenceUpdate> SubSequenceUpdates;
+
 	// Cached results for conditions that only need to be checked once, stored by the cache key returned by the condition itself.
-	mutable TMap<uint32, bool> CachedConditionResults;
+	// Results are also stored in the linker's condition result cache which is used for lookups outside of the main evaluation path.
+	TMap<uint32, bool> CachedConditionResults;
 };
 
 void DissectRange(TArrayView<const FMovieSceneDeterminismFenceWithSubframe> InDissectionTimes, const TRange<FFrameTime>& Bounds, TArray<TRange<FFrameTime>>& OutDissections)
@@ -226,6 +258,37 @@ TArrayView<const FMovieSceneDeterminismFence> GetFencesWithinRange(TArrayView<co
 	return MakeArrayView(Fences.GetData() + StartFence, NumFences);
 }
 
+TArrayView<const FMovieSceneDeterminismFenceWithSubframe> GetFencesWithinRange(TArrayView<const FMovieSceneDeterminismFenceWithSubframe> Fences, const TRange<FFrameTime>& Boundary)
+{
+	if (Fences.Num() == 0 || Boundary.IsEmpty())
+	{
+		return TArrayView<const FMovieSceneDeterminismFenceWithSubframe>();
+	}
+
+	// Bound rules match the FMovieSceneDeterminismFence overload above: a fence that lies exactly on an inclusive upper bound
+	// is not traversed, so an update that ends on a fence is not split into an additional single-frame pass
+	const int32 StartFence = Boundary.GetLowerBound().IsOpen()
+		? 0
+		: Boundary.GetLowerBound().IsInclusive()
+			? Algo::LowerBoundBy(Fences, Boundary.GetLowerBoundValue(), &FMovieSceneDeterminismFenceWithSubframe::FrameTime)
+			: Algo::UpperBoundBy(Fences, Boundary.GetLowerBoundValue(), &FMovieSceneDeterminismFenceWithSubframe::FrameTime);
+
+	const int32 EndFence = Boundary.GetUpperBound().IsOpen()
+		? Fences.Num()
+		: Boundary.GetUpperBound().IsInclusive()
+			? Algo::LowerBoundBy(Fences, Boundary.GetUpperBoundValue(), &FMovieSceneDeterminismFenceWithSubframe::FrameTime)
+			: Algo::UpperBoundBy(Fences, Boundary.GetUpperBoundValue(), &FMovieSceneDeterminismFenceWithSubframe::FrameTime);
+
+	const int32 NumFences = FMath::Max(0, EndFence - StartFence);
+	if (NumFences == 0)
+	{
+		return TArrayView<const FMovieSceneDeterminismFenceWithSubframe>();
+	}
+
+	return MakeArrayView(Fences.GetData() + StartFence, NumFences);
+}
+
+
 
 void ISequenceUpdater::FactoryInstance(TUniquePtr<ISequenceUpdater>& OutPtr, UMovieSceneCompiledDataManager* CompiledDataManager, FMovieSceneCompiledDataID CompiledDataID)
 {
@@ -440,6 +503,7 @@ void FSequenceUpdater_Flat::InvalidateCachedData(TSharedRef<const FSharedPlaybac
 	CachedDeterminismFences.Reset();
 	CachedPerTickConditionalEntities.Reset();
 	CachedConditionResults.Reset();
+	SharedPlaybackState->GetLinker()->ConditionResultCache.InvalidateInstance(SharedPlaybackState->GetRootInstanceHandle());
 	bDynamicWeighting.Reset();
 }
 
@@ -450,7 +514,8 @@ bool FSequenceUpdater_Flat::EvaluateCondition(const FGuid& BindingID, const FMov
 	{
 		if (Condition->CanCacheResult(SharedPlaybackState))
 		{
-			if (bool* ConditionResult = CachedConditionResults.Find(Condition->ComputeCacheKey(BindingID, SequenceID, SharedPlaybackState, ConditionOwnerObject)))
+			const FConditionResultKey CacheKey = FConditionResultCache::MakeKey(Condition, BindingID, SequenceID, SharedPlaybackState, ConditionOwnerObject, true);
+			if (const bool* ConditionResult = SharedPlaybackState->GetLinker()->ConditionResultCache.Find(CacheKey))
 			{
 				return *ConditionResult;
 			}
@@ -548,25 +613,25 @@ void FSequenceUpdater_Hierarchical::DissectContext(TSharedRef<const FSharedPlayb
 	}
 
 	TRange<FFrameNumber> TraversedRange = RootContext.GetFrameNumberRange();
-	TArray<FMovieSceneDeterminismFenceWithSubframe> RootDissectionTimes;
 
-	{
-		const FMovieSceneCompiledDataEntry&           DataEntry       = CompiledDataManager->GetEntryRef(RootCompiledDataID);
-		TArrayView<const FMovieSceneDeterminismFence> TraversedFences = GetFencesWithinRange(DataEntry.DeterminismFences, RootContext.GetRange());
+	// The root fences and those of all linearly transformed sub sequences are precompiled into a single sorted table in root space
+	const FRootDeterminismTable& DeterminismTable = CompiledDataManager->GetRootDeterminismTable(RootCompiledDataID);
+	TArrayView<const FMovieSceneDeterminismFenceWithSubframe> TraversedRootFences = GetFencesWithinRange(DeterminismTable.Fences, RootContext.GetRange());
 
-		for (const FMovieSceneDeterminismFence& Fence : TraversedFences)
-		{
-			RootDissectionTimes.Add(FMovieSceneDeterminismFenceWithSubframe{ Fence.FrameNumber, Fence.bInclusive });
-		}
-	}
+	TArray<FMovieSceneDeterminismFenceWithSubframe> DynamicDissectionTimes;
 
-	// @todo: should this all just be compiled into the root hierarchy?
-	if (const FMovieSceneSequenceHierarchy* Hierarchy = CompiledDataManager->FindHierarchy(RootCompiledDataID))
+	// Only time-warped or looping sub sequences need their fences transforming into root space for the range that is being evaluated
+	const FMovieSceneSequenceHierarchy* Hierarchy = DeterminismTable.DynamicRanges.Num() > 0 ? CompiledDataManager->FindHierarchy(RootCompiledDataID) : nullptr;
+	if (Hierarchy)
 	{
-		FMovieSceneEvaluationTreeRangeIterator SubSequenceIt = Hierarchy->GetTree().IterateFromLowerBound(TraversedRange.GetLowerBound());
-		for ( ; SubSequenceIt && SubSequenceIt.Range().Overlaps(TraversedRange); ++SubSequenceIt)
+		for (const FRootDeterminismTable::FDynamicRange& DynamicRange : DeterminismTable.DynamicRanges)
 		{
-			TRange<FFrameTime> RootClampRange = TRange<FFrameTime>::Intersection(ConvertToFrameTimeRange(SubSequenceIt.Range()), RootContext.GetRange());
+			if (!DynamicRange.RootRange.Overlaps(TraversedRange))
+			{
+				continue;
+			}
+
+			TRange<FFrameTime> RootClampRange = TRange<FFrameTime>::Intersection(ConvertToFrameTimeRange(DynamicRange.RootRange), RootContext.GetRange());
 
 			// When RootContext.GetRange() does not fall on whole frame boundaries, we can sometimes end up with a range that clamps to being empty, even though the range overlapped
 			// the traversed range. ie if we evaluated range (1.5, 10], our traversed range would be [2, 11). If we have a sub sequence range of (10, 20), it would still be iterated here
@@ -576,64 +641,65 @@ void FSequenceUpdater_Hierarchical::DissectContext(TSharedRef<const FSharedPlayb
 				continue;
 			}
 
-			for (const FMovieSceneSubSequenceTreeEntry& Entry : Hierarchy->GetTree().GetAllData(SubSequenceIt.Node()))
+			const FMovieSceneSubSequenceData* SubData = Hierarchy->FindSubData(DynamicRange.SequenceID);
+			checkf(SubData, TEXT("Sub data does not exist for a SequenceID that exists in the root determinism table - this indicates a corrupt compilation product."));
+
+			UMovieSceneSequence*      SubSequence = SubData->GetSequence();
+			FMovieSceneCompiledDataID SubDataID   = SubSequence ? CompiledDataManager->FindDataID(SubSequence) : FMovieSceneCompiledDataID();
+			if (!SubDataID.IsValid())
 			{
-				const FMovieSceneSubSequenceData* SubData = Hierarchy->FindSubData(Entry.SequenceID);
-				checkf(SubData, TEXT("Sub data does not exist for a SequenceID that exists in the hierarchical tree - this indicates a corrupt compilation product."));
+				continue;
+			}
 
-				UMovieSceneSequence*      SubSequence = SubData     ? SubData->GetSequence()                      : nullptr;
-				FMovieSceneCompiledDataID SubDataID   = SubSequence ? CompiledDataManager->GetDataID(SubSequence) : FMovieSceneCompiledDataID();
-				if (!SubDataID.IsValid())
-				{
-					continue;
-				}
+			TArrayView<const FMovieSceneDeterminismFence> SubDeterminismFences = CompiledDataManager->GetEntryRef(SubDataID).DeterminismFences;
 
-				TArrayView<const FMovieSceneDeterminismFence> SubDeterminismFences = CompiledDataManager->GetEntryRef(SubDataID).DeterminismFences;
-				if (SubDeterminismFences.Num() > 0)
-				{
-					TRange<FFrameTime> InnerRange = SubData->RootToSequenceTransform.ComputeTraversedHull(RootClampRange);
+			TRange<FFrameTime> InnerRange = SubData->RootToSequenceTransform.ComputeTraversedHull(RootClampRange);
 
-					// Time-warp can result in inside-out ranges
-					if (InnerRange.GetLowerBound().IsClosed() && InnerRange.GetUpperBound().IsClosed() && InnerRange.GetLowerBoundValue() > InnerRange.GetUpperBoundValue())
-					{
-						TRangeBound<FFrameTime> OldLower = InnerRange.GetLowerBound();
-						TRangeBound<FFrameTime> OldUpper = InnerRange.GetUpperBound();
-						InnerRange.SetLowerBound(OldUpper);
-						InnerRange.SetUpperBound(OldLower);
-					}
+			// Time-warp can result in inside-out ranges
+			if (InnerRange.GetLowerBound().IsClosed() && InnerRange.GetUpperBound().IsClosed() && InnerRange.GetLowerBoundValue() > InnerRange.GetUpperBoundValue())
+			{
+				TRangeBound<FFrameTime> OldLower = InnerRange.GetLowerBound();
+				TRangeBound<FFrameTime> OldUpper = InnerRange.GetUpperBound();
+				InnerRange.SetLowerBound(OldUpper);
+				InnerRange.SetUpperBound(OldLower);
+			}
 
-					TArrayView<const FMovieSceneDeterminismFence> TraversedFences = GetFencesWithinRange(SubDeterminismFences, InnerRange);
-					if (TraversedFences.Num() > 0)
-					{
-						// Find the breadcrumbs for this range
-						FMovieSceneTransformBreadcrumbs Breadcrumbs;
-						SubData->RootToSequenceTransform.TransformTime(RootClampRange.GetLowerBoundValue(), FTransformTimeParams().HarvestBreadcrumbs(Breadcrumbs));
+			TArrayView<const FMovieSceneDeterminismFence> TraversedFences = GetFencesWithinRange(SubDeterminismFences, InnerRange);
+			if (TraversedFences.Num() > 0)
+			{
+				// Find the breadcrumbs for this range
+				FMovieSceneTransformBreadcrumbs Breadcrumbs;
+				SubData->RootToSequenceTransform.TransformTime(RootClampRange.GetLowerBoundValue(), FTransformTimeParams().HarvestBreadcrumbs(Breadcrumbs));
 
-						FMovieSceneInverseSequenceTransform InverseTransform = SubData->RootToSequenceTransform.Inverse();
+				FMovieSceneInverseSequenceTransform InverseTransform = SubData->RootToSequenceTransform.Inverse();
 
-						for (FMovieSceneDeterminismFence Fence : TraversedFences)
-						{
-							TOptional<FFrameTime> RootTime = InverseTransform.TryTransformTime(Fence.FrameNumber, Breadcrumbs);
-							if (RootTime && TraversedRange.Contains(RootTime->FrameNumber))
-							{
-								RootDissectionTimes.Emplace(FMovieSceneDeterminismFenceWithSubframe{ RootTime.GetValue(), Fence.bInclusive });
-							}
-						}
+				for (FMovieSceneDeterminismFence Fence : TraversedFences)
+				{
+					TOptional<FFrameTime> RootTime = InverseTransform.TryTransformTime(Fence.FrameNumber, Breadcrumbs);
+					if (RootTime && TraversedRange.Contains(RootTime->FrameNumber))
+					{
+						DynamicDissectionTimes.Emplace(FMovieSceneDeterminismFenceWithSubframe{ RootTime.GetValue(), Fence.bInclusive });
 					}
 				}
 			}
 		}
 	}
 
-	if (RootDissectionTimes.Num() > 0)
+	if (DynamicDissectionTimes.Num() > 0)
 	{
-		Algo::SortBy(RootDissectionTimes, &FMovieSceneDeterminismFenceWithSubframe::FrameTime);
-		int32 Index = Algo::UniqueBy(RootDissectionTimes, &FMovieSceneDeterminismFenceWithSubframe::FrameTime);
-		if (Index < RootDissectionTimes.Num())
+		DynamicDissectionTimes.Append(TraversedRootFences.GetData(), TraversedRootFences.Num());
+
+		Algo::SortBy(DynamicDissectionTimes, &FMovieSceneDeterminismFenceWithSubframe::FrameTime);
+		int32 Index = Algo::UniqueBy(DynamicDissectionTimes, &FMovieSceneDeterminismFenceWithSubframe::FrameTime);
+		if (Index < DynamicDissectionTimes.Num())
 		{
-			RootDissectionTimes.SetNum(Index);
+			DynamicDissectionTimes.SetNum(Index);
 		}
-		UE::MovieScene::DissectRange(RootDissectionTimes, RootContext.GetRange(), OutDissections);
+		UE::MovieScene::DissectRange(DynamicDissectionTimes, RootContext.GetRange(), OutDissections);
+	}
+	else if (TraversedRootFences.Num() > 0)
+	{
+		UE::MovieScene::DissectRange(TraversedRootFences, RootContext.GetRange(), OutDissections);
 	}
 	else if (RootHierarchy->GetRootTransform().FindFirstWarpDomain() == ETimeWarpChannelDomain::Time)
 	{
@@ -830,6 +896,9 @@ void FSequenceUpdater_Hierarchical::Update(TSharedRef<const FSharedPlaybackState
 			CachedEntityRange = TRange<FFrameNumber>::Intersection(CachedEntityRange, SubSequenceIt.Range());
 		}
 
+		// Resolve all the active sub sequences and their instances on this thread first, since conditions and instance creation are not thread-safe
+		SubSequenceUpdates.Reset();
+
 		for (const FMovieSceneSubSequenceTreeEntry& Entry : RootOverrideHierarchy->GetTree().GetAllData(SubSequenceIt.Node()))
 		{
 			// When a root override path is specified, we always remap the 'local' sequence IDs to their equivalents from the root sequence.
@@ -848,7 +917,9 @@ void FSequenceUpdater_Hierarchical::Update(TSharedRef<const FSharedPlaybackState
 				// Otherwise, test it again.
 				if (Condition->CanCacheResult(SharedPlaybackState))
 				{
-					if (bool* ConditionResult = CachedConditionResults.Find(Condition->ComputeCacheKey(FGuid(), RootOverrideSequenceID, SharedPlaybackState, FindObject<UMovieSceneSubSection>(CompiledDataManager->GetEntryRef(RootCompiledDataID).GetSequence(), *SubData->SectionPath.ToString()))))
+					UMovieSceneSubSection* SubSection = FindObject<UMovieSceneSubSection>(CompiledDataManager->GetEntryRef(RootCompiledDataID).GetSequence(), *SubData->SectionPath.ToString());
+					const FConditionResultKey CacheKey = FConditionResultCache::MakeKey(Condition, FGuid(), RootOverrideSequenceID, SharedPlaybackState, SubSection, true);
+					if (const bool* ConditionResult = Linker->ConditionResultCache.Find(CacheKey))
 					{
 						if (*ConditionResult == false)
 						{
@@ -880,118 +951,174 @@ void FSequenceUpdater_Hierarchical::Update(TSharedRef<const FSharedPlaybackState
 			}
 			else
 			{
-				FMovieSceneCompiledDataID SubDataID = CompiledDataManager->GetDataID(SubSequence);
-
-				// Set the context for the root sequence instance
-				FInstanceHandle    SubSequenceHandle = GetOrCreateSequenceInstance(SharedPlaybackState, SubSequence, RootHierarchy, InstanceRegistry, SequenceIDFromRoot);
-				FSequenceInstance& SubSequenceInstance = InstanceRegistry->MutateInstance(SubSequenceHandle);
+				FSubSequenceUpdate& SubSequenceUpdate = SubSequenceUpdates.Emplace_GetRef();
+				SubSequenceUpdate.SequenceIDFromRoot = SequenceIDFromRoot;
+				SubSequenceUpdate.SubData            = SubData;
+				SubSequenceUpdate.SubSequence        = SubSequence;
+				SubSequenceUpdate.SubComponentField  = CompiledDataManager->FindEntityComponentField(CompiledDataManager->GetDataID(SubSequence));
+				SubSequenceUpdate.InstanceHandle     = GetOrCreateSequenceInstance(SharedPlaybackState, SubSequence, RootHierarchy, InstanceRegistry, SequenceIDFromRoot);
+			}
+		}
 
-				// Update the sub sequence's context
-				FMovieSceneContext SubContext = RootContext.Transform(SubData->RootToSequenceTransform, SubData->TickResolution);
-				SubContext.ReportOuterSectionRanges(SubData->PreRollRange.Value, SubData->PostRollRange.Value);
-				SubContext.SetHierarchicalBias(SubData->HierarchicalBias);
+		// Assign each sub sequence its entity scratch set. All sets are added before any are referenced, since adding may relocate existing ones.
+		for (const FSubSequenceUpdate& SubSequenceUpdate : SubSequenceUpdates)
+		{
+			SubSequenceEntities.FindOrAdd(SubSequenceUpdate.SequenceIDFromRoot);
+		}
+		for (FSubSequenceUpdate& SubSequenceUpdate : SubSequenceUpdates)
+		{
+			SubSequenceUpdate.Entities = &SubSequenceEntities.FindChecked(SubSequenceUpdate.SequenceIDFromRoot);
+		}
 
-				// Handle crossing a pre/postroll boundary
-				const bool bWasPreRoll  = SubSequenceInstance.GetContext().IsPreRoll();
-				const bool bWasPostRoll = SubSequenceInstance.GetContext().IsPostRoll();
-				const bool bIsPreRoll   = SubContext.IsPreRoll();
-				const bool bIsPostRoll  = SubContext.IsPostRoll();
+		// Update each sub sequence's context and diff its ledger against the entities for its current time.
+		// Each of these only touches its own sequence instance, so they can be run concurrently
+		auto UpdateSubSequence = [this, InstanceRegistry, &RootContext, bGatherEntities](FSubSequenceUpdate& SubSequenceUpdate)
+		{
+			const FMovieSceneSubSequenceData* SubData = SubSequenceUpdate.SubData;
+			FSequenceInstance& SubSequenceInstance = InstanceRegistry->MutateInstance(SubSequenceUpdate.InstanceHandle);
 
-				if (bWasPreRoll != bIsPreRoll || bWasPostRoll != bIsPostRoll)
-				{
-					// When crossing a pre/postroll boundary, we invalidate all entities currently imported, which results in them being re-imported 
-					// with the same EntityID. This ensures that the state is maintained for such entities across prerolls (ie entities with a
-					// spawnable binding component on them will not cause the spawnable to be destroyed and recreated again).
-					// The one edge case that this could open up is where a preroll entity has meaningfully different components from its 'normal' entity,
-					// and there are systems that track the link/unlink lifetime for such components. Under this circumstance, the unlink for the entity
-					// will not be seen until the whole entity goes away, not just the preroll region. This is a very nuanced edge-case however, and can
-					// be solved by giving the entities unique IDs (FMovieSceneEvaluationFieldEntityKey::EntityID) in the evaluation field.
-					SubSequenceInstance.Ledger.Invalidate();
-				}
+			// Update the sub sequence's context
+			FMovieSceneContext SubContext = RootContext.Transform(SubData->RootToSequenceTransform, SubData->TickResolution);
+			SubContext.ReportOuterSectionRanges(SubData->PreRollRange.Value, SubData->PostRollRange.Value);
+			SubContext.SetHierarchicalBias(SubData->HierarchicalBias);
 
-				SubSequenceInstance.SetContext(SubContext);
-				SubSequenceInstance.SetFinished(false);
+			// Handle crossing a pre/postroll boundary
+			const bool bWasPreRoll  = SubSequenceInstance.GetContext().IsPreRoll();
+			const bool bWasPostRoll = SubSequenceInstance.GetContext().IsPostRoll();
+			const bool bIsPreRoll   = SubContext.IsPreRoll();
+			const bool bIsPostRoll  = SubContext.IsPostRoll();
 
-				const FMovieSceneEntityComponentField* SubComponentField = CompiledDataManager->FindEntityComponentField(SubDataID);
+			if (bWasPreRoll != bIsPreRoll || bWasPostRoll != bIsPostRoll)
+			{
+				// When crossing a pre/postroll boundary, we invalidate all entities currently imported, which results in them being re-imported 
+				// with the same EntityID. This ensures that the state is maintained for such entities across prerolls (ie entities with a
+				// spawnable binding component on them will not cause the spawnable to be destroyed and recreated again).
+				// The one edge case that this could open up is where a preroll entity has meaningfully different components from its 'normal' entity,
+				// and there are systems that track the link/unlink lifetime for such components. Under this circumstance, the unlink for the entity
+				// will not be seen until the whole entity goes away, not just the preroll region. This is a very nuanced edge-case however, and can
+				// be solved by giving the entities unique IDs (FMovieSceneEvaluationFieldEntityKey::EntityID) in the evaluation field.
+				SubSequenceInstance.Ledger.Invalidate();
+			}
 
-				// Update entities if necessary
-				const FFrameTime SubSequenceTime = SubContext.GetEvaluationFieldTime();
+			SubSequenceInstance.SetContext(SubContext);
+			SubSequenceInstance.SetFinished(false);
 
-				FEntityImportSequenceParams Params;
-				Params.SequenceID = SequenceIDFromRoot;
-				Params.InstanceHandle = SubSequenceHandle;
-				Params.RootInstanceHandle = RootInstanceHandle;
-				Params.DefaultCompletionMode = SubSequence->DefaultCompletionMode;
-				Params.HierarchicalBias = SubData->HierarchicalBias;
-				Params.SubSectionFlags = SubData->AccumulatedFlags;
-				Params.bPreRoll  = bIsPreRoll;
-				Params.bPostRoll = bIsPostRoll;
-				Params.bDynamicWeighting = bDynamicWeighting.Get(false); // Always inherit dynamic weighting flags
-
-				if (bGatherEntities || SubSequenceInstance.Ledger.IsInvalidated())
-				{
-					EntitiesScratch.Reset();
+			SubSequenceUpdate.bPreRoll  = bIsPreRoll;
+			SubSequenceUpdate.bPostRoll = bIsPostRoll;
+			SubSequenceUpdate.bUpdateEntities = bGatherEntities || SubSequenceInstance.Ledger.IsInvalidated();
 
-					TRange<FFrameNumber> SubEntityRange = UpdateEntitiesForSequence(SubComponentField, SubSequenceTime, EntitiesScratch);
-					SubEntityRange = TRange<FFrameNumber>::Intersection(SubEntityRange, SubData->PlayRange.Value);
+			if (!SubSequenceUpdate.bUpdateEntities)
+			{
+				return;
+			}
 
-					FMovieSceneEvaluationFieldEntitySet& SubSequenceCachedConditionalEntries = CachedPerTickConditionalEntities.Add(SequenceIDFromRoot);
-					SubSequenceInstance.Ledger.UpdateEntities(Linker, Params, SubComponentField, EntitiesScratch, SubSequenceCachedConditionalEntries, CachedConditionResults);
+			// Update entities if necessary
+			const FFrameTime SubSequenceTime = SubContext.GetEvaluationFieldTime();
 
-					// Convert sub entity range into root space
-					// 
-					// Sometimes the bounds can be unset if the lower bound does not map to any valid time in the root sequence.
-					//   If this happens, we rely in the intersection with SubSequenceIt.Range() to clamp to the bounds of the current sub sequence range
-					FMovieSceneInverseSequenceTransform Inv = SubContext.GetSequenceToRootSequenceTransform();
+			SubSequenceUpdate.Entities->Reset();
 
-					TRange<FFrameNumber> SubCachedRange = TRange<FFrameNumber>::All();
-					if (!SubEntityRange.GetLowerBound().IsOpen())
-					{
-						TOptional<FFrameTime> LowerBoundRootSpace = Inv.TryTransformTime(SubEntityRange.GetLowerBoundValue(), SubContext.GetRootToSequenceWarpCounter());
-						if (LowerBoundRootSpace)
-						{
-							SubCachedRange.SetLowerBound(TRangeBound<FFrameNumber>::Inclusive(LowerBoundRootSpace.GetValue().CeilToFrame()));
-						}
-					}
+			TRange<FFrameNumber> SubEntityRange = UpdateEntitiesForSequence(SubSequenceUpdate.SubComponentField, SubSequenceTime, *SubSequenceUpdate.Entities);
+			SubEntityRange = TRange<FFrameNumber>::Intersection(SubEntityRange, SubData->PlayRange.Value);
 
-					if (!SubEntityRange.GetUpperBound().IsOpen())
-					{
-						TOptional<FFrameTime> UpperBoundRootSpace = Inv.TryTransformTime(SubEntityRange.GetUpperBoundValue(), SubContext.GetRootToSequenceWarpCounter());
-						if (UpperBoundRootSpace)
-						{
-							SubCachedRange.SetUpperBound(TRangeBound<FFrameNumber>::Exclusive(UpperBoundRootSpace.GetValue().FloorToFrame()));
-						}
-					}
+			SubSequenceInstance.Ledger.DiffEntities(*SubSequenceUpdate.Entities);
 
-					// Time-warp can result in inside-out ranges
-					if (SubCachedRange.GetLowerBound().IsClosed() && SubCachedRange.GetUpperBound().IsClosed() && SubCachedRange.GetLowerBoundValue() > SubCachedRange.GetUpperBoundValue())
-					{
-						TRangeBound<FFrameNumber> OldLower = SubCachedRange.GetLowerBound();
-						TRangeBound<FFrameNumber> OldUpper = SubCachedRange.GetUpperBound();
-						SubCachedRange.SetLowerBound(OldUpper);
-						SubCachedRange.SetUpperBound(OldLower);
-					}
+			// Convert sub entity range into root space
+			// 
+			// Sometimes the bounds can be unset if the lower bound does not map to any valid time in the root sequence.
+			//   If this happens, we rely in the intersection with SubSequenceIt.Range() to clamp to the bounds of the current sub sequence range
+			FMovieSceneInverseSequenceTransform Inv = SubContext.GetSequenceToRootSequenceTransform();
 
-					CachedEntityRange = TRange<FFrameNumber>::Intersection(CachedEntityRange, SubCachedRange);
+			TRange<FFrameNumber> SubCachedRange = TRange<FFrameNumber>::All();
+			if (!SubEntityRange.GetLowerBound().IsOpen())
+			{
+				TOptional<FFrameTime> LowerBoundRootSpace = Inv.TryTransformTime(SubEntityRange.GetLowerBoundValue(), SubContext.GetRootToSequenceWarpCounter());
+				if (LowerBoundRootSpace)
+				{
+					SubCachedRange.SetLowerBound(TRangeBound<FFrameNumber>::Inclusive(LowerBoundRootSpace.GetValue().CeilToFrame()));
 				}
-				else if (FMovieSceneEvaluationFieldEntitySet* SubSequenceCachedConditionalEntries = CachedPerTickConditionalEntities.Find(SequenceIDFromRoot))
+			}
+
+			if (!SubEntityRange.GetUpperBound().IsOpen())
+			{
+				TOptional<FFrameTime> UpperBoundRootSpace = Inv.TryTransformTime(SubEntityRange.GetUpperBoundValue(), SubContext.GetRootToSequenceWarpCounter());
+				if (UpperBoundRootSpace)
 				{
-					if (SubSequenceCachedConditionalEntries->Num() != 0)
-					{
-						SubSequenceInstance.Ledger.UpdateConditionalEntities(Linker, Params, SubComponentField, *SubSequenceCachedConditionalEntries);
-					}
+					SubCachedRange.SetUpperBound(TRangeBound<FFrameNumber>::Exclusive(UpperBoundRootSpace.GetValue().FloorToFrame()));
 				}
+			}
 
-				// Update any one-shot entities for the sub sequence
-				if (SubComponentField && SubComponentField->HasAnyOneShotEntities())
+			// Time-warp can result in inside-out ranges
+			if (SubCachedRange.GetLowerBound().IsClosed() && SubCachedRange.GetUpperBound().IsClosed() && SubCachedRange.GetLowerBoundValue() > SubCachedRange.GetUpperBoundValue())
+			{
+				TRangeBound<FFrameNumber> OldLower = SubCachedRange.GetLowerBound();
+				TRangeBound<FFrameNumber> OldUpper = SubCachedRange.GetUpperBound();
+				SubCachedRange.SetLowerBound(OldUpper);
+				SubCachedRange.SetUpperBound(OldLower);
+			}
+
+			SubSequenceUpdate.CachedRange = SubCachedRange;
+		};
+
+		if (GSequencerParallelSubSequenceThreshold > 0 && SubSequenceUpdates.Num() >= GSequencerParallelSubSequenceThreshold && !AutoRTFM::IsTransactional())
+		{
+			ParallelFor(SubSequenceUpdates.Num(), [this, &UpdateSubSequence](int32 Index)
+			{
+				UpdateSubSequence(SubSequenceUpdates[Index]);
+			});
+		}
+		else
+		{
+			for (FSubSequenceUpdate& SubSequenceUpdate : SubSequenceUpdates)
+			{
+				UpdateSubSequence(SubSequenceUpdate);
+			}
+		}
+
+		// Commit all entity changes in hierarchy order so that entity creation and destruction is deterministic regardless of how the updates were run
+		for (FSubSequenceUpdate& SubSequenceUpdate : SubSequenceUpdates)
+		{
+			const FMovieSceneSubSequenceData* SubData = SubSequenceUpdate.SubData;
+			FSequenceInstance& SubSequenceInstance = InstanceRegistry->MutateInstance(SubSequenceUpdate.InstanceHandle);
+			const FMovieSceneEntityComponentField* SubComponentField = SubSequenceUpdate.SubComponentField;
+
+			FEntityImportSequenceParams Params;
+			Params.SequenceID = SubSequenceUpdate.SequenceIDFromRoot;
+			Params.InstanceHandle = SubSequenceUpdate.InstanceHandle;
+			Params.RootInstanceHandle = RootInstanceHandle;
+			Params.DefaultCompletionMode = SubSequenceUpdate.SubSequence->DefaultCompletionMode;
+			Params.HierarchicalBias = SubData->HierarchicalBias;
+			Params.SubSectionFlags = SubData->AccumulatedFlags;
+			Params.bPreRoll  = SubSequenceUpdate.bPreRoll;
+			Params.bPostRoll = SubSequenceUpdate.bPostRoll;
+			Params.bDynamicWeighting = bDynamicWeighting.Get(false); // Always inherit dynamic weighting flags
+
+			if (SubSequenceUpdate.bUpdateEntities)
+			{
+				FMovieSceneEvaluationFieldEntitySet& SubSequenceCachedConditionalEntries = CachedPerTickConditionalEntities.Add(SubSequenceUpdate.SequenceIDFromRoot);
+				SubSequenceInstance.Ledger.CommitEntities(Linker, Params, SubComponentField, SubSequenceCachedConditionalEntries, CachedConditionResults);
+
+				CachedEntityRange = TRange<FFrameNumber>::Intersection(CachedEntityRange, SubSequenceUpdate.CachedRange);
+
+				// The ledger no longer references the entities, but the set's allocation is kept for the next update
+				SubSequenceUpdate.Entities->Reset();
+			}
+			else if (FMovieSceneEvaluationFieldEntitySet* SubSequenceCachedConditionalEntries = CachedPerTickConditionalEntities.Find(SubSequenceUpdate.SequenceIDFromRoot))
+			{
+				if (SubSequenceCachedConditionalEntries->Num() != 0)
 				{
-					EntitiesScratch.Reset();
-					SubComponentField->QueryOneShotEntities(SubContext.GetFrameNumberRange(), EntitiesScratch);
+					SubSequenceInstance.Ledger.UpdateConditionalEntities(Linker, Params, SubComponentField, *SubSequenceCachedConditionalEntries);
+				}
+			}
 
-					if (EntitiesScratch.Num() != 0)
-					{
-						SubSequenceInstance.Ledger.UpdateOneShotEntities(Linker, Params, SubComponentField, EntitiesScratch, CachedConditionResults);
-					}
+			// Update any one-shot entities for the sub sequence
+			if (SubComponentField && SubComponentField->HasAnyOneShotEntities())
+			{
+				EntitiesScratch.Reset();
+				SubComponentField->QueryOneShotEntities(SubSequenceInstance.GetContext().GetFrameNumberRange(), EntitiesScratch);
+
+				if (EntitiesScratch.Num() != 0)
+				{
+					SubSequenceInstance.Ledger.UpdateOneShotEntities(Linker, Params, SubComponentField, EntitiesScratch, CachedConditionResults);
 				}
 			}
 		}
@@ -1007,6 +1134,7 @@ void FSequenceUpdater_Hierarchical::Update(TSharedRef<const FSharedPlaybackState
 		if (!ActiveSequences.Contains(InstanceIt.Key()))
 		{
 			Flags = ERunnerUpdateFlags::Finish | ERunnerUpdateFlags::Destroy;
+			SubSequenceEntities.Remove(InstanceIt.Key());
 			InstanceIt.RemoveCurrent();
 		}
 
@@ -1062,6 +1190,8 @@ void FSequenceUpdater_Hierarchical::Destroy(TSharedRef<const FSharedPlaybackStat
 	{
 		InstanceRegistry->DestroyInstance(Pair.Value.Handle);
 	}
+
+	SubSequenceEntities.Empty();
 }
 
 void FSequenceUpdater_Hierarchical::InvalidateCachedData(TSharedRef<const FSharedPlaybackState> SharedPlaybackState, ESequenceInstanceInvalidationType InvalidationType)
@@ -1070,6 +1200,7 @@ void FSequenceUpdater_Hierarchical::InvalidateCachedData(TSharedRef<const FShare
 	CachedEntityRange = TRange<FFrameNumber>::Empty();
 	CachedPerTickConditionalEntities.Reset();
 	CachedConditionResults.Reset();
+	SharedPlaybackState->GetLinker()->ConditionResultCache.InvalidateInstance(SharedPlaybackState->GetRootInstanceHandle());
 
 	UMovieSceneEntitySystemLinker* Linker = SharedPlaybackState->GetLinker();
 	FInstanceRegistry* InstanceRegistry = Linker->GetInstanceRegistry();
@@ -1123,7 +1254,8 @@ bool FSequenceUpdater_Hierarchical::EvaluateCondition(const FGuid& BindingID, co
 	{
 		if (Condition->CanCacheResult(SharedPlaybackState))
 		{
-			if (bool* ConditionResult = CachedConditionResults.Find(Condition->ComputeCacheKey(BindingID, SequenceID, SharedPlaybackState, ConditionOwnerObject)))
+			const FConditionResultKey CacheKey = FConditionResultCache::MakeKey(Condition, BindingID, SequenceID, SharedPlaybackState, ConditionOwnerObject, true);
+			if (const bool* ConditionResult = SharedPlaybackState->GetLinker()->ConditionResultCache.Find(CacheKey))
 			{
 				return *ConditionResult;
 			}
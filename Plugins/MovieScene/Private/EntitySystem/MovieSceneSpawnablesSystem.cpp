@@ -8,7 +8,13 @@
 #include "EntitySystem/MovieSceneEntityInstantiatorSystem.h"
 #include "EntitySystem/MovieSceneSharedPlaybackState.h"
 #include "EntitySystem/BuiltInComponentTypes.h"
+#include "Evaluation/MovieSceneEvaluationField.h"
 #include "Evaluation/MovieSceneEvaluationOperand.h"
+#include "Evaluation/MovieSceneSequenceHierarchy.h"
+#include "MovieSceneTimeHelpers.h"
+#include "Compilation/MovieSceneCompiledDataManager.h"
+#include "Sections/MovieSceneSpawnSection.h"
+#include "HAL/IConsoleManager.h"
 
 #include "MovieScene.h"
 #include "MovieSceneSequence.h"
@@ -30,6 +36,25 @@ namespace MovieScene
 DECLARE_CYCLE_STAT(TEXT("Spawnables System"), MovieSceneEval_SpawnablesSystem, STATGROUP_MovieSceneECS);
 DECLARE_CYCLE_STAT(TEXT("Spawnables: Spawn"), MovieSceneEval_SpawnSpawnables, STATGROUP_MovieSceneEval);
 DECLARE_CYCLE_STAT(TEXT("Spawnables: Destroy"), MovieSceneEval_DestroySpawnables, STATGROUP_MovieSceneEval);
+DECLARE_CYCLE_STAT(TEXT("Spawnables: Pre-Spawn"), MovieSceneEval_PreSpawnSpawnables, STATGROUP_MovieSceneEval);
+
+/** CVar that defines how far ahead of the play head to look for spawnables to pre-spawn */
+float GSequencerSpawnableLookAheadSeconds = 0.f;
+static FAutoConsoleVariableRef CVarSequencerSpawnableLookAheadSeconds(
+	TEXT("Sequencer.SpawnableLookAhead.Seconds"),
+	GSequencerSpawnableLookAheadSeconds,
+	TEXT("(Default: 0. Defines how many seconds ahead of the current time of playing sequences to look for spawnables that are about to begin, and pre-spawn them hidden in the spawnable pool. Requires Sequencer.SpawnablePool.Enable. 0 disables the look-ahead.")
+	);
+
+/** CVar that defines the maximum number of objects to pre-spawn each frame */
+int32 GSequencerSpawnableLookAheadMaxPerFrame = 1;
+static FAutoConsoleVariableRef CVarSequencerSpawnableLookAheadMaxPerFrame(
+	TEXT("Sequencer.SpawnableLookAhead.MaxPerFrame"),
+	GSequencerSpawnableLookAheadMaxPerFrame,
+	TEXT("(Default: 1. The maximum number of spawnables to pre-spawn each frame, across all playing sequences. Limits the cost of the look-ahead so that it is spread out over the look-ahead window.")
+	);
+
+extern bool GSequencerSpawnablePooling;
 
 struct FSpawnTrackPreAnimatedTokenProducer : IMovieScenePreAnimatedTokenProducer
 {
@@ -88,6 +113,157 @@ FMovieSceneAnimTypeID UMovieSceneSpawnablesSystem::GetAnimTypeID()
 	return UE::MovieScene::SpawnableAnimTypeID;
 }
 
+void UMovieSceneSpawnablesSystem::PreSpawnUpcomingSpawnables(UMovieSceneEntitySystemLinker* Linker)
+{
+	using namespace UE::MovieScene;
+
+	if (GSequencerSpawnableLookAheadSeconds <= 0.f || GSequencerSpawnableLookAheadMaxPerFrame <= 0 || !GSequencerSpawnablePooling)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(MovieSceneEval_PreSpawnSpawnables)
+
+	int32 RemainingBudget = GSequencerSpawnableLookAheadMaxPerFrame;
+
+	FMovieSceneEvaluationFieldEntitySet EntitiesScratch;
+
+	// Pre-spawn any spawnables whose spawn section is in the specified entity field at any time within the look-ahead window.
+	// Querying the whole window rather than its end ensures that short spawn ranges that begin and end inside it are not missed.
+	auto PreSpawnFromField = [&RemainingBudget, &EntitiesScratch](const FMovieSceneEntityComponentField* ComponentField, const TRange<FFrameNumber>& Window, FMovieSceneSequenceIDRef SequenceID, UMovieSceneSequence* Sequence, FMovieSceneSpawnRegister* SpawnRegister, const TSharedRef<FSharedPlaybackState>& SharedPlaybackState)
+	{
+		UMovieScene* MovieScene = Sequence ? Sequence->GetMovieScene() : nullptr;
+		if (!ComponentField || !MovieScene)
+		{
+			return;
+		}
+
+		IStaticBindingOverridesPlaybackCapability* StaticOverrides = SharedPlaybackState->FindCapability<IStaticBindingOverridesPlaybackCapability>();
+
+		EntitiesScratch.Reset();
+		ComponentField->QueryPersistentEntities(Window, EntitiesScratch);
+
+		for (const FMovieSceneEvaluationFieldEntityQuery& Query : EntitiesScratch)
+		{
+			if (RemainingBudget <= 0)
+			{
+				return;
+			}
+
+			// Spawn sections only populate the field for the ranges in which their binding is spawned
+			if (!Cast<UMovieSceneSpawnSection>(Query.Entity.Key.EntityOwner.Get()))
+			{
+				continue;
+			}
+
+			const FMovieSceneEvaluationFieldSharedEntityMetaData* SharedMetaData = ComponentField->FindSharedMetaData(Query);
+			if (!SharedMetaData)
+			{
+				continue;
+			}
+
+			const FGuid& SpawnableBindingID = SharedMetaData->ObjectBindingID;
+			if (StaticOverrides && StaticOverrides->GetBindingOverride(FMovieSceneEvaluationOperand(SequenceID, SpawnableBindingID)))
+			{
+				continue;
+			}
+
+			if (MovieScene->FindSpawnable(SpawnableBindingID))
+			{
+				RemainingBudget -= SpawnRegister->PreSpawnObject(SpawnableBindingID, *MovieScene, SequenceID, SharedPlaybackState, 0) ? 1 : 0;
+			}
+			else if (const FMovieSceneBindingReferences* BindingReferences = Sequence->GetBindingReferences())
+			{
+				for (int32 Index = 0; Index < BindingReferences->GetReferences(SpawnableBindingID).Num() && RemainingBudget > 0; ++Index)
+				{
+					RemainingBudget -= SpawnRegister->PreSpawnObject(SpawnableBindingID, *MovieScene, SequenceID, SharedPlaybackState, Index) ? 1 : 0;
+				}
+			}
+		}
+	};
+
+	for (const FSequenceInstance& Instance : Linker->GetInstanceRegistry()->GetSparseInstances())
+	{
+		if (RemainingBudget <= 0)
+		{
+			break;
+		}
+
+		const FMovieSceneContext& Context = Instance.GetContext();
+		if (!Instance.IsRootSequence() || Context.GetStatus() != EMovieScenePlayerStatus::Playing)
+		{
+			continue;
+		}
+
+		TSharedRef<FSharedPlaybackState> SharedPlaybackState = Instance.GetSharedPlaybackState();
+		FMovieSceneSpawnRegister*        SpawnRegister       = SharedPlaybackState->FindCapability<FMovieSceneSpawnRegister>();
+		UMovieSceneCompiledDataManager*  CompiledDataManager = SharedPlaybackState->GetCompiledDataManager();
+		if (!SpawnRegister || !CompiledDataManager)
+		{
+			continue;
+		}
+
+		const FFrameTime Now           = Context.GetTime();
+		const FFrameTime LookAheadTime = Context.GetOffsetTime(Context.GetFrameRate().AsFrameTime(GSequencerSpawnableLookAheadSeconds));
+		const TRange<FFrameNumber> LookAheadWindow = TRange<FFrameNumber>::Inclusive(FMath::Min(Now, LookAheadTime).FloorToFrame(), FMath::Max(Now, LookAheadTime).CeilToFrame());
+
+		const FMovieSceneCompiledDataID RootCompiledDataID = SharedPlaybackState->GetRootCompiledDataID();
+
+		PreSpawnFromField(CompiledDataManager->FindEntityComponentField(RootCompiledDataID), LookAheadWindow, MovieSceneSequenceID::Root, SharedPlaybackState->GetRootSequence(), SpawnRegister, SharedPlaybackState);
+
+		// Sub sequences are compiled separately, so look up each one that will be active at any point within the look-ahead window
+		const FMovieSceneSequenceHierarchy* Hierarchy = CompiledDataManager->FindHierarchy(RootCompiledDataID);
+		if (!Hierarchy)
+		{
+			continue;
+		}
+
+		// Gather the hull of the window in each sub sequence's time-space first, since a sub sequence can span several nodes of the tree
+		TMap<FMovieSceneSequenceID, TRange<FFrameNumber>, TInlineSetAllocator<8>> SubSequenceWindows;
+		for (FMovieSceneEvaluationTreeRangeIterator SubSequenceIt = Hierarchy->GetTree().IterateFromLowerBound(LookAheadWindow.GetLowerBound()); SubSequenceIt && LookAheadWindow.Overlaps(SubSequenceIt.Range()); ++SubSequenceIt)
+		{
+			const TRange<FFrameNumber> RootWindow = TRange<FFrameNumber>::Intersection(LookAheadWindow, SubSequenceIt.Range());
+
+			for (const FMovieSceneSubSequenceTreeEntry& Entry : Hierarchy->GetTree().GetAllData(SubSequenceIt.Node()))
+			{
+				const FMovieSceneSubSequenceData* SubData = Hierarchy->FindSubData(Entry.SequenceID);
+				if (!SubData)
+				{
+					continue;
+				}
+
+				const TRange<FFrameNumber> SubWindow = ConvertToDiscreteRange(SubData->RootToSequenceTransform.ComputeTraversedHull(RootWindow));
+				if (TRange<FFrameNumber>* ExistingWindow = SubSequenceWindows.Find(Entry.SequenceID))
+				{
+					*ExistingWindow = TRange<FFrameNumber>::Hull(*ExistingWindow, SubWindow);
+				}
+				else
+				{
+					SubSequenceWindows.Add(Entry.SequenceID, SubWindow);
+				}
+			}
+		}
+
+		for (const TPair<FMovieSceneSequenceID, TRange<FFrameNumber>>& Pair : SubSequenceWindows)
+		{
+			const FMovieSceneSubSequenceData* SubData = Hierarchy->FindSubData(Pair.Key);
+			UMovieSceneSequence* SubSequence = SubData ? SubData->GetSequence() : nullptr;
+			if (!SubSequence || Pair.Value.IsEmpty())
+			{
+				continue;
+			}
+
+			const FMovieSceneCompiledDataID SubDataID = CompiledDataManager->FindDataID(SubSequence);
+			if (!SubDataID.IsValid())
+			{
+				continue;
+			}
+
+			PreSpawnFromField(CompiledDataManager->FindEntityComponentField(SubDataID), Pair.Value, Pair.Key, SubSequence, SpawnRegister, SharedPlaybackState);
+		}
+	}
+}
+
 void UMovieSceneSpawnablesSystem::OnRun(FSystemTaskPrerequisites& InPrerequisites, FSystemSubsequentTasks& Subsequents)
 {
 	using namespace UE::MovieScene;
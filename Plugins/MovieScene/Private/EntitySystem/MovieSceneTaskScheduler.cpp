@@ -1,16 +1,26 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "EntitySystem/MovieSceneTaskScheduler.h"
+#include "EntitySystem/MovieSceneEntitySystemTraceRecorder.h"
 #include "Tasks/Task.h"
 #include "Algo/RandomShuffle.h"
+#include "Algo/Sort.h"
 #include "ProfilingDebugging/CpuProfilerTrace.h"
 #include "Stats/Stats.h"
 #include "Misc/AutomationTest.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
 
 namespace UE::MovieScene
 {
 
 DECLARE_CYCLE_STAT(TEXT("Anonymous MovieScene Task"), MovieSceneEval_AnonymousTask, STATGROUP_MovieSceneECS);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Scheduled Tasks Makespan (ms)"), MovieSceneEval_ScheduledTasksMakespan, STATGROUP_MovieSceneECS);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Scheduled Tasks Total Work (ms)"), MovieSceneEval_ScheduledTasksTotalWork, STATGROUP_MovieSceneECS);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Scheduled Tasks Critical Path (ms)"), MovieSceneEval_ScheduledTasksCriticalPath, STATGROUP_MovieSceneECS);
 
 /** CVar that disables our task scheduler. When disabled, all systems that are normally in the Scheduling phase will be executed in the Evaluation phase with their OnRun function */
 bool GSequencerCustomTaskScheduling = true;
@@ -20,6 +30,38 @@ static FAutoConsoleVariableRef CVarSequencerCustomTaskScheduling(
 	TEXT("(Default: true. Enables more efficient custom task scheduling of asynchronous Sequencer evaluation.")
 	);
 
+/** CVar that enables dispatching ready tasks in order of their critical path length */
+bool GSequencerCriticalPathScheduling = true;
+static FAutoConsoleVariableRef CVarSequencerCriticalPathScheduling(
+	TEXT("Sequencer.CustomTaskScheduling.CriticalPathPriority"),
+	GSequencerCriticalPathScheduling,
+	TEXT("(Default: true. Dispatches ready tasks with the longest chain of dependent work first.")
+	);
+
+/** CVar that enables measuring the duration of every scheduled task */
+bool GSequencerMeasureScheduledTasks = false;
+static FAutoConsoleVariableRef CVarSequencerMeasureScheduledTasks(
+	TEXT("Sequencer.CustomTaskScheduling.MeasureTasks"),
+	GSequencerMeasureScheduledTasks,
+	TEXT("(Default: false. Measures the duration of every scheduled task so that critical path priorities are weighted by measured cost, and reports execution stats. When disabled, every task is given the same weight.")
+	);
+
+/** CVar that defines how often critical path lengths are recomputed from measured task durations */
+int32 GSequencerCriticalPathUpdateInterval = 16;
+static FAutoConsoleVariableRef CVarSequencerCriticalPathUpdateInterval(
+	TEXT("Sequencer.CustomTaskScheduling.CriticalPathUpdateInterval"),
+	GSequencerCriticalPathUpdateInterval,
+	TEXT("(Default: 16. The number of task graph executions between recomputing critical path lengths from measured task durations. <= 0 only computes them when the task graph is constructed.")
+	);
+
+/** CVar that enables replaying the task graph on a fixed set of persistent worker threads rather than launching a task for each scheduled task */
+int32 GSequencerTaskGraphReplayWorkers = 0;
+static FAutoConsoleVariableRef CVarSequencerTaskGraphReplayWorkers(
+	TEXT("Sequencer.CustomTaskScheduling.ReplayWorkers"),
+	GSequencerTaskGraphReplayWorkers,
+	TEXT("(Default: 0. When non-zero, scheduled tasks are executed by this many dedicated worker threads that pull ready tasks from a lock-free queue and sleep between task graph executions, avoiding per-task launch overhead. < 0 uses one worker thread per task graph worker thread.")
+	);
+
 /** Flag structure to pass when executing a task. */
 struct FTaskExecutionFlags
 {
@@ -53,6 +95,8 @@ FScheduledTask::FScheduledTask(FScheduledTask&& InTask)
 #endif
 	, StatId(InTask.StatId)
 	, WriteContextOffset(InTask.WriteContextOffset)
+	, MeasuredCycles(InTask.MeasuredCycles)
+	, CriticalPathCycles(InTask.CriticalPathCycles)
 	, LockedComponentData(MoveTemp(InTask.LockedComponentData))
 	, NumPrerequisites(InTask.NumPrerequisites)
 	, WaitCount(InTask.WaitCount.Load(EEntityThreadingModel::NoThreading))
@@ -95,6 +139,10 @@ void FScheduledTask::Run(const FEntitySystemScheduler* Scheduler, FTaskExecution
 #endif
 		FEntityAllocationWriteContext ThisWriteContext = Scheduler->GetWriteContextOffset().Add(WriteContextOffset);
 
+		const bool bMeasureTask = Scheduler->IsMeasuringTasks();
+		const bool bTraceTask = FEntitySystemTraceRecorder::IsRecordingEnabled();
+		const uint64 StartCycles = (bMeasureTask || bTraceTask) ? FPlatformTime::Cycles64() : 0;
+
 		switch(TaskFunctionType)
 		{
 		case FScheduledTaskFuncionPtr::EType::Unbound:
@@ -125,6 +173,19 @@ void FScheduledTask::Run(const FEntitySystemScheduler* Scheduler, FTaskExecution
 			}
 			break;
 		}
+
+		if (bMeasureTask || bTraceTask)
+		{
+			const uint64 EndCycles = FPlatformTime::Cycles64();
+			if (bMeasureTask)
+			{
+				MeasuredCycles = EndCycles - StartCycles;
+			}
+			if (bTraceTask)
+			{
+				Scheduler->RecordTraceEvent(this, StartCycles, EndCycles);
+			}
+		}
 	}
 
 	// Now the task is finished, schedule any children to run, or any subsequents
@@ -140,11 +201,7 @@ void FScheduledTask::Run(const FEntitySystemScheduler* Scheduler, FTaskExecution
 		// Once our loop has finished we check the child complete count to see if this was the last one
 		ChildCompleteCount.Add(Scheduler->GetEntityManager()->GetThreadingModel(), 1);
 
-		const FScheduledTask* Children = this + 1;
-		for (uint16 ChildIndex = 0; ChildIndex < NumChildren; ++ChildIndex)
-		{
-			Scheduler->PrerequisiteCompleted(&Children[ChildIndex], nullptr);
-		}
+		Scheduler->SignalChildTasks(this);
 
 		// Subtract our count added on ln 205. If this is the last count, complete this task (all children have completed)
 		const int32 PreviousCompleteCount = ChildCompleteCount.Sub(Scheduler->GetEntityManager()->GetThreadingModel(), 1);
@@ -160,6 +217,35 @@ void FScheduledTask::Run(const FEntitySystemScheduler* Scheduler, FTaskExecution
 	}
 }
 
+/** Dedicated thread that runs ready tasks for every execution of the task graph, and parks between them */
+class FEntitySystemScheduler::FReplayWorkerThread : public FRunnable
+{
+public:
+
+	FReplayWorkerThread(const FEntitySystemScheduler* InScheduler, int32 WorkerIndex)
+		: Scheduler(InScheduler)
+	{
+		Thread.Reset(FRunnableThread::Create(this, *FString::Printf(TEXT("MovieSceneReplayWorker %d"), WorkerIndex), 0, TPri_AboveNormal));
+	}
+
+	~FReplayWorkerThread()
+	{
+		// The scheduler must have requested all workers to stop before destroying them
+		Thread.Reset();
+	}
+
+	virtual uint32 Run() override
+	{
+		Scheduler->RunReplayWorkerThread();
+		return 0;
+	}
+
+private:
+
+	const FEntitySystemScheduler* Scheduler;
+	TUniquePtr<FRunnableThread> Thread;
+};
+
 FEntitySystemScheduler::FEntitySystemScheduler(FEntityManager* InEntityManager)
 	: EntityManager(InEntityManager)
 {
@@ -168,6 +254,8 @@ FEntitySystemScheduler::FEntitySystemScheduler(FEntityManager* InEntityManager)
 FEntitySystemScheduler::~FEntitySystemScheduler()
 {
 	check(!GameThreadSignal);
+
+	StopReplayWorkers();
 }
 
 bool FEntitySystemScheduler::IsCustomSchedulingEnabled()
@@ -503,6 +591,11 @@ void FEntitySystemScheduler::ShuffleTasks()
 
 	RedirectMask(InitialTasks);
 
+	for (int32& TaskIndex : PrioritizedInitialTasks)
+	{
+		TaskIndex = ShuffledIndices[TaskIndex];
+	}
+
 	TArray<FScheduledTask> OldTasks;
 	Swap(Tasks, OldTasks);
 
@@ -510,6 +603,8 @@ void FEntitySystemScheduler::ShuffleTasks()
 	{
 		Tasks.Emplace(MoveTemp(OldTasks[ReverseShuffledIndices[Index]]));
 	}
+
+	TaskTraceNames.Reset();
 }
 
 void FEntitySystemScheduler::ExecuteTasks()
@@ -530,22 +625,63 @@ void FEntitySystemScheduler::ExecuteTasks()
 
 	WriteContextBase = FEntityAllocationWriteContext(*EntityManager);
 
+	bPrioritizeCriticalPath = GSequencerCriticalPathScheduling;
+	bMeasureTasks = GSequencerMeasureScheduledTasks;
+	if (FEntitySystemTraceRecorder::IsRecordingEnabled())
+	{
+		CacheTaskTraceNames();
+	}
+
+	const double StartTime = bMeasureTasks ? FPlatformTime::Seconds() : 0.0;
+
 	// Condition 1: No threading
 	//              Initiate all tasks immediately. Their subsequents will be triggered inline
 	if (ThreadingModel == EEntityThreadingModel::NoThreading)
 	{
-		TRACE_CPUPROFILER_EVENT_SCOPE_STR("Run Scheduled Tasks");
-		for (int32 Index : InitialTasks)
 		{
-			Tasks[Index].Run(this, FTaskExecutionFlags());
+			TRACE_CPUPROFILER_EVENT_SCOPE_STR("Run Scheduled Tasks");
+			for (int32 Index : PrioritizedInitialTasks)
+			{
+				Tasks[Index].Run(this, FTaskExecutionFlags());
+			}
 		}
 
 		check(NumTasksRemaining.Load(ThreadingModel) == 0);
 		EntityManager->IncrementSystemSerial(SystemSerialIncrement);
+
+		if (bMeasureTasks)
+		{
+			UpdateExecutionStats(FPlatformTime::Seconds() - StartTime);
+		}
 		return;
 	}
 
-	// Condition 2: Task graph threading
+	// Condition 2: Replay workers
+	//              Run the whole graph on a fixed number of persistent worker threads that pull from lock-free ready queues
+	const int32 NumWorkers = GSequencerTaskGraphReplayWorkers < 0
+		? FTaskGraphInterface::Get().GetNumWorkerThreads()
+		: GSequencerTaskGraphReplayWorkers;
+	if (NumWorkers <= 0)
+	{
+		StopReplayWorkers();
+	}
+	else
+	{
+		ExecuteTasksWithReplayWorkers(NumWorkers);
+
+		check(NumTasksRemaining.Load(ThreadingModel) == -1);
+		EntityManager->IncrementSystemSerial(SystemSerialIncrement);
+
+		NumTasksRemaining.Exchange(ThreadingModel, 0);
+
+		if (bMeasureTasks)
+		{
+			UpdateExecutionStats(FPlatformTime::Seconds() - StartTime);
+		}
+		return;
+	}
+
+	// Condition 3: Task graph threading
 	//              Schedule initial tasks tasks immediately. Gamethread tasks will be added to the GT queue to ensure that threaded work can be scheduled asap.
 
 	// We need to get a game thread signal from the event pool for the execution
@@ -556,8 +692,9 @@ void FEntitySystemScheduler::ExecuteTasks()
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE_STR("Dispatch Scheduled Tasks");
 
+		// Initial tasks are sorted longest critical path first
 		int32 NumInitialTasks = 0;
-		for (int32 Index : InitialTasks)
+		for (int32 Index : PrioritizedInitialTasks)
 		{
 			// If it has to run on the game thread, add it to the task list.
 			// This allows us to schedule threaded tasks first, then run the game
@@ -629,20 +766,319 @@ void FEntitySystemScheduler::ExecuteTasks()
 	check(GameThreadSignal);
 	FPlatformProcess::ReturnSynchEventToPool(GameThreadSignal);
 	GameThreadSignal = nullptr;
+
+	if (bMeasureTasks)
+	{
+		UpdateExecutionStats(FPlatformTime::Seconds() - StartTime);
+	}
+}
+
+void FEntitySystemScheduler::StartReplayWorkers(int32 NumWorkers)
+{
+	if (ReplayWorkerThreads.Num() == NumWorkers)
+	{
+		return;
+	}
+
+	StopReplayWorkers();
+
+	bStopReplayWorkers = false;
+	for (int32 WorkerIndex = 0; WorkerIndex < NumWorkers; ++WorkerIndex)
+	{
+		ReplayWorkerThreads.Emplace(MakeUnique<FReplayWorkerThread>(this, WorkerIndex));
+	}
+}
+
+void FEntitySystemScheduler::StopReplayWorkers()
+{
+	if (ReplayWorkerThreads.Num() == 0)
+	{
+		return;
+	}
+
+	bStopReplayWorkers = true;
+	ReplayWorkAvailable.Notify();
+
+	// Destroying each thread waits for it to exit
+	ReplayWorkerThreads.Empty();
+}
+
+void FEntitySystemScheduler::ExecuteTasksWithReplayWorkers(int32 NumWorkers)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE_STR("Replay Scheduled Tasks");
+
+	// Worker threads persist across executions, and are only recreated when the number of workers changes
+	StartReplayWorkers(NumWorkers);
+
+	NumReplayWorkers = NumWorkers;
+
+	// Initial tasks are sorted longest critical path first
+	for (int32 Index : PrioritizedInitialTasks)
+	{
+		FScheduledTask* Task = &Tasks[Index];
+		if (Task->bForceGameThread)
+		{
+			GameThreadTaskList.Push(Task);
+		}
+		else
+		{
+			ReadyTaskList.Push(Task);
+		}
+	}
+	ReplayWorkAvailable.Notify();
+
+	// The game thread participates as well, and is the only thread that can run game thread tasks
+	RunReplayGameThreadLoop();
+
+	// The task that finished the graph may still be unwinding on its worker, so wait for it to leave the task before touching any counters
+	while (NumRunningReplayTasks.load(std::memory_order_acquire) != 0)
+	{
+		FPlatformProcess::Yield();
+	}
+
+	check(ReadyTaskList.IsEmpty() && GameThreadTaskList.IsEmpty());
+
+	// No tasks are running, so nothing else can be touching the counters - reset them all in one pass ready for the next run
+	for (FScheduledTask& Task : Tasks)
+	{
+		checkSlow(Task.WaitCount.Load(EEntityThreadingModel::NoThreading) == 0 && Task.ChildCompleteCount.Load(EEntityThreadingModel::NoThreading) == 0);
+
+		Task.WaitCount.Exchange(EEntityThreadingModel::NoThreading, Task.NumPrerequisites);
+		Task.ChildCompleteCount.Exchange(EEntityThreadingModel::NoThreading, Task.NumChildren);
+	}
+
+	NumReplayWorkers = 0;
+}
+
+void FEntitySystemScheduler::RunReplayGameThreadLoop() const
+{
+	for (;;)
+	{
+		const FScheduledTask* Task = GameThreadTaskList.Pop();
+		if (!Task)
+		{
+			Task = ReadyTaskList.Pop();
+		}
+
+		if (Task)
+		{
+			Task->Run(this, FTaskExecutionFlags());
+			continue;
+		}
+
+		// Park until more tasks become ready or the graph completes
+		const FEventCountToken Token = ReplayWorkAvailable.PrepareWait();
+		if (NumTasksRemaining.Load(ThreadingModel) == -1)
+		{
+			// OnAllTasksFinished has been called, so there is no more work to do
+			break;
+		}
+		if (GameThreadTaskList.IsEmpty() && ReadyTaskList.IsEmpty())
+		{
+			ReplayWorkAvailable.Wait(Token);
+		}
+	}
+}
+
+void FEntitySystemScheduler::RunReplayWorkerThread() const
+{
+	while (!bStopReplayWorkers.load(std::memory_order_relaxed))
+	{
+		// Count the task as running before it is popped so the game thread can never observe the graph finishing while we are still inside a task
+		NumRunningReplayTasks.fetch_add(1, std::memory_order_acq_rel);
+		if (const FScheduledTask* Task = ReadyTaskList.Pop())
+		{
+			Task->Run(this, FTaskExecutionFlags());
+			NumRunningReplayTasks.fetch_sub(1, std::memory_order_release);
+			continue;
+		}
+		NumRunningReplayTasks.fetch_sub(1, std::memory_order_release);
+
+		// Park until more tasks become ready, which may not be until the next execution of the task graph
+		const FEventCountToken Token = ReplayWorkAvailable.PrepareWait();
+		if (!bStopReplayWorkers.load(std::memory_order_relaxed) && ReadyTaskList.IsEmpty())
+		{
+			ReplayWorkAvailable.Wait(Token);
+		}
+	}
+}
+
+void FEntitySystemScheduler::CacheTaskTraceNames()
+{
+	if (TaskTraceNames.Num() == Tasks.Num())
+	{
+		return;
+	}
+
+	TaskTraceNames.Reset(Tasks.Num());
+	for (const FScheduledTask& Task : Tasks)
+	{
+#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+		TaskTraceNames.Add(Task.DebugName.Len() > 0 ? FName(*Task.DebugName) : FName());
+#else
+		TaskTraceNames.Add(FName());
+#endif
+	}
+}
+
+void FEntitySystemScheduler::RecordTraceEvent(const FScheduledTask* Task, uint64 StartCycles, uint64 EndCycles) const
+{
+	const int32 TaskIndex = static_cast<int32>(Task - Tasks.GetData());
+
+	FEntitySystemTraceEvent Event;
+	Event.Name        = TaskTraceNames.IsValidIndex(TaskIndex) ? TaskTraceNames[TaskIndex] : FName();
+	Event.StartCycles = StartCycles;
+	Event.EndCycles   = EndCycles;
+	Event.ThreadID    = FPlatformTLS::GetCurrentThreadId();
+	Event.TaskIndex   = TaskIndex;
+
+	const FScheduledTask::FLockedComponentData& LockedData = Task->LockedComponentData;
+	if (LockedData.AllocationIndex != MAX_uint16)
+	{
+		Event.NumAllocations = 1;
+		Event.NumEntities    = FEntityAllocationProxy::MakeInstance(EntityManager, LockedData.AllocationIndex)->Num();
+	}
+
+	FEntitySystemTraceRecorder::Get().Record(Event);
+}
+
+void FEntitySystemScheduler::UpdateExecutionStats(double MakespanSeconds)
+{
+	uint64 TotalWorkCycles = 0;
+	for (const FScheduledTask& Task : Tasks)
+	{
+		TotalWorkCycles += Task.MeasuredCycles;
+	}
+
+	++NumExecutionsSinceCriticalPathUpdate;
+	if (GSequencerCriticalPathUpdateInterval > 0 && NumExecutionsSinceCriticalPathUpdate >= GSequencerCriticalPathUpdateInterval)
+	{
+		UpdateCriticalPaths();
+	}
+
+	ExecutionStats.MakespanSeconds = MakespanSeconds;
+	ExecutionStats.TotalWorkSeconds = FPlatformTime::ToSeconds64(TotalWorkCycles);
+
+	SET_FLOAT_STAT(MovieSceneEval_ScheduledTasksMakespan, ExecutionStats.MakespanSeconds * 1000.0);
+	SET_FLOAT_STAT(MovieSceneEval_ScheduledTasksTotalWork, ExecutionStats.TotalWorkSeconds * 1000.0);
+	SET_FLOAT_STAT(MovieSceneEval_ScheduledTasksCriticalPath, ExecutionStats.CriticalPathSeconds * 1000.0);
+
+	UE_LOG(LogMovieSceneECS, VeryVerbose, TEXT("Executed %d tasks: makespan %.3fms, critical path %.3fms, total work %.3fms"),
+		Tasks.Num(), ExecutionStats.MakespanSeconds * 1000.0, ExecutionStats.CriticalPathSeconds * 1000.0, ExecutionStats.TotalWorkSeconds * 1000.0);
+}
+
+void FEntitySystemScheduler::UpdateCriticalPaths()
+{
+	NumExecutionsSinceCriticalPathUpdate = 0;
+
+	TBitArray<> VisitedTasks(false, Tasks.Num());
+
+	uint64 LongestCriticalPath = 0;
+	for (int32 Index = 0; Index < Tasks.Num(); ++Index)
+	{
+		LongestCriticalPath = FMath::Max(LongestCriticalPath, ComputeCriticalPath(Index, VisitedTasks));
+	}
+
+	// Critical paths are only a duration when every task has been measured, otherwise they are a count of tasks
+	ExecutionStats.CriticalPathSeconds = bMeasureTasks ? FPlatformTime::ToSeconds64(LongestCriticalPath) : 0.0;
+
+	PrioritizedInitialTasks.Reset();
+	for (int32 Index : InitialTasks)
+	{
+		PrioritizedInitialTasks.Add(Index);
+	}
+
+	Algo::Sort(PrioritizedInitialTasks, [this](int32 A, int32 B){ return Tasks[A].CriticalPathCycles > Tasks[B].CriticalPathCycles; });
+}
+
+uint64 FEntitySystemScheduler::ComputeCriticalPath(int32 TaskIndex, TBitArray<>& VisitedTasks)
+{
+	FScheduledTask& Task = Tasks[TaskIndex];
+	if (VisitedTasks[TaskIndex])
+	{
+		return Task.CriticalPathCycles;
+	}
+	VisitedTasks[TaskIndex] = true;
+
+	// Parent tasks complete (and trigger their subsequents) once all their children have completed,
+	// so their critical path is the longest of their children, each of which includes the parent's subsequents
+	uint64 LongestDependentPath = 0;
+	if (Task.NumChildren > 0)
+	{
+		const int32 FirstChild = TaskIndex + 1;
+		for (int32 ChildIndex = FirstChild; ChildIndex < FirstChild + Task.NumChildren; ++ChildIndex)
+		{
+			LongestDependentPath = FMath::Max(LongestDependentPath, ComputeCriticalPath(ChildIndex, VisitedTasks));
+		}
+	}
+	else
+	{
+		for (int32 SubsequentIndex : Task.ComputedSubsequents)
+		{
+			LongestDependentPath = FMath::Max(LongestDependentPath, ComputeCriticalPath(SubsequentIndex, VisitedTasks));
+		}
+
+		if (Task.Parent)
+		{
+			for (int32 SubsequentIndex : Tasks[Task.Parent.Index].ComputedSubsequents)
+			{
+				LongestDependentPath = FMath::Max(LongestDependentPath, ComputeCriticalPath(SubsequentIndex, VisitedTasks));
+			}
+		}
+	}
+
+	// Tasks that have never been measured are given a nominal weight so that longer chains of tasks are still prioritized
+	Task.CriticalPathCycles = FMath::Max<uint64>(Task.MeasuredCycles, 1) + LongestDependentPath;
+	return Task.CriticalPathCycles;
+}
+
+uint32 FEntitySystemScheduler::GetTaskHistoryKey(const FScheduledTask& Task)
+{
+	// Task functions are unique per task type, so combined with the data that the task operates on
+	// they identify the same work across re-constructions of the task graph
+	UPTRINT FunctionPtr = 0;
+	switch (Task.TaskFunctionType)
+	{
+	case FScheduledTaskFuncionPtr::EType::Unbound:                 FunctionPtr = reinterpret_cast<UPTRINT>(Task.TaskFunction.UnboundTask);             break;
+	case FScheduledTaskFuncionPtr::EType::AllocationPtr:           FunctionPtr = reinterpret_cast<UPTRINT>(Task.TaskFunction.Allocation);              break;
+	case FScheduledTaskFuncionPtr::EType::AllocationItem:          FunctionPtr = reinterpret_cast<UPTRINT>(Task.TaskFunction.AllocationItem);          break;
+	case FScheduledTaskFuncionPtr::EType::PreLockedAllocationItem: FunctionPtr = reinterpret_cast<UPTRINT>(Task.TaskFunction.PreLockedAllocationItem); break;
+	default: return 0;
+	}
+
+	return HashCombineFast(GetTypeHash(FunctionPtr), GetTypeHash(Task.LockedComponentData.AllocationIndex));
 }
 
 void FEntitySystemScheduler::CompleteTask(const FScheduledTask* Task, FTaskExecutionFlags InFlags) const
 {
-	// Reset the WaitCount ready for the next run
-	const int32 PreviousWaitCount = Task->WaitCount.Exchange(ThreadingModel, Task->NumPrerequisites);
-	const int32 PreviousChildCount = Task->ChildCompleteCount.Exchange(ThreadingModel, Task->NumChildren);
+	// Reset the WaitCount ready for the next run. Replay workers reset all counters in bulk once every task has completed.
+	if (NumReplayWorkers == 0)
+	{
+		const int32 PreviousWaitCount = Task->WaitCount.Exchange(ThreadingModel, Task->NumPrerequisites);
+		const int32 PreviousChildCount = Task->ChildCompleteCount.Exchange(ThreadingModel, Task->NumChildren);
 
-	checkSlow(PreviousWaitCount == 0 && PreviousChildCount == 0);
+		checkSlow(PreviousWaitCount == 0 && PreviousChildCount == 0);
+	}
 
 	int32 FirstInlineIndex = INDEX_NONE;
-	for (int32 Index : Task->ComputedSubsequents)
+	if (bPrioritizeCriticalPath)
 	{
-		PrerequisiteCompleted(FTaskID(Index), InFlags.bCanInlineSubsequents ? &FirstInlineIndex : nullptr);
+		FReadyTaskArray ReadyTasks;
+		for (int32 Index : Task->ComputedSubsequents)
+		{
+			if (ConsumePrerequisite(&Tasks[Index]))
+			{
+				ReadyTasks.Add(&Tasks[Index]);
+			}
+		}
+		DispatchReadyTasks(ReadyTasks, InFlags.bCanInlineSubsequents ? &FirstInlineIndex : nullptr);
+	}
+	else
+	{
+		for (int32 Index : Task->ComputedSubsequents)
+		{
+			PrerequisiteCompleted(FTaskID(Index), InFlags.bCanInlineSubsequents ? &FirstInlineIndex : nullptr);
+		}
 	}
 
 	// Complete our parent if this is the last child
@@ -675,68 +1111,140 @@ void FEntitySystemScheduler::PrerequisiteCompleted(FTaskID TaskID, int32* OptRun
 
 void FEntitySystemScheduler::PrerequisiteCompleted(const FScheduledTask* Task, int32* OptRunInlineIndex) const
 {
-	// We either need to not be using threading, or have a valid game thread signal event!
-	check((ThreadingModel == EEntityThreadingModel::NoThreading) || (GameThreadSignal != nullptr));
+	if (ConsumePrerequisite(Task))
+	{
+		DispatchReadyTask(Task, OptRunInlineIndex);
+	}
+}
 
-	int32 PreviousWaitCount = Task->WaitCount.Sub(ThreadingModel, 1);
-	if (PreviousWaitCount <= 1)
+void FEntitySystemScheduler::SignalChildTasks(const FScheduledTask* ParentTask) const
+{
+	const FScheduledTask* Children = ParentTask + 1;
+	if (bPrioritizeCriticalPath)
 	{
-		if (PreviousWaitCount <= 0)
+		FReadyTaskArray ReadyTasks;
+		for (uint16 ChildIndex = 0; ChildIndex < ParentTask->NumChildren; ++ChildIndex)
 		{
-			// This is an error
-			ensureMsgf(false, TEXT("Sequencer Task Prerequisite Count underflow!"));
-			if (GameThreadSignal)
+			if (ConsumePrerequisite(&Children[ChildIndex]))
 			{
-				// Trigger the game thread to wake up if necessary
-				GameThreadSignal->Trigger();
+				ReadyTasks.Add(&Children[ChildIndex]);
 			}
 		}
-		else if (ThreadingModel == EEntityThreadingModel::NoThreading)
+		DispatchReadyTasks(ReadyTasks, nullptr);
+	}
+	else
+	{
+		for (uint16 ChildIndex = 0; ChildIndex < ParentTask->NumChildren; ++ChildIndex)
 		{
-			Task->Run(this, FTaskExecutionFlags());
+			PrerequisiteCompleted(&Children[ChildIndex], nullptr);
 		}
-		else if (Task->bForceInline)
-		{
-			FTaskExecutionFlags Flags;
-			// Don't let the completion of this task inline any others
-			// to prevent cascades of inlined tasks suffocating the dispatch of others
-			Flags.bCanInlineSubsequents = false;
+	}
+}
 
-			Task->Run(this, Flags);
-		}
-		else if (Task->bForceGameThread)
+bool FEntitySystemScheduler::ConsumePrerequisite(const FScheduledTask* Task) const
+{
+	// We either need to not be using threading, be using replay workers, or have a valid game thread signal event!
+	check((ThreadingModel == EEntityThreadingModel::NoThreading) || (NumReplayWorkers > 0) || (GameThreadSignal != nullptr));
+
+	const int32 PreviousWaitCount = Task->WaitCount.Sub(ThreadingModel, 1);
+	if (PreviousWaitCount <= 0)
+	{
+		// This is an error
+		ensureMsgf(false, TEXT("Sequencer Task Prerequisite Count underflow!"));
+		if (GameThreadSignal)
 		{
-			// Push this onto the GT list even if we are already on the game thread.
-			// This ensures other subsequent tasks being processed in the same loop
-			// have a chance to be scheduled before we do any potentially time-consuming task work.
-			GameThreadTaskList.Push(const_cast<FScheduledTask*>(Task));
+			// Trigger the game thread to wake up if necessary
 			GameThreadSignal->Trigger();
 		}
-		else if (OptRunInlineIndex && *OptRunInlineIndex == INDEX_NONE)
-		{
-			const int32 TaskIndex = (Task - Tasks.GetData());
-			*OptRunInlineIndex = TaskIndex;
-		}
-		else if (GameThreadTaskList.IsEmpty())
+		return false;
+	}
+
+	return PreviousWaitCount == 1;
+}
+
+void FEntitySystemScheduler::DispatchReadyTasks(FReadyTaskArray& ReadyTasks, int32* OptRunInlineIndex) const
+{
+	// Dispatch the tasks with the longest chain of dependent work first. The first task that can be inlined will be the longest.
+	if (ReadyTasks.Num() > 1)
+	{
+		Algo::Sort(ReadyTasks, [](const FScheduledTask* A, const FScheduledTask* B){ return A->CriticalPathCycles > B->CriticalPathCycles; });
+	}
+
+	for (const FScheduledTask* Task : ReadyTasks)
+	{
+		DispatchReadyTask(Task, OptRunInlineIndex);
+	}
+}
+
+void FEntitySystemScheduler::DispatchReadyTask(const FScheduledTask* Task, int32* OptRunInlineIndex) const
+{
+	if (ThreadingModel == EEntityThreadingModel::NoThreading)
+	{
+		Task->Run(this, FTaskExecutionFlags());
+	}
+	else if (Task->bForceInline)
+	{
+		FTaskExecutionFlags Flags;
+		// Don't let the completion of this task inline any others
+		// to prevent cascades of inlined tasks suffocating the dispatch of others
+		Flags.bCanInlineSubsequents = false;
+
+		Task->Run(this, Flags);
+	}
+	else if (Task->bForceGameThread)
+	{
+		// Push this onto the GT list even if we are already on the game thread.
+		// This ensures other subsequent tasks being processed in the same loop
+		// have a chance to be scheduled before we do any potentially time-consuming task work.
+		GameThreadTaskList.Push(const_cast<FScheduledTask*>(Task));
+		if (GameThreadSignal)
 		{
-			GameThreadTaskList.Push(const_cast<FScheduledTask*>(Task));
 			GameThreadSignal->Trigger();
 		}
-		else
+		else if (NumReplayWorkers > 0)
 		{
-			UE::Tasks::Launch(TEXT("MovieSceneTask"), [this, Task](){
-				Task->Run(this, FTaskExecutionFlags());
-			}, UE::Tasks::ETaskPriority::High);
+			ReplayWorkAvailable.Notify();
 		}
 	}
+	else if (OptRunInlineIndex && *OptRunInlineIndex == INDEX_NONE)
+	{
+		const int32 TaskIndex = (Task - Tasks.GetData());
+		*OptRunInlineIndex = TaskIndex;
+	}
+	else if (NumReplayWorkers > 0)
+	{
+		// Replay workers are already running, so just make this task available to them and wake any that are parked
+		ReadyTaskList.Push(const_cast<FScheduledTask*>(Task));
+		ReplayWorkAvailable.Notify();
+	}
+	else if (GameThreadTaskList.IsEmpty())
+	{
+		GameThreadTaskList.Push(const_cast<FScheduledTask*>(Task));
+		GameThreadSignal->Trigger();
+	}
+	else
+	{
+		UE::Tasks::Launch(TEXT("MovieSceneTask"), [this, Task](){
+			Task->Run(this, FTaskExecutionFlags());
+		}, UE::Tasks::ETaskPriority::High);
+	}
 }
 
 void FEntitySystemScheduler::OnAllTasksFinished() const
 {
 	if (ThreadingModel != EEntityThreadingModel::NoThreading)
 	{
-		GameThreadSignal->Trigger();
+		if (GameThreadSignal)
+		{
+			GameThreadSignal->Trigger();
+		}
 		NumTasksRemaining.Sub(ThreadingModel, 1);
+
+		if (NumReplayWorkers > 0)
+		{
+			// Wake the game thread so that it can finish the replay
+			ReplayWorkAvailable.Notify();
+		}
 	}
 }
 
@@ -751,8 +1259,25 @@ void FEntitySystemScheduler::BeginConstruction()
 	WriteContextBase = FEntityAllocationWriteContext(*EntityManager);
 	SystemSerialIncrement = EntityManager->GetSystemSerial();
 
+	TaskTraceNames.Reset();
+
+	// Remember how long each task took so that new tasks doing the same work can be prioritized immediately
+	TaskCycleHistory.Reset();
+	for (const FScheduledTask& Task : Tasks)
+	{
+		if (Task.MeasuredCycles != 0)
+		{
+			const uint32 Key = GetTaskHistoryKey(Task);
+			if (Key != 0)
+			{
+				TaskCycleHistory.Add(Key, Task.MeasuredCycles);
+			}
+		}
+	}
+
 	Tasks.Reset();
 	InitialTasks = FTaskBitSet();
+	PrioritizedInitialTasks.Reset();
 }
 
 void FEntitySystemScheduler::BeginSystem(uint16 NodeID)
@@ -807,6 +1332,18 @@ void FEntitySystemScheduler::EndConstruction()
 		}
 	}
 
+	for (FScheduledTask& Task : Tasks)
+	{
+		const uint32 Key = GetTaskHistoryKey(Task);
+		if (const uint64* PreviousCycles = Key != 0 ? TaskCycleHistory.Find(Key) : nullptr)
+		{
+			Task.MeasuredCycles = *PreviousCycles;
+		}
+	}
+	TaskCycleHistory.Reset();
+
+	UpdateCriticalPaths();
+
 #if WITH_AUTOMATION_TESTS && (!UE_BUILD_SHIPPING && !UE_BUILD_TEST)
 	if (GIsAutomationTesting)
 	{
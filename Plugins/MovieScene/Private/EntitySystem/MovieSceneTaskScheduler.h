@@ -6,6 +6,7 @@
 #include "Containers/Map.h"
 #include "Containers/Array.h"
 #include "Tasks/Task.h"
+#include "Async/EventCount.h"
 #include "Containers/LockFreeList.h"
 #include "Containers/StringView.h"
 #include "EntitySystem/RelativePtr.h"
@@ -14,6 +15,8 @@
 #include "EntitySystem/MovieSceneMaybeAtomic.h"
 #include "Misc/TransactionallySafeCriticalSection.h"
 
+#include <atomic>
+
 namespace UE::MovieScene
 {
 
@@ -142,6 +145,11 @@ struct FScheduledTask
 	/** 8 Bytes - Write context offset for this task. Added to the current Entity Manager write context on execution. */
 	FEntityAllocationWriteContext WriteContextOffset;
 
+	/** 8 Bytes - The time taken to run this task's function the last time it was executed, in cycles. Only written by the thread that runs this task. */
+	mutable uint64 MeasuredCycles = 0;
+	/** 8 Bytes - The length of the longest chain of tasks that must run after this one begins (including this task), in cycles. Used to prioritize dispatch. */
+	uint64 CriticalPathCycles = 0;
+
 	/** 6 bytes - Pre-locked component data specifying the direct pointers to the data required by this task */
 	FLockedComponentData LockedComponentData;
 
@@ -167,6 +175,19 @@ struct FScheduledTask
 	uint8 bForceInline : 1;
 };
 
+/**
+ * Execution statistics for the task graph
+ */
+struct FEntitySystemSchedulerStats
+{
+	/** The wall-clock time taken to run all tasks the last time they were executed */
+	double MakespanSeconds = 0.0;
+	/** The sum of all task durations the last time they were executed */
+	double TotalWorkSeconds = 0.0;
+	/** The length of the longest chain of dependent tasks as of the last time critical paths were computed. This is the lower bound for MakespanSeconds. */
+	double CriticalPathSeconds = 0.0;
+};
+
 class FEntitySystemScheduler : public IEntitySystemScheduler
 {
 public:
@@ -312,17 +333,112 @@ public:
 	void PrerequisiteCompleted(FTaskID TaskID, int32* OptRunInlineIndex) const;
 	void PrerequisiteCompleted(const FScheduledTask* Task, int32* OptRunInlineIndex) const;
 
+	/**
+	 * Called when a parent task has run to signal each of its children, scheduling those that are ready longest critical path first
+	 */
+	void SignalChildTasks(const FScheduledTask* ParentTask) const;
+
 	/**
 	 * Called when all tasks have been completed
 	 */
 	void OnAllTasksFinished() const;
 
+	/**
+	 * Check whether task durations are being measured during the current execution
+	 */
+	bool IsMeasuringTasks() const
+	{
+		return bMeasureTasks;
+	}
+
+	/**
+	 * Retrieve execution statistics for the last time ExecuteTasks was called with Sequencer.CustomTaskScheduling.MeasureTasks enabled
+	 */
+	const FEntitySystemSchedulerStats& GetExecutionStats() const
+	{
+		return ExecutionStats;
+	}
+
 	/*~ End execution functionality */
 
 public:
 
 	FString ToString() const;
 
+private:
+
+	using FReadyTaskArray = TArray<const FScheduledTask*, TInlineAllocator<16>>;
+
+	/**
+	 * Decrement the specified task's wait count, returning true if it is now ready to run
+	 */
+	bool ConsumePrerequisite(const FScheduledTask* Task) const;
+
+	/**
+	 * Dispatch a task whose prerequisites have all completed
+	 */
+	void DispatchReadyTask(const FScheduledTask* Task, int32* OptRunInlineIndex) const;
+
+	/**
+	 * Dispatch all the specified ready tasks, longest critical path first
+	 */
+	void DispatchReadyTasks(FReadyTaskArray& ReadyTasks, int32* OptRunInlineIndex) const;
+
+	/**
+	 * Execute all tasks on the specified number of persistent worker threads (plus the game thread) that pull ready tasks from lock-free queues until the whole graph has completed
+	 */
+	void ExecuteTasksWithReplayWorkers(int32 NumWorkers);
+
+	/**
+	 * Run game thread and ready tasks on the game thread until all tasks in the graph have completed
+	 */
+	void RunReplayGameThreadLoop() const;
+
+	/**
+	 * Run ready tasks on a replay worker thread, parking whenever there are none, until StopReplayWorkers is called
+	 */
+	void RunReplayWorkerThread() const;
+
+	/**
+	 * Ensure that exactly NumWorkers replay worker threads are running
+	 */
+	void StartReplayWorkers(int32 NumWorkers);
+
+	/**
+	 * Stop and destroy all replay worker threads
+	 */
+	void StopReplayWorkers();
+
+	/**
+	 * Cache the name of each task for recording into FEntitySystemTraceRecorder. Must be called before tasks are run.
+	 */
+	void CacheTaskTraceNames();
+
+	/**
+	 * Record the execution of a single task into FEntitySystemTraceRecorder
+	 */
+	void RecordTraceEvent(const FScheduledTask* Task, uint64 StartCycles, uint64 EndCycles) const;
+
+	/**
+	 * Update execution statistics after all tasks have been run, and periodically recompute critical paths
+	 */
+	void UpdateExecutionStats(double MakespanSeconds);
+
+	/**
+	 * Recompute the critical path length of every task from their measured durations, and the dispatch order of initial tasks
+	 */
+	void UpdateCriticalPaths();
+
+	/**
+	 * Compute the critical path length for a single task and all tasks that it depends on
+	 */
+	uint64 ComputeCriticalPath(int32 TaskIndex, TBitArray<>& VisitedTasks);
+
+	/**
+	 * Compute a key for the specified task that is stable between re-constructions of the task graph
+	 */
+	static uint32 GetTaskHistoryKey(const FScheduledTask& Task);
+
 private:
 	/** Array of task data. Constant once EndConstruction has been called */
 	TArray<FScheduledTask> Tasks;
@@ -336,6 +452,21 @@ private:
 	/** Sparse bit set of all the tasks that have no prerequisites. Only valid after EndConstruction has been called. */
 	FTaskBitSet InitialTasks;
 
+	/** Indices of all the tasks within InitialTasks, sorted by descending critical path length. Only valid after EndConstruction has been called. */
+	TArray<int32> PrioritizedInitialTasks;
+
+	/** Measured task durations from previous task graphs, keyed by GetTaskHistoryKey. Used to seed critical path lengths for newly constructed tasks. */
+	TMap<uint32, uint64> TaskCycleHistory;
+
+	/** Name of each task for recording into FEntitySystemTraceRecorder. Only populated while the trace recorder is recording. */
+	TArray<FName> TaskTraceNames;
+
+	/** Execution statistics from the last call to ExecuteTasks */
+	FEntitySystemSchedulerStats ExecutionStats;
+
+	/** The number of times ExecuteTasks has been called since critical paths were last computed */
+	int32 NumExecutionsSinceCriticalPathUpdate = 0;
+
 	struct FComponentDependencies
 	{
 		FTaskBitSet ReadTasks;
@@ -352,9 +483,26 @@ private:
 
 	FEvent* GameThreadSignal = nullptr;
 	mutable TLockFreePointerListFIFO<FScheduledTask, PLATFORM_CACHE_LINE_SIZE> GameThreadTaskList;
+	/** Queue of tasks that are ready to be run by any replay worker. Only used while NumReplayWorkers is non-zero. */
+	mutable TLockFreePointerListFIFO<FScheduledTask, PLATFORM_CACHE_LINE_SIZE> ReadyTaskList;
+	/** The number of replay worker loops running the current execution, or 0 if tasks are being launched individually */
+	int32 NumReplayWorkers = 0;
+	/** Dedicated replay worker threads that persist across executions while replay mode is active */
+	class FReplayWorkerThread;
+	TArray<TUniquePtr<FReplayWorkerThread>> ReplayWorkerThreads;
+	/** Notified whenever tasks become ready for replay workers, when the graph completes, and when replay workers should stop */
+	mutable UE::FEventCount ReplayWorkAvailable;
+	/** The number of tasks currently being run by replay worker threads */
+	mutable std::atomic<int32> NumRunningReplayTasks = 0;
+	/** Set when replay worker threads should exit */
+	std::atomic<bool> bStopReplayWorkers = false;
 	FEntityAllocationWriteContext WriteContextBase = FEntityAllocationWriteContext::NewAllocation();
 	uint32 SystemSerialIncrement = 0;
 	EEntityThreadingModel ThreadingModel = EEntityThreadingModel::NoThreading;
+	/** Whether critical path scheduling is enabled for the current execution. Cached from Sequencer.CustomTaskScheduling.CriticalPathPriority */
+	bool bPrioritizeCriticalPath = false;
+	/** Whether task durations are measured for the current execution. Cached from Sequencer.CustomTaskScheduling.MeasureTasks */
+	bool bMeasureTasks = false;
 };
 
 
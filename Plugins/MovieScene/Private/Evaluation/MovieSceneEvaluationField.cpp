@@ -169,6 +169,23 @@ void FMovieSceneEntityComponentField::QueryPersistentEntities(FFrameNumber Query
 	}
 }
 
+void FMovieSceneEntityComponentField::QueryPersistentEntities(const TRange<FFrameNumber>& QueryRange, FMovieSceneEvaluationFieldEntitySet& OutEntities) const
+{
+	FMovieSceneEvaluationTreeRangeIterator Iterator = PersistentEntityTree.SerializedData.IterateFromLowerBound(QueryRange.GetLowerBound());
+	check(Iterator);
+
+	for ( ; Iterator && QueryRange.Overlaps(Iterator.Range()); ++Iterator )
+	{
+		for (FMovieSceneEvaluationFieldEntityTree::FEntityAndMetaDataIndex Pair : PersistentEntityTree.SerializedData.GetAllData(Iterator.Node()))
+		{
+			OutEntities.Add(FMovieSceneEvaluationFieldEntityQuery{
+				GetEntity(Pair.EntityIndex),
+				Pair.MetaDataIndex
+			});
+		}
+	}
+}
+
 bool FMovieSceneEntityComponentField::HasAnyOneShotEntities() const
 {
 	return !OneShotEntityTree.SerializedData.IsEmpty();
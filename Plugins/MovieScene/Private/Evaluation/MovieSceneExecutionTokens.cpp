@@ -3,14 +3,141 @@
 #include "Evaluation/MovieSceneExecutionTokens.h"
 #include "IMovieScenePlayer.h"
 #include "Algo/Sort.h"
+#include "Templates/MemoryOps.h"
 
 
 DECLARE_CYCLE_STAT(TEXT("Apply Execution Tokens"), MovieSceneEval_ApplyExecutionTokens, STATGROUP_MovieSceneEval);
 DECLARE_CYCLE_STAT(TEXT("Apply Execution Token"), MovieSceneEval_ApplyExecutionToken, STATGROUP_MovieSceneEval);
 
-bool SortTokens(const TInlineValue<IMovieSceneSharedExecutionToken, 32>& A, const TInlineValue<IMovieSceneSharedExecutionToken, 32>& B)
+/** The minimum size of each block allocated by FMovieSceneExecutionTokenArena */
+static constexpr SIZE_T ExecutionTokenArenaBlockSize = 16 * 1024;
+
+FMovieSceneExecutionTokenArena::~FMovieSceneExecutionTokenArena()
+{
+	FreeBlocks();
+}
+
+FMovieSceneExecutionTokenArena::FMovieSceneExecutionTokenArena(FMovieSceneExecutionTokenArena&& RHS)
+	: Blocks(MoveTemp(RHS.Blocks))
+	, CurrentBlock(RHS.CurrentBlock)
+	, CurrentOffset(RHS.CurrentOffset)
+{
+	RHS.Blocks.Empty();
+	RHS.CurrentBlock = 0;
+	RHS.CurrentOffset = 0;
+}
+
+FMovieSceneExecutionTokenArena& FMovieSceneExecutionTokenArena::operator=(FMovieSceneExecutionTokenArena&& RHS)
+{
+	if (this != &RHS)
+	{
+		FreeBlocks();
+
+		Blocks = MoveTemp(RHS.Blocks);
+		CurrentBlock = RHS.CurrentBlock;
+		CurrentOffset = RHS.CurrentOffset;
+
+		RHS.Blocks.Empty();
+		RHS.CurrentBlock = 0;
+		RHS.CurrentOffset = 0;
+	}
+	return *this;
+}
+
+void* FMovieSceneExecutionTokenArena::AllocateSlow(SIZE_T Size, SIZE_T Alignment)
+{
+	// Blocks are only ever appended between resets, so the current block is always the last one (if any)
+	const SIZE_T BlockSize = FMath::Max(ExecutionTokenArenaBlockSize, Size + Alignment);
+
+	FBlock NewBlock;
+	NewBlock.Memory = static_cast<uint8*>(FMemory::Malloc(BlockSize));
+	NewBlock.Size   = BlockSize;
+
+	CurrentBlock = Blocks.Add(NewBlock);
+
+	uint8* Result = Align(NewBlock.Memory, Alignment);
+	CurrentOffset = static_cast<SIZE_T>(Result + Size - NewBlock.Memory);
+	return Result;
+}
+
+void FMovieSceneExecutionTokenArena::Reset()
 {
-	return A->Order < B->Order;
+	// If the last evaluation overflowed into more than one block, consolidate them all into a single block
+	// so that subsequent evaluations of the same size are serviced entirely from the fast path
+	if (Blocks.Num() > 1)
+	{
+		SIZE_T TotalSize = 0;
+		for (const FBlock& Block : Blocks)
+		{
+			TotalSize += Block.Size;
+		}
+
+		FreeBlocks();
+
+		FBlock NewBlock;
+		NewBlock.Memory = static_cast<uint8*>(FMemory::Malloc(TotalSize));
+		NewBlock.Size   = TotalSize;
+		Blocks.Add(NewBlock);
+	}
+
+	CurrentBlock = 0;
+	CurrentOffset = 0;
+}
+
+void FMovieSceneExecutionTokenArena::FreeBlocks()
+{
+	for (const FBlock& Block : Blocks)
+	{
+		FMemory::Free(Block.Memory);
+	}
+	Blocks.Reset();
+}
+
+FMovieSceneExecutionTokens& FMovieSceneExecutionTokens::operator=(FMovieSceneExecutionTokens&& RHS)
+{
+	if (this != &RHS)
+	{
+		// Tokens that were never applied still need to be destroyed before the arena that owns them is replaced
+		DiscardTokens();
+
+		OrderedTokens = MoveTemp(RHS.OrderedTokens);
+		SharedTokens = MoveTemp(RHS.SharedTokens);
+		SortedSharedTokens = MoveTemp(RHS.SortedSharedTokens);
+		Arena = MoveTemp(RHS.Arena);
+		BlendingAccumulator = MoveTemp(RHS.BlendingAccumulator);
+		Operand = MoveTemp(RHS.Operand);
+		Scope = MoveTemp(RHS.Scope);
+		Context = MoveTemp(RHS.Context);
+	}
+	return *this;
+}
+
+FMovieSceneExecutionTokens::~FMovieSceneExecutionTokens()
+{
+	DiscardTokens();
+}
+
+void FMovieSceneExecutionTokens::DiscardTokens()
+{
+	// Tokens must be destroyed through their virtual destructors since they are only referenced through their interfaces.
+	// DestructItem would call the interface's destructor directly and skip the derived type's.
+	for (FEntry& Entry : OrderedTokens)
+	{
+		Entry.Token->~IMovieSceneExecutionToken();
+	}
+	for (TPair<FMovieSceneSharedDataId, IMovieSceneSharedExecutionToken*>& Pair : SharedTokens)
+	{
+		Pair.Value->~IMovieSceneSharedExecutionToken();
+	}
+
+	OrderedTokens.Reset();
+	SharedTokens.Reset();
+	Arena.Reset();
+}
+
+bool SortTokens(const IMovieSceneSharedExecutionToken& A, const IMovieSceneSharedExecutionToken& B)
+{
+	return A.Order < B.Order;
 }
 
 void FMovieSceneExecutionTokens::Apply(const FMovieSceneContext& RootContext, IMovieScenePlayer& Player)
@@ -19,15 +146,17 @@ void FMovieSceneExecutionTokens::Apply(const FMovieSceneContext& RootContext, IM
 
 	FPersistentEvaluationData PersistentDataProxy(Player);
 
-	TArray<TInlineValue<IMovieSceneSharedExecutionToken, 32>> SortedSharedTokens;
+	// Tokens live in the arena so sorting only shuffles pointers
+	SortedSharedTokens.Reset();
 	SortedSharedTokens.Reserve(SharedTokens.Num());
 
-	for (auto& Pair : SharedTokens)
+	for (TPair<FMovieSceneSharedDataId, IMovieSceneSharedExecutionToken*>& Pair : SharedTokens)
 	{
-		SortedSharedTokens.Add(MoveTemp(Pair.Value));
+		SortedSharedTokens.Add(Pair.Value);
 	}
+	SharedTokens.Reset();
 
-	Algo::Sort(SortedSharedTokens, SortTokens);
+	Algo::Sort(SortedSharedTokens, [](const IMovieSceneSharedExecutionToken* A, const IMovieSceneSharedExecutionToken* B) { return SortTokens(*A, *B); });
 
 	// Reset track and section keys
 	PersistentDataProxy.SetSectionKey(FMovieSceneEvaluationKey());
@@ -36,7 +165,7 @@ void FMovieSceneExecutionTokens::Apply(const FMovieSceneContext& RootContext, IM
 	int32 SharedTokenIndex = 0;
 	while (SharedTokenIndex < SortedSharedTokens.Num())
 	{
-		IMovieSceneSharedExecutionToken& Token = SortedSharedTokens[SharedTokenIndex].GetValue();
+		IMovieSceneSharedExecutionToken& Token = *SortedSharedTokens[SharedTokenIndex];
 		if (Token.Order <= 0)
 		{
 			Token.Execute(PersistentDataProxy, Player);
@@ -59,6 +188,8 @@ void FMovieSceneExecutionTokens::Apply(const FMovieSceneContext& RootContext, IM
 			MOVIESCENE_DETAILED_SCOPE_CYCLE_COUNTER(MovieSceneEval_ApplyExecutionToken);
 			Entry.Token->Execute(Entry.Context, Entry.Operand, PersistentDataProxy, Player);
 		}
+
+		Entry.Token->~IMovieSceneExecutionToken();
 	}
 
 	OrderedTokens.Reset();
@@ -72,7 +203,14 @@ void FMovieSceneExecutionTokens::Apply(const FMovieSceneContext& RootContext, IM
 		SortedSharedTokens[SharedTokenIndex++]->Execute(PersistentDataProxy, Player);
 	}
 
-	SharedTokens.Reset();
+	for (IMovieSceneSharedExecutionToken* Token : SortedSharedTokens)
+	{
+		Token->~IMovieSceneSharedExecutionToken();
+	}
+	SortedSharedTokens.Reset();
+
+	// All tokens have now been destroyed - rewind the arena without releasing its memory
+	Arena.Reset();
 
 	BlendingAccumulator.Apply(RootContext, PersistentDataProxy, Player);
 }
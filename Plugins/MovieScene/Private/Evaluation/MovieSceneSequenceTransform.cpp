@@ -41,6 +41,30 @@ namespace UE::MovieScene
 		}
 	}
 
+	/**
+	 * Attempt to fold a linear transform into the last entry of a nested transform stack where that entry is also linear.
+	 * Consecutive linear levels always collapse into a single offset and scale such that transforming a time only ever
+	 * visits one linear level between each warping level, regardless of how deep the hierarchy is.
+	 */
+	bool TryFoldLinearTransform(TArray<FMovieSceneNestedSequenceTransform>& NestedTransforms, const FMovieSceneTimeTransform& InTransform)
+	{
+		if (NestedTransforms.Num() == 0 || !NestedTransforms.Last().IsLinear())
+		{
+			return false;
+		}
+
+		const FMovieSceneTimeTransform Folded = InTransform * NestedTransforms.Last().AsLinear();
+		if (Folded.IsIdentity())
+		{
+			NestedTransforms.Pop(EAllowShrinking::No);
+		}
+		else
+		{
+			NestedTransforms.Last() = FMovieSceneNestedSequenceTransform(Folded);
+		}
+		return true;
+	}
+
 	FTransformTimeParams& FTransformTimeParams::HarvestBreadcrumbs(FMovieSceneTransformBreadcrumbs& OutBreadcrumbs)
 	{
 		OutBreadcrumbs.Reset();
@@ -865,7 +889,7 @@ void FMovieSceneSequenceTransform::Add(FMovieSceneTimeTransform InTransform)
 	{
 		LinearTransform = InTransform * LinearTransform;
 	}
-	else
+	else if (!UE::MovieScene::TryFoldLinearTransform(NestedTransforms, InTransform))
 	{
 		NestedTransforms.Emplace(InTransform);
 	}
@@ -878,9 +902,9 @@ void FMovieSceneSequenceTransform::Add(FMovieSceneNestedSequenceTransform InTran
 		return;
 	}
 
-	if (IsLinear() && InTransform.IsLinear())
+	if (InTransform.IsLinear())
 	{
-		LinearTransform = InTransform.AsLinear() * LinearTransform;
+		Add(InTransform.AsLinear());
 	}
 	else
 	{
@@ -1096,19 +1120,13 @@ FMovieSceneInverseSequenceTransform FMovieSceneSequenceTransform::Inverse() cons
 
 void FMovieSceneSequenceTransform::Append(const FMovieSceneSequenceTransform& Tail)
 {
-	if (IsLinear())
-	{
-		if (!Tail.LinearTransform.IsIdentity())
-		{
-			LinearTransform = Tail.LinearTransform * LinearTransform;
-		}
-	}
-	else if (!Tail.LinearTransform.IsIdentity())
+	Add(Tail.LinearTransform);
+
+	NestedTransforms.Reserve(NestedTransforms.Num() + Tail.NestedTransforms.Num());
+	for (const FMovieSceneNestedSequenceTransform& Nested : Tail.NestedTransforms)
 	{
-		NestedTransforms.Add(Tail.LinearTransform);
+		Add(Nested);
 	}
-
-	NestedTransforms.Append(Tail.NestedTransforms);
 }
 
 FMovieSceneSequenceTransform FMovieSceneSequenceTransform::operator*(const FMovieSceneSequenceTransform& RHS) const
@@ -1155,12 +1173,7 @@ FMovieSceneSequenceTransform FMovieSceneSequenceTransform::operator*(const FMovi
 		// because whatever linear placement/scaling it has would be in the linear part of the nested transform
 		// struct.
 		FMovieSceneSequenceTransform Result(RHS);
-		const bool bHasOnlyNested = LinearTransform.IsIdentity();
-		if (!bHasOnlyNested)
-		{
-			Result.NestedTransforms.Add(FMovieSceneNestedSequenceTransform(LinearTransform));
-		}
-		Result.NestedTransforms.Append(NestedTransforms);
+		Result.Append(*this);
 		return Result;
 	}
 }
@@ -7,12 +7,69 @@
 #include "MovieSceneSpawnableAnnotation.h"
 #include "MovieSceneBindingReferences.h"
 #include "Bindings/MovieSceneSpawnableBinding.h"
+#include "EntitySystem/MovieSceneSharedPlaybackState.h"
+#include "EntitySystem/MovieSceneSpawnablesSystem.h"
+#include "Evaluation/MovieSceneAnimTypeID.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
 
 UE_DEFINE_MOVIESCENE_PLAYBACK_CAPABILITY(FMovieSceneSpawnRegister)
 
+namespace UE::MovieScene
+{
+	/** CVar that enables parking spawned objects in a pool when they are no longer needed, so that they can be reused for the next spawn of the same template */
+	bool GSequencerSpawnablePooling = false;
+	static FAutoConsoleVariableRef CVarSequencerSpawnablePooling(
+		TEXT("Sequencer.SpawnablePool.Enable"),
+		GSequencerSpawnablePooling,
+		TEXT("(Default: false. When enabled, spawnables that leave their spawn range are deactivated and parked rather than destroyed, and reused the next time the same template is spawned. Reused objects are reset through their captured pre-animated state.")
+		);
+
+	/** CVar that defines the maximum number of objects to park for any one spawnable template */
+	int32 GSequencerSpawnablePoolMaxPerTemplate = 4;
+	static FAutoConsoleVariableRef CVarSequencerSpawnablePoolMaxPerTemplate(
+		TEXT("Sequencer.SpawnablePool.MaxPerTemplate"),
+		GSequencerSpawnablePoolMaxPerTemplate,
+		TEXT("(Default: 4. The maximum number of deactivated objects to keep in the spawnable pool for each spawnable template.")
+		);
+}
+
 FMovieSceneSpawnRegister::FMovieSceneSpawnRegister() = default;
 FMovieSceneSpawnRegister::FMovieSceneSpawnRegister(const FMovieSceneSpawnRegister&) = default;
-FMovieSceneSpawnRegister::~FMovieSceneSpawnRegister() = default;
+
+FMovieSceneSpawnRegister::~FMovieSceneSpawnRegister()
+{
+	if (SpawnablePool.Num() == 0 || !UObjectInitialized())
+	{
+		return;
+	}
+
+	// Any derived register has already been destroyed, so PreDestroyObject and DestroySpawnedObject can no longer be called.
+	// Destroy whatever is left in the pool directly rather than leaking deactivated objects.
+	TMap<FSpawnablePoolKey, TArray<FPooledObject>> PooledObjects = MoveTemp(SpawnablePool);
+	for (TPair<FSpawnablePoolKey, TArray<FPooledObject>>& Pair : PooledObjects)
+	{
+		for (const FPooledObject& PooledObject : Pair.Value)
+		{
+			UObject* Object = PooledObject.Object.Get();
+			if (!Object)
+			{
+				continue;
+			}
+
+			if (UMovieSceneSpawnableBindingBase* CustomSpawnableBinding = PooledObject.CustomSpawnableBinding.Get())
+			{
+				CustomSpawnableBinding->PreDestroyObject(Object, PooledObject.BindingId, PooledObject.BindingIndex, PooledObject.TemplateID);
+				CustomSpawnableBinding->DestroySpawnedObject(Object);
+			}
+			else if (AActor* Actor = Cast<AActor>(Object))
+			{
+				Actor->Destroy();
+			}
+		}
+	}
+}
 
 TWeakObjectPtr<> FMovieSceneSpawnRegister::FindSpawnedObject(const FGuid& BindingId, FMovieSceneSequenceIDRef TemplateID, int BindingIndex/* = 0*/) const
 {
@@ -37,6 +94,12 @@ UObject* FMovieSceneSpawnRegister::SpawnObject(const FGuid& BindingId, UMovieSce
 	UObject* SpawnedActor = nullptr; 
 	ESpawnOwnership SpawnOwnership = ESpawnOwnership::InnerSequence;
 
+	const bool bUsePool = UE::MovieScene::GSequencerSpawnablePooling;
+	const double SpawnStartTime = bUsePool ? FPlatformTime::Seconds() : 0.0;
+
+	FSpawnablePoolKey PoolKey;
+	bool bReusedPooledObject = false;
+
 	UMovieSceneSequence* Sequence = SharedPlaybackState->GetSequence(TemplateID);
 	if (!ensure(Sequence))
 	{
@@ -54,8 +117,18 @@ UObject* FMovieSceneSpawnRegister::SpawnObject(const FGuid& BindingId, UMovieSce
 
 		SpawnOwnership = Spawnable->GetSpawnOwnership();
 
-		// Call through to the list of spawners to see who can spawn something from this FMovieSceneSpawnable
-		SpawnedActor = SpawnObject(*Spawnable, TemplateID, SharedPlaybackState);
+		if (bUsePool && SpawnOwnership != ESpawnOwnership::External)
+		{
+			PoolKey = FSpawnablePoolKey(Spawnable->GetObjectTemplate(), BindingIndex);
+			SpawnedActor = TakePooledObject(PoolKey, SharedPlaybackState);
+			bReusedPooledObject = SpawnedActor != nullptr;
+		}
+
+		if (!SpawnedActor)
+		{
+			// Call through to the list of spawners to see who can spawn something from this FMovieSceneSpawnable
+			SpawnedActor = SpawnObject(*Spawnable, TemplateID, SharedPlaybackState);
+		}
 	}
 	else if (UMovieSceneSequence* MovieSceneSequence = MovieScene.GetTypedOuter<UMovieSceneSequence>())
 	{
@@ -72,8 +145,18 @@ UObject* FMovieSceneSpawnRegister::SpawnObject(const FGuid& BindingId, UMovieSce
 
 					SpawnOwnership = SpawnableBinding->SpawnOwnership;
 
-					// Call the Spawnable binding itself to spawn the object
-					SpawnedActor = SpawnableBinding->SpawnObject(BindingId, BindingIndex, MovieScene, TemplateID, SharedPlaybackState);
+					if (bUsePool && SpawnOwnership != ESpawnOwnership::External)
+					{
+						PoolKey = FSpawnablePoolKey(SpawnableBinding, BindingIndex);
+						SpawnedActor = TakePooledObject(PoolKey, SharedPlaybackState);
+						bReusedPooledObject = SpawnedActor != nullptr;
+					}
+
+					if (!SpawnedActor)
+					{
+						// Call the Spawnable binding itself to spawn the object
+						SpawnedActor = SpawnableBinding->SpawnObject(BindingId, BindingIndex, MovieScene, TemplateID, SharedPlaybackState);
+					}
 				}
 			}
 		}
@@ -84,7 +167,23 @@ UObject* FMovieSceneSpawnRegister::SpawnObject(const FGuid& BindingId, UMovieSce
 		FMovieSceneSpawnableAnnotation::Add(SpawnedActor, BindingId, TemplateID, Sequence);
 
 		FMovieSceneSpawnRegisterKey Key(TemplateID, BindingId, BindingIndex);
-		Register.Add(Key, FSpawnedObject(BindingId, *SpawnedActor, SpawnOwnership));
+		FSpawnedObject& NewSpawnedObject = Register.Add(Key, FSpawnedObject(BindingId, *SpawnedActor, SpawnOwnership));
+		NewSpawnedObject.PoolKey = PoolKey;
+
+		if (PoolKey)
+		{
+			const double SpawnSeconds = FPlatformTime::Seconds() - SpawnStartTime;
+			if (bReusedPooledObject)
+			{
+				++PoolStats.NumHits;
+				PoolStats.ReuseSeconds += SpawnSeconds;
+			}
+			else
+			{
+				++PoolStats.NumMisses;
+				PoolStats.SpawnSeconds += SpawnSeconds;
+			}
+		}
 
 		if (FMovieSceneEvaluationState* State = SharedPlaybackState->FindCapability<FMovieSceneEvaluationState>())
 		{
@@ -95,6 +194,72 @@ UObject* FMovieSceneSpawnRegister::SpawnObject(const FGuid& BindingId, UMovieSce
 	return SpawnedActor;
 }
 
+bool FMovieSceneSpawnRegister::PreSpawnObject(const FGuid& BindingId, UMovieScene& MovieScene, FMovieSceneSequenceIDRef TemplateID, TSharedRef<const FSharedPlaybackState> SharedPlaybackState, int32 BindingIndex)
+{
+	if (!UE::MovieScene::GSequencerSpawnablePooling || FindSpawnedObject(BindingId, TemplateID, BindingIndex).IsValid())
+	{
+		return false;
+	}
+
+	FSpawnablePoolKey PoolKey;
+	FMovieSceneSpawnable* Spawnable = MovieScene.FindSpawnable(BindingId);
+	UMovieSceneSpawnableBindingBase* SpawnableBinding = nullptr;
+
+	if (Spawnable)
+	{
+		if (Spawnable->GetSpawnOwnership() != ESpawnOwnership::External)
+		{
+			PoolKey = FSpawnablePoolKey(Spawnable->GetObjectTemplate(), BindingIndex);
+		}
+	}
+	else if (UMovieSceneSequence* MovieSceneSequence = MovieScene.GetTypedOuter<UMovieSceneSequence>())
+	{
+		if (FMovieSceneBindingReferences* BindingReferences = MovieSceneSequence->GetBindingReferences())
+		{
+			if (UMovieSceneCustomBinding* CustomBinding = BindingReferences->GetCustomBinding(BindingId, BindingIndex))
+			{
+				SpawnableBinding = CustomBinding->AsSpawnable(SharedPlaybackState);
+				if (SpawnableBinding && SpawnableBinding->SpawnOwnership != ESpawnOwnership::External)
+				{
+					PoolKey = FSpawnablePoolKey(SpawnableBinding, BindingIndex);
+				}
+			}
+		}
+	}
+
+	// Only one object is ever needed for each binding, so there is nothing to do if one is already waiting
+	if (!PoolKey || SpawnablePool.Contains(PoolKey))
+	{
+		return false;
+	}
+
+	const double SpawnStartTime = FPlatformTime::Seconds();
+
+	UObject* SpawnedObject = Spawnable
+		? SpawnObject(*Spawnable, TemplateID, SharedPlaybackState)
+		: SpawnableBinding->SpawnObject(BindingId, BindingIndex, MovieScene, TemplateID, SharedPlaybackState);
+
+	if (!SpawnedObject)
+	{
+		return false;
+	}
+
+	FPooledObjectState PooledState;
+	if (!DeactivatePooledObject(*SpawnedObject, PooledState))
+	{
+		// This object type cannot be hidden, so it must not exist until its range actually begins
+		TGuardValue<bool> CleaningUp(bCleaningUp, true);
+		PreDestroyAndDestroySpawnedObject(*SpawnedObject, BindingId, BindingIndex, TemplateID, SpawnableBinding);
+		return false;
+	}
+
+	SpawnablePool.FindOrAdd(PoolKey).Add(FPooledObject{ SpawnedObject, SpawnableBinding, PooledState, BindingId, TemplateID, BindingIndex });
+
+	++PoolStats.NumPreSpawned;
+	PoolStats.SpawnSeconds += FPlatformTime::Seconds() - SpawnStartTime;
+	return true;
+}
+
 void FMovieSceneSpawnRegister::PreDestroyObject(UObject & Object, const FGuid & BindingId, FMovieSceneSequenceIDRef TemplateID)
 {
 	PreDestroyObject(Object, BindingId, 0, TemplateID);
@@ -110,10 +275,8 @@ bool FMovieSceneSpawnRegister::DestroySpawnedObject(const FGuid& BindingId, FMov
 	UObject* SpawnedObject = Existing ? Existing->Object.Get() : nullptr;
 	if (SpawnedObject)
 	{
-		PreDestroyObject(*SpawnedObject, BindingId, BindingIndex, TemplateID);
-
-		bool bCustomBinding = false;
 		// If we have a custom binding, it will handle object destruction
+		UMovieSceneSpawnableBindingBase* CustomSpawnableBinding = nullptr;
 		if (FMovieSceneEvaluationState* State = SharedPlaybackState->FindCapability<FMovieSceneEvaluationState>())
 		{
 			if (UMovieSceneSequence* MovieSceneSequence = State->FindSequence(TemplateID))
@@ -122,20 +285,15 @@ bool FMovieSceneSpawnRegister::DestroySpawnedObject(const FGuid& BindingId, FMov
 				{
 					if (UMovieSceneCustomBinding* CustomBinding = BindingReferences->GetCustomBinding(BindingId, BindingIndex))
 					{
-						if (UMovieSceneSpawnableBindingBase* SpawnableBinding = CustomBinding->AsSpawnable(SharedPlaybackState))
-						{
-							bCustomBinding = true;
-							SpawnableBinding->PreDestroyObject(SpawnedObject, BindingId, BindingIndex, TemplateID);
-							DestroySpawnedObject(*SpawnedObject, SpawnableBinding);
-						}
+						CustomSpawnableBinding = CustomBinding->AsSpawnable(SharedPlaybackState);
 					}
 				}
 			}
 		}
 
-		if (!bCustomBinding)
+		if (!ParkPooledObject(Key, *Existing, CustomSpawnableBinding))
 		{
-			DestroySpawnedObject(*SpawnedObject, nullptr);
+			PreDestroyAndDestroySpawnedObject(*SpawnedObject, BindingId, BindingIndex, TemplateID, CustomSpawnableBinding);
 		}
 	}
 
@@ -165,8 +323,8 @@ void FMovieSceneSpawnRegister::DestroyObjectsByPredicate(TSharedRef<const FShare
 			UObject* SpawnedObject = It.Value().Object.Get();
 			if (SpawnedObject)
 			{
-				bool bCustomBinding = false;
 				// If we have a custom binding, it will handle object destruction
+				UMovieSceneSpawnableBindingBase* CustomSpawnableBinding = nullptr;
 				if (FMovieSceneEvaluationState* State = SharedPlaybackState->FindCapability<FMovieSceneEvaluationState>())
 				{
 					if (UMovieSceneSequence* MovieSceneSequence = State->FindSequence(It.Key().TemplateID))
@@ -175,23 +333,13 @@ void FMovieSceneSpawnRegister::DestroyObjectsByPredicate(TSharedRef<const FShare
 						{
 							if (UMovieSceneCustomBinding* CustomBinding = BindingReferences->GetCustomBinding(It.Key().BindingId, It.Key().BindingIndex))
 							{
-								if (UMovieSceneSpawnableBindingBase* SpawnableBinding = CustomBinding->AsSpawnable(SharedPlaybackState))
-								{
-									bCustomBinding = true;
-									SpawnableBinding->PreDestroyObject(SpawnedObject, It.Key().BindingId, It.Key().BindingIndex, It.Key().TemplateID);
-									PreDestroyObject(*SpawnedObject, It.Key().BindingId, 0, It.Key().TemplateID); 
-									DestroySpawnedObject(*SpawnedObject, SpawnableBinding);
-								}
+								CustomSpawnableBinding = CustomBinding->AsSpawnable(SharedPlaybackState);
 							}
 						}
 					}
 				}
 
-				if (!bCustomBinding)
-				{
-					PreDestroyObject(*SpawnedObject, It.Key().BindingId, 0, It.Key().TemplateID);
-					DestroySpawnedObject(*SpawnedObject, nullptr);
-				}
+				PreDestroyAndDestroySpawnedObject(*SpawnedObject, It.Key().BindingId, It.Key().BindingIndex, It.Key().TemplateID, CustomSpawnableBinding);
 			}
 
 			It.RemoveCurrent();
@@ -222,6 +370,154 @@ void FMovieSceneSpawnRegister::CleanUp(TSharedRef<const FSharedPlaybackState> Sh
 	DestroyObjectsByPredicate(SharedPlaybackState, [&](const FGuid&, ESpawnOwnership, FMovieSceneSequenceIDRef){
 		return true;
 	});
+
+	EmptySpawnablePool();
+}
+
+void FMovieSceneSpawnRegister::EmptySpawnablePool()
+{
+	DestroyPooledObjects([](const FPooledObject&){ return true; });
+}
+
+void FMovieSceneSpawnRegister::DestroyPooledObjects(TFunctionRef<bool(const FPooledObject&)> Predicate)
+{
+	TGuardValue<bool> CleaningUp(bCleaningUp, true);
+
+	// Take the objects out of the pool first since destroying objects can re-enter the spawn register
+	TArray<FPooledObject> ObjectsToDestroy;
+	for (auto It = SpawnablePool.CreateIterator(); It; ++It)
+	{
+		TArray<FPooledObject>& PooledObjects = It.Value();
+		for (int32 Index = 0; Index < PooledObjects.Num(); )
+		{
+			if (Predicate(PooledObjects[Index]))
+			{
+				ObjectsToDestroy.Add(MoveTemp(PooledObjects[Index]));
+				PooledObjects.RemoveAt(Index, 1, EAllowShrinking::No);
+			}
+			else
+			{
+				++Index;
+			}
+		}
+
+		if (PooledObjects.Num() == 0)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	for (const FPooledObject& PooledObject : ObjectsToDestroy)
+	{
+		if (UObject* Object = PooledObject.Object.Get())
+		{
+			PreDestroyAndDestroySpawnedObject(*Object, PooledObject.BindingId, PooledObject.BindingIndex, PooledObject.TemplateID, PooledObject.CustomSpawnableBinding.Get());
+		}
+	}
+}
+
+void FMovieSceneSpawnRegister::PreDestroyAndDestroySpawnedObject(UObject& Object, const FGuid& BindingId, int32 BindingIndex, FMovieSceneSequenceIDRef TemplateID, UMovieSceneSpawnableBindingBase* CustomSpawnableBinding)
+{
+	PreDestroyObject(Object, BindingId, BindingIndex, TemplateID);
+
+	if (CustomSpawnableBinding)
+	{
+		CustomSpawnableBinding->PreDestroyObject(&Object, BindingId, BindingIndex, TemplateID);
+	}
+
+	DestroySpawnedObject(Object, CustomSpawnableBinding);
+}
+
+UObject* FMovieSceneSpawnRegister::TakePooledObject(const FSpawnablePoolKey& PoolKey, TSharedRef<const FSharedPlaybackState> SharedPlaybackState)
+{
+	TArray<FPooledObject>* PooledObjects = SpawnablePool.Find(PoolKey);
+	if (!PooledObjects)
+	{
+		return nullptr;
+	}
+
+	UObject* Object = nullptr;
+	FPooledObjectState PooledState;
+	while (!Object && PooledObjects->Num() > 0)
+	{
+		// Pooled objects may have been destroyed externally (ie, by a level unload) since they were parked
+		FPooledObject PooledObject = PooledObjects->Pop(EAllowShrinking::No);
+		Object      = PooledObject.Object.Get();
+		PooledState = PooledObject.State;
+	}
+
+	if (PooledObjects->Num() == 0)
+	{
+		SpawnablePool.Remove(PoolKey);
+	}
+
+	if (Object)
+	{
+		// Reset the object by restoring anything that was captured for it while it was last spawned, but leave the
+		// spawnable token alone since that would destroy the object. The remaining tokens are then discarded so that
+		// the spawnables system captures a new token for the binding that is now using this object.
+		FMovieSceneInstancePreAnimatedState& PreAnimatedState = ConstCastSharedRef<FSharedPlaybackState>(SharedPlaybackState)->GetPreAnimatedState();
+
+		const FMovieSceneAnimTypeID SpawnableAnimTypeID = UMovieSceneSpawnablesSystem::GetAnimTypeID();
+		PreAnimatedState.RestorePreAnimatedState(*Object, [SpawnableAnimTypeID](FMovieSceneAnimTypeID AnimTypeID){ return AnimTypeID != SpawnableAnimTypeID; });
+		PreAnimatedState.DiscardAndRemoveEntityTokensForObject(*Object);
+
+		ReactivatePooledObject(*Object, PooledState);
+	}
+
+	return Object;
+}
+
+bool FMovieSceneSpawnRegister::ParkPooledObject(const FMovieSceneSpawnRegisterKey& Key, const FSpawnedObject& SpawnedObject, UMovieSceneSpawnableBindingBase* CustomSpawnableBinding)
+{
+	UObject* Object = SpawnedObject.Object.Get();
+	if (!Object || !SpawnedObject.PoolKey || !UE::MovieScene::GSequencerSpawnablePooling)
+	{
+		return false;
+	}
+
+	FPooledObjectState PooledState;
+	TArray<FPooledObject>& PooledObjects = SpawnablePool.FindOrAdd(SpawnedObject.PoolKey);
+	if (PooledObjects.Num() >= UE::MovieScene::GSequencerSpawnablePoolMaxPerTemplate || !DeactivatePooledObject(*Object, PooledState))
+	{
+		if (PooledObjects.Num() == 0)
+		{
+			SpawnablePool.Remove(SpawnedObject.PoolKey);
+		}
+		return false;
+	}
+
+	PooledObjects.Add(FPooledObject{ Object, CustomSpawnableBinding, PooledState, Key.BindingId, Key.TemplateID, Key.BindingIndex });
+	++PoolStats.NumParked;
+	return true;
+}
+
+bool FMovieSceneSpawnRegister::DeactivatePooledObject(UObject& Object, FPooledObjectState& OutState)
+{
+	AActor* Actor = Cast<AActor>(&Object);
+	if (!Actor)
+	{
+		return false;
+	}
+
+	OutState.bHiddenInGame     = Actor->IsHidden();
+	OutState.bCollisionEnabled = Actor->GetActorEnableCollision();
+	OutState.bTickEnabled      = Actor->IsActorTickEnabled();
+
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetActorEnableCollision(false);
+	Actor->SetActorTickEnabled(false);
+	return true;
+}
+
+void FMovieSceneSpawnRegister::ReactivatePooledObject(UObject& Object, const FPooledObjectState& State)
+{
+	if (AActor* Actor = Cast<AActor>(&Object))
+	{
+		Actor->SetActorHiddenInGame(State.bHiddenInGame);
+		Actor->SetActorEnableCollision(State.bCollisionEnabled);
+		Actor->SetActorTickEnabled(State.bTickEnabled);
+	}
 }
 
 void FMovieSceneSpawnRegister::CleanUpSequence(FMovieSceneSequenceIDRef TemplateID, TSharedRef<const FSharedPlaybackState> SharedPlaybackState)
@@ -229,6 +525,11 @@ void FMovieSceneSpawnRegister::CleanUpSequence(FMovieSceneSequenceIDRef Template
 	DestroyObjectsByPredicate(SharedPlaybackState, [&](const FGuid&, ESpawnOwnership, FMovieSceneSequenceIDRef ThisTemplateID){
 		return ThisTemplateID == TemplateID;
 	});
+
+	// Objects that were parked by this sequence would otherwise stay hidden in the pool until the whole register is cleaned up
+	DestroyPooledObjects([&](const FPooledObject& PooledObject){
+		return PooledObject.TemplateID == TemplateID;
+	});
 }
 
 void FMovieSceneSpawnRegister::OnSequenceExpired(FMovieSceneSequenceIDRef TemplateID, TSharedRef<const FSharedPlaybackState> SharedPlaybackState)
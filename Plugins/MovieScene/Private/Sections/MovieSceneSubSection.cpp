@@ -338,7 +338,7 @@ void UMovieSceneSubSection::AppendInnerTimeWarpTransform(FMovieSceneSequenceTran
 				}
 				else
 				{
-					OutTransform.NestedTransforms.Add(TimeWarpTransform);
+					OutTransform.Add(MoveTemp(TimeWarpTransform));
 				}
 			}
 
@@ -0,0 +1,331 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "EntitySystem/MovieSceneComponentRegistry.h"
+#include "EntitySystem/MovieSceneEntityIDs.h"
+#include "EntitySystem/MovieSceneEntityManager.h"
+#include "EntitySystem/MovieSceneEntitySystemTypes.h"
+#include "EntitySystem/EntityAllocationIterator.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeExit.h"
+#include "MovieSceneFwd.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UE::MovieScene::Tests
+{
+
+/** Reference implementations of mask matching that operate on temporary masks */
+bool ReferenceContainsAll(const FComponentMask& Input, const FComponentMask& Mask)
+{
+	FComponentMask Temp = Mask;
+	Temp.CombineWithBitwiseAND(Input, EBitwiseOperatorFlags::MaintainSize);
+	return Temp == Mask;
+}
+
+bool ReferenceContainsAny(const FComponentMask& Input, const FComponentMask& Mask)
+{
+	FComponentMask Temp = Mask;
+	Temp.CombineWithBitwiseAND(Input, EBitwiseOperatorFlags::MaintainSize);
+	return Temp.Find(true) != INDEX_NONE;
+}
+
+bool ReferenceContainsExactlyOne(const FComponentMask& Input, const FComponentMask& Mask)
+{
+	FComponentMask Temp = Mask;
+	Temp.CombineWithBitwiseAND(Input, EBitwiseOperatorFlags::MaintainSize);
+	return Temp.NumComponents() == 1;
+}
+
+FComponentMask MakeRandomMask(FRandomStream& Random)
+{
+	FComponentMask Mask;
+
+	// Occasionally leave stale bits past the end of the mask's storage to ensure they are never read
+	if (Random.RandRange(0, 3) == 0)
+	{
+		Mask.Set(FComponentTypeID::FromBitIndex(MaximumNumComponentsSupported - 1));
+		Mask.Reset();
+	}
+
+	const int32 MaxBit  = Random.RandRange(0, MaximumNumComponentsSupported - 1);
+	const int32 NumBits = Random.RandRange(0, 4);
+	for (int32 Index = 0; Index < NumBits; ++Index)
+	{
+		Mask.Set(FComponentTypeID::FromBitIndex(Random.RandRange(0, MaxBit)));
+	}
+	return Mask;
+}
+
+/** Make a set of random masks, combined such that they give a reasonable number of partial and complete matches */
+TArray<FComponentMask> MakeRandomMasks(int32 NumMasks)
+{
+	FRandomStream Random(0x5EED);
+
+	TArray<FComponentMask> Masks;
+	for (int32 Index = 0; Index < NumMasks; ++Index)
+	{
+		Masks.Add(MakeRandomMask(Random));
+	}
+
+	for (int32 Index = 0; Index + 1 < NumMasks; Index += 4)
+	{
+		Masks[Index].CombineWithBitwiseOR(Masks[Index + 1], EBitwiseOperatorFlags::MaxSize);
+	}
+	return Masks;
+}
+
+/** An entity manager with an allocation for every combination of 8 tags, and a set of filters of each kind */
+struct FAllocationMatchTestFixture
+{
+	static constexpr int32 NumTags    = 8;
+	static constexpr int32 NumFilters = 4;
+
+	FComponentRegistry ComponentRegistry;
+	FEntityManager EntityManager;
+
+	TComponentTypeID<int32> IntComponent;
+	FComponentTypeID Tags[NumTags];
+
+	TArray<FMovieSceneEntityID> Entities;
+	FEntityComponentFilter Filters[NumFilters];
+
+	FAllocationMatchTestFixture()
+	{
+		EntityManager.SetComponentRegistry(&ComponentRegistry);
+
+		IntComponent = ComponentRegistry.NewComponentType<int32>(TEXT("Integer"));
+
+		const TCHAR* TagNames[NumTags] = { TEXT("Tag0"), TEXT("Tag1"), TEXT("Tag2"), TEXT("Tag3"), TEXT("Tag4"), TEXT("Tag5"), TEXT("Tag6"), TEXT("Tag7") };
+		for (int32 Index = 0; Index < NumTags; ++Index)
+		{
+			Tags[Index] = ComponentRegistry.NewTag(TagNames[Index]);
+		}
+
+		for (int32 Combination = 0; Combination < (1 << NumTags); ++Combination)
+		{
+			FComponentMask Mask({ IntComponent });
+			for (int32 Index = 0; Index < NumTags; ++Index)
+			{
+				if (Combination & (1 << Index))
+				{
+					Mask.Set(Tags[Index]);
+				}
+			}
+
+			FMovieSceneEntityID Entity = EntityManager.AllocateEntity();
+			EntityManager.AddComponents(Entity, Mask);
+			Entities.Add(Entity);
+		}
+
+		Filters[0].All({ IntComponent, Tags[0] });
+		Filters[1].All({ Tags[1] }).None({ Tags[2], Tags[3] });
+		Filters[2].Complex({ Tags[4], Tags[5] }, EComplexFilterMode::OneOf);
+		Filters[3].Any({ Tags[6], Tags[7] }).Deny({ Tags[0], Tags[1], Tags[2] });
+	}
+};
+
+} // namespace UE::MovieScene::Tests
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneComponentMaskKernelsTest,
+		"System.Engine.Sequencer.EntitySystem.ComponentMaskKernels",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneComponentMaskKernelsTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+	using namespace UE::MovieScene::Tests;
+
+	const TArray<FComponentMask> Masks = MakeRandomMasks(512);
+
+	for (const FComponentMask& Input : Masks)
+	{
+		for (const FComponentMask& Mask : Masks)
+		{
+			if (Input.ContainsAll(Mask) != ReferenceContainsAll(Input, Mask)
+				|| Input.ContainsAny(Mask) != ReferenceContainsAny(Input, Mask)
+				|| Input.ContainsNone(Mask) == ReferenceContainsAny(Input, Mask)
+				|| Input.ContainsExactlyOne(Mask) != ReferenceContainsExactlyOne(Input, Mask))
+			{
+				AddError(FString::Printf(TEXT("Mask kernels disagree with reference implementation for masks of %d and %d bits"), Input.Num(), Mask.Num()));
+				return false;
+			}
+		}
+	}
+
+	UTEST_TRUE("Empty masks are contained by anything", FComponentMask().ContainsAll(FComponentMask()));
+	UTEST_FALSE("Empty masks contain nothing", FComponentMask().ContainsAny(FComponentMask({ FComponentTypeID::FromBitIndex(0) })));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneComponentMaskKernelsPerfTest,
+		"System.Engine.Sequencer.EntitySystem.ComponentMaskKernels.Perf",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter | EAutomationTestFlags::Disabled)
+bool FMovieSceneComponentMaskKernelsPerfTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+	using namespace UE::MovieScene::Tests;
+
+	constexpr int32 NumMasks      = 512;
+	constexpr int32 NumIterations = 200;
+
+	const TArray<FComponentMask> Masks = MakeRandomMasks(NumMasks);
+
+	// Microbenchmark the kernels against the reference implementation
+	auto RunBenchmark = [&Masks](auto&& Kernel)
+	{
+		int32 NumMatches = 0;
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			const FComponentMask& Mask = Masks[Iteration % NumMasks];
+			for (const FComponentMask& Input : Masks)
+			{
+				NumMatches += Kernel(Input, Mask) ? 1 : 0;
+			}
+		}
+		return TTuple<double, int32>(FPlatformTime::Seconds() - StartTime, NumMatches);
+	};
+
+	const TTuple<double, int32> ReferenceAll = RunBenchmark(&ReferenceContainsAll);
+	const TTuple<double, int32> KernelAll    = RunBenchmark([](const FComponentMask& Input, const FComponentMask& Mask){ return Input.ContainsAll(Mask); });
+	const TTuple<double, int32> ReferenceAny = RunBenchmark(&ReferenceContainsAny);
+	const TTuple<double, int32> KernelAny    = RunBenchmark([](const FComponentMask& Input, const FComponentMask& Mask){ return Input.ContainsAny(Mask); });
+
+	UTEST_EQUAL("Benchmarked all matches", KernelAll.Get<1>(), ReferenceAll.Get<1>());
+	UTEST_EQUAL("Benchmarked any matches", KernelAny.Get<1>(), ReferenceAny.Get<1>());
+
+	UE_LOG(LogMovieScene, Display, TEXT("Matched %d masks %d times. All: reference %.3fms, kernel %.3fms. Any: reference %.3fms, kernel %.3fms"),
+		NumMasks, NumIterations,
+		ReferenceAll.Get<0>() * 1000.0, KernelAll.Get<0>() * 1000.0,
+		ReferenceAny.Get<0>() * 1000.0, KernelAny.Get<0>() * 1000.0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneCachedAllocationMatchesTest,
+		"System.Engine.Sequencer.EntitySystem.CachedAllocationMatches",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneCachedAllocationMatchesTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+	using namespace UE::MovieScene::Tests;
+
+	IConsoleVariable* CacheThreshold = IConsoleManager::Get().FindConsoleVariable(TEXT("Sequencer.EntitySystem.AllocationMatchCacheThreshold"));
+	UTEST_NOT_NULL("Cache threshold console variable", CacheThreshold);
+
+	const int32 OldCacheThreshold = CacheThreshold->GetInt();
+	ON_SCOPE_EXIT
+	{
+		CacheThreshold->Set(OldCacheThreshold, ECVF_SetByCode);
+	};
+
+	FAllocationMatchTestFixture Fixture;
+	FEntityManager& EntityManager = Fixture.EntityManager;
+
+	auto GatherMatches = [&EntityManager](const FEntityComponentFilter& Filter)
+	{
+		TArray<const FEntityAllocation*> Matches;
+		for (FEntityAllocationIteratorItem Item : EntityManager.Iterate(&Filter))
+		{
+			Matches.Add(Item.GetAllocation());
+		}
+		return Matches;
+	};
+
+	auto CompareCachedMatches = [this, &GatherMatches, &Fixture, CacheThreshold](const TCHAR* Context)
+	{
+		for (const FEntityComponentFilter& Filter : Fixture.Filters)
+		{
+			CacheThreshold->Set(0, ECVF_SetByCode);
+			const TArray<const FEntityAllocation*> Expected = GatherMatches(Filter);
+
+			CacheThreshold->Set(1, ECVF_SetByCode);
+			const TArray<const FEntityAllocation*> Cached = GatherMatches(Filter);
+			const TArray<const FEntityAllocation*> Recached = GatherMatches(Filter);
+
+			if (!TestTrue(FString::Printf(TEXT("Cached matches are correct %s"), Context), Cached == Expected && Recached == Expected && Expected.Num() > 0))
+			{
+				return false;
+			}
+		}
+		return true;
+	};
+
+	UTEST_TRUE("Initial matches", CompareCachedMatches(TEXT("initially")));
+
+	// Mutating the allocations must invalidate the cache
+	for (int32 Index = 0; Index < Fixture.Entities.Num(); Index += 3)
+	{
+		EntityManager.AddComponent(Fixture.Entities[Index], Fixture.Tags[Index % FAllocationMatchTestFixture::NumTags]);
+	}
+	UTEST_TRUE("Matches after adding components", CompareCachedMatches(TEXT("after adding components")));
+
+	for (int32 Index = 0; Index < Fixture.Entities.Num(); Index += 5)
+	{
+		EntityManager.RemoveComponent(Fixture.Entities[Index], Fixture.IntComponent);
+	}
+	UTEST_TRUE("Matches after removing components", CompareCachedMatches(TEXT("after removing components")));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneCachedAllocationMatchesPerfTest,
+		"System.Engine.Sequencer.EntitySystem.CachedAllocationMatches.Perf",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter | EAutomationTestFlags::Disabled)
+bool FMovieSceneCachedAllocationMatchesPerfTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+	using namespace UE::MovieScene::Tests;
+
+	constexpr int32 NumIterations = 2000;
+
+	IConsoleVariable* CacheThreshold = IConsoleManager::Get().FindConsoleVariable(TEXT("Sequencer.EntitySystem.AllocationMatchCacheThreshold"));
+	UTEST_NOT_NULL("Cache threshold console variable", CacheThreshold);
+
+	const int32 OldCacheThreshold = CacheThreshold->GetInt();
+	ON_SCOPE_EXIT
+	{
+		CacheThreshold->Set(OldCacheThreshold, ECVF_SetByCode);
+	};
+
+	FAllocationMatchTestFixture Fixture;
+
+	// Microbenchmark iterating every filter with and without the cache
+	auto RunBenchmark = [&Fixture]
+	{
+		int32 NumMatches = 0;
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			for (const FEntityComponentFilter& Filter : Fixture.Filters)
+			{
+				for (FEntityAllocationIteratorItem Item : Fixture.EntityManager.Iterate(&Filter))
+				{
+					NumMatches += Item.GetAllocation()->Num();
+				}
+			}
+		}
+		return TTuple<double, int32>(FPlatformTime::Seconds() - StartTime, NumMatches);
+	};
+
+	CacheThreshold->Set(0, ECVF_SetByCode);
+	const TTuple<double, int32> Uncached = RunBenchmark();
+
+	CacheThreshold->Set(1, ECVF_SetByCode);
+	const TTuple<double, int32> Cached = RunBenchmark();
+
+	UTEST_EQUAL("Benchmarked matches", Cached.Get<1>(), Uncached.Get<1>());
+
+	UE_LOG(LogMovieScene, Display, TEXT("Iterated %d filters over %d allocations %d times. Uncached: %.3fms, cached: %.3fms"),
+		FAllocationMatchTestFixture::NumFilters, 1 << FAllocationMatchTestFixture::NumTags, NumIterations, Uncached.Get<0>() * 1000.0, Cached.Get<0>() * 1000.0);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,122 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "EntitySystem/MovieSceneConditionResultCache.h"
+#include "EntitySystem/MovieSceneEntitySystemLinker.h"
+#include "EntitySystem/MovieSceneSharedPlaybackState.h"
+#include "Misc/AutomationTest.h"
+#include "MovieSceneTestObjects.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneConditionResultCacheScopeTest,
+		"System.Engine.Sequencer.Conditions.ResultCacheScopes",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneConditionResultCacheScopeTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+
+	FConditionResultCache Cache;
+
+	const FInstanceHandle InstanceA(0, 0);
+	const FInstanceHandle InstanceB(1, 0);
+
+	auto MakeKey = [](uint32 Hash, FInstanceHandle Instance, EConditionResultScope Scope)
+	{
+		FConditionResultKey Key;
+		Key.ConditionHash = Hash;
+		Key.RootInstanceHandle = Instance;
+		Key.Scope = Scope;
+		return Key;
+	};
+
+	// Global results are shared between instances
+	Cache.Add(MakeKey(1, InstanceA, EConditionResultScope::Global), true);
+	const bool* SharedResult = Cache.Find(MakeKey(1, InstanceB, EConditionResultScope::Global));
+	UTEST_TRUE("Global result is shared", SharedResult != nullptr && *SharedResult);
+
+	// Per-instance results are not
+	Cache.Add(MakeKey(2, InstanceA, EConditionResultScope::PerInstance), false);
+	UTEST_TRUE("Per-instance result is found for its instance", Cache.Find(MakeKey(2, InstanceA, EConditionResultScope::PerInstance)) != nullptr);
+	UTEST_TRUE("Per-instance result is not shared", Cache.Find(MakeKey(2, InstanceB, EConditionResultScope::PerInstance)) == nullptr);
+
+	// Per-frame results are shared within the frame
+	Cache.Add(MakeKey(3, InstanceA, EConditionResultScope::PerFrame), true);
+	UTEST_TRUE("Per-frame result is found", Cache.Find(MakeKey(3, InstanceB, EConditionResultScope::PerFrame)) != nullptr);
+	Cache.InvalidateFrame();
+	UTEST_TRUE("Per-frame result is invalidated", Cache.Find(MakeKey(3, InstanceB, EConditionResultScope::PerFrame)) == nullptr);
+
+	// Invalidating an instance only removes its own results, and global results computed this frame are still valid
+	Cache.InvalidateInstance(InstanceA);
+	UTEST_TRUE("Per-instance result is invalidated", Cache.Find(MakeKey(2, InstanceA, EConditionResultScope::PerInstance)) == nullptr);
+	UTEST_TRUE("Global result from this frame is still valid", Cache.Find(MakeKey(1, InstanceA, EConditionResultScope::Global)) != nullptr);
+
+	Cache.InvalidateGlobal();
+	UTEST_TRUE("Global result is invalidated", Cache.Find(MakeKey(1, InstanceB, EConditionResultScope::Global)) == nullptr);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneConditionResultCacheEvaluateTest,
+		"System.Engine.Sequencer.Conditions.ResultCacheEvaluation",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneConditionResultCacheEvaluateTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+
+	UMovieSceneEntitySystemLinker* Linker = NewObject<UMovieSceneEntitySystemLinker>(GetTransientPackage());
+	TSharedRef<FSharedPlaybackState> PlaybackState = MakeShared<FSharedPlaybackState>(Linker);
+
+	const FInstanceHandle InstanceA(0, 0);
+	const FInstanceHandle InstanceB(1, 0);
+
+	FConditionResultCache Cache;
+
+	// Evaluate the condition from the specified instance through the cache, returning the total number of evaluations
+	auto Evaluate = [&Cache, &PlaybackState](UTestMovieSceneCountingCondition* Condition, FInstanceHandle Instance)
+	{
+		const bool bCanCacheResult = Condition->CheckFrequency == EMovieSceneConditionCheckFrequency::Once;
+
+		FConditionResultKey Key = FConditionResultCache::MakeKey(Condition, FGuid(), MovieSceneSequenceID::Root, PlaybackState, nullptr, bCanCacheResult);
+		Key.RootInstanceHandle = Instance;
+
+		Cache.FindOrEvaluate(Key, Condition, FGuid(), MovieSceneSequenceID::Root, PlaybackState);
+		return Condition->NumEvaluations;
+	};
+
+	// Global conditions are evaluated once and shared between instances
+	UTestMovieSceneCountingCondition* GlobalCondition = NewObject<UTestMovieSceneCountingCondition>(GetTransientPackage());
+	GlobalCondition->Scope = EMovieSceneConditionScope::Global;
+
+	UTEST_EQUAL("Global condition is evaluated the first time", Evaluate(GlobalCondition, InstanceA), 1);
+	UTEST_EQUAL("Global condition is cached for its instance", Evaluate(GlobalCondition, InstanceA), 1);
+	UTEST_EQUAL("Global condition is shared with other instances", Evaluate(GlobalCondition, InstanceB), 1);
+
+	// Binding conditions are evaluated once per instance
+	UTestMovieSceneCountingCondition* BindingCondition = NewObject<UTestMovieSceneCountingCondition>(GetTransientPackage());
+	BindingCondition->Scope = EMovieSceneConditionScope::Binding;
+
+	UTEST_EQUAL("Binding condition is evaluated the first time", Evaluate(BindingCondition, InstanceA), 1);
+	UTEST_EQUAL("Binding condition is cached for its instance", Evaluate(BindingCondition, InstanceA), 1);
+	UTEST_EQUAL("Binding condition is evaluated again for another instance", Evaluate(BindingCondition, InstanceB), 2);
+	UTEST_EQUAL("Binding condition is cached for the other instance", Evaluate(BindingCondition, InstanceB), 2);
+
+	Cache.InvalidateInstance(InstanceA);
+	UTEST_EQUAL("Binding condition is evaluated again after invalidation", Evaluate(BindingCondition, InstanceA), 3);
+
+	// Per-tick conditions are evaluated once per frame
+	UTestMovieSceneCountingCondition* TickCondition = NewObject<UTestMovieSceneCountingCondition>(GetTransientPackage());
+	TickCondition->Scope = EMovieSceneConditionScope::Global;
+	TickCondition->CheckFrequency = EMovieSceneConditionCheckFrequency::OnTick;
+
+	UTEST_EQUAL("Per-tick condition is evaluated the first time", Evaluate(TickCondition, InstanceA), 1);
+	UTEST_EQUAL("Per-tick condition is cached within the frame", Evaluate(TickCondition, InstanceB), 1);
+
+	Cache.InvalidateFrame();
+	UTEST_EQUAL("Per-tick condition is evaluated again on the next frame", Evaluate(TickCondition, InstanceA), 2);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
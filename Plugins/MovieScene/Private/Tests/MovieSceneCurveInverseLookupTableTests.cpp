@@ -0,0 +1,150 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Channels/MovieSceneCurveInverseLookupTable.h"
+#include "Channels/MovieSceneTimeWarpChannel.h"
+#include "Misc/AutomationTest.h"
+#include "MovieSceneTransformTypes.h"
+#include "UObject/Package.h"
+#include "Variants/MovieSceneTimeWarpCurve.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneCurveInverseLookupTableTest,
+		"System.Engine.Sequencer.Channels.CurveInverseLookupTable",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneCurveInverseLookupTableTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+
+	constexpr int32 NumKeys    = 200;
+	constexpr int32 KeySpacing = 100;
+
+	// Mostly increasing time-warp with a section that plays backwards, and a constant hold
+	FMovieSceneTimeWarpChannel Channel;
+	Channel.Domain = ETimeWarpChannelDomain::Time;
+
+	double WarpedTime = 0.0;
+	for (int32 Index = 0; Index < NumKeys; ++Index)
+	{
+		if (Index >= 120 && Index < 130)
+		{
+			Channel.AddLinearKey(Index * KeySpacing, WarpedTime);
+		}
+		else
+		{
+			Channel.AddCubicKey(Index * KeySpacing, WarpedTime);
+		}
+
+		WarpedTime += (Index >= 60 && Index < 80) ? -40.0 : (Index >= 120 && Index < 130) ? 0.0 : 80.0 + 20.0 * FMath::Sin(Index * 0.3);
+	}
+	Channel.AutoSetTangents();
+	Channel.PreInfinityExtrap  = RCCE_Linear;
+	Channel.PostInfinityExtrap = RCCE_Linear;
+
+	Channel.UpdateInverseLookupTable();
+
+	TSharedPtr<const FCurveInverseLookupTable> Table = FCurveInverseLookupTable::Build(Channel);
+	UTEST_TRUE("Built lookup table", Table.IsValid());
+	UTEST_TRUE("Lookup table matches its channel", Table->IsValidFor(Channel));
+	UTEST_TRUE("Monotonic sections are grouped into runs", Table->GetNumRuns() < 10);
+
+	const FMovieSceneDoubleChannel& Unaccelerated = Channel;
+
+	const EInverseEvaluateFlags AllFlags[] = {
+		EInverseEvaluateFlags::AnyDirection,
+		EInverseEvaluateFlags::Forwards,
+		EInverseEvaluateFlags::Backwards | EInverseEvaluateFlags::Equal,
+		EInverseEvaluateFlags::AnyDirection | EInverseEvaluateFlags::Cycle,
+	};
+
+	// Every query must produce exactly the same solution as solving the curve directly
+	for (double Value = -500.0; Value < WarpedTime + 500.0; Value += 37.3)
+	{
+		for (int32 Hint = -1000; Hint < (NumKeys + 10) * KeySpacing; Hint += 1530)
+		{
+			for (EInverseEvaluateFlags Flags : AllFlags)
+			{
+				const TOptional<FFrameTime> Expected = Unaccelerated.InverseEvaluate(Value, FFrameTime(Hint), Flags);
+				const TOptional<FFrameTime> Actual   = Channel.InverseEvaluate(Value, FFrameTime(Hint), Flags);
+
+				if (!TestEqual(FString::Printf(TEXT("Solution exists for %f at %d"), Value, Hint), Actual.IsSet(), Expected.IsSet()))
+				{
+					return false;
+				}
+				if (Expected.IsSet() && !TestEqual(FString::Printf(TEXT("Solution for %f at %d"), Value, Hint), Actual.GetValue(), Expected.GetValue()))
+				{
+					return false;
+				}
+			}
+		}
+
+		TArray<FFrameTime> ExpectedSolutions, ActualSolutions;
+		Unaccelerated.InverseEvaluateBetween(Value, FFrameTime(1500), FFrameTime(15000), [&ExpectedSolutions](FFrameTime Time){ ExpectedSolutions.Add(Time); return true; });
+		Channel.InverseEvaluateBetween(Value, FFrameTime(1500), FFrameTime(15000), [&ActualSolutions](FFrameTime Time){ ActualSolutions.Add(Time); return true; });
+
+		UTEST_TRUE(FString::Printf(TEXT("Solutions between for %f"), Value), ActualSolutions == ExpectedSolutions);
+	}
+
+	// Changing the keys invalidates the table until it is rebuilt
+	Channel.AddCubicKey(NumKeys * KeySpacing, WarpedTime);
+	UTEST_FALSE("Lookup table is invalidated by new keys", Table->IsValidFor(Channel));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneCurveInverseLookupTableInteriorEditTest,
+		"System.Engine.Sequencer.Channels.CurveInverseLookupTable.InteriorKeyEdit",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneCurveInverseLookupTableInteriorEditTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+
+	constexpr int32 NumKeys    = 64;
+	constexpr int32 KeySpacing = 100;
+	constexpr int32 EditedKey  = 32;
+
+	UMovieSceneTimeWarpCurve* Curve = NewObject<UMovieSceneTimeWarpCurve>(GetTransientPackage());
+	FMovieSceneTimeWarpChannel& Channel = Curve->Channel;
+
+	for (int32 Index = 0; Index < NumKeys; ++Index)
+	{
+		Channel.AddLinearKey(Index * KeySpacing, Index * KeySpacing);
+	}
+	Channel.PostEditChange();
+
+	// Edit an interior key the way the editor does, leaving the key count and end points unchanged
+	constexpr double EditedValue = 100000.0;
+
+	Curve->Modify();
+	Channel.GetData().GetValues()[EditedKey].Value = EditedValue;
+
+	const FMovieSceneDoubleChannel& Unaccelerated = Channel;
+
+	const TOptional<FFrameTime> Expected = Unaccelerated.InverseEvaluate(EditedValue, FFrameTime(0), EInverseEvaluateFlags::AnyDirection);
+	UTEST_TRUE("Edited value can be solved directly", Expected.IsSet() && Expected.GetValue() == FFrameTime(EditedKey * KeySpacing));
+
+	const TOptional<FFrameTime> Actual = Channel.InverseEvaluate(EditedValue, FFrameTime(0), EInverseEvaluateFlags::AnyDirection);
+	UTEST_TRUE("Edited value is solved after the edit", Actual.IsSet());
+	UTEST_EQUAL("Solution after the edit", Actual.GetValue(), Expected.GetValue());
+
+	// Rebuilding the table once the edit is complete must produce the same solution
+	Channel.PostEditChange();
+
+	const TOptional<FFrameTime> Rebuilt = Channel.InverseEvaluate(EditedValue, FFrameTime(0), EInverseEvaluateFlags::AnyDirection);
+	UTEST_TRUE("Edited value is solved after rebuilding", Rebuilt.IsSet());
+	UTEST_EQUAL("Solution after rebuilding", Rebuilt.GetValue(), Expected.GetValue());
+
+	// Moving the key through the channel interface must keep the table in sync without another Modify
+	const FKeyHandle EditedHandle = Channel.GetData().GetHandle(EditedKey);
+	const FFrameNumber MovedTime  = EditedKey * KeySpacing + KeySpacing / 2;
+	Channel.SetKeyTimes(MakeArrayView(&EditedHandle, 1), MakeArrayView(&MovedTime, 1));
+
+	const TOptional<FFrameTime> Moved = Channel.InverseEvaluate(EditedValue, FFrameTime(0), EInverseEvaluateFlags::AnyDirection);
+	UTEST_TRUE("Edited value is solved after moving its key", Moved.IsSet());
+	UTEST_EQUAL("Solution after moving the key", Moved.GetValue(), FFrameTime(MovedTime));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,77 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Channels/MovieSceneCurveSimplification.h"
+#include "Channels/MovieSceneDoubleChannel.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneCurveSimplificationTest,
+		"System.Engine.Sequencer.Channels.CurveSimplification",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneCurveSimplificationTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+
+	constexpr int32  NumKeys    = 480;
+	constexpr int32  KeySpacing = 100;
+	constexpr double MaxError   = 0.001;
+
+	// Dense, baked sine wave with a key on every frame as produced by a mocap import
+	FMovieSceneDoubleChannel Original;
+	for (int32 Index = 0; Index < NumKeys; ++Index)
+	{
+		Original.AddCubicKey(Index * KeySpacing, FMath::Sin(Index * UE_DOUBLE_TWO_PI / 120.0));
+	}
+	Original.AutoSetTangents();
+
+	FCurveSimplificationParams Params;
+	Params.MaxError = MaxError;
+
+	FMovieSceneDoubleChannel Simplified = Original;
+	const FCurveSimplificationResult Result = SimplifyCurve(&Simplified, Params);
+
+	UTEST_EQUAL("Keys before", Result.NumKeysBefore, NumKeys);
+	UTEST_EQUAL("Keys after", Result.NumKeysAfter, Simplified.GetNumKeys());
+	UTEST_TRUE("Keys were reduced", Result.NumKeysAfter < NumKeys / 4);
+	UTEST_TRUE("Reported error is within tolerance", Result.MaxError <= MaxError);
+
+	// Every key time and every midpoint between keys is a sample, so must be within tolerance
+	for (int32 Time = 0; Time < (NumKeys - 1) * KeySpacing; Time += KeySpacing / 2)
+	{
+		double Expected = 0.0, Actual = 0.0;
+		Original.Evaluate(FFrameTime(Time), Expected);
+		Simplified.Evaluate(FFrameTime(Time), Actual);
+
+		UTEST_TRUE("Simplified curve is within tolerance", FMath::Abs(Expected - Actual) <= MaxError);
+	}
+
+	// Keys outside of the range must be left untouched
+	FMovieSceneDoubleChannel PartiallySimplified = Original;
+	Params.Range = TRange<FFrameNumber>(0, (NumKeys / 2) * KeySpacing);
+	SimplifyCurve(&PartiallySimplified, Params);
+
+	TArray<FFrameNumber> UntouchedTimes;
+	PartiallySimplified.GetKeys(TRange<FFrameNumber>::AtLeast(Params.Range.GetUpperBoundValue()), &UntouchedTimes, nullptr);
+	UTEST_EQUAL("Keys outside the range are retained", UntouchedTimes.Num(), NumKeys / 2);
+
+	// Simplifying many channels at once produces the same results as doing so individually
+	TArray<FMovieSceneDoubleChannel> Channels;
+	Channels.Init(Original, 8);
+
+	TArray<FMovieSceneDoubleChannel*> ChannelPtrs;
+	for (FMovieSceneDoubleChannel& Channel : Channels)
+	{
+		ChannelPtrs.Add(&Channel);
+	}
+
+	Params.Range = TRange<FFrameNumber>::All();
+	const FCurveSimplificationResult BatchResult = SimplifyCurves(ChannelPtrs, Params);
+	UTEST_EQUAL("Batch keys before", BatchResult.NumKeysBefore, NumKeys * Channels.Num());
+	UTEST_EQUAL("Batch keys after", BatchResult.NumKeysAfter, Result.NumKeysAfter * Channels.Num());
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -7,7 +7,10 @@
 #include "EntitySystem/MovieSceneEntitySystemTask.h"
 #include "EntitySystem/MovieSceneTaskScheduler.h"
 #include "EntitySystem/MovieSceneEntityFactoryTemplates.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
 #include "Misc/AutomationTest.h"
+#include "Misc/ScopeExit.h"
 
 #if WITH_DEV_AUTOMATION_TESTS
 
@@ -211,6 +214,254 @@ bool FMovieSceneCustomSchedulerTest::RunTest(const FString& Parameters)
 	return true;
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneCustomSchedulerCriticalPathTest, 
+		"System.Engine.Sequencer.EntitySystem.Scheduler.CriticalPath", 
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneCustomSchedulerCriticalPathTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+
+	IConsoleVariable* CriticalPathPriority = IConsoleManager::Get().FindConsoleVariable(TEXT("Sequencer.CustomTaskScheduling.CriticalPathPriority"));
+	IConsoleVariable* UpdateInterval = IConsoleManager::Get().FindConsoleVariable(TEXT("Sequencer.CustomTaskScheduling.CriticalPathUpdateInterval"));
+	if (!CriticalPathPriority || !CriticalPathPriority->GetBool() || !UpdateInterval || UpdateInterval->GetInt() <= 0)
+	{
+		AddInfo(TEXT("Critical path scheduling is disabled - skipping test"));
+		return true;
+	}
+
+	IConsoleVariable* MeasureTasks = IConsoleManager::Get().FindConsoleVariable(TEXT("Sequencer.CustomTaskScheduling.MeasureTasks"));
+	UTEST_NOT_NULL("Measure tasks console variable", MeasureTasks);
+
+	const bool bOldMeasureTasks = MeasureTasks->GetBool();
+	ON_SCOPE_EXIT
+	{
+		MeasureTasks->Set(bOldMeasureTasks, ECVF_SetByCode);
+	};
+
+	FEntityManager EntityManager;
+	FEntitySystemScheduler Scheduler(&EntityManager);
+
+	TArray<TCHAR> ExecutionOrder;
+
+	struct FRecordTask
+	{
+		TArray<TCHAR>* ExecutionOrder;
+		TCHAR Name;
+		double DurationSeconds;
+
+		FRecordTask(TArray<TCHAR>* InExecutionOrder, TCHAR InName, double InDurationSeconds)
+			: ExecutionOrder(InExecutionOrder), Name(InName), DurationSeconds(InDurationSeconds)
+		{}
+
+		void Run(FEntityAllocationWriteContext) const
+		{
+			const double EndTime = FPlatformTime::Seconds() + DurationSeconds;
+			while (FPlatformTime::Seconds() < EndTime);
+
+			ExecutionOrder->Add(Name);
+		}
+	};
+
+	// A is a short independent task, B->C is a longer chain so should always be started first once it has been measured
+	Scheduler.BeginConstruction();
+	Scheduler.BeginSystem(0);
+
+	Scheduler.AddTask<FRecordTask>(FTaskParams(TEXT("A")), &ExecutionOrder, TEXT('A'), 0.0);
+	FTaskID TaskB = Scheduler.AddTask<FRecordTask>(FTaskParams(TEXT("B")), &ExecutionOrder, TEXT('B'), 0.001);
+	FTaskID TaskC = Scheduler.AddTask<FRecordTask>(FTaskParams(TEXT("C")), &ExecutionOrder, TEXT('C'), 0.001);
+	Scheduler.AddPrerequisite(TaskB, TaskC);
+
+	Scheduler.EndSystem(0);
+	Scheduler.EndConstruction();
+
+	// Without measurement every task has the same weight, so the chain is still prioritized but no stats are gathered
+	MeasureTasks->Set(false, ECVF_SetByCode);
+	Scheduler.ExecuteTasks();
+
+	UTEST_EQUAL("Number of tasks run (unmeasured)", ExecutionOrder.Num(), 3);
+	UTEST_EQUAL("Longest chain runs first (unmeasured)", ExecutionOrder[0], TEXT('B'));
+	UTEST_EQUAL("Makespan is not measured", Scheduler.GetExecutionStats().MakespanSeconds, 0.0);
+
+	MeasureTasks->Set(true, ECVF_SetByCode);
+	for (int32 Index = 0; Index < UpdateInterval->GetInt(); ++Index)
+	{
+		Scheduler.ExecuteTasks();
+	}
+
+	ExecutionOrder.Reset();
+	Scheduler.ExecuteTasks();
+
+	UTEST_EQUAL("Number of tasks run", ExecutionOrder.Num(), 3);
+	UTEST_EQUAL("Longest chain runs first", ExecutionOrder[0], TEXT('B'));
+
+	const FEntitySystemSchedulerStats& Stats = Scheduler.GetExecutionStats();
+	UTEST_TRUE("Critical path is measured", Stats.CriticalPathSeconds >= 0.002);
+	UTEST_TRUE("Makespan is measured", Stats.MakespanSeconds > 0.0);
+
+	return true;
+}
+
+namespace UE::MovieScene::Test
+{
+
+/** Builds a scheduler with many small allocation tasks for testing task graph replay */
+struct FReplaySchedulerFixture
+{
+	FComponentRegistry ComponentRegistry;
+	FEntityManager EntityManager;
+	FEntitySystemScheduler Scheduler;
+
+	TComponentTypeID<int> IntComponent;
+	TComponentTypeID<double> DoubleComponent;
+	TComponentTypeID<float> FloatComponent;
+
+	TSortedMap<FMovieSceneEntityID, int> Entities;
+
+	static inline double Factor = 1.0;
+
+	struct FDoubleTask
+	{
+		static void ForEachEntity(int InIndex, double& OutDouble)
+		{
+			OutDouble = static_cast<double>(InIndex) * Factor;
+		}
+	};
+	struct FFloatTask
+	{
+		static void ForEachEntity(double InDouble, float& OutFloat)
+		{
+			OutFloat = static_cast<float>(InDouble);
+		}
+	};
+
+	FReplaySchedulerFixture(int32 NumEntities)
+		: Scheduler(&EntityManager)
+	{
+		EntityManager.SetComponentRegistry(&ComponentRegistry);
+
+		IntComponent = ComponentRegistry.NewComponentType<int>(TEXT("Integer"));
+		DoubleComponent = ComponentRegistry.NewComponentType<double>(TEXT("Double"));
+		FloatComponent = ComponentRegistry.NewComponentType<float>(TEXT("Float"));
+
+		for (int32 Index = 0; Index < NumEntities; ++Index)
+		{
+			FMovieSceneEntityID Entity = FEntityBuilder()
+			.Add(IntComponent, Index)
+			.Add(DoubleComponent, 0.0)
+			.Add(FloatComponent, 0.f)
+			.CreateEntity(&EntityManager);
+
+			Entities.Add(Entity, Index);
+		}
+
+		EntityManager.UpdateThreadingModel();
+
+		Scheduler.BeginConstruction();
+		Scheduler.BeginSystem(0);
+		{
+			FEntityTaskBuilder()
+			.Read(IntComponent)
+			.Write(DoubleComponent)
+			.Fork_PerEntity<FDoubleTask>(&EntityManager, &Scheduler);
+		}
+		Scheduler.EndSystem(0);
+		Scheduler.BeginSystem(1);
+		{
+			FEntityTaskBuilder()
+			.Read(DoubleComponent)
+			.Write(FloatComponent)
+			.Fork_PerEntity<FFloatTask>(&EntityManager, &Scheduler);
+		}
+		Scheduler.EndSystem(1);
+		Scheduler.EndConstruction();
+	}
+};
+
+} // namespace UE::MovieScene::Test
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneCustomSchedulerReplayTest, 
+		"System.Engine.Sequencer.EntitySystem.Scheduler.ReplayWorkers", 
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneCustomSchedulerReplayTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+	using namespace UE::MovieScene::Test;
+
+	IConsoleVariable* ReplayWorkers = IConsoleManager::Get().FindConsoleVariable(TEXT("Sequencer.CustomTaskScheduling.ReplayWorkers"));
+	UTEST_NOT_NULL("Replay workers console variable", ReplayWorkers);
+
+	const int32 PreviousReplayWorkers = ReplayWorkers->GetInt();
+	ON_SCOPE_EXIT
+	{
+		ReplayWorkers->Set(PreviousReplayWorkers, ECVF_SetByCode);
+	};
+
+	FReplaySchedulerFixture Fixture(512);
+
+	// Alternate between replay workers and individually launched tasks to ensure that counters are always left in a valid state.
+	// Repeated worker counts re-use the parked worker threads from the previous execution.
+	for (int32 NumWorkers : { 2, 2, 0, -1, -1, 2 })
+	{
+		ReplayWorkers->Set(NumWorkers, ECVF_SetByCode);
+
+		FReplaySchedulerFixture::Factor = static_cast<double>(NumWorkers) + 10.0;
+		Fixture.Scheduler.ExecuteTasks();
+
+		for (TPair<FMovieSceneEntityID, int> Pair : Fixture.Entities)
+		{
+			const double ExpectedResult = static_cast<double>(Pair.Value) * FReplaySchedulerFixture::Factor;
+			UTEST_EQUAL("Double result", Fixture.EntityManager.ReadComponentChecked(Pair.Key, Fixture.DoubleComponent), ExpectedResult);
+			UTEST_EQUAL("Float result", Fixture.EntityManager.ReadComponentChecked(Pair.Key, Fixture.FloatComponent), static_cast<float>(ExpectedResult));
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneCustomSchedulerReplayPerfTest, 
+		"System.Engine.Sequencer.EntitySystem.Scheduler.ReplayWorkers.Perf", 
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter | EAutomationTestFlags::Disabled)
+bool FMovieSceneCustomSchedulerReplayPerfTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+	using namespace UE::MovieScene::Test;
+
+	IConsoleVariable* ReplayWorkers = IConsoleManager::Get().FindConsoleVariable(TEXT("Sequencer.CustomTaskScheduling.ReplayWorkers"));
+	UTEST_NOT_NULL("Replay workers console variable", ReplayWorkers);
+
+	const int32 PreviousReplayWorkers = ReplayWorkers->GetInt();
+	ON_SCOPE_EXIT
+	{
+		ReplayWorkers->Set(PreviousReplayWorkers, ECVF_SetByCode);
+	};
+
+	// Allocations hold up to 64 entities, so this results in several hundred small tasks
+	constexpr int32 NumEntities = 64 * 256;
+	constexpr int32 NumIterations = 1000;
+
+	FReplaySchedulerFixture Fixture(NumEntities);
+
+	auto RunBenchmark = [&Fixture, ReplayWorkers](int32 NumWorkers)
+	{
+		ReplayWorkers->Set(NumWorkers, ECVF_SetByCode);
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			Fixture.Scheduler.ExecuteTasks();
+		}
+		return FPlatformTime::Seconds() - StartTime;
+	};
+
+	const double LaunchSeconds = RunBenchmark(0);
+	const double ReplaySeconds = RunBenchmark(-1);
+
+	UE_LOG(LogMovieSceneECS, Display, TEXT("Executed %d entities %d times. Launched tasks: %.3fms, replay workers: %.3fms"),
+		NumEntities, NumIterations, LaunchSeconds * 1000.0, ReplaySeconds * 1000.0);
+
+	return true;
+}
+
 #undef LOCTEXT_NAMESPACE
 
 #endif // WITH_DEV_AUTOMATION_TESTS
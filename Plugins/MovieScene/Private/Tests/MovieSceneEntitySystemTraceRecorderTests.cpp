@@ -0,0 +1,99 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Async/ParallelFor.h"
+#include "EntitySystem/MovieSceneEntitySystemTraceRecorder.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneEntitySystemTraceRecorderTest,
+		"System.Engine.Sequencer.EntitySystem.TraceRecorder",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneEntitySystemTraceRecorderTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+
+	FEntitySystemTraceRecorder Recorder;
+
+	auto MakeEvent = [](int32 TaskIndex)
+	{
+		FEntitySystemTraceEvent Event;
+		Event.Name           = FName(TEXT("Task"), TaskIndex);
+		Event.StartCycles    = 100 + TaskIndex * 10;
+		Event.EndCycles      = 105 + TaskIndex * 10;
+		Event.TaskIndex      = TaskIndex;
+		Event.NumEntities    = TaskIndex * 2;
+		Event.NumAllocations = 1;
+		return Event;
+	};
+
+	// Events are ignored until recording starts
+	Recorder.Record(MakeEvent(0));
+	UTEST_EQUAL("Events before Start are ignored", Recorder.GetNumRecordedEvents(), uint64(0));
+
+	Recorder.Start(4);
+	for (int32 Index = 0; Index < 6; ++Index)
+	{
+		Recorder.Record(MakeEvent(Index));
+	}
+	Recorder.Stop();
+	Recorder.Record(MakeEvent(6));
+
+	// The ring buffer retains the most recent events, oldest first
+	TArray<FEntitySystemTraceEvent> Events = Recorder.GetEvents();
+	UTEST_EQUAL("Total recorded events", Recorder.GetNumRecordedEvents(), uint64(6));
+	UTEST_EQUAL("Retained events", Events.Num(), 4);
+	for (int32 Index = 0; Index < Events.Num(); ++Index)
+	{
+		UTEST_EQUAL("Retained event order", Events[Index].TaskIndex, Index + 2);
+	}
+
+	const FString Json = Recorder.ExportChromeTrace();
+	UTEST_TRUE("Trace has an event array", Json.StartsWith(TEXT("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[")) && Json.EndsWith(TEXT("]}")));
+	UTEST_TRUE("Trace contains the most recent event", Json.Contains(TEXT("\"task\":5")));
+	UTEST_FALSE("Trace does not contain overwritten events", Json.Contains(TEXT("\"task\":1")));
+	UTEST_TRUE("Trace contains thread metadata", Json.Contains(TEXT("\"thread_name\"")));
+
+	// Restarting discards everything
+	Recorder.Start(4);
+	UTEST_EQUAL("Restart discards events", Recorder.GetEvents().Num(), 0);
+	Recorder.Stop();
+
+	// Record from several threads while the ring buffer is repeatedly read and reallocated. Every event that is read must be complete.
+	std::atomic<int32> NumIncompleteEvents = 0;
+	Recorder.Start(8);
+	ParallelFor(8, [&Recorder, &MakeEvent, &NumIncompleteEvents](int32 ThreadIndex)
+	{
+		for (int32 Iteration = 0; Iteration < 2000; ++Iteration)
+		{
+			if (ThreadIndex == 0)
+			{
+				if (Iteration % 100 == 0)
+				{
+					Recorder.Start(8 + Iteration % 3);
+				}
+
+				for (const FEntitySystemTraceEvent& Event : Recorder.GetEvents())
+				{
+					const FEntitySystemTraceEvent Expected = MakeEvent(Event.TaskIndex);
+					if (Event.Name != Expected.Name || Event.StartCycles != Expected.StartCycles || Event.EndCycles != Expected.EndCycles || Event.NumEntities != Expected.NumEntities)
+					{
+						++NumIncompleteEvents;
+					}
+				}
+			}
+			else
+			{
+				Recorder.Record(MakeEvent(ThreadIndex * 10000 + Iteration));
+			}
+		}
+	});
+	Recorder.Stop();
+
+	UTEST_EQUAL("Concurrently read events are complete", NumIncompleteEvents.load(), 0);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
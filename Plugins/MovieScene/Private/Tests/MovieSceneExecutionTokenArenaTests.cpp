@@ -0,0 +1,174 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Evaluation/MovieSceneEvaluationTemplateInstance.h"
+#include "Evaluation/MovieSceneExecutionTokens.h"
+#include "IMovieScenePlayer.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UE::MovieScene::Test
+{
+
+/** Token that owns a non-trivial member, and records when it has been executed and destroyed */
+struct FCountingExecutionToken : IMovieSceneExecutionToken
+{
+	FCountingExecutionToken(int32& InNumExecuted, int32& InNumDestroyed)
+		: NumExecuted(InNumExecuted), NumDestroyed(InNumDestroyed), Payload({ 1, 2, 3 })
+	{}
+
+	virtual ~FCountingExecutionToken()
+	{
+		++NumDestroyed;
+	}
+
+	virtual void Execute(const FMovieSceneContext& Context, const FMovieSceneEvaluationOperand& Operand, FPersistentEvaluationData& PersistentData, IMovieScenePlayer& Player) override
+	{
+		++NumExecuted;
+	}
+
+	int32& NumExecuted;
+	int32& NumDestroyed;
+	TArray<int32> Payload;
+};
+
+/** Shared token that records when it has been executed and destroyed */
+struct FCountingSharedExecutionToken : IMovieSceneSharedExecutionToken
+{
+	FCountingSharedExecutionToken(int32& InNumExecuted, int32& InNumDestroyed, int32 InOrder)
+		: NumExecuted(InNumExecuted), NumDestroyed(InNumDestroyed), Payload(TEXT("Shared"))
+	{
+		Order = InOrder;
+	}
+
+	virtual ~FCountingSharedExecutionToken()
+	{
+		++NumDestroyed;
+	}
+
+	virtual void Execute(FPersistentEvaluationData& PersistentData, IMovieScenePlayer& Player) override
+	{
+		++NumExecuted;
+	}
+
+	int32& NumExecuted;
+	int32& NumDestroyed;
+	FString Payload;
+};
+
+struct FExecutionTokenTestPlayer : IMovieScenePlayer
+{
+	FMovieSceneRootEvaluationTemplateInstance RootInstance;
+	virtual FMovieSceneRootEvaluationTemplateInstance& GetEvaluationTemplate() override { return RootInstance; }
+	virtual void SetViewportSettings(const TMap<FViewportClient*, EMovieSceneViewportParams>& ViewportParamsMap) override {}
+	virtual void GetViewportSettings(TMap<FViewportClient*, EMovieSceneViewportParams>& ViewportParamsMap) const override {}
+	virtual EMovieScenePlayerStatus::Type GetPlaybackStatus() const override { return EMovieScenePlayerStatus::Stopped; }
+	virtual void SetPlaybackStatus(EMovieScenePlayerStatus::Type InPlaybackStatus) override {}
+};
+
+} // namespace UE::MovieScene::Test
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneExecutionTokenArenaTest,
+		"System.Engine.Sequencer.Evaluation.ExecutionTokenArena",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneExecutionTokenArenaTest::RunTest(const FString& Parameters)
+{
+	FMovieSceneExecutionTokenArena Arena;
+
+	// Allocations must honor the requested alignment and never overlap
+	uint8* First  = static_cast<uint8*>(Arena.Allocate(3, 1));
+	uint8* Second = static_cast<uint8*>(Arena.Allocate(16, 16));
+	UTEST_TRUE("Aligned allocation", IsAligned(Second, 16));
+	UTEST_TRUE("Allocations do not overlap", Second >= First + 3);
+
+	// Allocating more than a single block's worth overflows into further blocks
+	TArray<uint8*> Allocations;
+	for (int32 Index = 0; Index < 1024; ++Index)
+	{
+		uint8* Allocation = static_cast<uint8*>(Arena.Allocate(64, 8));
+		FMemory::Memset(Allocation, uint8(Index), 64);
+		Allocations.Add(Allocation);
+	}
+	for (int32 Index = 0; Index < Allocations.Num(); ++Index)
+	{
+		UTEST_EQUAL("Allocation contents remain intact", Allocations[Index][63], uint8(Index));
+	}
+
+	// After a reset, the same workload is serviced from the consolidated block
+	Arena.Reset();
+	uint8* PreviousAllocation = nullptr;
+	for (int32 Index = 0; Index < 1024; ++Index)
+	{
+		uint8* Allocation = static_cast<uint8*>(Arena.Allocate(64, 8));
+		if (PreviousAllocation)
+		{
+			UTEST_EQUAL("Allocations are contiguous after reset", Allocation, PreviousAllocation + 64);
+		}
+		PreviousAllocation = Allocation;
+	}
+
+	// Moving an arena transfers ownership of its memory
+	FMovieSceneExecutionTokenArena MovedArena(MoveTemp(Arena));
+	UTEST_NOT_NULL("Moved arena remains usable", MovedArena.Allocate(8, 8));
+	UTEST_NOT_NULL("Moved-from arena remains usable", Arena.Allocate(8, 8));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneExecutionTokenDestructionTest,
+		"System.Engine.Sequencer.Evaluation.ExecutionTokenDestruction",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneExecutionTokenDestructionTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene::Test;
+
+	FExecutionTokenTestPlayer Player;
+	const FMovieSceneContext Context(FMovieSceneEvaluationRange(0, FFrameRate()));
+
+	FMovieSceneTrackIdentifier TrackIdentifier;
+	++TrackIdentifier;
+
+	const FMovieSceneEvaluationScope Scope(FMovieSceneEvaluationKey(MovieSceneSequenceID::Root, TrackIdentifier, 0), EMovieSceneCompletionMode::KeepState);
+	const FMovieSceneEvaluationOperand Operand(MovieSceneSequenceID::Root, FGuid());
+
+	int32 NumExecuted = 0, NumDestroyed = 0;
+
+	// Applied tokens must run their derived destructors
+	{
+		FMovieSceneExecutionTokens ExecutionTokens;
+		ExecutionTokens.SetOperand(Operand);
+		ExecutionTokens.SetCurrentScope(Scope);
+		ExecutionTokens.Add(FCountingExecutionToken(NumExecuted, NumDestroyed));
+		ExecutionTokens.Add(FCountingExecutionToken(NumExecuted, NumDestroyed));
+		ExecutionTokens.AddShared(FMovieSceneSharedDataId::Allocate(), FCountingSharedExecutionToken(NumExecuted, NumDestroyed, -1));
+		ExecutionTokens.AddShared(FMovieSceneSharedDataId::Allocate(), FCountingSharedExecutionToken(NumExecuted, NumDestroyed, 1));
+
+		// Adding a token moves from a temporary, which is destroyed immediately
+		const int32 NumTemporariesDestroyed = NumDestroyed;
+		UTEST_EQUAL("Temporaries were destroyed", NumTemporariesDestroyed, 4);
+
+		ExecutionTokens.Apply(Context, Player);
+
+		UTEST_EQUAL("All tokens were executed", NumExecuted, 4);
+		UTEST_EQUAL("All applied tokens were destroyed", NumDestroyed - NumTemporariesDestroyed, 4);
+	}
+
+	// Tokens that are never applied must also run their derived destructors when discarded
+	NumExecuted = NumDestroyed = 0;
+	{
+		FMovieSceneExecutionTokens ExecutionTokens;
+		ExecutionTokens.SetOperand(Operand);
+		ExecutionTokens.SetCurrentScope(Scope);
+		ExecutionTokens.Add(FCountingExecutionToken(NumExecuted, NumDestroyed));
+		ExecutionTokens.AddShared(FMovieSceneSharedDataId::Allocate(), FCountingSharedExecutionToken(NumExecuted, NumDestroyed, 0));
+		NumDestroyed = 0;
+	}
+
+	UTEST_EQUAL("Discarded tokens were not executed", NumExecuted, 0);
+	UTEST_EQUAL("Discarded tokens were destroyed", NumDestroyed, 2);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,301 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "EntitySystem/BuiltInComponentTypes.h"
+#include "EntitySystem/MovieSceneEntityBuilder.h"
+#include "EntitySystem/MovieSceneEntityMutations.h"
+#include "EntitySystem/MovieSceneEntitySystemLinker.h"
+#include "EntitySystem/MovieSceneInitialValueCache.h"
+#include "EntitySystem/MovieScenePropertyComponentHandler.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeExit.h"
+#include "MovieSceneTestObjects.h"
+#include "TrackInstancePropertyBindings.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+#include <atomic>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UE::MovieScene::Test
+{
+
+/** Minimal property traits for exercising initial value storage */
+struct FInitialValueTestTraits
+{
+	using StorageType = double;
+};
+
+/** Property traits that return a fixed value for each property access path and record which thread they were called on */
+struct FInitialValueHandlerTestTraits
+{
+	using StorageType  = double;
+	using MetaDataType = TPropertyMetaData<>;
+
+	mutable std::atomic<int32> NumFastReads{ 0 };
+	mutable std::atomic<int32> NumCustomReads{ 0 };
+	mutable std::atomic<int32> NumSlowReads{ 0 };
+	mutable std::atomic<int32> NumReadsOffGameThread{ 0 };
+
+	void GetObjectPropertyValue(const UObject* InObject, const FCustomPropertyAccessor& BaseCustomAccessor, StorageType& OutValue) const
+	{
+		++NumCustomReads;
+		NumReadsOffGameThread += IsInGameThread() ? 0 : 1;
+		OutValue = 100.0;
+	}
+	void GetObjectPropertyValue(const UObject* InObject, uint16 PropertyOffset, StorageType& OutValue) const
+	{
+		++NumFastReads;
+		OutValue = PropertyOffset;
+	}
+	void GetObjectPropertyValue(const UObject* InObject, FTrackInstancePropertyBindings* PropertyBindings, StorageType& OutValue) const
+	{
+		++NumSlowReads;
+		NumReadsOffGameThread += IsInGameThread() ? 0 : 1;
+		OutValue = 200.0;
+	}
+};
+
+struct FInitialValueHandlerTestRegistration : ICustomPropertyRegistration
+{
+	TArray<FCustomPropertyAccessor> Accessors;
+
+	virtual FCustomAccessorView GetAccessors() const override
+	{
+		return FCustomAccessorView(Accessors);
+	}
+};
+
+/** Mutation that drives an initial value processor in the same way as UMovieSceneInitialValueSystem */
+struct FInitialValueHandlerTestMutation : IMovieSceneEntityMutation
+{
+	IInitialValueProcessor* Processor;
+
+	virtual void CreateMutation(FEntityManager* EntityManager, FComponentMask* InOutEntityComponentTypes) const override
+	{
+		InOutEntityComponentTypes->Set(FBuiltInComponentTypes::Get()->InitialValueIndex);
+	}
+	virtual void InitializeAllocation(FEntityAllocation* Allocation, const FComponentMask& AllocationType) const override
+	{
+		Processor->Process(Allocation, AllocationType);
+	}
+};
+
+} // namespace UE::MovieScene::Test
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneInitialValueSlotStorageTest,
+		"System.Engine.Sequencer.EntitySystem.InitialValueSlotStorage",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneInitialValueSlotStorageTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+	using namespace UE::MovieScene::Test;
+
+	UObject* Object = GetTransientPackage();
+
+	TPropertyValueStorage<FInitialValueTestTraits> Storage;
+
+	// Cache a value through the regular keyed path first
+	const FInitialValueIndex ExistingIndex = Storage.AddInitialValue(Object, 1.0, uint16(8));
+
+	const FInitialValueIndex FirstSlot = Storage.ReserveSlots(3);
+	const FInitialValueIndex SlotA{ uint16(FirstSlot.Index + 0) };
+	const FInitialValueIndex SlotB{ uint16(FirstSlot.Index + 1) };
+	const FInitialValueIndex SlotC{ uint16(FirstSlot.Index + 2) };
+
+	Storage.BeginConcurrentAccess();
+
+	TOptional<FInitialValueIndex> Found = Storage.FindPropertyIndexConcurrent(Object, uint16(8));
+	UTEST_TRUE("Existing value is found", Found.IsSet() && Found->Index == ExistingIndex.Index);
+	UTEST_FALSE("New value is not found", Storage.FindPropertyIndexConcurrent(Object, uint16(16)).IsSet());
+
+	Storage.GetSlotValue(SlotB) = 2.0;
+	Storage.GetSlotValue(SlotC) = 3.0;
+
+	// Slot A resolved to the existing value so is released, slot C duplicates slot B so cannot be committed
+	Storage.ReleaseSlot(SlotA);
+	UTEST_TRUE("First slot is committed", Storage.CommitSlot(Object, uint16(16), SlotB));
+	UTEST_FALSE("Duplicate slot is rejected", Storage.CommitSlot(Object, uint16(16), SlotC));
+	Storage.ReleaseSlot(SlotC);
+
+	const double* CommittedValue = Storage.FindCachedValue(Object, uint16(16));
+	UTEST_TRUE("Committed value is found", CommittedValue != nullptr && *CommittedValue == 2.0);
+
+	const double* ExistingValue = Storage.FindCachedValue(Object, uint16(8));
+	UTEST_TRUE("Existing value is unchanged", ExistingValue != nullptr && *ExistingValue == 1.0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneInitialValueSlotChurnTest,
+		"System.Engine.Sequencer.EntitySystem.InitialValueSlotChurn",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneInitialValueSlotChurnTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+	using namespace UE::MovieScene::Test;
+
+	constexpr int32 NumSlots      = 64;
+	constexpr int32 NumIterations = 4000;
+
+	UObject* Object = GetTransientPackage();
+
+	TPropertyValueStorage<FInitialValueTestTraits> Storage;
+
+	// A long-lived value ensures that released slots are reused around it rather than only trimmed from the end
+	const FInitialValueIndex PersistentIndex = Storage.AddInitialValue(Object, -1.0, uint16(0));
+
+	// Simulate entities continually being linked and unlinked. Without slot reuse this would reserve 256,000 slots and overflow the 16 bit index.
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		const FInitialValueIndex FirstSlot = Storage.ReserveSlots(NumSlots);
+		UTEST_TRUE("Reserved slots are reused", FirstSlot.Index + NumSlots <= NumSlots * 3 + 1);
+
+		Storage.BeginConcurrentAccess();
+
+		// Commit half of the slots, and release the rest as if they had resolved to existing values
+		TArray<FInitialValueIndex> Committed;
+		for (int32 Offset = 0; Offset < NumSlots; ++Offset)
+		{
+			const FInitialValueIndex Slot{ uint16(FirstSlot.Index + Offset) };
+			Storage.GetSlotValue(Slot) = Iteration;
+
+			if (Offset % 2 == 0 && Storage.CommitSlot(Object, uint16(Offset + 1), Slot))
+			{
+				Committed.Add(Slot);
+			}
+			else
+			{
+				Storage.ReleaseSlot(Slot);
+			}
+		}
+
+		const double* CommittedValue = Storage.FindCachedValue(Object, uint16(1));
+		UTEST_TRUE("Committed value is found", CommittedValue != nullptr && *CommittedValue == double(Iteration));
+
+		// Unlink all the committed values again
+		Storage.Reset(Committed);
+	}
+
+	const double* PersistentValue = Storage.FindCachedValue(Object, uint16(0));
+	UTEST_TRUE("Persistent value is unchanged", PersistentValue != nullptr && *PersistentValue == -1.0);
+	UTEST_EQUAL("Persistent value index is unchanged", Storage.FindPropertyIndex(Object, uint16(0))->Index, PersistentIndex.Index);
+	UTEST_FALSE("Unlinked values are no longer found", Storage.FindPropertyIndex(Object, uint16(1)).IsSet());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneInitialValueProcessorTest,
+		"System.Engine.Sequencer.EntitySystem.InitialValueProcessor",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneInitialValueProcessorTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+	using namespace UE::MovieScene::Test;
+
+	FBuiltInComponentTypes* BuiltInComponents = FBuiltInComponentTypes::Get();
+
+	IConsoleVariable* AllocationThreshold = IConsoleManager::Get().FindConsoleVariable(TEXT("Sequencer.ThreadedEvaluation.AllocationThreshold"));
+	UTEST_NOT_NULL("Allocation threshold console variable", AllocationThreshold);
+
+	const int32 OldAllocationThreshold = AllocationThreshold->GetInt();
+	ON_SCOPE_EXIT
+	{
+		AllocationThreshold->Set(OldAllocationThreshold, ECVF_SetByCode);
+	};
+
+	TStrongObjectPtr<UTestMovieSceneObject> Object(NewObject<UTestMovieSceneObject>(GetTransientPackage()));
+
+	FInitialValueHandlerTestRegistration CustomRegistration;
+	CustomRegistration.Accessors.Add(FCustomPropertyAccessor{ UTestMovieSceneObject::StaticClass(), TEXT("CustomA") });
+	CustomRegistration.Accessors.Add(FCustomPropertyAccessor{ UTestMovieSceneObject::StaticClass(), TEXT("CustomB") });
+
+	TSharedPtr<FTrackInstancePropertyBindings> SlowBindings = MakeShared<FTrackInstancePropertyBindings>(TEXT("Slow"), TEXT("Slow"));
+
+	const TComponentTypeID<double> InitialValueType = BuiltInComponents->DoubleResult[0];
+	const uint16 InvalidIndex = 0xFFFF;
+
+	// Run the same set of entities through the serial and concurrent paths, which must produce identical results
+	for (const bool bThreaded : { false, true })
+	{
+		const TCHAR* Context = bThreaded ? TEXT("(threaded)") : TEXT("(serial)");
+
+		AllocationThreshold->Set(bThreaded ? 0 : OldAllocationThreshold, ECVF_SetByCode);
+
+		TStrongObjectPtr<UMovieSceneEntitySystemLinker> Linker(NewObject<UMovieSceneEntitySystemLinker>(GetTransientPackage()));
+		FEntityManager& EntityManager = Linker->EntityManager;
+
+		auto MakeEntity = [&](auto&& Builder)
+		{
+			return Builder.Add(BuiltInComponents->BoundObject, Object.Get()).Add(InitialValueType, 0.0).CreateEntity(&EntityManager);
+		};
+
+		const FMovieSceneEntityID ExistingFast   = MakeEntity(FEntityBuilder().Add(BuiltInComponents->FastPropertyOffset, uint16(8)));
+		const FMovieSceneEntityID NewFast        = MakeEntity(FEntityBuilder().Add(BuiltInComponents->FastPropertyOffset, uint16(16)));
+		const FMovieSceneEntityID ExistingCustom = MakeEntity(FEntityBuilder().Add(BuiltInComponents->CustomPropertyIndex, FCustomPropertyIndex{ 0 }));
+		const FMovieSceneEntityID NewCustom      = MakeEntity(FEntityBuilder().Add(BuiltInComponents->CustomPropertyIndex, FCustomPropertyIndex{ 1 }));
+		const FMovieSceneEntityID NewSlow        = MakeEntity(FEntityBuilder().Add(BuiltInComponents->SlowProperty, SlowBindings));
+
+		EntityManager.UpdateThreadingModel();
+		if (bThreaded && EntityManager.GetThreadingModel() == EEntityThreadingModel::NoThreading)
+		{
+			AddInfo(TEXT("Skipping threaded initial value processing since this platform does not support multithreading"));
+			continue;
+		}
+
+		// Values that were cached before this batch must be re-used without reading the property
+		FInitialValueCache InitialValueCache;
+		TPropertyValueStorage<FInitialValueHandlerTestTraits>* Storage = InitialValueCache.GetStorage<FInitialValueHandlerTestTraits>(InitialValueType);
+		Storage->AddInitialValue(Object.Get(), 5.0, uint16(8));
+		Storage->AddInitialValue(Object.Get(), 6.0, FCustomPropertyIndex{ 0 });
+
+		FInitialValueHandlerTestTraits Traits;
+		TInitialValueProcessor<FInitialValueHandlerTestTraits> Processor(&Traits, InitialValueType, TArrayView<const FComponentTypeID>(), &CustomRegistration);
+
+		FInitialValueHandlerTestMutation Mutation;
+		Mutation.Processor = &Processor;
+
+		FEntityComponentFilter Filter;
+		Filter.All({ BuiltInComponents->BoundObject, InitialValueType });
+
+		Processor.Initialize(Linker.Get(), &InitialValueCache);
+		EntityManager.MutateAll(Filter, Mutation);
+		Processor.ProcessDeferred();
+		Processor.Finalize();
+
+		auto ReadValue = [&EntityManager, InitialValueType](FMovieSceneEntityID Entity)
+		{
+			return EntityManager.ReadComponentChecked(Entity, InitialValueType);
+		};
+		auto ReadIndex = [&EntityManager, BuiltInComponents](FMovieSceneEntityID Entity)
+		{
+			return EntityManager.ReadComponentChecked(Entity, BuiltInComponents->InitialValueIndex).Index;
+		};
+
+		UTEST_EQUAL(FString::Printf(TEXT("Existing fast value %s"), Context), ReadValue(ExistingFast), 5.0);
+		UTEST_EQUAL(FString::Printf(TEXT("Existing fast index %s"), Context), ReadIndex(ExistingFast), InvalidIndex);
+		UTEST_EQUAL(FString::Printf(TEXT("Existing custom value %s"), Context), ReadValue(ExistingCustom), 6.0);
+		UTEST_EQUAL(FString::Printf(TEXT("Existing custom index %s"), Context), ReadIndex(ExistingCustom), InvalidIndex);
+
+		UTEST_EQUAL(FString::Printf(TEXT("New fast value %s"), Context), ReadValue(NewFast), 16.0);
+		UTEST_EQUAL(FString::Printf(TEXT("New custom value %s"), Context), ReadValue(NewCustom), 100.0);
+		UTEST_EQUAL(FString::Printf(TEXT("New slow value %s"), Context), ReadValue(NewSlow), 200.0);
+
+		TOptional<FInitialValueIndex> NewFastIndex   = Storage->FindPropertyIndex(Object.Get(), uint16(16));
+		TOptional<FInitialValueIndex> NewCustomIndex = Storage->FindPropertyIndex(Object.Get(), FCustomPropertyIndex{ 1 });
+		TOptional<FInitialValueIndex> NewSlowIndex   = Storage->FindPropertyIndex(Object.Get(), FName(TEXT("Slow")));
+		UTEST_TRUE(FString::Printf(TEXT("New fast value is cached %s"), Context), NewFastIndex.IsSet() && NewFastIndex->Index == ReadIndex(NewFast));
+		UTEST_TRUE(FString::Printf(TEXT("New custom value is cached %s"), Context), NewCustomIndex.IsSet() && NewCustomIndex->Index == ReadIndex(NewCustom));
+		UTEST_TRUE(FString::Printf(TEXT("New slow value is cached %s"), Context), NewSlowIndex.IsSet() && NewSlowIndex->Index == ReadIndex(NewSlow));
+
+		UTEST_EQUAL(FString::Printf(TEXT("Fast reads %s"), Context), Traits.NumFastReads.load(), 1);
+		UTEST_EQUAL(FString::Printf(TEXT("Custom reads %s"), Context), Traits.NumCustomReads.load(), 1);
+		UTEST_EQUAL(FString::Printf(TEXT("Slow reads %s"), Context), Traits.NumSlowReads.load(), 1);
+		UTEST_EQUAL(FString::Printf(TEXT("Custom and slow properties are only read on the game thread %s"), Context), Traits.NumReadsOffGameThread.load(), 0);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,172 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "EntitySystem/BuiltInComponentTypes.h"
+#include "EntitySystem/MovieSceneEntityBuilder.h"
+#include "EntitySystem/MovieSceneEntitySystemLinker.h"
+#include "EntitySystem/MovieSceneOverlappingEntityTracker.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#define LOCTEXT_NAMESPACE "MovieSceneOverlappingEntityTrackerTests"
+
+namespace UE::MovieScene::Test
+{
+
+/** Output handler that simply records the number of inputs contributing to each output */
+struct FOverlappingEntityCountHandler
+{
+	void InitializeOutput(int16 Key, TArrayView<const FMovieSceneEntityID> Inputs, int32* Output, FEntityOutputAggregate Aggregate)
+	{
+		*Output = Inputs.Num();
+	}
+	void UpdateOutput(int16 Key, TArrayView<const FMovieSceneEntityID> Inputs, int32* Output, FEntityOutputAggregate Aggregate)
+	{
+		*Output = Inputs.Num();
+	}
+	void DestroyOutput(int16 Key, int32* Output, FEntityOutputAggregate Aggregate)
+	{
+		*Output = 0;
+	}
+};
+
+/** Allocates NumEntities entities spread over NumKeys distinct keys, all tagged as NeedsLink */
+TArray<FMovieSceneEntityID> CreateOverlappingEntities(UMovieSceneEntitySystemLinker* Linker, int32 NumEntities, int32 NumKeys)
+{
+	FBuiltInComponentTypes* BuiltInComponents = FBuiltInComponentTypes::Get();
+
+	TArray<FMovieSceneEntityID> EntityIDs;
+	EntityIDs.Reserve(NumEntities);
+	for (int32 Index = 0; Index < NumEntities; ++Index)
+	{
+		EntityIDs.Add(
+			FEntityBuilder()
+			.Add(BuiltInComponents->HierarchicalBias, static_cast<int16>(Index % NumKeys))
+			.AddTag(BuiltInComponents->Tags.NeedsLink)
+			.CreateEntity(&Linker->EntityManager)
+		);
+	}
+	return EntityIDs;
+}
+
+template<typename TrackerType>
+double UpdateTracker(UMovieSceneEntitySystemLinker* Linker, TrackerType& Tracker)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	Tracker.Update(Linker, FBuiltInComponentTypes::Get()->HierarchicalBias, FEntityComponentFilter());
+	Tracker.ProcessInvalidatedOutputs(Linker, FOverlappingEntityCountHandler());
+
+	return FPlatformTime::Seconds() - StartTime;
+}
+
+} // namespace UE::MovieScene::Test
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneDenseOverlappingEntityTrackerTest,
+		"System.Engine.Sequencer.EntitySystem.DenseOverlappingEntityTracker",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneDenseOverlappingEntityTrackerTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+	using namespace UE::MovieScene::Test;
+
+	TStrongObjectPtr<UMovieSceneEntitySystemLinker> Linker(NewObject<UMovieSceneEntitySystemLinker>(GetTransientPackage()));
+
+	constexpr int32 NumEntities = 1000;
+	constexpr int32 NumKeys = 37;
+	TArray<FMovieSceneEntityID> EntityIDs = CreateOverlappingEntities(Linker.Get(), NumEntities, NumKeys);
+
+	TOverlappingEntityTracker<int32, int16> MapTracker;
+	TDenseOverlappingEntityTracker<int32, int16> DenseTracker;
+	MapTracker.Initialize(nullptr);
+	DenseTracker.Initialize(nullptr);
+
+	UpdateTracker(Linker.Get(), MapTracker);
+	UpdateTracker(Linker.Get(), DenseTracker);
+
+	for (FMovieSceneEntityID EntityID : EntityIDs)
+	{
+		const int32* MapOutput   = MapTracker.FindOutput(EntityID);
+		const int32* DenseOutput = DenseTracker.FindOutput(EntityID);
+
+		UTEST_TRUE("Dense output exists", DenseOutput != nullptr);
+		UTEST_TRUE("Map output exists", MapOutput != nullptr);
+		UTEST_EQUAL("Output input count", *DenseOutput, *MapOutput);
+	}
+
+	for (int16 Key = 0; Key < NumKeys; ++Key)
+	{
+		TArray<FMovieSceneEntityID> MapEntities, DenseEntities;
+		MapTracker.FindEntityIDs(Key, MapEntities);
+		DenseTracker.FindEntityIDs(Key, DenseEntities);
+
+		MapEntities.Sort();
+		DenseEntities.Sort();
+		UTEST_EQUAL("Entities for key", DenseEntities, MapEntities);
+	}
+
+	// Unlink every other entity and make sure both trackers agree on what remains
+	FComponentTypeID NeedsLink = FBuiltInComponentTypes::Get()->Tags.NeedsLink;
+	FComponentTypeID NeedsUnlink = FBuiltInComponentTypes::Get()->Tags.NeedsUnlink;
+	for (int32 Index = 0; Index < EntityIDs.Num(); ++Index)
+	{
+		Linker->EntityManager.RemoveComponent(EntityIDs[Index], NeedsLink);
+		if (Index % 2 == 0)
+		{
+			Linker->EntityManager.AddComponent(EntityIDs[Index], NeedsUnlink);
+		}
+	}
+
+	UpdateTracker(Linker.Get(), MapTracker);
+	UpdateTracker(Linker.Get(), DenseTracker);
+
+	for (int32 Index = 0; Index < EntityIDs.Num(); ++Index)
+	{
+		const bool bExpectOutput = (Index % 2) != 0;
+		UTEST_EQUAL("Map output after unlink", MapTracker.FindOutput(EntityIDs[Index]) != nullptr, bExpectOutput);
+		UTEST_EQUAL("Dense output after unlink", DenseTracker.FindOutput(EntityIDs[Index]) != nullptr, bExpectOutput);
+	}
+
+	MapTracker.Destroy(FOverlappingEntityCountHandler());
+	DenseTracker.Destroy(FOverlappingEntityCountHandler());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneDenseOverlappingEntityTrackerPerfTest,
+		"System.Engine.Sequencer.EntitySystem.DenseOverlappingEntityTracker.Perf",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter | EAutomationTestFlags::Disabled)
+bool FMovieSceneDenseOverlappingEntityTrackerPerfTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+	using namespace UE::MovieScene::Test;
+
+	TStrongObjectPtr<UMovieSceneEntitySystemLinker> Linker(NewObject<UMovieSceneEntitySystemLinker>(GetTransientPackage()));
+
+	// Mirrors the shape of a large property instantiation: 50k inputs animating 10k distinct outputs
+	constexpr int32 NumEntities = 50000;
+	constexpr int32 NumKeys = 10000;
+	CreateOverlappingEntities(Linker.Get(), NumEntities, NumKeys);
+
+	TOverlappingEntityTracker<int32, int16> MapTracker;
+	TDenseOverlappingEntityTracker<int32, int16> DenseTracker;
+	MapTracker.Initialize(nullptr);
+	DenseTracker.Initialize(nullptr);
+
+	const double MapSeconds   = UpdateTracker(Linker.Get(), MapTracker);
+	const double DenseSeconds = UpdateTracker(Linker.Get(), DenseTracker);
+
+	UE_LOG(LogMovieScene, Display, TEXT("Instantiated %d entities (%d outputs): TMap storage %.3fms, dense storage %.3fms"),
+		NumEntities, NumKeys, MapSeconds * 1000.0, DenseSeconds * 1000.0);
+
+	MapTracker.Destroy(FOverlappingEntityCountHandler());
+	DenseTracker.Destroy(FOverlappingEntityCountHandler());
+	return true;
+}
+
+#undef LOCTEXT_NAMESPACE
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,151 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Compilation/MovieSceneCompiledDataManager.h"
+#include "EntitySystem/MovieSceneSequenceInstance.h"
+#include "Evaluation/MovieSceneEvaluationTemplateInstance.h"
+#include "IMovieScenePlayer.h"
+#include "Misc/AutomationTest.h"
+#include "MovieScene.h"
+#include "MovieSceneMarkedFrame.h"
+#include "Tests/MovieSceneTestObjects.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneRootDeterminismTableTest,
+		"System.Engine.Sequencer.Compiler.RootDeterminismTable",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneRootDeterminismTableTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+
+	auto AddFence = [](UMovieSceneSequence* Sequence, int32 FrameNumber)
+	{
+		FMovieSceneMarkedFrame MarkedFrame(FrameNumber);
+		MarkedFrame.bIsDeterminismFence = true;
+		Sequence->GetMovieScene()->AddMarkedFrame(MarkedFrame);
+		Sequence->GetMovieScene()->MarkAsChanged();
+	};
+
+	UTestMovieSceneSequence* RootSequence = NewObject<UTestMovieSceneSequence>(GetTransientPackage());
+	RootSequence->GetMovieScene()->SetPlaybackRange(0, 300);
+	AddFence(RootSequence, 10);
+
+	UTestMovieSceneSequence* ShotSequence = NewObject<UTestMovieSceneSequence>(GetTransientPackage());
+	ShotSequence->GetMovieScene()->SetPlaybackRange(0, 100);
+	AddFence(ShotSequence, 50);
+
+	// The shot plays from root frame 100, so its fence at 50 should be flattened to 150 in root space
+	UTestMovieSceneSubTrack* RootSubTrack = RootSequence->GetMovieScene()->AddTrack<UTestMovieSceneSubTrack>();
+	UTestMovieSceneSubSection* ShotSubSection = NewObject<UTestMovieSceneSubSection>(RootSubTrack);
+	ShotSubSection->SetRange(TRange<FFrameNumber>(100, 200));
+	ShotSubSection->SetSequence(ShotSequence);
+	RootSubTrack->SectionArray.Add(ShotSubSection);
+
+	UMovieSceneCompiledDataManager* CompiledDataManager = NewObject<UMovieSceneCompiledDataManager>(GetTransientPackage());
+	FMovieSceneCompiledDataID RootDataID = CompiledDataManager->Compile(RootSequence);
+
+	{
+		const FRootDeterminismTable& Table = CompiledDataManager->GetRootDeterminismTable(RootDataID);
+		UTEST_EQUAL("Number of fences", Table.Fences.Num(), 2);
+		UTEST_EQUAL("Number of dynamic ranges", Table.DynamicRanges.Num(), 0);
+		UTEST_EQUAL("Root fence", Table.Fences[0].FrameTime, FFrameTime(10));
+		UTEST_EQUAL("Flattened sub sequence fence", Table.Fences[1].FrameTime, FFrameTime(150));
+	}
+
+	// Recompiling the sub sequence must invalidate the table
+	AddFence(ShotSequence, 20);
+	CompiledDataManager->Compile(RootSequence);
+
+	{
+		const FRootDeterminismTable& Table = CompiledDataManager->GetRootDeterminismTable(RootDataID);
+		UTEST_EQUAL("Number of fences after recompile", Table.Fences.Num(), 3);
+		UTEST_EQUAL("Fences remain sorted", Table.Fences[1].FrameTime, FFrameTime(120));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneRootDeterminismTableDissectionTest,
+		"System.Engine.Sequencer.Compiler.RootDeterminismTable.Dissection",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneRootDeterminismTableDissectionTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+
+	UTestMovieSceneSequence* RootSequence = NewObject<UTestMovieSceneSequence>(GetTransientPackage());
+	RootSequence->GetMovieScene()->SetPlaybackRange(0, 300);
+
+	UTestMovieSceneSequence* ShotSequence = NewObject<UTestMovieSceneSequence>(GetTransientPackage());
+	ShotSequence->GetMovieScene()->SetPlaybackRange(0, 100);
+
+	// Exclusive fence at 50 in the shot, which plays from root frame 100, is flattened to 150 in the root table
+	FMovieSceneMarkedFrame MarkedFrame(50);
+	MarkedFrame.bIsDeterminismFence = true;
+	ShotSequence->GetMovieScene()->AddMarkedFrame(MarkedFrame);
+
+	UTestMovieSceneSubTrack* RootSubTrack = RootSequence->GetMovieScene()->AddTrack<UTestMovieSceneSubTrack>();
+	UTestMovieSceneSubSection* ShotSubSection = NewObject<UTestMovieSceneSubSection>(RootSubTrack);
+	ShotSubSection->SetRange(TRange<FFrameNumber>(100, 200));
+	ShotSubSection->SetSequence(ShotSequence);
+	RootSubTrack->SectionArray.Add(ShotSubSection);
+
+	struct FTestMovieScenePlayer : IMovieScenePlayer
+	{
+		FMovieSceneRootEvaluationTemplateInstance RootInstance;
+		virtual FMovieSceneRootEvaluationTemplateInstance& GetEvaluationTemplate() override { return RootInstance; }
+		virtual void SetViewportSettings(const TMap<FViewportClient*, EMovieSceneViewportParams>& ViewportParamsMap) override {}
+		virtual void GetViewportSettings(TMap<FViewportClient*, EMovieSceneViewportParams>& ViewportParamsMap) const override {}
+		virtual EMovieScenePlayerStatus::Type GetPlaybackStatus() const override { return EMovieScenePlayerStatus::Playing; }
+		virtual void SetPlaybackStatus(EMovieScenePlayerStatus::Type InPlaybackStatus) override {}
+	} TestPlayer;
+
+	TestPlayer.RootInstance.Initialize(*RootSequence, TestPlayer, UMovieSceneCompiledDataManager::GetPrecompiledData());
+
+	FSequenceInstance* RootInstance = TestPlayer.RootInstance.FindInstance(MovieSceneSequenceID::Root);
+	UTEST_NOT_NULL("Root sequence instance", RootInstance);
+
+	const FFrameRate TickResolution = RootSequence->GetMovieScene()->GetTickResolution();
+
+	auto Dissect = [RootInstance, TickResolution](const TRange<FFrameTime>& Range)
+	{
+		TArray<TRange<FFrameTime>> Dissections;
+		RootInstance->DissectContext(FMovieSceneContext(FMovieSceneEvaluationRange(Range, TickResolution, EPlayDirection::Forwards)), Dissections);
+		return Dissections;
+	};
+
+	{
+		// An update that ends exactly on the fence is not dissected
+		TArray<TRange<FFrameTime>> Dissections = Dissect(TRange<FFrameTime>(TRangeBound<FFrameTime>::Exclusive(140), TRangeBound<FFrameTime>::Inclusive(150)));
+		UTEST_EQUAL("Dissections ending on a fence", Dissections.Num(), 0);
+	}
+
+	{
+		// An update that starts exactly on the fence is not dissected either
+		TArray<TRange<FFrameTime>> Dissections = Dissect(TRange<FFrameTime>(TRangeBound<FFrameTime>::Exclusive(150), TRangeBound<FFrameTime>::Inclusive(160)));
+		UTEST_EQUAL("Dissections starting after a fence", Dissections.Num(), 0);
+	}
+
+	{
+		// An update that straddles the fence is split either side of it
+		TArray<TRange<FFrameTime>> Dissections = Dissect(TRange<FFrameTime>(TRangeBound<FFrameTime>::Exclusive(140), TRangeBound<FFrameTime>::Inclusive(160)));
+		UTEST_EQUAL("Dissections straddling a fence", Dissections.Num(), 2);
+		UTEST_EQUAL("Range before the fence", Dissections[0], TRange<FFrameTime>(TRangeBound<FFrameTime>::Exclusive(140), TRangeBound<FFrameTime>::Exclusive(150)));
+		UTEST_EQUAL("Range after the fence", Dissections[1], TRange<FFrameTime>(TRangeBound<FFrameTime>::Inclusive(150), TRangeBound<FFrameTime>::Inclusive(160)));
+	}
+
+	{
+		// An exclusive upper bound on the fence yields the whole range, matching the frame number fence lookup
+		TArray<TRange<FFrameTime>> Dissections = Dissect(TRange<FFrameTime>(TRangeBound<FFrameTime>::Inclusive(140), TRangeBound<FFrameTime>::Exclusive(150)));
+		UTEST_EQUAL("Dissections with an exclusive upper bound on a fence", Dissections.Num(), 1);
+		UTEST_EQUAL("Whole range", Dissections[0], TRange<FFrameTime>(TRangeBound<FFrameTime>::Inclusive(140), TRangeBound<FFrameTime>::Exclusive(150)));
+	}
+
+	TestPlayer.RootInstance.TearDown();
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,268 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "EntitySystem/MovieSceneEntitySystemLinker.h"
+#include "EntitySystem/MovieSceneSharedPlaybackState.h"
+#include "Evaluation/MovieSceneEvaluationField.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeExit.h"
+#include "MovieScene.h"
+#include "MovieSceneSpawnable.h"
+#include "MovieSceneSpawnRegister.h"
+#include "MovieSceneTestObjects.h"
+#include "MovieSceneTimeHelpers.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UE::MovieScene::Tests
+{
+
+/** Spawn register that spawns bare actors and counts how many were created and destroyed */
+class FPoolTestSpawnRegister : public FMovieSceneSpawnRegister
+{
+public:
+
+	using FMovieSceneSpawnRegister::SpawnObject;
+	using FMovieSceneSpawnRegister::DestroySpawnedObject;
+
+	int32 NumSpawned = 0;
+	int32 NumDestroyed = 0;
+	int32 NumPreDestroyed = 0;
+
+	/** Bindings that PreDestroyObject was called for, in order */
+	TArray<FGuid> PreDestroyedBindings;
+
+protected:
+
+	virtual UObject* SpawnObject(FMovieSceneSpawnable&, FMovieSceneSequenceIDRef, TSharedRef<const FSharedPlaybackState>) override
+	{
+		AActor* Actor = NewObject<AActor>(GetTransientPackage());
+		Actor->PrimaryActorTick.bCanEverTick = true;
+		++NumSpawned;
+		return Actor;
+	}
+
+	virtual void PreDestroyObject(UObject& Object, const FGuid& BindingId, int32 BindingIndex, FMovieSceneSequenceIDRef TemplateID) override
+	{
+		PreDestroyedBindings.Add(BindingId);
+		++NumPreDestroyed;
+	}
+
+	virtual void DestroySpawnedObject(UObject& Object, UMovieSceneSpawnableBindingBase*) override
+	{
+		Object.MarkAsGarbage();
+		++NumDestroyed;
+	}
+};
+
+} // namespace UE::MovieScene::Tests
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneSpawnablePoolReuseTest,
+		"System.Engine.Sequencer.SpawnablePool.Reuse",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneSpawnablePoolReuseTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+	using namespace UE::MovieScene::Tests;
+
+	IConsoleVariable* EnablePooling = IConsoleManager::Get().FindConsoleVariable(TEXT("Sequencer.SpawnablePool.Enable"));
+	UTEST_NOT_NULL("Spawnable pool console variable", EnablePooling);
+
+	const bool bOldEnablePooling = EnablePooling->GetBool();
+	ON_SCOPE_EXIT
+	{
+		EnablePooling->Set(bOldEnablePooling, ECVF_SetByCode);
+	};
+	EnablePooling->Set(true, ECVF_SetByCode);
+
+	UTestMovieSceneSequence* Sequence = NewObject<UTestMovieSceneSequence>(GetTransientPackage());
+	AActor* Template = NewObject<AActor>(GetTransientPackage());
+	const FGuid BindingId = Sequence->MovieScene->AddSpawnable(TEXT("Pooled"), *Template);
+
+	FSharedPlaybackStateCreateParams CreateParams;
+	CreateParams.Linker = NewObject<UMovieSceneEntitySystemLinker>(GetTransientPackage());
+	TSharedRef<FSharedPlaybackState> PlaybackState = MakeShared<FSharedPlaybackState>(*Sequence, CreateParams);
+
+	FPoolTestSpawnRegister SpawnRegister;
+
+	// Spawn the object and give it a state that differs from an actor's defaults
+	AActor* Spawned = Cast<AActor>(SpawnRegister.SpawnObject(BindingId, *Sequence->MovieScene, MovieSceneSequenceID::Root, PlaybackState));
+	UTEST_NOT_NULL("Spawned actor", Spawned);
+
+	Spawned->SetActorHiddenInGame(true);
+	Spawned->SetActorEnableCollision(false);
+	Spawned->SetActorTickEnabled(true);
+
+	// Destroying the object should park it in a deactivated state
+	SpawnRegister.DestroySpawnedObject(BindingId, MovieSceneSequenceID::Root, PlaybackState);
+
+	UTEST_EQUAL("Parked actor was not destroyed", SpawnRegister.NumDestroyed, 0);
+	UTEST_EQUAL("Actor was parked", SpawnRegister.GetSpawnablePoolStats().NumParked, 1);
+	UTEST_TRUE("Parked actor is hidden", Spawned->IsHidden());
+	UTEST_FALSE("Parked actor has no collision", Spawned->GetActorEnableCollision());
+	UTEST_FALSE("Parked actor does not tick", Spawned->IsActorTickEnabled());
+
+	// Respawning should reuse the parked object and restore its previous state rather than the actor defaults
+	AActor* Reused = Cast<AActor>(SpawnRegister.SpawnObject(BindingId, *Sequence->MovieScene, MovieSceneSequenceID::Root, PlaybackState));
+
+	UTEST_EQUAL("Pooled actor was reused", Reused, Spawned);
+	UTEST_EQUAL("No new actor was spawned", SpawnRegister.NumSpawned, 1);
+	UTEST_EQUAL("Pool hit was recorded", SpawnRegister.GetSpawnablePoolStats().NumHits, 1);
+	UTEST_TRUE("Reused actor is still hidden", Reused->IsHidden());
+	UTEST_FALSE("Reused actor still has no collision", Reused->GetActorEnableCollision());
+	UTEST_TRUE("Reused actor ticks", Reused->IsActorTickEnabled());
+
+	// Cycle again with the opposite state to ensure that the state is captured each time the object is parked
+	Reused->SetActorHiddenInGame(false);
+	Reused->SetActorEnableCollision(true);
+	Reused->SetActorTickEnabled(false);
+
+	SpawnRegister.DestroySpawnedObject(BindingId, MovieSceneSequenceID::Root, PlaybackState);
+	Reused = Cast<AActor>(SpawnRegister.SpawnObject(BindingId, *Sequence->MovieScene, MovieSceneSequenceID::Root, PlaybackState));
+
+	UTEST_EQUAL("Pooled actor was reused again", Reused, Spawned);
+	UTEST_EQUAL("Still no new actor was spawned", SpawnRegister.NumSpawned, 1);
+	UTEST_FALSE("Reused actor is visible", Reused->IsHidden());
+	UTEST_TRUE("Reused actor has collision", Reused->GetActorEnableCollision());
+	UTEST_FALSE("Reused actor does not tick", Reused->IsActorTickEnabled());
+
+	// Destroying with the pool disabled should really destroy the object
+	EnablePooling->Set(false, ECVF_SetByCode);
+	SpawnRegister.DestroySpawnedObject(BindingId, MovieSceneSequenceID::Root, PlaybackState);
+	SpawnRegister.EmptySpawnablePool();
+
+	UTEST_EQUAL("Actor was destroyed", SpawnRegister.NumDestroyed, 1);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneSpawnablePoolCleanUpTest,
+		"System.Engine.Sequencer.SpawnablePool.CleanUp",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneSpawnablePoolCleanUpTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+	using namespace UE::MovieScene::Tests;
+
+	IConsoleVariable* EnablePooling = IConsoleManager::Get().FindConsoleVariable(TEXT("Sequencer.SpawnablePool.Enable"));
+	UTEST_NOT_NULL("Spawnable pool console variable", EnablePooling);
+
+	const bool bOldEnablePooling = EnablePooling->GetBool();
+	ON_SCOPE_EXIT
+	{
+		EnablePooling->Set(bOldEnablePooling, ECVF_SetByCode);
+	};
+	EnablePooling->Set(true, ECVF_SetByCode);
+
+	UTestMovieSceneSequence* Sequence = NewObject<UTestMovieSceneSequence>(GetTransientPackage());
+	AActor* Template = NewObject<AActor>(GetTransientPackage());
+	const FGuid BindingId = Sequence->MovieScene->AddSpawnable(TEXT("Pooled"), *Template);
+
+	FSharedPlaybackStateCreateParams CreateParams;
+	CreateParams.Linker = NewObject<UMovieSceneEntitySystemLinker>(GetTransientPackage());
+	TSharedRef<FSharedPlaybackState> PlaybackState = MakeShared<FSharedPlaybackState>(*Sequence, CreateParams);
+
+	FPoolTestSpawnRegister SpawnRegister;
+	ON_SCOPE_EXIT
+	{
+		SpawnRegister.EmptySpawnablePool();
+	};
+
+	// Parking an object is not a destruction, so PreDestroyObject must not be called yet
+	SpawnRegister.SpawnObject(BindingId, *Sequence->MovieScene, MovieSceneSequenceID::Root, PlaybackState);
+	SpawnRegister.DestroySpawnedObject(BindingId, MovieSceneSequenceID::Root, PlaybackState);
+
+	UTEST_EQUAL("Parked actor was not pre-destroyed", SpawnRegister.NumPreDestroyed, 0);
+	UTEST_EQUAL("Parked actor was not destroyed", SpawnRegister.NumDestroyed, 0);
+
+	// Cleaning up the sequence that parked the object must also destroy it, notifying PreDestroyObject for its binding
+	SpawnRegister.CleanUpSequence(MovieSceneSequenceID::Root, PlaybackState);
+
+	UTEST_EQUAL("Pooled actor was destroyed with its sequence", SpawnRegister.NumDestroyed, 1);
+	UTEST_EQUAL("Pooled actor was pre-destroyed", SpawnRegister.NumPreDestroyed, 1);
+	UTEST_EQUAL("Pooled actor was pre-destroyed for its binding", SpawnRegister.PreDestroyedBindings.Last(), BindingId);
+
+	// The pool is now empty, so spawning again must create a new object
+	SpawnRegister.SpawnObject(BindingId, *Sequence->MovieScene, MovieSceneSequenceID::Root, PlaybackState);
+	UTEST_EQUAL("New actor was spawned after cleanup", SpawnRegister.NumSpawned, 2);
+
+	// Destroying without the pool must notify in exactly the same way
+	EnablePooling->Set(false, ECVF_SetByCode);
+	SpawnRegister.CleanUp(PlaybackState);
+
+	UTEST_EQUAL("Spawned actor was destroyed", SpawnRegister.NumDestroyed, 2);
+	UTEST_EQUAL("Spawned actor was pre-destroyed", SpawnRegister.NumPreDestroyed, 2);
+	UTEST_EQUAL("Spawned actor was pre-destroyed for its binding", SpawnRegister.PreDestroyedBindings.Last(), BindingId);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneSpawnableLookAheadWindowTest,
+		"System.Engine.Sequencer.SpawnablePool.LookAheadWindow",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneSpawnableLookAheadWindowTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+
+	UTestMovieSceneSection* Active    = NewObject<UTestMovieSceneSection>(GetTransientPackage());
+	UTestMovieSceneSection* Short     = NewObject<UTestMovieSceneSection>(GetTransientPackage());
+	UTestMovieSceneSection* Straddles = NewObject<UTestMovieSceneSection>(GetTransientPackage());
+	UTestMovieSceneSection* Later     = NewObject<UTestMovieSceneSection>(GetTransientPackage());
+
+	FMovieSceneEntityComponentField Field;
+	{
+		FMovieSceneEntityComponentFieldBuilder Builder(&Field);
+		Builder.AddPersistentEntity(MakeDiscreteRange(0, 100), Active);
+		Builder.AddPersistentEntity(MakeDiscreteRange(20, 30), Short);
+		Builder.AddPersistentEntity(MakeDiscreteRange(40, 200), Straddles);
+		Builder.AddPersistentEntity(MakeDiscreteRange(120, 200), Later);
+	}
+
+	auto ContainsOwner = [](const FMovieSceneEvaluationFieldEntitySet& Entities, UObject* Owner)
+	{
+		for (const FMovieSceneEvaluationFieldEntityQuery& Query : Entities)
+		{
+			if (Query.Entity.Key.EntityOwner.Get() == Owner)
+			{
+				return true;
+			}
+		}
+		return false;
+	};
+
+	// A look-ahead window of [10, 50] must see everything that begins anywhere inside it, not just what exists at its end
+	FMovieSceneEvaluationFieldEntitySet WindowEntities;
+	Field.QueryPersistentEntities(TRange<FFrameNumber>::Inclusive(10, 50), WindowEntities);
+
+	UTEST_TRUE("Window contains the active section", ContainsOwner(WindowEntities, Active));
+	UTEST_TRUE("Window contains a section that begins and ends inside it", ContainsOwner(WindowEntities, Short));
+	UTEST_TRUE("Window contains a section that begins inside it", ContainsOwner(WindowEntities, Straddles));
+	UTEST_FALSE("Window does not contain a section that begins after it", ContainsOwner(WindowEntities, Later));
+	UTEST_EQUAL("Window entity count", WindowEntities.Num(), 3);
+
+	// Sampling only the end of the window misses the short section
+	FMovieSceneEvaluationFieldEntitySet EndEntities;
+	TRange<FFrameNumber> UnusedRange;
+	Field.QueryPersistentEntities(FFrameNumber(50), UnusedRange, EndEntities);
+
+	UTEST_FALSE("End of window does not contain the short section", ContainsOwner(EndEntities, Short));
+
+	// Entities are gathered in time order so that the nearest spawnables take the per-frame budget first
+	FMovieSceneEvaluationFieldEntitySet OrderedEntities;
+	Field.QueryPersistentEntities(TRange<FFrameNumber>::Inclusive(110, 130), OrderedEntities);
+
+	TArray<UObject*> Owners;
+	for (const FMovieSceneEvaluationFieldEntityQuery& Query : OrderedEntities)
+	{
+		Owners.Add(Query.Entity.Key.EntityOwner.Get());
+	}
+	UTEST_EQUAL("Ordered entity count", Owners.Num(), 2);
+	UTEST_TRUE("Entities are in time order", Owners[0] == Straddles && Owners[1] == Later);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,175 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Async/ParallelFor.h"
+#include "Channels/MovieSceneDoubleChannel.h"
+#include "Channels/MovieSceneStreamedChannelData.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneStreamedChannelDataTest,
+		"System.Engine.Sequencer.Channels.StreamedChannelData",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneStreamedChannelDataTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+
+	constexpr int32 NumKeys      = 10000;
+	constexpr int32 KeySpacing   = 50;
+	constexpr int32 KeysPerBlock = 256;
+
+	// Mix of interpolation modes to ensure that every kind of segment is reproduced exactly
+	FMovieSceneDoubleChannel Channel;
+	for (int32 Index = 0; Index < NumKeys; ++Index)
+	{
+		const double Value = FMath::Sin(Index * 0.05) * 10.0;
+		switch (Index % 3)
+		{
+		case 0: Channel.AddCubicKey(Index * KeySpacing, Value);  break;
+		case 1: Channel.AddLinearKey(Index * KeySpacing, Value);  break;
+		default: Channel.AddConstantKey(Index * KeySpacing, Value); break;
+		}
+	}
+	Channel.AutoSetTangents();
+	Channel.PostInfinityExtrap = RCCE_Linear;
+
+	const FString Filename = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("StreamedChannelDataTest.bin"));
+	UTEST_TRUE("Wrote streamed channel", FStreamedDoubleChannelData::WriteToFile(Channel, *Filename, KeysPerBlock));
+
+	{
+		TUniquePtr<FStreamedDoubleChannelData> Streamed = FStreamedDoubleChannelData::Open(*Filename);
+		UTEST_NOT_NULL("Opened streamed channel", Streamed.Get());
+		UTEST_EQUAL("Number of keys", Streamed->GetNumKeys(), NumKeys);
+
+		Streamed->SetStreamingWindow(1, 2);
+
+		// Play forwards through the whole channel including subframes, block boundaries and extrapolation
+		int32 MaxResidentBlocks = 0;
+		for (int32 Frame = -KeySpacing; Frame < (NumKeys + 1) * KeySpacing; Frame += 7)
+		{
+			const FFrameTime Time(Frame, 0.25f);
+
+			double Expected = 0.0, Actual = 0.0;
+			const bool bExpected = Channel.Evaluate(Time, Expected);
+			const bool bActual   = Streamed->Evaluate(Time, Actual);
+
+			UTEST_EQUAL("Evaluation succeeded", bActual, bExpected);
+			UTEST_EQUAL_TOLERANCE("Streamed value", Actual, Expected, UE_DOUBLE_KINDA_SMALL_NUMBER);
+
+			MaxResidentBlocks = FMath::Max(MaxResidentBlocks, Streamed->GetNumResidentBlocks());
+		}
+
+		UTEST_TRUE("Resident blocks are bounded by the streaming window", MaxResidentBlocks <= 4);
+
+		// Play backwards, which should prefetch in the opposite direction
+		for (int32 Frame = NumKeys * KeySpacing; Frame >= 0; Frame -= 13)
+		{
+			double Expected = 0.0, Actual = 0.0;
+			Channel.Evaluate(FFrameTime(Frame), Expected);
+			Streamed->Evaluate(FFrameTime(Frame), Actual);
+
+			UTEST_EQUAL_TOLERANCE("Streamed value played backwards", Actual, Expected, UE_DOUBLE_KINDA_SMALL_NUMBER);
+		}
+
+		// Evaluate concurrently across several blocks, such that some threads read the current block without the lock while others move the streaming window
+		std::atomic<int32> NumMismatches = 0;
+		ParallelFor(4096, [&Channel, &Streamed, &NumMismatches](int32 Index)
+		{
+			const FFrameTime Time((Index * 37) % (KeysPerBlock * KeySpacing * 6), 0.5f);
+
+			double Expected = 0.0, Actual = 0.0;
+			Channel.Evaluate(Time, Expected);
+			Streamed->Evaluate(Time, Actual);
+
+			if (!FMath::IsNearlyEqual(Actual, Expected, UE_DOUBLE_KINDA_SMALL_NUMBER))
+			{
+				++NumMismatches;
+			}
+		});
+
+		UTEST_EQUAL("Concurrent evaluations match the channel", NumMismatches.load(), 0);
+
+		Streamed->ReleaseResidentBlocks();
+		UTEST_EQUAL("Released all blocks", Streamed->GetNumResidentBlocks(), 0);
+	}
+
+	IFileManager::Get().Delete(*Filename);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneStreamedChannelDataCyclingTest,
+		"System.Engine.Sequencer.Channels.StreamedChannelData.Cycling",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneStreamedChannelDataCyclingTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::MovieScene;
+
+	constexpr int32 NumKeys      = 1000;
+	constexpr int32 KeySpacing   = 20;
+	constexpr int32 KeysPerBlock = 64;
+	constexpr int32 Duration     = (NumKeys - 1) * KeySpacing;
+
+	FMovieSceneDoubleChannel Channel;
+	for (int32 Index = 0; Index < NumKeys; ++Index)
+	{
+		// Start at a non-zero time so that cycles are not symmetric about zero
+		const double Value = FMath::Sin(Index * 0.1) * 5.0 + Index * 0.01;
+		switch (Index % 3)
+		{
+		case 0: Channel.AddCubicKey(100 + Index * KeySpacing, Value);  break;
+		case 1: Channel.AddLinearKey(100 + Index * KeySpacing, Value);  break;
+		default: Channel.AddConstantKey(100 + Index * KeySpacing, Value); break;
+		}
+	}
+	Channel.AutoSetTangents();
+
+	const FString Filename = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("StreamedChannelDataCyclingTest.bin"));
+
+	for (ERichCurveExtrapolation Extrapolation : { RCCE_Cycle, RCCE_CycleWithOffset, RCCE_Oscillate, RCCE_None })
+	{
+		Channel.PreInfinityExtrap  = Extrapolation;
+		Channel.PostInfinityExtrap = Extrapolation;
+
+		UTEST_TRUE("Wrote streamed channel", FStreamedDoubleChannelData::WriteToFile(Channel, *Filename, KeysPerBlock));
+
+		TSharedPtr<const FStreamedDoubleChannelData> Streamed(FStreamedDoubleChannelData::Open(*Filename));
+		UTEST_NOT_NULL("Opened streamed channel", Streamed.Get());
+
+		// Evaluate through the streamed data assigned to an otherwise empty channel, which is how tracks evaluate it
+		FMovieSceneDoubleChannel StreamedChannel;
+		StreamedChannel.SetStreamedData(Streamed);
+		UTEST_TRUE("Streamed channel has data", StreamedChannel.HasAnyData());
+
+		for (int32 Frame = 100 - Duration * 3; Frame < 100 + Duration * 4; Frame += 31)
+		{
+			const FFrameTime Time(Frame, 0.75f);
+
+			double Expected = 0.0, Actual = 0.0;
+			const bool bExpected = Channel.Evaluate(Time, Expected);
+			const bool bActual   = StreamedChannel.Evaluate(Time, Actual);
+
+			UTEST_EQUAL("Evaluation succeeded", bActual, bExpected);
+			UTEST_EQUAL_TOLERANCE("Cycled streamed value", Actual, Expected, UE_DOUBLE_KINDA_SMALL_NUMBER);
+
+			// Cached interpolations must also agree, since the channel evaluator system caches them across frames
+			double CachedValue = 0.0;
+			UTEST_TRUE("Cached interpolation evaluated", StreamedChannel.GetInterpolationForTime(Time).Evaluate(Time, CachedValue));
+			UTEST_EQUAL_TOLERANCE("Cached interpolation value", CachedValue, Expected, UE_DOUBLE_KINDA_SMALL_NUMBER);
+		}
+
+		UTEST_TRUE("Cycling keeps resident blocks bounded", Streamed->GetNumResidentBlocks() <= 4);
+
+		StreamedChannel.SetStreamedData(nullptr);
+		Streamed.Reset();
+	}
+
+	IFileManager::Get().Delete(*Filename);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
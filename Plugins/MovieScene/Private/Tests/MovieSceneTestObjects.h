@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Compilation/IMovieSceneTrackTemplateProducer.h"
+#include "Conditions/MovieSceneCondition.h"
 #include "Evaluation/MovieSceneEvalTemplate.h"
 #include "GameFramework/Actor.h"
 #include "MovieScene.h"
@@ -210,6 +211,41 @@ class UTestMovieSceneObject : public UObject
 	GENERATED_BODY()
 };
 
+UCLASS(MinimalAPI)
+class UTestMovieSceneCountingCondition : public UMovieSceneCondition
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY()
+	EMovieSceneConditionScope Scope = EMovieSceneConditionScope::Global;
+
+	UPROPERTY()
+	EMovieSceneConditionCheckFrequency CheckFrequency = EMovieSceneConditionCheckFrequency::Once;
+
+	/** The number of times this condition has been evaluated */
+	mutable int32 NumEvaluations = 0;
+
+protected:
+
+	virtual bool EvaluateConditionInternal(FGuid BindingGuid, FMovieSceneSequenceID SequenceID, TSharedRef<const UE::MovieScene::FSharedPlaybackState> SharedPlaybackState) const override
+	{
+		++NumEvaluations;
+		return true;
+	}
+
+	virtual EMovieSceneConditionScope GetScopeInternal() const override
+	{
+		return Scope;
+	}
+
+	virtual EMovieSceneConditionCheckFrequency GetCheckFrequencyInternal() const override
+	{
+		return CheckFrequency;
+	}
+};
+
 UCLASS(MinimalAPI, BlueprintType)
 class ATestMovieSceneArrayPropertiesActor : public AActor
 {
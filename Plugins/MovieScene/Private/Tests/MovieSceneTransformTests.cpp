@@ -7,6 +7,8 @@
 #include "Containers/ArrayView.h"
 #include "Misc/AutomationTest.h"
 #include "MovieSceneTimeHelpers.h"
+#include "MovieSceneFwd.h"
+#include "HAL/PlatformTime.h"
 #include "UObject/Package.h"
 
 #define LOCTEXT_NAMESPACE "MovieSceneTransformTests"
@@ -477,4 +479,89 @@ bool FMovieSceneSubSectionCoreWarpingAndScalingTransformsTest::RunTest(const FSt
 	return true;
 }
 
+// Build 8 levels of sub-sequence transforms, each offset and scaled, with a loop on the third level. The uncollapsed stack is built by hand without any folding.
+void MakeDeepHierarchyTransforms(int32 NumLevels, FMovieSceneSequenceTransform& OutCollapsed, FMovieSceneSequenceTransform& OutUncollapsed)
+{
+	for (int32 Level = 0; Level < NumLevels; ++Level)
+	{
+		FMovieSceneSequenceTransform LevelTransform(FFrameTime(-10 * (Level + 1)), Level % 2 == 0 ? 1.5f : 0.5f);
+		if (Level == 2)
+		{
+			LevelTransform.AddLoop(0, 500);
+		}
+
+		OutCollapsed = LevelTransform * OutCollapsed;
+
+		if (Level == 0)
+		{
+			OutUncollapsed.LinearTransform = LevelTransform.LinearTransform;
+		}
+		else
+		{
+			OutUncollapsed.NestedTransforms.Emplace(LevelTransform.LinearTransform);
+		}
+		OutUncollapsed.NestedTransforms.Append(LevelTransform.NestedTransforms);
+	}
+}
+
+// Deep hierarchies should collapse consecutive linear levels, and transform identically to the uncollapsed stack
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneSubSectionCoreDeepHierarchyTransformsTest,
+		"System.Engine.Sequencer.Core.DeepHierarchyTransforms",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FMovieSceneSubSectionCoreDeepHierarchyTransformsTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumLevels = 8;
+
+	FMovieSceneSequenceTransform Collapsed;
+	FMovieSceneSequenceTransform Uncollapsed;
+	MakeDeepHierarchyTransforms(NumLevels, Collapsed, Uncollapsed);
+
+	// The linear levels either side of the loop are folded into a single level
+	TestEqual("Number of nested levels", Collapsed.NestedTransforms.Num(), 2);
+	TestEqual("Number of uncollapsed nested levels", Uncollapsed.NestedTransforms.Num(), NumLevels);
+
+	for (int32 Frame = -1000; Frame < 1000; Frame += 17)
+	{
+		const FFrameTime Expected = Uncollapsed.TransformTime(FFrameTime(Frame));
+		const FFrameTime Actual   = Collapsed.TransformTime(FFrameTime(Frame));
+
+		TestTrue(FString::Printf(TEXT("Collapsed transform of frame %d"), Frame), FMath::IsNearlyEqual(Expected.AsDecimal(), Actual.AsDecimal(), 1e-3));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovieSceneSubSectionCoreDeepHierarchyTransformsPerfTest,
+		"System.Engine.Sequencer.Core.DeepHierarchyTransforms.Perf",
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter | EAutomationTestFlags::Disabled)
+bool FMovieSceneSubSectionCoreDeepHierarchyTransformsPerfTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumLevels     = 8;
+	constexpr int32 NumIterations = 1000000;
+
+	FMovieSceneSequenceTransform Collapsed;
+	FMovieSceneSequenceTransform Uncollapsed;
+	MakeDeepHierarchyTransforms(NumLevels, Collapsed, Uncollapsed);
+
+	auto RunBenchmark = [](const FMovieSceneSequenceTransform& Transform)
+	{
+		double Accumulator = 0.0;
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			Accumulator += Transform.TransformTime(FFrameTime(Iteration % 1000)).AsDecimal();
+		}
+		return TTuple<double, double>(FPlatformTime::Seconds() - StartTime, Accumulator);
+	};
+
+	const TTuple<double, double> UncollapsedResult = RunBenchmark(Uncollapsed);
+	const TTuple<double, double> CollapsedResult   = RunBenchmark(Collapsed);
+
+	UE_LOG(LogMovieScene, Display, TEXT("Transformed %d times through %d levels. Uncollapsed: %.3fms, collapsed: %.3fms"),
+		NumIterations, NumLevels, UncollapsedResult.Get<0>() * 1000.0, CollapsedResult.Get<0>() * 1000.0);
+
+	return true;
+}
+
 #undef LOCTEXT_NAMESPACE
@@ -15,6 +15,38 @@ UMovieSceneTimeWarpCurve::UMovieSceneTimeWarpCurve()
 {
 	Channel.Owner = nullptr;
 	Channel.Domain = UE::MovieScene::ETimeWarpChannelDomain::Time;
+
+	OnSignatureChanged().AddUObject(this, &UMovieSceneTimeWarpCurve::UpdateInverseLookupTable);
+}
+
+void UMovieSceneTimeWarpCurve::PostLoad()
+{
+	Super::PostLoad();
+	UpdateInverseLookupTable();
+}
+
+#if WITH_EDITOR
+bool UMovieSceneTimeWarpCurve::Modify(bool bAlwaysMarkDirty)
+{
+	// The channel is about to change - stop using the table until it is rebuilt after the edit.
+	// Modify broadcasts the signature change synchronously, before any keys have changed, so the table must not be rebuilt here.
+	TGuardValue<bool> ModifyGuard(bIsModifying, true);
+
+	Channel.InvalidateInverseLookupTable();
+	return Super::Modify(bAlwaysMarkDirty);
+}
+#endif
+
+void UMovieSceneTimeWarpCurve::UpdateInverseLookupTable()
+{
+#if WITH_EDITOR
+	if (bIsModifying)
+	{
+		return;
+	}
+#endif
+
+	Channel.UpdateInverseLookupTable();
 }
 
 void UMovieSceneTimeWarpCurve::InitializeDefaults()
@@ -58,6 +90,8 @@ void UMovieSceneTimeWarpCurve::InitializeDefaults()
 
 		Channel.PreInfinityExtrap  = RCCE_Constant;
 		Channel.PostInfinityExtrap = RCCE_Constant;
+
+		Channel.UpdateInverseLookupTable();
 	}
 }
 
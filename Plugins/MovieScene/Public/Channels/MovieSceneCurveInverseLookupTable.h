@@ -0,0 +1,125 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "CoreTypes.h"
+#include "Misc/FrameNumber.h"
+#include "Templates/SharedPointer.h"
+
+struct FMovieSceneDoubleChannel;
+
+namespace UE
+{
+namespace MovieScene
+{
+
+/**
+ * Immutable lookup table that accelerates inverse evaluation of a double channel by allowing the solver to skip over
+ * spans of keys that cannot contain a given value.
+ *
+ * The value extents of every pair of keys are grouped into runs where both the minimum and maximum extents are monotonic.
+ * Within each run, the spans that can contain a value are contiguous and can be found with a binary search, leaving only
+ * those spans to be solved exactly. Time-warp curves are generally monotonic, so most curves are represented by a single run.
+ *
+ * Tables only cover the range of the channel's keys; extrapolated and cycled regions are always solved directly.
+ * A table must be rebuilt whenever the channel's keys change.
+ */
+struct FCurveInverseLookupTable
+{
+	/**
+	 * Build a new lookup table for the specified channel
+	 *
+	 * @return A new lookup table, or nullptr if the channel has too few keys to benefit from one
+	 */
+	MOVIESCENE_API static TSharedPtr<const FCurveInverseLookupTable> Build(const FMovieSceneDoubleChannel& Channel);
+
+	/**
+	 * Check whether this table was built for the current keys of the specified channel.
+	 * This is a constant-time check of the key count and end points, and will not detect changes to interior keys. Owners
+	 * must invalidate their table before editing keys, and rebuild it once the edit is complete.
+	 */
+	MOVIESCENE_API bool IsValidFor(const FMovieSceneDoubleChannel& Channel) const;
+
+	/**
+	 * Given the next time that a forward walk over the channel's interpolations would visit, skip ahead to the start of the
+	 * first subsequent span that may contain the specified value.
+	 *
+	 * @param Channel        The channel this table was built for
+	 * @param Value          The value being solved for
+	 * @param NextTime       The next time that would be visited without a lookup table
+	 * @param OutNumSkipped  Receives the number of spans that were skipped
+	 * @return The time to visit next, which is NextTime if nothing could be skipped
+	 */
+	MOVIESCENE_API FFrameNumber SkipForwards(const FMovieSceneDoubleChannel& Channel, double Value, FFrameNumber NextTime, int32& OutNumSkipped) const;
+
+	/**
+	 * Given the next time that a backward walk over the channel's interpolations would visit, skip back to the start of the
+	 * first preceding span that may contain the specified value.
+	 *
+	 * @param Channel        The channel this table was built for
+	 * @param Value          The value being solved for
+	 * @param NextTime       The next time that would be visited without a lookup table
+	 * @param OutNumSkipped  Receives the number of spans that were skipped
+	 * @return The time to visit next, which is NextTime if nothing could be skipped
+	 */
+	MOVIESCENE_API FFrameNumber SkipBackwards(const FMovieSceneDoubleChannel& Channel, double Value, FFrameNumber NextTime, int32& OutNumSkipped) const;
+
+	/** Retrieve the number of monotonic runs in this table */
+	int32 GetNumRuns() const
+	{
+		return Runs.Num();
+	}
+
+private:
+
+	/** Find the first span at or after StartSpan whose extents contain Value, or INDEX_NONE */
+	int32 FindNextCandidate(double Value, int32 StartSpan) const;
+
+	/** Find the last span at or before StartSpan whose extents contain Value, or INDEX_NONE */
+	int32 FindPreviousCandidate(double Value, int32 StartSpan) const;
+
+	/** Compute the contiguous range of spans within a run whose extents contain Value. Returns false if there are none. */
+	bool FindCandidatesInRun(int32 RunIndex, double Value, int32& OutFirstSpan, int32& OutLastSpan) const;
+
+	/** Find the index of the run containing the specified span */
+	int32 FindRun(int32 SpanIndex) const;
+
+
+private:
+
+	struct FSpanExtents
+	{
+		double MinValue;
+		double MaxValue;
+	};
+
+	struct FMonotonicRun
+	{
+		/** Index of the first span in this run */
+		int32 FirstSpan;
+		/** Number of spans in this run */
+		int32 NumSpans;
+		/** Combined extents of every span in this run */
+		double MinValue;
+		double MaxValue;
+		/** Whether the extents of each span decrease through this run, rather than increase */
+		bool bDecreasing;
+	};
+
+	/** Value extents of each pair of keys, conservatively expanded to account for solver precision */
+	TArray<FSpanExtents> Spans;
+
+	/** Monotonic runs of spans, sorted by FirstSpan */
+	TArray<FMonotonicRun> Runs;
+
+	/** Signature of the channel this table was built for */
+	int32 NumKeys = 0;
+	FFrameNumber FirstTime;
+	FFrameNumber LastTime;
+	double FirstValue = 0.0;
+	double LastValue = 0.0;
+};
+
+} // namespace MovieScene
+} // namespace UE
@@ -0,0 +1,78 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/ArrayView.h"
+#include "CoreTypes.h"
+#include "Math/Range.h"
+#include "Math/UnrealMathUtility.h"
+#include "Misc/FrameNumber.h"
+
+class UMovieSceneSection;
+struct FMovieSceneDoubleChannel;
+struct FMovieSceneFloatChannel;
+
+namespace UE
+{
+namespace MovieScene
+{
+
+/**
+ * Parameters for error-bounded curve simplification of float and double channels.
+ *
+ * Simplification is a coarse-to-fine process: each span between two retained keys is re-fit as a single cubic segment
+ * using least-squares tangents, and is only subdivided at the original key closest to its worst sample when that fit
+ * exceeds MaxError. Only keys that border a re-fit cubic span have their tangents broken and made explicit so that the
+ * result remains within tolerance regardless of subsequent auto-tangent updates. Keys bordering constant or linear
+ * spans keep their original interpolation and tangents.
+ */
+struct FCurveSimplificationParams
+{
+	/** The maximum absolute difference in value permitted between the original and simplified curves at any sampled time */
+	double MaxError = KINDA_SMALL_NUMBER;
+
+	/** The range of keys to simplify. The first and last keys within this range are always retained. */
+	TRange<FFrameNumber> Range = TRange<FFrameNumber>::All();
+
+	/** The number of additional times to sample between each pair of original keys when measuring error */
+	int32 NumSamplesPerSegment = 3;
+};
+
+/**
+ * Result of simplifying a single channel, or the aggregate result of simplifying many channels
+ */
+struct FCurveSimplificationResult
+{
+	/** The number of keys within the simplification range before simplification */
+	int32 NumKeysBefore = 0;
+
+	/** The number of keys within the simplification range after simplification */
+	int32 NumKeysAfter = 0;
+
+	/** The maximum error that was measured between the original and simplified curves */
+	double MaxError = 0.0;
+
+	void Accumulate(const FCurveSimplificationResult& Other)
+	{
+		NumKeysBefore += Other.NumKeysBefore;
+		NumKeysAfter  += Other.NumKeysAfter;
+		MaxError       = Other.MaxError > MaxError ? Other.MaxError : MaxError;
+	}
+};
+
+/** Simplify a single channel in place, guaranteeing that the result is within Params.MaxError of the original at all sampled times */
+MOVIESCENE_API FCurveSimplificationResult SimplifyCurve(FMovieSceneDoubleChannel* Channel, const FCurveSimplificationParams& Params);
+MOVIESCENE_API FCurveSimplificationResult SimplifyCurve(FMovieSceneFloatChannel* Channel, const FCurveSimplificationParams& Params);
+
+/** Simplify many independent channels in place, in parallel where possible */
+MOVIESCENE_API FCurveSimplificationResult SimplifyCurves(TArrayView<FMovieSceneDoubleChannel* const> Channels, const FCurveSimplificationParams& Params);
+MOVIESCENE_API FCurveSimplificationResult SimplifyCurves(TArrayView<FMovieSceneFloatChannel* const> Channels, const FCurveSimplificationParams& Params);
+
+/**
+ * Simplify all the float and double channels of a section in parallel. Must be called on the game thread.
+ * The section is modified prior to simplification so that the operation can be transacted.
+ */
+MOVIESCENE_API FCurveSimplificationResult SimplifySectionCurves(UMovieSceneSection* Section, const FCurveSimplificationParams& Params);
+
+} // namespace MovieScene
+} // namespace UE
@@ -21,6 +21,7 @@
 #include "MovieSceneChannelData.h"
 #include "MovieSceneChannelTraits.h"
 #include "Serialization/StructuredArchive.h"
+#include "Templates/SharedPointer.h"
 #include "Templates/Tuple.h"
 #include "Templates/UnrealTemplate.h"
 #include "UObject/Class.h"
@@ -38,7 +39,9 @@ template <typename T> struct TIsPODType;
 namespace UE::MovieScene
 {
 	enum class EInverseEvaluateFlags : uint8;
+	struct FCurveInverseLookupTable;
 	struct FPiecewiseCurve;
+	class FStreamedDoubleChannelData;
 	MOVIESCENE_API void OnRemapChannelKeyTime(const FMovieSceneChannel* Channel, const IRetimingInterface& Retimer, FFrameNumber PreviousTime, FFrameNumber CurrentTime, FMovieSceneDoubleValue& InOutValue);
 }
 namespace UE::MovieScene::Interpolation
@@ -230,6 +233,24 @@ struct FMovieSceneDoubleChannel : public FMovieSceneChannel
 	MOVIESCENE_API bool InverseEvaluateBetween(double Value, FFrameTime StartTime, FFrameTime EndTime, const TFunctionRef<bool(FFrameTime)>& Visitor) const;
 
 
+	/**
+	 * Solve this curve for a given (y), using a lookup table to skip over spans of keys that cannot contain a solution.
+	 * Produces the same solutions as InverseEvaluate without a lookup table.
+	 *
+	 * @param LookupTable   (Optional) A lookup table previously built for this channel's current keys
+	 */
+	MOVIESCENE_API TOptional<FFrameTime> InverseEvaluate(double Value, FFrameTime TimeHint, UE::MovieScene::EInverseEvaluateFlags Flags, const UE::MovieScene::FCurveInverseLookupTable* LookupTable) const;
+
+
+	/**
+	 * Solve this curve for a given (y) within a range, using a lookup table to skip over spans of keys that cannot contain a solution.
+	 * Produces the same solutions as InverseEvaluateBetween without a lookup table.
+	 *
+	 * @param LookupTable   (Optional) A lookup table previously built for this channel's current keys
+	 */
+	MOVIESCENE_API bool InverseEvaluateBetween(double Value, FFrameTime StartTime, FFrameTime EndTime, const UE::MovieScene::FCurveInverseLookupTable* LookupTable, const TFunctionRef<bool(FFrameTime)>& Visitor) const;
+
+
 	/**
 	 * Retrieve the index of the cycle that the specified time falls within according to this channel's extrapolation modes.
 	 * @note Negative cycle counts are returned for cycles that lie before the first key
@@ -279,7 +300,7 @@ public:
 	 */
 	inline bool HasAnyData() const
 	{
-		return Times.Num() != 0 || bHasDefaultValue == true;
+		return Times.Num() != 0 || bHasDefaultValue == true || StreamedData.IsValid();
 	}
 
 	/**
@@ -331,6 +352,18 @@ public:
 
 	MOVIESCENE_API void AutoSetTangents(float Tension = 0.f);
 
+	/**
+	 * Evaluate this channel from streamed key data instead of its own keys. Intended for very large baked channels whose keys have been
+	 * written with FStreamedDoubleChannelData::WriteToFile and then removed from the channel so that they no longer need to be resident.
+	 * Streamed data is only used by Evaluate and GetInterpolationForTime, and is not serialized with the channel.
+	 *
+	 * @param InStreamedData The streamed data to evaluate, or nullptr to evaluate this channel's own keys again
+	 */
+	MOVIESCENE_API void SetStreamedData(TSharedPtr<const UE::MovieScene::FStreamedDoubleChannelData> InStreamedData);
+
+	/** Retrieve the streamed data that this channel is evaluated from, if any */
+	const UE::MovieScene::FStreamedDoubleChannelData* GetStreamedData() const { return StreamedData.Get(); }
+
 	/** Get the channel's frame resolution */
 	FFrameRate GetTickResolution() const { return TickResolution; }
 	/** Set the channel's frame resolution */
@@ -403,6 +436,9 @@ private:
 
 #endif
 
+	/** Streamed key data that is evaluated in place of Times and Values when set */
+	TSharedPtr<const UE::MovieScene::FStreamedDoubleChannelData> StreamedData;
+
 	friend struct TMovieSceneCurveChannelImpl<FMovieSceneDoubleChannel>;
 	using FMovieSceneDoubleChannelImpl = TMovieSceneCurveChannelImpl<FMovieSceneDoubleChannel>;
 };
@@ -0,0 +1,222 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Channels/MovieSceneDoubleChannel.h"
+#include "Channels/MovieSceneInterpolation.h"
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "CoreTypes.h"
+#include "Curves/RealCurve.h"
+#include "HAL/CriticalSection.h"
+#include "Misc/FrameRate.h"
+#include "Misc/FrameTime.h"
+#include "Templates/UniquePtr.h"
+
+#include <atomic>
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+namespace UE
+{
+namespace MovieScene
+{
+
+/**
+ * A view of a single resident block of a streamed channel that presents the same data layout as FMovieSceneDoubleChannel
+ * such that TMovieSceneCurveChannelImpl can produce identical interpolations for it.
+ */
+struct FStreamedDoubleChannelBlockView
+{
+	using ChannelValueType = FMovieSceneDoubleValue;
+	using CurveValueType = double;
+
+	TArrayView<const FFrameNumber> Times;
+	TArrayView<const FMovieSceneDoubleValue> Values;
+	FFrameRate TickResolution;
+	TEnumAsByte<ERichCurveExtrapolation> PreInfinityExtrap;
+	TEnumAsByte<ERichCurveExtrapolation> PostInfinityExtrap;
+};
+
+/**
+ * Read-only storage for very large baked double channels that keeps its keys in a memory-mapped file rather than in memory.
+ *
+ * Keys are written in fixed size blocks, where each block also contains the first key of the next block such that any pair of
+ * keys that need to be interpolated always lies within a single block. Only the blocks surrounding the most recently evaluated time
+ * are kept mapped, with additional blocks prefetched in the direction of playback, which keeps memory usage bounded regardless of
+ * the length of the channel.
+ *
+ * Interpolation is identical to FMovieSceneDoubleChannel for all times and extrapolation modes. Cycling extrapolation maps the time back
+ * into the range of the keys before its block is found, so cycling only ever pages in the blocks that the cycled time lies within.
+ *
+ * Streamed data is evaluated in place of a channel's own keys by assigning it with FMovieSceneDoubleChannel::SetStreamedData.
+ *
+ * The file format is a direct image of the in-memory key layout and is not intended to be portable between platforms or engine versions.
+ * All evaluation functions are thread-safe. Evaluating within the most recently evaluated block does not take a lock; the lock is only
+ * taken when evaluation moves to a different block and the streaming window needs to be updated.
+ */
+class FStreamedDoubleChannelData
+{
+public:
+
+	MOVIESCENE_API ~FStreamedDoubleChannelData();
+
+	FStreamedDoubleChannelData(const FStreamedDoubleChannelData&) = delete;
+	FStreamedDoubleChannelData& operator=(const FStreamedDoubleChannelData&) = delete;
+
+	/**
+	 * Write the keys of the specified channel to a file that can be opened with Open
+	 *
+	 * @param Channel        The channel whose keys should be written
+	 * @param Filename       The file to write
+	 * @param KeysPerBlock   The number of keys to store in each block. Larger blocks reduce the number of mapped regions at the cost of memory.
+	 * @return Whether the file was written successfully
+	 */
+	MOVIESCENE_API static bool WriteToFile(const FMovieSceneDoubleChannel& Channel, const TCHAR* Filename, int32 KeysPerBlock = 4096);
+
+	/**
+	 * Open a file previously written with WriteToFile
+	 *
+	 * @return The streamed data, or nullptr if the file could not be opened or is not compatible
+	 */
+	MOVIESCENE_API static TUniquePtr<FStreamedDoubleChannelData> Open(const TCHAR* Filename);
+
+	/**
+	 * Retrieve a cached interpolation for the specified time, paging in its block if necessary
+	 */
+	MOVIESCENE_API Interpolation::FCachedInterpolation GetInterpolationForTime(FFrameTime InTime) const;
+
+	/**
+	 * Evaluate this data at the specified time, paging in its block if necessary
+	 *
+	 * @return true if the data was evaluated successfully, false otherwise
+	 */
+	MOVIESCENE_API bool Evaluate(FFrameTime InTime, double& OutValue) const;
+
+	/**
+	 * Define how many blocks should remain mapped around the most recently evaluated block
+	 *
+	 * @param InNumBlocksBehind   The number of blocks to keep mapped behind the current block, opposite to the direction of playback
+	 * @param InNumBlocksAhead    The number of blocks to prefetch ahead of the current block in the direction of playback
+	 */
+	MOVIESCENE_API void SetStreamingWindow(int32 InNumBlocksBehind, int32 InNumBlocksAhead);
+
+	/**
+	 * Unmap all currently resident blocks
+	 */
+	MOVIESCENE_API void ReleaseResidentBlocks();
+
+	/** Retrieve the number of blocks that are currently mapped */
+	MOVIESCENE_API int32 GetNumResidentBlocks() const;
+
+	/** Retrieve the total number of keys in this data */
+	int32 GetNumKeys() const
+	{
+		return NumKeys;
+	}
+
+	/** Retrieve the tick resolution of the keys in this data */
+	FFrameRate GetTickResolution() const
+	{
+		return TickResolution;
+	}
+
+private:
+
+	FStreamedDoubleChannelData() = default;
+
+	struct FBlockEntry
+	{
+		/** The time of the first key in this block */
+		FFrameNumber FirstTime;
+		/** The time of the last key in this block, which is also the first key of the next block */
+		FFrameNumber LastTime;
+		/** The number of keys in this block, including the key shared with the next block */
+		int32 NumKeys;
+		/** Offset of the block's times within the file. Values follow immediately after, aligned to 16 bytes. */
+		int64 FileOffset;
+	};
+
+	/** Find the index of the block that contains the specified time. The time must lie within the range of the keys. */
+	int32 FindBlock(FFrameTime InTime) const;
+
+	/** Make the specified block resident, updating the streaming window around it. Lock must be held. */
+	FStreamedDoubleChannelBlockView MakeBlockResident(int32 BlockIndex) const;
+
+	/** Make a view of the specified block's mapped data */
+	FStreamedDoubleChannelBlockView MakeBlockView(int32 BlockIndex, const uint8* BlockData) const;
+
+	/** Compute the cycle parameters for the specified time, which leave the time unchanged unless it lies outside of the keys with a cycling extrapolation mode */
+	FCycleParams ComputeCycleParams(FFrameTime InTime) const;
+
+	/** Compute the interpolation for the specified time from a view of the block that contains its cycled time */
+	Interpolation::FCachedInterpolation GetInterpolationForBlock(FFrameTime InTime, const FCycleParams& Params, const FStreamedDoubleChannelBlockView& View) const;
+
+	/** Map the specified block if it is not already mapped. Lock must be held. */
+	void MapBlock(int32 BlockIndex, bool bPreload) const;
+
+	/** Unmap the specified block, deferring the release of its region until no lock-free readers are using it. Lock must be held. */
+	void UnmapBlock(int32 BlockIndex) const;
+
+	/** Release any unmapped regions that are no longer being read. Lock must be held. */
+	void ReleaseRetiredRegions() const;
+
+	/** Compute the size in bytes of the specified block within the file */
+	int64 GetBlockSize(int32 BlockIndex) const;
+
+private:
+
+	/** State for each block that is accessed without holding the lock */
+	struct FBlockState
+	{
+		/** The block's mapped data, or null if the block is not resident. Only written while the lock is held. */
+		std::atomic<const uint8*> MappedData = nullptr;
+		/** The number of lock-free evaluations that are currently reading this block's mapped data */
+		std::atomic<int32> NumReaders = 0;
+	};
+
+	/** Handle to the memory-mapped file */
+	TUniquePtr<IMappedFileHandle> FileHandle;
+
+	/** Index of all the blocks within the file, always resident */
+	TArray<FBlockEntry> Blocks;
+
+	/** Mapped regions for each block, null for blocks that are not resident */
+	mutable TArray<TUniquePtr<IMappedFileRegion>> BlockRegions;
+
+	/** Lock-free state for each block */
+	TUniquePtr<FBlockState[]> BlockStates;
+
+	/** Regions that have been unmapped while lock-free evaluations may still have been reading them, paired with their block index */
+	mutable TArray<TPair<int32, TUniquePtr<IMappedFileRegion>>> RetiredRegions;
+
+	/** Indices of all currently resident blocks */
+	mutable TArray<int32, TInlineAllocator<8>> ResidentBlocks;
+
+	/** Critical section protecting the mapped regions and streaming window */
+	mutable FCriticalSection CriticalSection;
+
+	/** The block that was most recently evaluated, used to determine the direction of playback. Evaluations within this block do not take the lock. */
+	mutable std::atomic<int32> CurrentBlock = INDEX_NONE;
+
+	/** +1 for forwards playback, -1 for backwards */
+	mutable int32 PlaybackDirection = 1;
+
+	int32 NumBlocksBehind = 1;
+	int32 NumBlocksAhead = 2;
+
+	int32 NumKeys = 0;
+	FFrameRate TickResolution;
+	TEnumAsByte<ERichCurveExtrapolation> PreInfinityExtrap = RCCE_Constant;
+	TEnumAsByte<ERichCurveExtrapolation> PostInfinityExtrap = RCCE_Constant;
+	double DefaultValue = 0.0;
+	bool bHasDefaultValue = false;
+
+	/** Values of the first and last keys, kept resident for computing the value offset of cycles */
+	double FirstValue = 0.0;
+	double LastValue = 0.0;
+};
+
+} // namespace MovieScene
+} // namespace UE
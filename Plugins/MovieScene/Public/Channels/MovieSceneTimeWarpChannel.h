@@ -4,6 +4,7 @@
 
 #include "Channels/MovieSceneChannelTraits.h"
 #include "Channels/MovieSceneDoubleChannel.h"
+#include "Templates/SharedPointer.h"
 
 #include "MovieSceneTimeWarpChannel.generated.h"
 
@@ -28,6 +29,47 @@ struct FMovieSceneTimeWarpChannel : public FMovieSceneDoubleChannel
 	TObjectPtr<UMovieScene> Owner;
 
 	UE::MovieScene::ETimeWarpChannelDomain Domain;
+
+	/**
+	 * Solve this curve for a given (y), using this channel's inverse lookup table where one exists.
+	 * @see FMovieSceneDoubleChannel::InverseEvaluate
+	 */
+	MOVIESCENE_API TOptional<FFrameTime> InverseEvaluate(double Value, FFrameTime TimeHint, UE::MovieScene::EInverseEvaluateFlags Flags) const;
+
+	/**
+	 * Solve this curve for a given (y) within a range, using this channel's inverse lookup table where one exists.
+	 * @see FMovieSceneDoubleChannel::InverseEvaluateBetween
+	 */
+	MOVIESCENE_API bool InverseEvaluateBetween(double Value, FFrameTime StartTime, FFrameTime EndTime, const TFunctionRef<bool(FFrameTime)>& Visitor) const;
+
+	/**
+	 * Rebuild the lookup table used to accelerate inverse evaluation of this channel.
+	 * Must be called whenever this channel's keys are changed, otherwise inverse evaluation may skip valid solutions.
+	 * Code that edits keys over several steps should call InvalidateInverseLookupTable first, and rebuild the table once the edit is complete.
+	 * Tables are only built for time-domain channels with enough keys (see Sequencer.CurveInverseLookupTableMinKeys).
+	 */
+	MOVIESCENE_API void UpdateInverseLookupTable();
+
+	/**
+	 * Discard this channel's inverse lookup table, reverting to solving the curve directly
+	 */
+	MOVIESCENE_API void InvalidateInverseLookupTable();
+
+	// ~ FMovieSceneChannel Interface - overridden to keep the inverse lookup table in sync with the keys
+	MOVIESCENE_API virtual void SetKeyTimes(TArrayView<const FKeyHandle> InHandles, TArrayView<const FFrameNumber> InKeyTimes) override;
+	MOVIESCENE_API virtual void DuplicateKeys(TArrayView<const FKeyHandle> InHandles, TArrayView<FKeyHandle> OutNewHandles) override;
+	MOVIESCENE_API virtual void DeleteKeys(TArrayView<const FKeyHandle> InHandles) override;
+	MOVIESCENE_API virtual void DeleteKeysFrom(FFrameNumber InTime, bool bDeleteKeysBefore) override;
+	MOVIESCENE_API virtual void RemapTimes(const UE::MovieScene::IRetimingInterface& Retimer) override;
+	MOVIESCENE_API virtual void Reset() override;
+	MOVIESCENE_API virtual void Offset(FFrameNumber DeltaPosition) override;
+	MOVIESCENE_API virtual void Optimize(const FKeyDataOptimizationParams& InParameters) override;
+	MOVIESCENE_API virtual void PostEditChange() override;
+
+private:
+
+	/** Optional lookup table for inverse evaluation. Tables are immutable once built, so can be safely shared between copies of this channel. */
+	TSharedPtr<const UE::MovieScene::FCurveInverseLookupTable> InverseLookupTable;
 };
 
 MOVIESCENE_API void Dilate(FMovieSceneTimeWarpChannel* InChannel, FFrameNumber Origin, double DilationFactor);
@@ -4,6 +4,7 @@
 
 #include "Compilation/MovieSceneCompiledDataID.h"
 #include "Compilation/MovieSceneDeterminismFence.h"
+#include "Compilation/MovieSceneRootDeterminismTable.h"
 #include "Containers/Array.h"
 #include "Containers/Map.h"
 #include "Containers/Set.h"
@@ -243,6 +244,13 @@ public:
 	const FMovieSceneEvaluationField&      GetTrackTemplateFieldChecked(FMovieSceneCompiledDataID DataID) const { return TrackTemplateFields.FindChecked(DataID.Value);   }
 	const FMovieSceneEntityComponentField& GetEntityComponentFieldChecked(FMovieSceneCompiledDataID DataID) const { return EntityComponentFields.FindChecked(DataID.Value); }
 
+	/**
+	 * Retrieve a flattened table of all the determinism fences for the specified sequence and its sub sequences, in the time-space of the specified sequence.
+	 * The table is rebuilt on demand if any sequence in this manager has been (re)compiled since it was last retrieved.
+	 * WARNING: This reference will become invalid if any sequence in this manager is (re)compiled
+	 */
+	MOVIESCENE_API const UE::MovieScene::FRootDeterminismTable& GetRootDeterminismTable(FMovieSceneCompiledDataID DataID);
+
 	MOVIESCENE_API void Compile(FMovieSceneCompiledDataID DataID);
 
 	MOVIESCENE_API void Compile(FMovieSceneCompiledDataID DataID, EMovieSceneServerClientMask InNetworkMask);
@@ -296,6 +304,8 @@ private:
 
 	MOVIESCENE_API void ProcessSubTrack(FMovieSceneCompiledDataEntry* OutEntry, UMovieSceneSubTrack* SubTrack, const FGuid& ObjectBindingId, const FTrackGatherParameters& Params, FMovieSceneGatheredCompilerData* OutCompilerData);
 
+	MOVIESCENE_API void BuildRootDeterminismTable(FMovieSceneCompiledDataID DataID, UE::MovieScene::FRootDeterminismTable* OutTable) const;
+
 	MOVIESCENE_API void DestroyData(FMovieSceneCompiledDataID DataID);
 
 	virtual void BeginDestroy() override;
@@ -338,6 +348,9 @@ private:
 	UPROPERTY()
 	TMap<int32, FMovieSceneEntityComponentField> EntityComponentFields;
 
+	/** Transient root-space determinism tables, built on demand by GetRootDeterminismTable */
+	TMap<int32, UE::MovieScene::FRootDeterminismTable> RootDeterminismTables;
+
 	FGuid CompilerVersion;
 
 	uint32 ReallocationVersion;
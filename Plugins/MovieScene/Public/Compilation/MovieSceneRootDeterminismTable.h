@@ -0,0 +1,59 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/Array.h"
+#include "Math/Range.h"
+#include "Misc/FrameNumber.h"
+#include "Misc/FrameTime.h"
+#include "MovieSceneSequenceID.h"
+
+namespace UE
+{
+namespace MovieScene
+{
+
+/** A determinism fence that has been transformed into the time-space of a root sequence, and may therefore lie on a sub-frame */
+struct FMovieSceneDeterminismFenceWithSubframe
+{
+	FFrameTime FrameTime;
+	uint8 bInclusive : 1;
+};
+
+/**
+ * Flattened table of all the determinism fences within a sequence hierarchy, expressed in the time-space of its root sequence.
+ * Built on demand by UMovieSceneCompiledDataManager::GetRootDeterminismTable such that dissecting an evaluation range
+ * is a binary search over a single sorted array rather than a walk of the sub sequence tree.
+ */
+struct FRootDeterminismTable
+{
+	/**
+	 * A range within the root sequence's time-space where a sub sequence with determinism fences is active,
+	 * but whose fences could not be flattened because its transform is non-linear (ie, it is time-warped or looping).
+	 * Fences for these sub sequences must still be transformed at runtime using breadcrumbs for the evaluated time.
+	 */
+	struct FDynamicRange
+	{
+		/** The range of the sub sequence tree within which the sub sequence is active, in root space */
+		TRange<FFrameNumber> RootRange;
+
+		/** The ID of the sub sequence within the root hierarchy */
+		FMovieSceneSequenceID SequenceID;
+	};
+
+	/** All the root and linearly transformed sub sequence fences in root space, sorted and unique by time */
+	TArray<FMovieSceneDeterminismFenceWithSubframe> Fences;
+
+	/** Ranges that require runtime fence transformation, sorted by the lower bound of their root range */
+	TArray<FDynamicRange> DynamicRanges;
+
+	/** The compiled data manager's reallocation version that this table was built for */
+	uint32 ReallocationVersion = 0;
+
+	/** Whether this table has been built at all */
+	bool bIsValid = false;
+};
+
+} // namespace MovieScene
+} // namespace UE
@@ -813,6 +813,9 @@ public:
 
 		FComponentTypeID AlwaysCacheInitialValue;
 
+		/** Tag that opts a property entity in to skipping values that are identical to the one it last applied. Only valid for properties exclusively driven by Sequencer. */
+		FComponentTypeID SkipUnchangedPropertyValues;
+
 		FComponentTypeID DontOptimizeConstants;
 
 		UE_DEPRECATED(5.5, "This tag is no longer used. Blend targets are entirely managed by UMovieSceneHierarchicalBiasSystem now.")
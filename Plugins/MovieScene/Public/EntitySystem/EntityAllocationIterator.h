@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "Containers/Array.h"
 #include "CoreTypes.h"
 #include "EntitySystem/MovieSceneEntitySystemTypes.h"
 
@@ -65,11 +66,17 @@ private:
 	/**
 	 * Find the index of the next allocation that matches our filter
 	 */
-	int32 FindMatchingAllocationStartingAt(int32 Index) const;
+	int32 FindMatchingAllocationStartingAt(int32 Index);
 
 	/** Filter to match entity allocations against */
 	const FEntityComponentFilter* Filter;
 
+	/** Cached indices of all allocations that match Filter, or nullptr if every allocation must be tested */
+	const TArray<uint16>* MatchingAllocations;
+
+	/** Index within MatchingAllocations of the next allocation to visit */
+	int32 NextMatchingAllocation;
+
 	/** Entity manager being iterated */
 	const FEntityManager* Manager;
 
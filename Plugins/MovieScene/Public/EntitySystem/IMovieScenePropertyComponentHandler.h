@@ -148,6 +148,8 @@ struct IInitialValueProcessor
 	virtual void PopulateFilter(FEntityComponentFilter& OutFilter) const = 0;
 	/** Process all initial values for the specified allocation */
 	virtual void Process(const FEntityAllocation* Allocation, const FComponentMask& AllocationType) = 0;
+	/** Complete any work that was deferred from Process so that it can run concurrently across all the visited allocations. Called once after all allocations have been processed. */
+	virtual void ProcessDeferred() {}
 	/** Finish processing */
 	virtual void Finalize() = 0;
 };
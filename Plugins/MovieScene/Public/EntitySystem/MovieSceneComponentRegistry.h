@@ -111,6 +111,25 @@ public:
 #endif
 	}
 
+	/**
+	 * Allow a property type to support change detection by defining its last applied value component. This does not enable change detection
+	 * by itself: only entities tagged with FBuiltInComponentTypes::Tags.SkipUnchangedPropertyValues receive the component, and property setter
+	 * tasks skip those entities when their value is identical to the one last applied to their bound object. Must be called before the property
+	 * is defined with FPropertyRegistry::DefineProperty or DefineCompositeProperty.
+	 */
+	template<typename PropertyTraits>
+	void NewLastAppliedValueType(TPropertyComponents<PropertyTraits>& InOutComponents, const TCHAR* DebugName)
+	{
+		checkf(!InOutComponents.CompositeID, TEXT("Change detection must be enabled before the property is defined"));
+
+#if UE_MOVIESCENE_ENTITY_DEBUG
+		FString LastAppliedValueDebugName = FString(TEXT("Last Applied ")) + DebugName;
+		NewComponentType(&InOutComponents.LastAppliedValue, *LastAppliedValueDebugName);
+#else
+		NewComponentType(&InOutComponents.LastAppliedValue, nullptr);
+#endif
+	}
+
 	MOVIESCENE_API const FComponentTypeInfo& GetComponentTypeChecked(FComponentTypeID ComponentTypeID) const;
 
 public:
@@ -0,0 +1,146 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/Map.h"
+#include "Misc/Guid.h"
+#include "MovieSceneSequenceID.h"
+#include "EntitySystem/MovieSceneSequenceInstanceHandle.h"
+#include "Templates/SharedPointerFwd.h"
+
+class UObject;
+class UMovieSceneCondition;
+
+namespace UE
+{
+namespace MovieScene
+{
+
+struct FSharedPlaybackState;
+
+/** Defines how long a cached condition result remains valid within an FConditionResultCache */
+enum class EConditionResultScope : uint8
+{
+	/** The result is shared between all sequence instances in the linker until explicitly invalidated. Used for cacheable conditions with a global condition scope. */
+	Global,
+	/** The result is specific to a single root sequence instance, and remains valid until that instance is invalidated or destroyed. */
+	PerInstance,
+	/** The result is only valid for the current frame. Used for conditions that cannot be cached, such as those checked on tick. */
+	PerFrame,
+};
+
+/** Key that identifies a cached condition result, and the scope it should be stored in */
+struct FConditionResultKey
+{
+	/** Hash returned from UMovieSceneCondition::ComputeCacheKey, combined with any additional context required for the scope */
+	uint32 ConditionHash = 0;
+	/** The root instance that is evaluating the condition */
+	FInstanceHandle RootInstanceHandle;
+	/** The scope that the result should be cached in */
+	EConditionResultScope Scope = EConditionResultScope::PerInstance;
+};
+
+/**
+ * Linker-wide cache of UMovieSceneCondition results.
+ *
+ * Results are stored in one of 3 scopes (see EConditionResultScope) which allows many instances of the same sequence to
+ * share the result of a condition that does not depend on their bindings, while still re-evaluating per-tick conditions once every frame.
+ * Global results are only ever returned to instances that were last invalidated on or before the frame the result was computed, so
+ * restarting a sequence will always re-evaluate its conditions rather than observing a result from a previous playback.
+ */
+struct FConditionResultCache
+{
+	/**
+	 * Make a key for the specified condition and evaluation context
+	 *
+	 * @param Condition            The condition that is being evaluated
+	 * @param BindingID            The binding that the condition is being evaluated for, if any
+	 * @param SequenceID           The sequence ID that the condition exists within
+	 * @param SharedPlaybackState  The playback state of the root sequence instance evaluating the condition
+	 * @param EntityOwner          The object that owns the conditional entity (usually a track or section)
+	 * @param bCanCacheResult      The result of Condition->CanCacheResult(SharedPlaybackState)
+	 */
+	MOVIESCENE_API static FConditionResultKey MakeKey(const UMovieSceneCondition* Condition, const FGuid& BindingID, FMovieSceneSequenceID SequenceID, TSharedRef<const FSharedPlaybackState> SharedPlaybackState, UObject* EntityOwner, bool bCanCacheResult);
+
+	/**
+	 * Find a previously cached result for the specified key. Does not modify the cache.
+	 *
+	 * @return A pointer to the cached result, or nullptr if the condition has not been evaluated within the key's scope
+	 */
+	MOVIESCENE_API const bool* Find(const FConditionResultKey& Key) const;
+
+	/**
+	 * Cache a condition result for the specified key
+	 */
+	MOVIESCENE_API void Add(const FConditionResultKey& Key, bool bResult);
+
+	/**
+	 * Find a cached result for the specified key, or evaluate the condition and cache its result if none exists
+	 *
+	 * @param Key                  Key returned from MakeKey for the condition and evaluation context
+	 * @param Condition            The condition to evaluate if no result is cached
+	 * @param BindingID            The binding that the condition is being evaluated for, if any
+	 * @param SequenceID           The sequence ID that the condition exists within
+	 * @param SharedPlaybackState  The playback state of the root sequence instance evaluating the condition
+	 */
+	MOVIESCENE_API bool FindOrEvaluate(const FConditionResultKey& Key, const UMovieSceneCondition* Condition, const FGuid& BindingID, FMovieSceneSequenceID SequenceID, TSharedRef<const FSharedPlaybackState> SharedPlaybackState);
+
+public:
+
+	/**
+	 * Invalidate all results for the specified root instance, including any global results computed before the current frame
+	 */
+	MOVIESCENE_API void InvalidateInstance(FInstanceHandle RootInstanceHandle);
+
+	/**
+	 * Remove all tracking information for the specified root instance when it is destroyed
+	 */
+	MOVIESCENE_API void RemoveInstance(FInstanceHandle RootInstanceHandle);
+
+	/**
+	 * Invalidate all per-frame results
+	 */
+	MOVIESCENE_API void InvalidateFrame();
+
+	/**
+	 * Invalidate all results that are shared between instances
+	 */
+	MOVIESCENE_API void InvalidateGlobal();
+
+	/**
+	 * Invalidate everything
+	 */
+	MOVIESCENE_API void Reset();
+
+private:
+
+	/** Discard per-frame results if the frame has changed since they were computed */
+	void UpdateFrame();
+
+	struct FGlobalResult
+	{
+		/** The frame on which this result was computed */
+		uint64 FrameNumber;
+		bool bResult;
+	};
+
+	struct FInstanceResults
+	{
+		/** Results for conditions with a per-instance scope */
+		TMap<uint32, bool> Results;
+		/** The first frame from which global results are considered valid for this instance */
+		uint64 ValidFromFrame = 0;
+	};
+
+	FInstanceResults& FindOrAddInstance(FInstanceHandle RootInstanceHandle);
+
+	TMap<uint32, FGlobalResult> GlobalResults;
+	TMap<uint32, bool> FrameResults;
+	TMap<FInstanceHandle, FInstanceResults> InstanceResults;
+
+	uint64 CachedFrameNumber = 0;
+};
+
+} // namespace MovieScene
+} // namespace UE
@@ -125,8 +125,21 @@ struct FComponentMask
 	}
 
 	bool Contains(FComponentTypeID InComponentType) const;
-	bool ContainsAll(const FComponentMask& InComponentMask) const;
-	bool ContainsAny(const FComponentMask& InComponentMask) const;
+
+	/** Check whether this mask contains every component in InComponentMask, ie (this & In) == In */
+	MOVIESCENE_API bool ContainsAll(const FComponentMask& InComponentMask) const;
+
+	/** Check whether this mask contains at least one of the components in InComponentMask, ie (this & In) != 0 */
+	MOVIESCENE_API bool ContainsAny(const FComponentMask& InComponentMask) const;
+
+	/** Check whether this mask contains none of the components in InComponentMask, ie (this & In) == 0 */
+	bool ContainsNone(const FComponentMask& InComponentMask) const
+	{
+		return !ContainsAny(InComponentMask);
+	}
+
+	/** Check whether this mask contains exactly one of the components in InComponentMask, ie countbits(this & In) == 1 */
+	MOVIESCENE_API bool ContainsExactlyOne(const FComponentMask& InComponentMask) const;
 
 	void Set(FComponentTypeID InComponentType);
 	void SetAll(std::initializer_list<FComponentTypeID> InComponentTypes);
@@ -431,16 +444,6 @@ inline bool FComponentMask::Contains(FComponentTypeID InComponentType) const
 	return InComponentType && Bits.IsValidIndex(InComponentType.BitIndex()) && Bits[InComponentType.BitIndex()] == true;
 }
 
-inline bool FComponentMask::ContainsAll(const FComponentMask& InComponentMask) const
-{
-	return FComponentMask::BitwiseAND(*this, InComponentMask, EBitwiseOperatorFlags::MinSize).CompareSetBits(InComponentMask);
-}
-
-inline bool FComponentMask::ContainsAny(const FComponentMask& InComponentMask) const
-{
-	return FComponentMask::BitwiseAND(*this, InComponentMask, EBitwiseOperatorFlags::MinSize).Find(true) != INDEX_NONE;
-}
-
 inline void FComponentMask::Set(FComponentTypeID InComponentType)
 {
 	checkSlow(InComponentType);
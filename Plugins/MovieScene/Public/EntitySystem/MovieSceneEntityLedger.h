@@ -51,6 +51,27 @@ struct FEntityLedger
 	 */
 	MOVIESCENE_API void UpdateEntities(UMovieSceneEntitySystemLinker* Linker, const FEntityImportSequenceParams& ImportParams, const FMovieSceneEntityComponentField* EntityField, const FMovieSceneEvaluationFieldEntitySet& NewEntities, FMovieSceneEvaluationFieldEntitySet& OutPerTickConditionalEntities, TMap<uint32, bool>& ConditionResultCache);
 
+	/**
+	 * Compute the difference between the currently imported entities and the specified set without making any changes to the linker.
+	 * Only this ledger is modified, so ledgers that belong to different sequence instances may be diffed concurrently.
+	 * Must be followed by a call to CommitEntities before this ledger is used again. NewEntities must remain valid until then.
+	 *
+	 * @param NewEntities				A set specifying all the entities required for the next evaluation
+	 */
+	MOVIESCENE_API void DiffEntities(const FMovieSceneEvaluationFieldEntitySet& NewEntities);
+
+	/**
+	 * Apply the result of the last call to DiffEntities to the linker by finishing expired entities and importing new ones.
+	 * Must be called on the game thread.
+	 *
+	 * @param Linker					The linker that owns this ledger
+	 * @param ImportParams				Basis for import parameters
+	 * @param EntityField				Possibly null if no entities were diffed- an entity field containing structural information about the sequence
+	 * @param OutPerTickConditionalEntities Output set returning conditional entities that require re-evaluating in between full updates.
+	 * @param ConditionResultCache      Cache of previous condition results, to be used and potentially modified during any condition checking in updating entities.
+	 */
+	MOVIESCENE_API void CommitEntities(UMovieSceneEntitySystemLinker* Linker, const FEntityImportSequenceParams& ImportParams, const FMovieSceneEntityComponentField* EntityField, FMovieSceneEvaluationFieldEntitySet& OutPerTickConditionalEntities, TMap<uint32, bool>& ConditionResultCache);
+
 	
 	UE_DEPRECATED(5.5, "Please call the version that takes ConditionResultCache")
 	MOVIESCENE_API void UpdateOneShotEntities(UMovieSceneEntitySystemLinker* Linker, const FEntityImportSequenceParams& ImportParams, const FMovieSceneEntityComponentField* EntityField, const FMovieSceneEvaluationFieldEntitySet& NewEntities);
@@ -178,11 +199,41 @@ private:
 		FMovieSceneEntityID EntityID;
 	};
 
+	/** An imported field entity, stored in a flat array sorted by KeyHash */
+	struct FImportedEntityEntry
+	{
+		FMovieSceneEvaluationFieldEntityKey Key;
+		uint32 KeyHash;
+		FImportedEntityData Data;
+	};
+
+	/** A new entity query paired with its key hash, used for merging against ImportedEntities */
+	struct FSortedEntityQuery
+	{
+		uint32 KeyHash;
+		const FMovieSceneEvaluationFieldEntityQuery* Query;
+	};
+
+	/** Find the index of the specified key within ImportedEntities, or INDEX_NONE */
+	int32 FindImportedEntityIndex(const FMovieSceneEvaluationFieldEntityKey& EntityKey, uint32 KeyHash) const;
+
+	/** Find or insert (maintaining sort order) the imported entity data for the specified key */
+	FImportedEntityData& FindOrAddImportedEntity(const FMovieSceneEvaluationFieldEntityKey& EntityKey);
+
+	/** Import the specified query into an already existing imported entity entry */
+	void ImportEntityImpl(UMovieSceneEntitySystemLinker* Linker, const FEntityImportSequenceParams& ImportParams, const FMovieSceneEntityComponentField* EntityField, const FMovieSceneEvaluationFieldEntityQuery& Query, FMovieSceneEvaluationFieldEntitySet& OutPerTickConditionalEntities, TMap<uint32, bool>& ConditionResultCache, FImportedEntityData& EntityData);
+
 	/** Map of source entities that were swept this frame */
 	TArray<FMovieSceneEntityID> OneShotEntities;
 
-	/** Map of source field entity key -> imported linker entities */
-	TMap<FMovieSceneEvaluationFieldEntityKey, FImportedEntityData> ImportedEntities;
+	/** Flat array of source field entity key -> imported linker entities, sorted by key hash so that it can be merge-joined with new entity sets */
+	TArray<FImportedEntityEntry> ImportedEntities;
+
+	/** Scratch buffers retained between updates to avoid re-allocating when merging new entity sets */
+	TArray<FSortedEntityQuery> SortedQueryScratch;
+	TArray<FImportedEntityEntry> MergedEntityScratch;
+	TArray<TPair<int32, const FMovieSceneEvaluationFieldEntityQuery*>> PendingImportScratch;
+	TArray<FMovieSceneEntityID> ExpiredEntityScratch;
 
 	/** Whether we have been invalidated, and need to re-instantiate everything */
 	bool bInvalidated;
@@ -25,7 +25,9 @@
 #include "Misc/AssertionMacros.h"
 #include "Misc/EnumClassFlags.h"
 #include "Misc/InlineValue.h"
+#include "Misc/TransactionallySafeRWLock.h"
 #include "MovieSceneSequenceID.h"
+#include "Templates/UniquePtr.h"
 #include "Templates/UnrealTemplate.h"
 #include "UObject/StrongObjectPtr.h"
 #include "UObject/UObjectArray.h"
@@ -220,6 +222,24 @@ public:
 	 */
 	MOVIESCENE_API EEntityThreadingModel GetThreadingModel() const;
 
+
+	/**
+	 * Retrieve the number of entities currently allocated within this manager
+	 */
+	int32 GetNumEntities() const
+	{
+		return EntityLocations.Num();
+	}
+
+
+	/**
+	 * Retrieve the number of entity allocations currently within this manager
+	 */
+	int32 GetNumAllocations() const
+	{
+		return EntityAllocations.Num();
+	}
+
 public:
 
 
@@ -832,7 +852,8 @@ public:
 	 */
 	void MimicStructureChanged()
 	{
-		OnStructureChanged();
+		// Allocations have not actually changed, so there is no need to invalidate anything cached against their layout
+		StructureMutationSystemSerialNumber = SystemSerialNumber;
 	}
 
 public:
@@ -912,6 +933,14 @@ private:
 
 	MOVIESCENE_API void CheckInvariants();
 
+	/**
+	 * Retrieve the sorted indices of all allocations whose masks match the specified filter, updating the cached result if the
+	 * allocation layout has changed since it was last cached. Allocations are not checked for being empty.
+	 *
+	 * @return The cached allocation indices, or nullptr if iterations of this filter should not be cached
+	 */
+	MOVIESCENE_API const TArray<uint16>* FindMatchingAllocations(const FEntityComponentFilter& InFilter) const;
+
 	virtual SIZE_T GetAllocatedSize() const override
 	{
 		return 0;
@@ -1011,6 +1040,25 @@ private:
 	/** The value of this manager's SystemSerialNumber the last time any entities were allocated, freed, or mutated in some way (this does not include component values being written to) */
 	uint64 StructureMutationSystemSerialNumber;
 
+	/** Serial number incremented every time any allocation is added, removed or changes its component mask */
+	uint64 AllocationLayoutSerial;
+
+	/** Indices of all the allocations that match a specific filter */
+	struct FCachedAllocationMatches
+	{
+		/** Sorted indices of all matching allocations */
+		TArray<uint16> AllocationIndices;
+
+		/** The value of AllocationLayoutSerial when AllocationIndices was last generated */
+		uint64 LayoutSerial = 0;
+	};
+
+	/** Map of filters to the allocations that match them. Entries are only ever removed when nothing is being iterated. */
+	mutable TMap<FEntityComponentFilter, TUniquePtr<FCachedAllocationMatches>> CachedAllocationMatches;
+
+	/** Lock that guards CachedAllocationMatches when iterating from multiple threads */
+	mutable FTransactionallySafeRWLock CachedAllocationMatchesLock;
+
 	/** Debugging ptr for natvis */
 #if UE_MOVIESCENE_ENTITY_DEBUG
 	const bool* RichComponentDebuggingPtr;
@@ -15,6 +15,7 @@
 #include "EntitySystem/MovieSceneEntitySystemGraphs.h"
 #include "EntitySystem/MovieSceneSequenceInstance.h"
 #include "EntitySystem/MovieSceneEntitySystemLinkerExtension.h"
+#include "EntitySystem/MovieSceneConditionResultCache.h"
 #include "Evaluation/PreAnimatedState/MovieScenePreAnimatedStateExtension.h"
 
 #include "MovieSceneEntitySystemLinker.generated.h"
@@ -133,6 +134,9 @@ public:
 
 	UE::MovieScene::FPreAnimatedStateExtension PreAnimatedState;
 
+	/** Cache of condition results shared between all the sequence instances in this linker */
+	UE::MovieScene::FConditionResultCache ConditionResultCache;
+
 	/** Constructs a new linker */
 	MOVIESCENE_API UMovieSceneEntitySystemLinker(const FObjectInitializer& ObjInit);
 
@@ -0,0 +1,188 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "HAL/CriticalSection.h"
+#include "Templates/UniquePtr.h"
+#include "UObject/NameTypes.h"
+#include <atomic>
+
+namespace UE
+{
+namespace MovieScene
+{
+
+class FEntityManager;
+
+/** The type of an event recorded by FEntitySystemTraceRecorder */
+enum class EEntitySystemTraceEventType : uint8
+{
+	/** A single scheduled task run by FEntitySystemScheduler */
+	Task,
+	/** A phase of the entity system runner's flush loop */
+	Phase,
+};
+
+/** A single timed event recorded by FEntitySystemTraceRecorder */
+struct FEntitySystemTraceEvent
+{
+	/** The name of the task or phase */
+	FName Name;
+	/** Cycle count (FPlatformTime::Cycles64) when the event began */
+	uint64 StartCycles = 0;
+	/** Cycle count (FPlatformTime::Cycles64) when the event ended */
+	uint64 EndCycles = 0;
+	/** The ID of the thread that the event ran on */
+	uint32 ThreadID = 0;
+	/** The index of the task within its scheduler, or INDEX_NONE for phases */
+	int32 TaskIndex = INDEX_NONE;
+	/** The number of entities that the task operated on, or the number of entities in the entity manager at the end of a phase */
+	int32 NumEntities = 0;
+	/** The number of allocations that the task operated on, or the number of allocations in the entity manager at the end of a phase */
+	int32 NumAllocations = 0;
+	/** The type of this event */
+	EEntitySystemTraceEventType Type = EEntitySystemTraceEventType::Task;
+};
+
+/**
+ * Lightweight opt-in recorder for entity system task and phase timings that does not require Unreal Insights.
+ * Events are written into a fixed-size ring buffer from any thread, and can be exported to the Chrome trace event JSON format
+ * for viewing in chrome://tracing or Perfetto. Each slot carries a sequence number so that readers never observe partially written events.
+ *
+ * Controlled through the Sequencer.TraceRecorder.Start, Sequencer.TraceRecorder.Stop and Sequencer.TraceRecorder.Export console commands.
+ */
+class FEntitySystemTraceRecorder
+{
+public:
+
+	/**
+	 * Retrieve the global recorder that the scheduler and runner record into
+	 */
+	MOVIESCENE_API static FEntitySystemTraceRecorder& Get();
+
+	/**
+	 * Check whether the global recorder is currently recording events. Cheap enough to call for every task.
+	 */
+	static bool IsRecordingEnabled()
+	{
+		return GlobalRecordingCount.load(std::memory_order_relaxed) != 0;
+	}
+
+public:
+
+	MOVIESCENE_API FEntitySystemTraceRecorder();
+	MOVIESCENE_API ~FEntitySystemTraceRecorder();
+
+	FEntitySystemTraceRecorder(const FEntitySystemTraceRecorder&) = delete;
+	FEntitySystemTraceRecorder& operator=(const FEntitySystemTraceRecorder&) = delete;
+
+	/**
+	 * Discard any previously recorded events and begin recording into a ring buffer of the specified size.
+	 * Waits for any in-flight calls to Record to finish before the ring buffer is reallocated.
+	 *
+	 * @param Capacity      The maximum number of events to retain. Once full, the oldest events are overwritten.
+	 */
+	MOVIESCENE_API void Start(int32 Capacity);
+
+	/**
+	 * Stop recording events. Recorded events remain available for export until Start is next called.
+	 */
+	MOVIESCENE_API void Stop();
+
+	/**
+	 * Check whether this recorder is currently recording
+	 */
+	bool IsRecording() const
+	{
+		return bRecording.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * Record an event. Thread-safe. Does nothing if this recorder is not recording.
+	 */
+	MOVIESCENE_API void Record(const FEntitySystemTraceEvent& Event);
+
+	/**
+	 * Copy all the events that are currently retained in the ring buffer, oldest first. Thread-safe.
+	 * Events that are being written or overwritten while they are copied are omitted.
+	 */
+	MOVIESCENE_API TArray<FEntitySystemTraceEvent> GetEvents() const;
+
+	/**
+	 * Retrieve the total number of events recorded since Start was called, including those that have since been overwritten
+	 */
+	MOVIESCENE_API uint64 GetNumRecordedEvents() const;
+
+	/**
+	 * Generate a Chrome trace event JSON string for all the events currently retained in the ring buffer
+	 */
+	MOVIESCENE_API FString ExportChromeTrace() const;
+
+	/**
+	 * Write a Chrome trace event JSON file for all the events currently retained in the ring buffer
+	 *
+	 * @return true if the file was written successfully, false otherwise
+	 */
+	MOVIESCENE_API bool ExportChromeTrace(const FString& Filename) const;
+
+public:
+
+	/**
+	 * Scope that records a runner phase into the global recorder, along with the number of entities and allocations in the entity manager when it ends
+	 */
+	struct FScopedPhase
+	{
+		MOVIESCENE_API FScopedPhase(FName InName, const FEntityManager* InEntityManager);
+		MOVIESCENE_API ~FScopedPhase();
+
+		FScopedPhase(const FScopedPhase&) = delete;
+		FScopedPhase& operator=(const FScopedPhase&) = delete;
+
+	private:
+		FName Name;
+		const FEntityManager* EntityManager;
+		uint64 StartCycles;
+	};
+
+private:
+
+	/** A single entry within the ring buffer */
+	struct FSlot
+	{
+		/** 1 + the index of the event stored in this slot, 0 if empty, or BusySequence while a writer owns the slot */
+		std::atomic<uint64> Sequence = 0;
+		FEntitySystemTraceEvent Event;
+	};
+
+	static constexpr uint64 BusySequence = MAX_uint64;
+
+	/** Stop recording and wait for any in-flight writers to leave the ring buffer */
+	void StopAndWaitForWriters();
+
+	/** Ring buffer of events. Only reallocated by Start once all writers have finished. */
+	TUniquePtr<FSlot[]> Slots;
+
+	/** The number of slots in the ring buffer */
+	int32 Capacity;
+
+	/** Monotonically increasing index of the next event to write. Wrapped by Capacity. */
+	std::atomic<uint64> WriteIndex;
+
+	/** The number of calls to Record that may currently be accessing the ring buffer */
+	std::atomic<int32> NumActiveWriters;
+
+	/** Whether this recorder is currently recording */
+	std::atomic<bool> bRecording;
+
+	/** Prevents the ring buffer from being reallocated while it is being read */
+	mutable FCriticalSection BufferLock;
+
+	/** The number of recorders that are currently recording. Allows a fast early-out for IsRecordingEnabled. */
+	static MOVIESCENE_API std::atomic<int32> GlobalRecordingCount;
+};
+
+} // namespace MovieScene
+} // namespace UE
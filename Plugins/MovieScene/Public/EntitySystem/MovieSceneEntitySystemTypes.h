@@ -305,6 +305,21 @@ struct FEntityComponentFilter
 
 	MOVIESCENE_API bool IsValid() const;
 
+	friend bool operator==(const FEntityComponentFilter& A, const FEntityComponentFilter& B)
+	{
+		return A.AllMask == B.AllMask && A.NoneMask == B.NoneMask && A.ComplexMasks == B.ComplexMasks;
+	}
+
+	friend uint32 GetTypeHash(const FEntityComponentFilter& Filter)
+	{
+		uint32 Hash = HashCombine(GetTypeHash(Filter.AllMask), GetTypeHash(Filter.NoneMask));
+		for (const FComplexMask& ComplexMask : Filter.ComplexMasks)
+		{
+			Hash = HashCombine(Hash, HashCombine(GetTypeHash(ComplexMask.Mask), GetTypeHash(ComplexMask.Mode)));
+		}
+		return Hash;
+	}
+
 	FEntityComponentFilter& All(const FComponentMask& InComponentMask)
 	{
 		AllMask.CombineWithBitwiseOR(InComponentMask, EBitwiseOperatorFlags::MaxSize);
@@ -412,6 +427,11 @@ private:
 			: Mask(InMask), Mode(InMode)
 		{}
 
+		friend bool operator==(const FComplexMask& A, const FComplexMask& B)
+		{
+			return A.Mode == B.Mode && A.Mask == B.Mask;
+		}
+
 		FComponentMask Mask;
 		EComplexFilterMode Mode;
 	};
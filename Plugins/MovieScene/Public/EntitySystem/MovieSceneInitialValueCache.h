@@ -322,6 +322,109 @@ struct TPropertyValueStorage : IPropertyValueStorage
 		return PropertyValues[Index.Index];
 	}
 
+public:
+
+	/**
+	 * Slot-indexed storage mode used for populating many initial values concurrently.
+	 * Slots are reserved up-front on the game thread, written to from any thread without locks (each slot must only be written by a single thread),
+	 * and finally either committed to the look-up-table or released on the game thread once all concurrent work has completed.
+	 */
+
+	/**
+	 * Reserve a contiguous range of slots that will be populated concurrently. Reuses the first run of free slots that is large enough.
+	 * Every reserved slot must subsequently be passed to either CommitSlot or ReleaseSlot.
+	 *
+	 * @param Num      The number of slots to reserve
+	 * @return The index of the first slot in the range
+	 */
+	FInitialValueIndex ReserveSlots(int32 Num)
+	{
+		// Purge stale look-up-table entries first so that they can never refer to a reused slot. This also trims any free slots from the end.
+		CleanupStaleEntries();
+
+		const int32 MaxIndex = PropertyValues.GetMaxIndex();
+
+		int32 FirstIndex = MaxIndex;
+		if (PropertyValues.Num() < MaxIndex)
+		{
+			int32 RunLength = 0;
+			for (int32 Index = 0; Index < MaxIndex; ++Index)
+			{
+				RunLength = PropertyValues.IsAllocated(Index) ? 0 : RunLength + 1;
+				if (RunLength == Num)
+				{
+					FirstIndex = Index + 1 - Num;
+					break;
+				}
+			}
+		}
+
+		check(FirstIndex + Num < int32(uint16(0xFFFF)));
+
+		for (int32 Offset = 0; Offset < Num; ++Offset)
+		{
+			PropertyValues.Insert(FirstIndex + Offset, StorageType{});
+		}
+		return FInitialValueIndex{ static_cast<uint16>(FirstIndex) };
+	}
+
+	/**
+	 * Purge any stale look-up-table entries so that FindPropertyIndexConcurrent can be called.
+	 * No other modifications may be made to this storage until all concurrent work has completed.
+	 */
+	void BeginConcurrentAccess()
+	{
+		CleanupStaleEntries();
+	}
+
+	/**
+	 * Find an existing initial value index without modifying the storage. Safe to call from multiple threads after BeginConcurrentAccess.
+	 */
+	template<typename PropertyKeyType>
+	TOptional<FInitialValueIndex> FindPropertyIndexConcurrent(UObject* BoundObject, const PropertyKeyType& PropertyKey) const
+	{
+		checkSlow(!bLUTContainsInvalidEntries);
+
+		const uint16* Index = KeyToPropertyIndex.Find(MakeKey(BoundObject, PropertyKey));
+		return Index ? TOptional<FInitialValueIndex>(FInitialValueIndex{*Index}) : TOptional<FInitialValueIndex>();
+	}
+
+	/**
+	 * Retrieve a reserved slot for writing. Distinct slots may be written concurrently.
+	 */
+	StorageType& GetSlotValue(FInitialValueIndex Index)
+	{
+		return PropertyValues[Index.Index];
+	}
+
+	/**
+	 * Commit a populated slot to the look-up-table so that it can be found by subsequent lookups.
+	 *
+	 * @return true if the slot was committed, false if a value already exists for the object and property, in which case the slot should be released
+	 */
+	template<typename PropertyKeyType>
+	bool CommitSlot(UObject* BoundObject, const PropertyKeyType& PropertyKey, FInitialValueIndex Index)
+	{
+		const FKeyType Key = MakeKey(BoundObject, PropertyKey);
+		if (KeyToPropertyIndex.Contains(Key))
+		{
+			return false;
+		}
+
+		KeyToPropertyIndex.Add(Key, Index.Index);
+		return true;
+	}
+
+	/**
+	 * Release a reserved slot that was not committed
+	 */
+	void ReleaseSlot(FInitialValueIndex Index)
+	{
+		PropertyValues.RemoveAt(Index.Index);
+		// Ensure the next cleanup trims released slots from the end of the array
+		bLUTContainsInvalidEntries = true;
+	}
+
 private:
 
 	using FPropertyKey = TVariant<uint16, FCustomPropertyIndex, FName>;
@@ -355,6 +458,19 @@ private:
 		}
 	};
 
+	static FKeyType MakeKey(UObject* BoundObject, uint16 ResolvedPropertyOffset)
+	{
+		return FKeyType{ FObjectKey(BoundObject), FPropertyKey(TInPlaceType<uint16>(), ResolvedPropertyOffset) };
+	}
+	static FKeyType MakeKey(UObject* BoundObject, FCustomPropertyIndex AccessorIndex)
+	{
+		return FKeyType{ FObjectKey(BoundObject), FPropertyKey(TInPlaceType<FCustomPropertyIndex>(), AccessorIndex) };
+	}
+	static FKeyType MakeKey(UObject* BoundObject, FTrackInstancePropertyBindings* SlowBindings)
+	{
+		return FKeyType{ FObjectKey(BoundObject), FPropertyKey(TInPlaceType<FName>(), SlowBindings->GetPropertyPath()) };
+	}
+
 	inline void CleanupStaleEntries()
 	{
 		if (!bLUTContainsInvalidEntries)
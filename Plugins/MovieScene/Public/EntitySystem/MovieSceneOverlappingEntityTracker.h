@@ -121,13 +121,334 @@ struct TOverlappingEntityInput
 };
 
 
+/**
+ * Hash-free entity -> output lookup addressed directly by entity index.
+ * Since entity IDs are 16 bit indices, the side table is bounded at 64k entries and never needs hashing.
+ */
+struct FDenseEntityToOutputMap
+{
+	static constexpr uint16 NO_OUTPUT = MAX_uint16;
+
+	const uint16* Find(FMovieSceneEntityID EntityID) const
+	{
+		const int32 Index = EntityID.AsIndex();
+		return (OutputsByEntity.IsValidIndex(Index) && OutputsByEntity[Index] != NO_OUTPUT) ? &OutputsByEntity[Index] : nullptr;
+	}
+
+	void Add(FMovieSceneEntityID EntityID, uint16 OutputIndex)
+	{
+		check(OutputIndex != NO_OUTPUT);
+
+		const int32 Index = EntityID.AsIndex();
+		if (Index >= OutputsByEntity.Num())
+		{
+			const int32 OldNum = OutputsByEntity.Num();
+			OutputsByEntity.SetNumUninitialized(Index + 1, EAllowShrinking::No);
+			for (int32 FillIndex = OldNum; FillIndex < OutputsByEntity.Num(); ++FillIndex)
+			{
+				OutputsByEntity[FillIndex] = NO_OUTPUT;
+			}
+		}
+		OutputsByEntity[Index] = OutputIndex;
+	}
+
+	void Remove(FMovieSceneEntityID EntityID)
+	{
+		const int32 Index = EntityID.AsIndex();
+		if (OutputsByEntity.IsValidIndex(Index))
+		{
+			OutputsByEntity[Index] = NO_OUTPUT;
+		}
+	}
+
+	void Empty()
+	{
+		OutputsByEntity.Empty();
+	}
+
+	/** Iterator over all valid entity -> output pairs that supports removal of the current element */
+	struct FIterator
+	{
+		explicit FIterator(FDenseEntityToOutputMap& InOwner)
+			: Owner(InOwner)
+			, Index(-1)
+		{
+			Advance();
+		}
+
+		explicit operator bool() const
+		{
+			return Owner.OutputsByEntity.IsValidIndex(Index);
+		}
+
+		FIterator& operator++()
+		{
+			Advance();
+			return *this;
+		}
+
+		FMovieSceneEntityID Key() const
+		{
+			return FMovieSceneEntityID::FromIndex(Index);
+		}
+
+		uint16 Value() const
+		{
+			return Owner.OutputsByEntity[Index];
+		}
+
+		void RemoveCurrent()
+		{
+			Owner.OutputsByEntity[Index] = NO_OUTPUT;
+		}
+
+	private:
+
+		void Advance()
+		{
+			++Index;
+			while (Index < Owner.OutputsByEntity.Num() && Owner.OutputsByEntity[Index] == NO_OUTPUT)
+			{
+				++Index;
+			}
+		}
+
+		FDenseEntityToOutputMap& Owner;
+		int32 Index;
+	};
+
+	FIterator CreateIterator()
+	{
+		return FIterator(*this);
+	}
+
+private:
+
+	/** Output index for each entity index, or NO_OUTPUT */
+	TArray<uint16> OutputsByEntity;
+};
+
+/**
+ * Key -> output lookup using a linear-probing open-addressing index over a sparse array of entries.
+ * Entries never move once added so their indices (and pointers to their values) are stable until removed,
+ * and lookups never allocate.
+ */
+template<typename KeyType>
+struct TDenseKeyToOutputMap
+{
+	using ParamType = typename TCallTraits<KeyType>::ParamType;
+	using FEntry = TPair<KeyType, uint16>;
+
+	const uint16* Find(ParamType Key) const
+	{
+		const int32 EntryIndex = FindEntryIndex(Key, GetTypeHash(Key));
+		return EntryIndex != INDEX_NONE ? &Entries[EntryIndex].Value : nullptr;
+	}
+
+	void Add(ParamType Key, uint16 OutputIndex)
+	{
+		const uint32 Hash = GetTypeHash(Key);
+
+		const int32 ExistingEntry = FindEntryIndex(Key, Hash);
+		if (ExistingEntry != INDEX_NONE)
+		{
+			Entries[ExistingEntry].Value = OutputIndex;
+			return;
+		}
+
+		// Keep the load factor (including tombstones) at or below 50%
+		if ((Entries.Num() + NumTombstones + 1) * 2 > Slots.Num())
+		{
+			Rehash(FMath::Max(16, static_cast<int32>(FMath::RoundUpToPowerOfTwo((Entries.Num() + 1) * 4))));
+		}
+
+		const int32 EntryIndex = Entries.Add(FEntry(Key, OutputIndex));
+		EntryHashes.SetNumUninitialized(FMath::Max(EntryHashes.Num(), EntryIndex + 1), EAllowShrinking::No);
+		EntryHashes[EntryIndex] = Hash;
+
+		InsertSlot(EntryIndex, Hash);
+	}
+
+	void Remove(ParamType Key)
+	{
+		const int32 EntryIndex = FindEntryIndex(Key, GetTypeHash(Key));
+		if (EntryIndex != INDEX_NONE)
+		{
+			RemoveSlot(EntryIndex);
+			Entries.RemoveAt(EntryIndex);
+		}
+	}
+
+	void Empty()
+	{
+		Entries.Empty();
+		EntryHashes.Empty();
+		Slots.Empty();
+		NumTombstones = 0;
+	}
+
+	/** Iterator over all entries that supports removal of the current element */
+	struct FIterator
+	{
+		explicit FIterator(TDenseKeyToOutputMap& InOwner)
+			: Owner(InOwner)
+			, It(InOwner.Entries.CreateIterator())
+		{}
+
+		explicit operator bool() const
+		{
+			return static_cast<bool>(It);
+		}
+
+		FIterator& operator++()
+		{
+			++It;
+			return *this;
+		}
+
+		KeyType& Key() const
+		{
+			return It->Key;
+		}
+
+		uint16 Value() const
+		{
+			return It->Value;
+		}
+
+		void RemoveCurrent()
+		{
+			Owner.RemoveSlot(It.GetIndex());
+			It.RemoveCurrent();
+		}
+
+	private:
+
+		TDenseKeyToOutputMap& Owner;
+		typename TSparseArray<FEntry>::TIterator It;
+	};
+
+	FIterator CreateIterator()
+	{
+		return FIterator(*this);
+	}
+
+	auto begin()       { return Entries.begin(); }
+	auto begin() const { return Entries.begin(); }
+	auto end()         { return Entries.end(); }
+	auto end() const   { return Entries.end(); }
+
+private:
+
+	static constexpr int32 EMPTY_SLOT = -1;
+	static constexpr int32 TOMBSTONE_SLOT = -2;
+
+	int32 FindEntryIndex(ParamType Key, uint32 Hash) const
+	{
+		if (Slots.Num() == 0)
+		{
+			return INDEX_NONE;
+		}
+
+		const uint32 Mask = static_cast<uint32>(Slots.Num() - 1);
+		for (uint32 SlotIndex = Hash & Mask; Slots[SlotIndex] != EMPTY_SLOT; SlotIndex = (SlotIndex + 1) & Mask)
+		{
+			const int32 EntryIndex = Slots[SlotIndex];
+			if (EntryIndex >= 0 && EntryHashes[EntryIndex] == Hash && Entries[EntryIndex].Key == Key)
+			{
+				return EntryIndex;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	void InsertSlot(int32 EntryIndex, uint32 Hash)
+	{
+		const uint32 Mask = static_cast<uint32>(Slots.Num() - 1);
+
+		uint32 SlotIndex = Hash & Mask;
+		while (Slots[SlotIndex] >= 0)
+		{
+			SlotIndex = (SlotIndex + 1) & Mask;
+		}
+
+		if (Slots[SlotIndex] == TOMBSTONE_SLOT)
+		{
+			--NumTombstones;
+		}
+		Slots[SlotIndex] = EntryIndex;
+	}
+
+	void RemoveSlot(int32 EntryIndex)
+	{
+		const uint32 Mask = static_cast<uint32>(Slots.Num() - 1);
+		for (uint32 SlotIndex = EntryHashes[EntryIndex] & Mask; Slots[SlotIndex] != EMPTY_SLOT; SlotIndex = (SlotIndex + 1) & Mask)
+		{
+			if (Slots[SlotIndex] == EntryIndex)
+			{
+				Slots[SlotIndex] = TOMBSTONE_SLOT;
+				++NumTombstones;
+				return;
+			}
+		}
+		checkf(false, TEXT("Entry %d was not present in the open-addressing index"), EntryIndex);
+	}
+
+	void Rehash(int32 NewNumSlots)
+	{
+		check(FMath::IsPowerOfTwo(NewNumSlots));
+
+		Slots.SetNumUninitialized(NewNumSlots, EAllowShrinking::No);
+		for (int32& Slot : Slots)
+		{
+			Slot = EMPTY_SLOT;
+		}
+		NumTombstones = 0;
+
+		for (auto It = Entries.CreateConstIterator(); It; ++It)
+		{
+			InsertSlot(It.GetIndex(), EntryHashes[It.GetIndex()]);
+		}
+	}
+
+	/** Stable storage for all keys and their output indices */
+	TSparseArray<FEntry> Entries;
+	/** Cached hash of each entry, indexed by sparse entry index */
+	TArray<uint32> EntryHashes;
+	/** Power-of-two open-addressing table containing entry indices, EMPTY_SLOT or TOMBSTONE_SLOT */
+	TArray<int32> Slots;
+	int32 NumTombstones = 0;
+};
+
+/** Default storage for overlapping entity trackers, using hashed maps for all lookups */
+struct FOverlappingEntityMapStorage
+{
+	using FEntityToOutputMap = TMap<FMovieSceneEntityID, uint16>;
+
+	template<typename KeyType>
+	using TKeyToOutputMap = TMap<KeyType, uint16>;
+};
+
+/**
+ * Dense storage for overlapping entity trackers, using an entity-index-addressed side table and an open-addressing
+ * key index. Preferable for trackers that link very large numbers of entities at once.
+ */
+struct FOverlappingEntityDenseStorage
+{
+	using FEntityToOutputMap = FDenseEntityToOutputMap;
+
+	template<typename KeyType>
+	using TKeyToOutputMap = TDenseKeyToOutputMap<KeyType>;
+};
+
 /**
  * Templated utility class that assists in tracking the state of many -> one data relationships in an FEntityManager.
  * InputKeyTypes defines the component type(s) which defines the key that determines whether an entity animates the same output.
  * OutputType defines the user-specfied data to be associated with the multiple inputs (ie, its output)
+ * StoragePolicy defines the containers used for entity -> output and key -> output lookups (see FOverlappingEntityMapStorage)
  */
-template<typename OutputType, typename... InputKeyTypes>
-struct TOverlappingEntityTrackerImpl
+template<typename StoragePolicy, typename OutputType, typename... InputKeyTypes>
+struct TOverlappingEntityTrackerWithStorageImpl
 {
 	using KeyType = TOverlappingEntityInput<InputKeyTypes...>;
 	using ParamType = typename TCallTraits<KeyType>::ParamType;
@@ -517,10 +838,10 @@ protected:
 		FEntityOutputAggregate Aggregate;
 	};
 
-	TMap<FMovieSceneEntityID, uint16> EntityToOutput;
+	typename StoragePolicy::FEntityToOutputMap EntityToOutput;
 	TMultiMap<uint16, FMovieSceneEntityID> OutputToEntity;
 
-	TMap<KeyType, uint16> KeyToOutput;
+	typename StoragePolicy::template TKeyToOutputMap<KeyType> KeyToOutput;
 	TSparseArray< FOutput > Outputs;
 
 	TBitArray<> InvalidatedOutputs, NewOutputs;
@@ -530,9 +851,12 @@ protected:
 	static constexpr uint16 NO_OUTPUT = MAX_uint16;
 };
 
+template<typename OutputType, typename... InputKeyTypes>
+using TOverlappingEntityTrackerImpl = TOverlappingEntityTrackerWithStorageImpl<FOverlappingEntityMapStorage, OutputType, InputKeyTypes...>;
 
-template<typename OutputType, typename... InputTypes>
-struct TOverlappingEntityTracker_NoGarbage : TOverlappingEntityTrackerImpl<OutputType, InputTypes...>
+
+template<typename StoragePolicy, typename OutputType, typename... InputTypes>
+struct TOverlappingEntityTrackerWithStorage_NoGarbage : TOverlappingEntityTrackerWithStorageImpl<StoragePolicy, OutputType, InputTypes...>
 {
 	void Initialize(UMovieSceneEntitySystem* OwningSystem)
 	{
@@ -540,15 +864,15 @@ struct TOverlappingEntityTracker_NoGarbage : TOverlappingEntityTrackerImpl<Outpu
 	}
 };
 
-template<typename OutputType, typename... InputTypes>
-struct TOverlappingEntityTracker_WithGarbage : TOverlappingEntityTrackerImpl<OutputType, InputTypes...>
+template<typename StoragePolicy, typename OutputType, typename... InputTypes>
+struct TOverlappingEntityTrackerWithStorage_WithGarbage : TOverlappingEntityTrackerWithStorageImpl<StoragePolicy, OutputType, InputTypes...>
 {
-	using ThisType = TOverlappingEntityTracker_WithGarbage<OutputType, InputTypes...>;
-	using Super = TOverlappingEntityTrackerImpl<OutputType, InputTypes...>;
+	using ThisType = TOverlappingEntityTrackerWithStorage_WithGarbage<StoragePolicy, OutputType, InputTypes...>;
+	using Super = TOverlappingEntityTrackerWithStorageImpl<StoragePolicy, OutputType, InputTypes...>;
 	using typename Super::FOutput;
 	using typename Super::KeyType;
 
-	~TOverlappingEntityTracker_WithGarbage()
+	~TOverlappingEntityTrackerWithStorage_WithGarbage()
 	{
 		UMovieSceneEntitySystem* OwningSystem = WeakOwningSystem.GetEvenIfUnreachable();
 		UMovieSceneEntitySystemLinker* Linker = OwningSystem ? OwningSystem->GetLinker() : nullptr;
@@ -670,12 +994,28 @@ protected:
 
 
 
-template<typename OutputType, typename... KeyType>
-using TOverlappingEntityTracker = std::conditional_t<
+template<typename OutputType, typename... InputTypes>
+using TOverlappingEntityTracker_NoGarbage = TOverlappingEntityTrackerWithStorage_NoGarbage<FOverlappingEntityMapStorage, OutputType, InputTypes...>;
+
+template<typename OutputType, typename... InputTypes>
+using TOverlappingEntityTracker_WithGarbage = TOverlappingEntityTrackerWithStorage_WithGarbage<FOverlappingEntityMapStorage, OutputType, InputTypes...>;
+
+template<typename StoragePolicy, typename OutputType, typename... KeyType>
+using TOverlappingEntityTrackerWithStorage = std::conditional_t<
 	(THasAddReferencedObjectForComponent<KeyType>::Value || ...) || THasAddReferencedObjectForComponent<OutputType>::Value,
-	TOverlappingEntityTracker_WithGarbage<OutputType, KeyType...>,
-	TOverlappingEntityTracker_NoGarbage<OutputType, KeyType...>
+	TOverlappingEntityTrackerWithStorage_WithGarbage<StoragePolicy, OutputType, KeyType...>,
+	TOverlappingEntityTrackerWithStorage_NoGarbage<StoragePolicy, OutputType, KeyType...>
 >;
 
+template<typename OutputType, typename... KeyType>
+using TOverlappingEntityTracker = TOverlappingEntityTrackerWithStorage<FOverlappingEntityMapStorage, OutputType, KeyType...>;
+
+/**
+ * Overlapping entity tracker with the same interface as TOverlappingEntityTracker, but which uses hash-free dense storage
+ * for its entity and key lookups. See FOverlappingEntityDenseStorage.
+ */
+template<typename OutputType, typename... KeyType>
+using TDenseOverlappingEntityTracker = TOverlappingEntityTrackerWithStorage<FOverlappingEntityDenseStorage, OutputType, KeyType...>;
+
 } // namespace MovieScene
 } // namespace UE
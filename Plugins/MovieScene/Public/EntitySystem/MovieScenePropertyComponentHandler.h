@@ -17,6 +17,8 @@
 #include "Evaluation/PreAnimatedState/MovieScenePreAnimatedStateStorage.h"
 #include "Evaluation/PreAnimatedState/MovieScenePreAnimatedPropertyStorage.h"
 
+#include "Async/ParallelFor.h"
+
 class UMovieSceneTrack;
 
 namespace UE
@@ -56,6 +58,20 @@ struct TInitialValueProcessorImpl<PropertyTraits, TPropertyMetaData<MetaDataType
 	const PropertyTraits* Traits;
 	TPropertyValueStorage<PropertyTraits>* CacheStorage;
 
+	/** A range of initial value slots reserved for an allocation that will be populated concurrently in ProcessDeferred */
+	struct FPendingSlotRange
+	{
+		const FEntityAllocation* Allocation;
+		FInitialValueIndex FirstSlot;
+	};
+	TArray<FPendingSlotRange> PendingSlotRanges;
+
+	/** When true, cached initial values are populated concurrently across allocations using slot-indexed storage */
+	bool bConcurrentSlots;
+
+	/** Index assigned to entities that reuse a value cached by another entity, so they never reset a value they do not own */
+	static constexpr FInitialValueIndex InvalidIndex{ uint16(0xFFFF) };
+
 	FEntityAllocationWriteContext WriteContext;
 
 	TInitialValueProcessorImpl(
@@ -73,6 +89,7 @@ struct TInitialValueProcessorImpl<PropertyTraits, TPropertyMetaData<MetaDataType
 		Traits = InTraits;
 		Interrogation = nullptr;
 		CacheStorage = nullptr;
+		bConcurrentSlots = false;
 	}
 
 	virtual void Initialize(UMovieSceneEntitySystemLinker* Linker, FInitialValueCache* InitialValueCache) override
@@ -88,6 +105,7 @@ struct TInitialValueProcessorImpl<PropertyTraits, TPropertyMetaData<MetaDataType
 		if (InitialValueCache)
 		{
 			CacheStorage = InitialValueCache->GetStorage<PropertyTraits>(InitialValueType);
+			bConcurrentSlots = Linker->EntityManager.GetThreadingModel() != EEntityThreadingModel::NoThreading;
 		}
 	}
 
@@ -103,6 +121,12 @@ struct TInitialValueProcessorImpl<PropertyTraits, TPropertyMetaData<MetaDataType
 		{
 			VisitInterrogationAllocation(Allocation);
 		}
+		else if (CacheStorage && bConcurrentSlots && AllocationType.Contains(BuiltInComponents->FastPropertyOffset) && !AllocationType.Contains(BuiltInComponents->CustomPropertyIndex))
+		{
+			// Only reserve slots for this allocation here - the values are retrieved concurrently in ProcessDeferred.
+			// Custom accessors and slow property bindings are not safe to call off the game thread so are always visited immediately.
+			PendingSlotRanges.Add(FPendingSlotRange{ Allocation, CacheStorage->ReserveSlots(Allocation->Num()) });
+		}
 		else if (CacheStorage)
 		{
 			VisitAllocationCached(Allocation);
@@ -113,11 +137,36 @@ struct TInitialValueProcessorImpl<PropertyTraits, TPropertyMetaData<MetaDataType
 		}
 	}
 
+	virtual void ProcessDeferred() override
+	{
+		if (PendingSlotRanges.Num() == 0)
+		{
+			return;
+		}
+
+		CacheStorage->BeginConcurrentAccess();
+
+		ParallelFor(PendingSlotRanges.Num(), [this](int32 RangeIndex)
+		{
+			PopulateSlots(PendingSlotRanges[RangeIndex]);
+		});
+
+		for (const FPendingSlotRange& Range : PendingSlotRanges)
+		{
+			CommitSlots(Range);
+		}
+		PendingSlotRanges.Empty();
+	}
+
 	virtual void Finalize() override
 	{
+		ensureMsgf(PendingSlotRanges.Num() == 0, TEXT("Initial value processor finalized without processing its deferred allocations."));
+
 		ValuesByChannel.Empty();
+		PendingSlotRanges.Empty();
 		Interrogation = nullptr;
 		CacheStorage = nullptr;
+		bConcurrentSlots = false;
 	}
 
 	void VisitAllocation(const FEntityAllocation* Allocation)
@@ -180,6 +229,7 @@ struct TInitialValueProcessorImpl<PropertyTraits, TPropertyMetaData<MetaDataType
 				if (ExistingIndex)
 				{
 					InitialValues[Index] = CacheStorage->GetCachedValue(ExistingIndex.GetValue());
+					InitialValueIndices[Index] = InvalidIndex;
 				}
 				else
 				{
@@ -201,6 +251,7 @@ struct TInitialValueProcessorImpl<PropertyTraits, TPropertyMetaData<MetaDataType
 				if (ExistingIndex)
 				{
 					InitialValues[Index] = CacheStorage->GetCachedValue(ExistingIndex.GetValue());
+					InitialValueIndices[Index] = InvalidIndex;
 				}
 				else
 				{
@@ -222,6 +273,7 @@ struct TInitialValueProcessorImpl<PropertyTraits, TPropertyMetaData<MetaDataType
 				if (ExistingIndex)
 				{
 					InitialValues[Index] = CacheStorage->GetCachedValue(ExistingIndex.GetValue());
+					InitialValueIndices[Index] = InvalidIndex;
 				}
 				else
 				{
@@ -235,6 +287,73 @@ struct TInitialValueProcessorImpl<PropertyTraits, TPropertyMetaData<MetaDataType
 		}
 	}
 
+	void PopulateSlots(const FPendingSlotRange& Range)
+	{
+		const FEntityAllocation* Allocation = Range.Allocation;
+		const int32 Num = Allocation->Num();
+
+		TComponentWriter<FInitialValueIndex> InitialValueIndices = Allocation->WriteComponents(BuiltInComponents->InitialValueIndex, WriteContext);
+		TComponentWriter<StorageType>        InitialValues       = Allocation->WriteComponents(InitialValueType, WriteContext);
+		TComponentReader<UObject*>           BoundObjects        = Allocation->ReadComponents(BuiltInComponents->BoundObject);
+		TComponentReader<uint16>             FastOffsets         = Allocation->ReadComponents(BuiltInComponents->FastPropertyOffset);
+
+		TTuple< TComponentReader<MetaDataTypes>... > MetaData(
+			Allocation->ReadComponents(MetaDataComponents.template Get<MetaDataIndices>())...
+		);
+
+		// Only fast property offsets are deferred (see Process), since reading them does not call into any user code
+		const uint16* RawOffsets = FastOffsets.AsPtr();
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			TOptional<FInitialValueIndex> ExistingIndex = CacheStorage->FindPropertyIndexConcurrent(BoundObjects[Index], RawOffsets[Index]);
+			if (ExistingIndex)
+			{
+				InitialValues[Index] = CacheStorage->GetCachedValue(ExistingIndex.GetValue());
+				InitialValueIndices[Index] = InvalidIndex;
+			}
+			else
+			{
+				const FInitialValueIndex Slot{ static_cast<uint16>(Range.FirstSlot.Index + Index) };
+				StorageType& Value = CacheStorage->GetSlotValue(Slot);
+				Traits->GetObjectPropertyValue(BoundObjects[Index], MetaData.template Get<MetaDataIndices>()[Index]..., RawOffsets[Index], Value);
+
+				InitialValues[Index] = Value;
+				InitialValueIndices[Index] = Slot;
+			}
+		}
+	}
+
+	void CommitSlots(const FPendingSlotRange& Range)
+	{
+		const FEntityAllocation* Allocation = Range.Allocation;
+		const int32 Num = Allocation->Num();
+
+		TComponentWriter<FInitialValueIndex> InitialValueIndices = Allocation->WriteComponents(BuiltInComponents->InitialValueIndex, WriteContext);
+		TComponentReader<UObject*>           BoundObjects        = Allocation->ReadComponents(BuiltInComponents->BoundObject);
+		TComponentReader<uint16>             FastOffsets         = Allocation->ReadComponents(BuiltInComponents->FastPropertyOffset);
+
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			CommitSlot(FInitialValueIndex{ static_cast<uint16>(Range.FirstSlot.Index + Index) }, BoundObjects[Index], FastOffsets[Index], InitialValueIndices[Index]);
+		}
+	}
+
+	template<typename PropertyKeyType>
+	void CommitSlot(FInitialValueIndex Slot, UObject* BoundObject, const PropertyKeyType& PropertyKey, FInitialValueIndex& InOutIndex)
+	{
+		if (InOutIndex.Index != Slot.Index)
+		{
+			// The entity used an existing cached value so never populated its slot
+			CacheStorage->ReleaseSlot(Slot);
+		}
+		else if (!CacheStorage->CommitSlot(BoundObject, PropertyKey, Slot))
+		{
+			// Another entity in this batch cached the same object and property first
+			CacheStorage->ReleaseSlot(Slot);
+			InOutIndex = InvalidIndex;
+		}
+	}
+
 	void VisitInterrogationAllocation(const FEntityAllocation* Allocation)
 	{
 		const int32 Num = Allocation->Num();
@@ -402,6 +521,7 @@ struct TPropertyComponentHandlerImpl<PropertyTraits, TPropertyMetaData<MetaDataT
 		.ReadOneOf(BuiltInComponents->CustomPropertyIndex, BuiltInComponents->FastPropertyOffset, BuiltInComponents->SlowProperty)
 		.ReadAllOf(Definition.GetMetaDataComponent<MetaDataTypes>(MetaDataIndices)...)
 		.ReadAllOf(Composites[CompositeIndices].ComponentTypeID.ReinterpretCast<CompositeTypes>()...)
+		.WriteOptional(Definition.LastAppliedValueType.ReinterpretCast<TLastAppliedPropertyValue<StorageType>>())
 		.FilterAll({ Definition.PropertyType })
 		.FilterNone({ BuiltInComponents->Tags.Ignored })
 		.CombineFilter(AdditionalFilter)
@@ -449,6 +569,7 @@ struct TPropertyComponentHandlerImpl<PropertyTraits, TPropertyMetaData<MetaDataT
 		.ReadOneOf(BuiltInComponents->CustomPropertyIndex, BuiltInComponents->FastPropertyOffset, BuiltInComponents->SlowProperty)
 		.ReadAllOf(Definition.GetMetaDataComponent<MetaDataTypes>(MetaDataIndices)...)
 		.ReadAllOf(Composites[CompositeIndices].ComponentTypeID.ReinterpretCast<CompositeTypes>()...)
+		.WriteOptional(Definition.LastAppliedValueType.ReinterpretCast<TLastAppliedPropertyValue<StorageType>>())
 		.FilterAll({ Definition.PropertyType })
 		.FilterNone({ BuiltInComponents->Tags.Ignored })
 		.SetStat(Definition.StatID)
@@ -126,6 +126,9 @@ struct FPropertyDefinition
 	/** The component type for this property's inital value (used for relative and/or additive blending) */
 	FComponentTypeID InitialValueType;
 
+	/** (Optional) The component type that records the last value applied to each bound object for this property, if change detection is enabled for it */
+	FComponentTypeID LastAppliedValueType;
+
 	/** MetaData types */
 	TArrayView<const FComponentTypeID> MetaDataTypes;
 
@@ -309,6 +312,7 @@ private:
 			InOutPropertyComponents.InitialValue);
 
 		NewDefinition.StatID = StatID;
+		NewDefinition.LastAppliedValueType = InOutPropertyComponents.LastAppliedValue;
 
 		NewDefinition.MetaDataTypes = InOutPropertyComponents.MetaDataComponents.GetTypes();
 		checkf(!NewDefinition.MetaDataTypes.Contains(FComponentTypeID()), TEXT("Property meta-data component is not defined"));
@@ -9,6 +9,8 @@
 #include "Templates/SharedPointer.h"
 #include "Templates/UnrealTypeTraits.h"
 #include "Containers/StringView.h"
+#include "Concepts/EqualityComparable.h"
+#include "UObject/ObjectKey.h"
 #include "EntitySystem/MovieSceneComponentAccessors.h"
 #include "EntitySystem/MovieScenePropertyMetaData.h"
 
@@ -286,6 +288,65 @@ protected:
 	TArray<TCustomPropertyAccessor<PropertyTraits>, TInlineAllocator<InlineSize>> CustomAccessors;
 };
 
+namespace Private
+{
+	/**
+	 * Check whether two property values are identical. Trivially copyable types are compared bitwise (which treats -0/+0 as a change),
+	 * other types use operator== where available, and are otherwise always considered to have changed.
+	 */
+	template<typename StorageType>
+	FORCEINLINE bool ArePropertyValuesIdentical(const StorageType& A, const StorageType& B)
+	{
+		if constexpr (std::is_trivially_copyable_v<StorageType>)
+		{
+			return FMemory::Memcmp(&A, &B, sizeof(StorageType)) == 0;
+		}
+		else if constexpr (TModels_V<CEqualityComparable, StorageType>)
+		{
+			return A == B;
+		}
+		else
+		{
+			return false;
+		}
+	}
+}
+
+/**
+ * Component that records the value most recently applied to a property by a setter task, along with the object it was applied to.
+ * Only exists on property entities tagged with FBuiltInComponentTypes::Tags.SkipUnchangedPropertyValues whose property type supports change
+ * detection through FComponentRegistry::NewLastAppliedValueType.
+ * Values that are written to the object by anything other than Sequencer are not detected, so this should only be used for properties
+ * that are exclusively driven by Sequencer while animated.
+ */
+template<typename StorageType>
+struct TLastAppliedPropertyValue
+{
+	/** The object that Value was last applied to, or null if nothing has been applied yet */
+	FObjectKey Object;
+
+	/** The value that was last applied to Object */
+	StorageType Value;
+
+	/**
+	 * Check whether the specified value needs to be applied to the specified object, recording it as the last applied value if so
+	 *
+	 * @return true if the value should be applied, false if it is identical to the value that was last applied to the same object
+	 */
+	bool Update(const UObject* InObject, const StorageType& InValue)
+	{
+		const FObjectKey ObjectKey(InObject);
+		if (Object == ObjectKey && Private::ArePropertyValuesIdentical(Value, InValue))
+		{
+			return false;
+		}
+
+		Object = ObjectKey;
+		Value  = InValue;
+		return true;
+	}
+};
+
 /**
  * User-defined property type that is represented as an UE::MovieScene::FPropertyDefinition within UE::MovieScene::FPropertyRegistry
  *
@@ -302,6 +363,9 @@ struct TPropertyComponents
 	FComponentTypeID PropertyTag;
 	TComponentTypeID<typename InPropertyTraits::StorageType> InitialValue;
 
+	/** (Optional) Component used for skipping unchanged values when applying this property. Only defined if FComponentRegistry::NewLastAppliedValueType has been called for this property. */
+	TComponentTypeID<TLastAppliedPropertyValue<typename InPropertyTraits::StorageType>> LastAppliedValue;
+
 	TPropertyMetaDataComponents<typename InPropertyTraits::MetaDataType> MetaDataComponents;
 
 	TCompositePropertyTypeID<InPropertyTraits> CompositeID;
@@ -397,6 +461,32 @@ public:
 	 */
 	void ForEachAllocation(const FEntityAllocation* Allocation, TRead<UObject*> BoundObjectComponents, FTwoWayAccessor ResolvedPropertyComponents, TRead<MetaDataTypes>... MetaDataComponents, TRead<StorageType> PropertyValueComponents) const;
 
+	/**
+	 * Task callback that applies properties for a whole allocation of entities, skipping any entity whose value is identical to the one last applied to its object.
+	 * Must be invoked with a task builder with the specified parameters:
+	 *
+	 *     FEntityTaskBuilder()
+	 *     .Read(          TComponentTypeID<UObject*>(...) )
+	 *     .ReadOneOf(     TComponentTypeID<FCustomPropertyIndex>(...), TComponentTypeID<uint16>(...), TComponentTypeID<TSharedPtr<FTrackInstancePropertyBindings>>(...) )
+	 *     .Read(          TComponentTypeID<PropertyType>(...) )
+	 *     .WriteOptional( TComponentTypeID<TLastAppliedPropertyValue<PropertyType>>(...) )
+	 *     .Dispatch_PerAllocation<TSetPropertyValues<PropertyType>>(...);
+	 */
+	void ForEachAllocation(const FEntityAllocation* Allocation, TRead<UObject*> BoundObjectComponents, FThreeWayAccessor ResolvedPropertyComponents, TRead<MetaDataTypes>... MetaDataComponents, TRead<StorageType> PropertyValueComponents, TWriteOptional<TLastAppliedPropertyValue<StorageType>> LastAppliedValues) const;
+
+	/**
+	 * Task callback that applies properties for a whole allocation of entities, skipping any entity whose value is identical to the one last applied to its object.
+	 * Must be invoked with a task builder with the specified parameters:
+	 *
+	 *     FEntityTaskBuilder()
+	 *     .Read(          TComponentTypeID<UObject*>(...) )
+	 *     .ReadOneOf(     TComponentTypeID<uint16>(...), TComponentTypeID<TSharedPtr<FTrackInstancePropertyBindings>>(...) )
+	 *     .Read(          TComponentTypeID<PropertyType>(...) )
+	 *     .WriteOptional( TComponentTypeID<TLastAppliedPropertyValue<PropertyType>>(...) )
+	 *     .Dispatch_PerAllocation<TSetPropertyValues<PropertyType>>(...);
+	 */
+	void ForEachAllocation(const FEntityAllocation* Allocation, TRead<UObject*> BoundObjectComponents, FTwoWayAccessor ResolvedPropertyComponents, TRead<MetaDataTypes>... MetaDataComponents, TRead<StorageType> PropertyValueComponents, TWriteOptional<TLastAppliedPropertyValue<StorageType>> LastAppliedValues) const;
+
 private:
 
 	const PropertyTraits* Traits;
@@ -680,8 +770,29 @@ public:
 	 */
 	void ForEachAllocation(const FEntityAllocation* Allocation, TRead<UObject*> BoundObjectComponents, FTwoWayAccessor ResolvedPropertyComponents, TRead<MetaDataTypes>... InMetaData, TRead<CompositeTypes>... VariadicComponents) const;
 
+	/**
+	 * Task callback that applies properties for a whole allocation of entities, skipping any entity whose combined value is identical to the one last applied to its object.
+	 * Must be invoked with a task builder with the same parameters as above, followed by:
+	 *
+	 *     .WriteOptional( TComponentTypeID<TLastAppliedPropertyValue<PropertyType>>(...) )
+	 */
+	void ForEachAllocation(const FEntityAllocation* Allocation, TRead<UObject*> BoundObjectComponents, FThreeWayAccessor ResolvedPropertyComponents, TRead<MetaDataTypes>... InMetaData, TRead<CompositeTypes>... VariadicComponents, TWriteOptional<TLastAppliedPropertyValue<StorageType>> LastAppliedValues) const;
+
+	/**
+	 * Task callback that applies properties for a whole allocation of entities, skipping any entity whose combined value is identical to the one last applied to its object.
+	 * Must be invoked with a task builder with the same parameters as above, followed by:
+	 *
+	 *     .WriteOptional( TComponentTypeID<TLastAppliedPropertyValue<PropertyType>>(...) )
+	 */
+	void ForEachAllocation(const FEntityAllocation* Allocation, TRead<UObject*> BoundObjectComponents, FTwoWayAccessor ResolvedPropertyComponents, TRead<MetaDataTypes>... InMetaData, TRead<CompositeTypes>... VariadicComponents, TWriteOptional<TLastAppliedPropertyValue<StorageType>> LastAppliedValues) const;
+
 private:
 
+	void ApplyValue(UObject* InObject, FCustomPropertyIndex CustomPropertyIndex, typename TCallTraits<MetaDataTypes>::ParamType... MetaData, const StorageType& Value) const;
+	void ApplyValue(UObject* InObject, uint16 PropertyOffset, typename TCallTraits<MetaDataTypes>::ParamType... MetaData, const StorageType& Value) const;
+	void ApplyValue(UObject* InObject, const TSharedPtr<FTrackInstancePropertyBindings>& PropertyBindings, typename TCallTraits<MetaDataTypes>::ParamType... MetaData, const StorageType& Value) const;
+
+
 	const PropertyTraits* Traits;
 	const ICustomPropertyRegistration* CustomProperties;
 	FCustomAccessorView CustomAccessors;
@@ -15,7 +15,10 @@
 #include "EntitySystem/MovieSceneComponentAccessors.h"
 #include "EntitySystem/MovieSceneOperationalTypeConversions.h"
 #include "EntitySystem/MovieScenePropertyBinding.h"
+#include "Stats/Stats.h"
 
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Property Values Applied"), MovieSceneEval_PropertyValuesApplied, STATGROUP_MovieSceneECS, MOVIESCENE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Property Values Skipped (Unchanged)"), MovieSceneEval_PropertyValuesSkipped, STATGROUP_MovieSceneECS, MOVIESCENE_API);
 
 namespace UE::MovieScene
 {
@@ -61,12 +64,42 @@ void TSetPropertyValuesImpl<PropertyTraits, TPropertyMetaData<MetaDataTypes...>>
 	FThreeWayAccessor ResolvedPropertyComponents,
 	TRead<MetaDataTypes>... MetaDataComponents,
 	TRead<StorageType> PropertyValueComponents) const
+{
+	ForEachAllocation(Allocation, BoundObjectComponents, ResolvedPropertyComponents, MetaDataComponents..., PropertyValueComponents, TWriteOptional<TLastAppliedPropertyValue<StorageType>>());
+}
+
+template<typename PropertyTraits, typename ...MetaDataTypes>
+void TSetPropertyValuesImpl<PropertyTraits, TPropertyMetaData<MetaDataTypes...>>::ForEachAllocation(
+	const FEntityAllocation* Allocation,
+	TRead<UObject*> BoundObjectComponents,
+	FTwoWayAccessor ResolvedPropertyComponents,
+	TRead<MetaDataTypes>... MetaDataComponents,
+	TRead<StorageType> PropertyValueComponents) const
+{
+	ForEachAllocation(Allocation, BoundObjectComponents, ResolvedPropertyComponents, MetaDataComponents..., PropertyValueComponents, TWriteOptional<TLastAppliedPropertyValue<StorageType>>());
+}
+
+template<typename PropertyTraits, typename ...MetaDataTypes>
+void TSetPropertyValuesImpl<PropertyTraits, TPropertyMetaData<MetaDataTypes...>>::ForEachAllocation(
+	const FEntityAllocation* Allocation,
+	TRead<UObject*> BoundObjectComponents,
+	FThreeWayAccessor ResolvedPropertyComponents,
+	TRead<MetaDataTypes>... MetaDataComponents,
+	TRead<StorageType> PropertyValueComponents,
+	TWriteOptional<TLastAppliedPropertyValue<StorageType>> LastAppliedValues) const
 {
 	const int32 Num = Allocation->Num();
+	int32 NumSkipped = 0;
+
 	if (const FCustomPropertyIndex* Custom = ResolvedPropertyComponents.template Get<0>())
 	{
 		for (int32 Index = 0; Index < Num; ++Index)
 		{
+			if (LastAppliedValues && !LastAppliedValues[Index].Update(BoundObjectComponents[Index], PropertyValueComponents[Index]))
+			{
+				++NumSkipped;
+				continue;
+			}
 			ForEachEntity(BoundObjectComponents[Index], Custom[Index], MetaDataComponents[Index]..., PropertyValueComponents[Index]);
 		}
 	}
@@ -74,6 +107,11 @@ void TSetPropertyValuesImpl<PropertyTraits, TPropertyMetaData<MetaDataTypes...>>
 	{
 		for (int32 Index = 0; Index < Num; ++Index)
 		{
+			if (LastAppliedValues && !LastAppliedValues[Index].Update(BoundObjectComponents[Index], PropertyValueComponents[Index]))
+			{
+				++NumSkipped;
+				continue;
+			}
 			ForEachEntity(BoundObjectComponents[Index], Fast[Index], MetaDataComponents[Index]..., PropertyValueComponents[Index]);
 		}
 	}
@@ -81,9 +119,17 @@ void TSetPropertyValuesImpl<PropertyTraits, TPropertyMetaData<MetaDataTypes...>>
 	{
 		for (int32 Index = 0; Index < Num; ++Index)
 		{
+			if (LastAppliedValues && !LastAppliedValues[Index].Update(BoundObjectComponents[Index], PropertyValueComponents[Index]))
+			{
+				++NumSkipped;
+				continue;
+			}
 			ForEachEntity(BoundObjectComponents[Index], Slow[Index], MetaDataComponents[Index]..., PropertyValueComponents[Index]);
 		}
 	}
+
+	INC_DWORD_STAT_BY(MovieSceneEval_PropertyValuesApplied, Num - NumSkipped);
+	INC_DWORD_STAT_BY(MovieSceneEval_PropertyValuesSkipped, NumSkipped);
 }
 
 template<typename PropertyTraits, typename ...MetaDataTypes>
@@ -92,23 +138,39 @@ void TSetPropertyValuesImpl<PropertyTraits, TPropertyMetaData<MetaDataTypes...>>
 	TRead<UObject*> BoundObjectComponents,
 	FTwoWayAccessor ResolvedPropertyComponents,
 	TRead<MetaDataTypes>... MetaDataComponents,
-	TRead<StorageType> PropertyValueComponents) const
+	TRead<StorageType> PropertyValueComponents,
+	TWriteOptional<TLastAppliedPropertyValue<StorageType>> LastAppliedValues) const
 {
 	const int32 Num = Allocation->Num();
+	int32 NumSkipped = 0;
+
 	if (const uint16* Fast = ResolvedPropertyComponents.template Get<0>())
 	{
 		for (int32 Index = 0; Index < Num; ++Index)
 		{
-			ForEachEntity(BoundObjectComponents[Index], *Fast++, MetaDataComponents[Index]..., PropertyValueComponents[Index]);
+			if (LastAppliedValues && !LastAppliedValues[Index].Update(BoundObjectComponents[Index], PropertyValueComponents[Index]))
+			{
+				++NumSkipped;
+				continue;
+			}
+			ForEachEntity(BoundObjectComponents[Index], Fast[Index], MetaDataComponents[Index]..., PropertyValueComponents[Index]);
 		}
 	}
 	else if (const TSharedPtr<FTrackInstancePropertyBindings>* Slow = ResolvedPropertyComponents.template Get<1>())
 	{
 		for (int32 Index = 0; Index < Num; ++Index)
 		{
-			ForEachEntity(BoundObjectComponents[Index], *Slow++, MetaDataComponents[Index]..., PropertyValueComponents[Index]);
+			if (LastAppliedValues && !LastAppliedValues[Index].Update(BoundObjectComponents[Index], PropertyValueComponents[Index]))
+			{
+				++NumSkipped;
+				continue;
+			}
+			ForEachEntity(BoundObjectComponents[Index], Slow[Index], MetaDataComponents[Index]..., PropertyValueComponents[Index]);
 		}
 	}
+
+	INC_DWORD_STAT_BY(MovieSceneEval_PropertyValuesApplied, Num - NumSkipped);
+	INC_DWORD_STAT_BY(MovieSceneEval_PropertyValuesSkipped, NumSkipped);
 }
 
 template<typename PropertyTraits, typename ...MetaDataTypes>
@@ -210,8 +272,7 @@ void TSetCompositePropertyValuesImpl<PropertyTraits, TPropertyMetaData<MetaDataT
 	typename TCallTraits<MetaDataTypes>::ParamType... MetaData,
 	typename TCallTraits<CompositeTypes>::ParamType... CompositeResults) const
 {
-	StorageType Result = Traits->CombineComposites(MetaData..., CompositeResults...);
-	Traits->SetObjectPropertyValue(InObject, MetaData..., CustomAccessors[CustomPropertyIndex.Value], Result);
+	ApplyValue(InObject, CustomPropertyIndex, MetaData..., Traits->CombineComposites(MetaData..., CompositeResults...));
 }
 
 template<typename PropertyTraits, typename... MetaDataTypes, typename... CompositeTypes>
@@ -220,24 +281,52 @@ void TSetCompositePropertyValuesImpl<PropertyTraits, TPropertyMetaData<MetaDataT
 	uint16 PropertyOffset,
 	typename TCallTraits<MetaDataTypes>::ParamType... MetaData,
 	typename TCallTraits<CompositeTypes>::ParamType... CompositeResults) const
+{
+	ApplyValue(InObject, PropertyOffset, MetaData..., Traits->CombineComposites(MetaData..., CompositeResults...));
+}
+
+template<typename PropertyTraits, typename... MetaDataTypes, typename... CompositeTypes>
+void TSetCompositePropertyValuesImpl<PropertyTraits, TPropertyMetaData<MetaDataTypes...>, CompositeTypes...>::ForEachEntity(
+	UObject* InObject,
+	const TSharedPtr<FTrackInstancePropertyBindings>& PropertyBindings,
+	typename TCallTraits<MetaDataTypes>::ParamType... MetaData,
+	typename TCallTraits<CompositeTypes>::ParamType... CompositeResults) const
+{
+	ApplyValue(InObject, PropertyBindings, MetaData..., Traits->CombineComposites(MetaData..., CompositeResults...));
+}
+
+template<typename PropertyTraits, typename... MetaDataTypes, typename... CompositeTypes>
+void TSetCompositePropertyValuesImpl<PropertyTraits, TPropertyMetaData<MetaDataTypes...>, CompositeTypes...>::ApplyValue(
+	UObject* InObject,
+	FCustomPropertyIndex CustomPropertyIndex,
+	typename TCallTraits<MetaDataTypes>::ParamType... MetaData,
+	const StorageType& Value) const
+{
+	Traits->SetObjectPropertyValue(InObject, MetaData..., CustomAccessors[CustomPropertyIndex.Value], Value);
+}
+
+template<typename PropertyTraits, typename... MetaDataTypes, typename... CompositeTypes>
+void TSetCompositePropertyValuesImpl<PropertyTraits, TPropertyMetaData<MetaDataTypes...>, CompositeTypes...>::ApplyValue(
+	UObject* InObject,
+	uint16 PropertyOffset,
+	typename TCallTraits<MetaDataTypes>::ParamType... MetaData,
+	const StorageType& Value) const
 {
 	// Would really like to avoid branching here, but if we encounter this data the options are either handle it gracefully, stomp a vtable, or report a fatal error.
 	if (ensureAlwaysMsgf(PropertyOffset != 0, TEXT("Invalid property offset specified (ptr+%d bytes) for property on object %s. This would otherwise overwrite the object's vfptr."), PropertyOffset, *InObject->GetName()))
 	{
-		StorageType Result = Traits->CombineComposites(MetaData..., CompositeResults...);
-		Traits->SetObjectPropertyValue(InObject, MetaData..., PropertyOffset, Result);
+		Traits->SetObjectPropertyValue(InObject, MetaData..., PropertyOffset, Value);
 	}
 }
 
 template<typename PropertyTraits, typename... MetaDataTypes, typename... CompositeTypes>
-void TSetCompositePropertyValuesImpl<PropertyTraits, TPropertyMetaData<MetaDataTypes...>, CompositeTypes...>::ForEachEntity(
+void TSetCompositePropertyValuesImpl<PropertyTraits, TPropertyMetaData<MetaDataTypes...>, CompositeTypes...>::ApplyValue(
 	UObject* InObject,
 	const TSharedPtr<FTrackInstancePropertyBindings>& PropertyBindings,
 	typename TCallTraits<MetaDataTypes>::ParamType... MetaData,
-	typename TCallTraits<CompositeTypes>::ParamType... CompositeResults) const
+	const StorageType& Value) const
 {
-	StorageType Result = Traits->CombineComposites(MetaData..., CompositeResults...);
-	Traits->SetObjectPropertyValue(InObject, MetaData..., PropertyBindings.Get(), Result);
+	Traits->SetObjectPropertyValue(InObject, MetaData..., PropertyBindings.Get(), Value);
 }
 
 template<typename PropertyTraits, typename... MetaDataTypes, typename... CompositeTypes>
@@ -247,29 +336,75 @@ void TSetCompositePropertyValuesImpl<PropertyTraits, TPropertyMetaData<MetaDataT
 	FThreeWayAccessor ResolvedPropertyComponents,
 	TRead<MetaDataTypes>... InMetaData,
 	TRead<CompositeTypes>... VariadicComponents) const
+{
+	ForEachAllocation(Allocation, BoundObjectComponents, ResolvedPropertyComponents, InMetaData..., VariadicComponents..., TWriteOptional<TLastAppliedPropertyValue<StorageType>>());
+}
+
+template<typename PropertyTraits, typename... MetaDataTypes, typename... CompositeTypes>
+void TSetCompositePropertyValuesImpl<PropertyTraits, TPropertyMetaData<MetaDataTypes...>, CompositeTypes...>::ForEachAllocation(
+	const FEntityAllocation* Allocation,
+	TRead<UObject*> BoundObjectComponents,
+	FTwoWayAccessor ResolvedPropertyComponents,
+	TRead<MetaDataTypes>... InMetaData,
+	TRead<CompositeTypes>... VariadicComponents) const
+{
+	ForEachAllocation(Allocation, BoundObjectComponents, ResolvedPropertyComponents, InMetaData..., VariadicComponents..., TWriteOptional<TLastAppliedPropertyValue<StorageType>>());
+}
+
+template<typename PropertyTraits, typename... MetaDataTypes, typename... CompositeTypes>
+void TSetCompositePropertyValuesImpl<PropertyTraits, TPropertyMetaData<MetaDataTypes...>, CompositeTypes...>::ForEachAllocation(
+	const FEntityAllocation* Allocation,
+	TRead<UObject*> BoundObjectComponents,
+	FThreeWayAccessor ResolvedPropertyComponents,
+	TRead<MetaDataTypes>... InMetaData,
+	TRead<CompositeTypes>... VariadicComponents,
+	TWriteOptional<TLastAppliedPropertyValue<StorageType>> LastAppliedValues) const
 {
 	const int32 Num = Allocation->Num();
+	int32 NumSkipped = 0;
+
 	if (const FCustomPropertyIndex* Custom = ResolvedPropertyComponents.template Get<0>())
 	{
 		for (int32 Index = 0; Index < Num; ++Index )
 		{
-			ForEachEntity( BoundObjectComponents[Index], Custom[Index], InMetaData[Index]..., VariadicComponents[Index]... );
+			const StorageType Value = Traits->CombineComposites(InMetaData[Index]..., VariadicComponents[Index]...);
+			if (LastAppliedValues && !LastAppliedValues[Index].Update(BoundObjectComponents[Index], Value))
+			{
+				++NumSkipped;
+				continue;
+			}
+			ApplyValue( BoundObjectComponents[Index], Custom[Index], InMetaData[Index]..., Value );
 		}
 	}
 	else if (const uint16* Fast = ResolvedPropertyComponents.template Get<1>())
 	{
 		for (int32 Index = 0; Index < Num; ++Index )
 		{
-			ForEachEntity( BoundObjectComponents[Index], Fast[Index], InMetaData[Index]..., VariadicComponents[Index]... );
+			const StorageType Value = Traits->CombineComposites(InMetaData[Index]..., VariadicComponents[Index]...);
+			if (LastAppliedValues && !LastAppliedValues[Index].Update(BoundObjectComponents[Index], Value))
+			{
+				++NumSkipped;
+				continue;
+			}
+			ApplyValue( BoundObjectComponents[Index], Fast[Index], InMetaData[Index]..., Value );
 		}
 	}
 	else if (const TSharedPtr<FTrackInstancePropertyBindings>* Slow = ResolvedPropertyComponents.template Get<2>())
 	{
 		for (int32 Index = 0; Index < Num; ++Index )
 		{
-			ForEachEntity( BoundObjectComponents[Index], Slow[Index], InMetaData[Index]..., VariadicComponents[Index]... );
+			const StorageType Value = Traits->CombineComposites(InMetaData[Index]..., VariadicComponents[Index]...);
+			if (LastAppliedValues && !LastAppliedValues[Index].Update(BoundObjectComponents[Index], Value))
+			{
+				++NumSkipped;
+				continue;
+			}
+			ApplyValue( BoundObjectComponents[Index], Slow[Index], InMetaData[Index]..., Value );
 		}
 	}
+
+	INC_DWORD_STAT_BY(MovieSceneEval_PropertyValuesApplied, Num - NumSkipped);
+	INC_DWORD_STAT_BY(MovieSceneEval_PropertyValuesSkipped, NumSkipped);
 }
 
 template<typename PropertyTraits, typename... MetaDataTypes, typename... CompositeTypes>
@@ -278,23 +413,41 @@ void TSetCompositePropertyValuesImpl<PropertyTraits, TPropertyMetaData<MetaDataT
 	TRead<UObject*> BoundObjectComponents,
 	FTwoWayAccessor ResolvedPropertyComponents,
 	TRead<MetaDataTypes>... InMetaData,
-	TRead<CompositeTypes>... VariadicComponents) const
+	TRead<CompositeTypes>... VariadicComponents,
+	TWriteOptional<TLastAppliedPropertyValue<StorageType>> LastAppliedValues) const
 {
 	const int32 Num = Allocation->Num();
+	int32 NumSkipped = 0;
+
 	if (const uint16* Fast = ResolvedPropertyComponents.template Get<0>())
 	{
 		for (int32 Index = 0; Index < Num; ++Index )
 		{
-			ForEachEntity( BoundObjectComponents[Index], Fast[Index], InMetaData[Index]..., VariadicComponents[Index]... );
+			const StorageType Value = Traits->CombineComposites(InMetaData[Index]..., VariadicComponents[Index]...);
+			if (LastAppliedValues && !LastAppliedValues[Index].Update(BoundObjectComponents[Index], Value))
+			{
+				++NumSkipped;
+				continue;
+			}
+			ApplyValue( BoundObjectComponents[Index], Fast[Index], InMetaData[Index]..., Value );
 		}
 	}
 	else if (const TSharedPtr<FTrackInstancePropertyBindings>* Slow = ResolvedPropertyComponents.template Get<1>())
 	{
 		for (int32 Index = 0; Index < Num; ++Index )
 		{
-			ForEachEntity( BoundObjectComponents[Index], Slow[Index], InMetaData[Index]..., VariadicComponents[Index]... );
+			const StorageType Value = Traits->CombineComposites(InMetaData[Index]..., VariadicComponents[Index]...);
+			if (LastAppliedValues && !LastAppliedValues[Index].Update(BoundObjectComponents[Index], Value))
+			{
+				++NumSkipped;
+				continue;
+			}
+			ApplyValue( BoundObjectComponents[Index], Slow[Index], InMetaData[Index]..., Value );
 		}
 	}
+
+	INC_DWORD_STAT_BY(MovieSceneEval_PropertyValuesApplied, Num - NumSkipped);
+	INC_DWORD_STAT_BY(MovieSceneEval_PropertyValuesSkipped, NumSkipped);
 }
 
 } // namespace UE::MovieScene
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include "MovieSceneSpawnablesSystem.generated.h"
 
 class UObject;
+class UMovieSceneEntitySystemLinker;
 struct FMovieSceneAnimTypeID;
 
 UCLASS(MinimalAPI)
@@ -22,6 +23,13 @@ public:
 
 	MOVIESCENE_API static FMovieSceneAnimTypeID GetAnimTypeID();
 
+	/**
+	 * Scan the evaluation field of all playing root sequences Sequencer.SpawnableLookAhead.Seconds ahead of their current time,
+	 * and pre-spawn hidden objects for any spawnables that will become active there so that spawning them is a cheap handoff from the spawnable pool.
+	 * Called once per spawn phase by the runner. Does nothing unless both the look-ahead and Sequencer.SpawnablePool.Enable are enabled.
+	 */
+	MOVIESCENE_API static void PreSpawnUpcomingSpawnables(UMovieSceneEntitySystemLinker* Linker);
+
 private:
 
 	virtual void OnRun(FSystemTaskPrerequisites& InPrerequisites, FSystemSubsequentTasks& Subsequents) override final;
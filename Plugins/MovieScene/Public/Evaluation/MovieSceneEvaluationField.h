@@ -280,6 +280,15 @@ struct FMovieSceneEntityComponentField
 	 */
 	MOVIESCENE_API void QueryPersistentEntities(FFrameNumber QueryTime, TFunctionRef<bool(const FMovieSceneEvaluationFieldEntityQuery&)> QueryCallback, TRange<FFrameNumber>& OutRange) const;
 
+	/**
+	 * Query the persistent entities that overlap with the specified query range.
+	 * @note: Entities are added in time order, so those nearest the start of the range are visited first when iterating OutEntities.
+	 *
+	 * @param QueryRange  The range over which to query the field (in the TickResolution of the sequence this was generated from)
+	 * @param OutEntities A set that will be populated with all the entities that exist at any time within the specified range
+	 */
+	MOVIESCENE_API void QueryPersistentEntities(const TRange<FFrameNumber>& QueryRange, FMovieSceneEvaluationFieldEntitySet& OutEntities) const;
+
 	/**
 	 * Check whether this field contains any one-shot entities
 	 */
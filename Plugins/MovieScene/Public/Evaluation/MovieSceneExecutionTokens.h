@@ -20,6 +20,8 @@
 #include "Misc/InlineValue.h"
 #include "MovieSceneExecutionToken.h"
 #include "MovieSceneFwd.h"
+#include "Templates/AlignmentTemplates.h"
+#include "Templates/Decay.h"
 #include "Templates/EnableIf.h"
 #include "Templates/PointerIsConvertibleFromTo.h"
 #include "Templates/RemoveReference.h"
@@ -28,6 +30,65 @@
 class IMovieScenePlayer;
 
 
+/**
+ * Linear allocator used for storing execution tokens between their creation and application.
+ * Allocations are never freed individually - the arena is reset once all its tokens have been applied, retaining its memory for the next evaluation.
+ */
+struct FMovieSceneExecutionTokenArena
+{
+	FMovieSceneExecutionTokenArena() = default;
+	MOVIESCENE_API ~FMovieSceneExecutionTokenArena();
+
+	FMovieSceneExecutionTokenArena(const FMovieSceneExecutionTokenArena&) = delete;
+	FMovieSceneExecutionTokenArena& operator=(const FMovieSceneExecutionTokenArena&) = delete;
+
+	MOVIESCENE_API FMovieSceneExecutionTokenArena(FMovieSceneExecutionTokenArena&& RHS);
+	MOVIESCENE_API FMovieSceneExecutionTokenArena& operator=(FMovieSceneExecutionTokenArena&& RHS);
+
+	/**
+	 * Allocate uninitialized memory from this arena. The memory remains valid until Reset is called.
+	 */
+	void* Allocate(SIZE_T Size, SIZE_T Alignment)
+	{
+		if (CurrentBlock < Blocks.Num())
+		{
+			const FBlock& Block = Blocks[CurrentBlock];
+			uint8* Result = Align(Block.Memory + CurrentOffset, Alignment);
+			if (Result + Size <= Block.Memory + Block.Size)
+			{
+				CurrentOffset = static_cast<SIZE_T>(Result + Size - Block.Memory);
+				return Result;
+			}
+		}
+		return AllocateSlow(Size, Alignment);
+	}
+
+	/**
+	 * Discard all allocations, retaining all memory for subsequent allocations.
+	 * If more than one block was required since the last reset, the blocks are consolidated into a single block large enough for all of them.
+	 */
+	MOVIESCENE_API void Reset();
+
+private:
+
+	MOVIESCENE_API void* AllocateSlow(SIZE_T Size, SIZE_T Alignment);
+	MOVIESCENE_API void FreeBlocks();
+
+	struct FBlock
+	{
+		uint8* Memory;
+		SIZE_T Size;
+	};
+
+	/** All the blocks owned by this arena */
+	TArray<FBlock, TInlineAllocator<2>> Blocks;
+	/** The index of the block that is currently being allocated from */
+	int32 CurrentBlock = 0;
+	/** The offset within the current block of the next allocation */
+	SIZE_T CurrentOffset = 0;
+};
+
+
 /**
  * Ordered execution token stack that accumulates tokens that will apply animated state to the sequence environment at a later time
  */
@@ -42,7 +103,9 @@ struct FMovieSceneExecutionTokens
 	FMovieSceneExecutionTokens& operator=(const FMovieSceneExecutionTokens&) = delete;
 
 	FMovieSceneExecutionTokens(FMovieSceneExecutionTokens&&) = default;
-	FMovieSceneExecutionTokens& operator=(FMovieSceneExecutionTokens&&) = default;
+	MOVIESCENE_API FMovieSceneExecutionTokens& operator=(FMovieSceneExecutionTokens&& RHS);
+
+	MOVIESCENE_API ~FMovieSceneExecutionTokens();
 
 	/**
 	 * Add a new IMovieSceneExecutionToken derived token to the stack
@@ -51,7 +114,10 @@ struct FMovieSceneExecutionTokens
 	inline typename TEnableIf<TPointerIsConvertibleFromTo<typename TRemoveReference<T>::Type, const IMovieSceneExecutionToken>::Value>::Type Add(T&& InToken)
 	{
 		check(Scope.Key.IsValid() && Operand.IsValid());
-		OrderedTokens.Add(FEntry(Operand, Scope, Context, Forward<T>(InToken)));
+
+		typedef typename TDecay<T>::Type TokenType;
+		IMovieSceneExecutionToken* Token = new (Arena.Allocate(sizeof(TokenType), alignof(TokenType))) TokenType(Forward<T>(InToken));
+		OrderedTokens.Add(FEntry(Operand, Scope, Context, Token));
 	}
 
 	/**
@@ -61,7 +127,10 @@ struct FMovieSceneExecutionTokens
 	inline typename TEnableIf<TPointerIsConvertibleFromTo<typename TRemoveReference<T>::Type, const IMovieSceneSharedExecutionToken>::Value>::Type AddShared(FMovieSceneSharedDataId ID, T&& InToken)
 	{
 		checkf(!SharedTokens.Contains(ID), TEXT("Already added a shared token of this type"));
-		SharedTokens.Add(ID, MoveTemp(InToken));
+
+		typedef typename TDecay<T>::Type TokenType;
+		IMovieSceneSharedExecutionToken* Token = new (Arena.Allocate(sizeof(TokenType), alignof(TokenType))) TokenType(MoveTemp(InToken));
+		SharedTokens.Add(ID, Token);
 	}
 
 	/**
@@ -69,8 +138,7 @@ struct FMovieSceneExecutionTokens
 	 */
 	IMovieSceneSharedExecutionToken* FindShared(FMovieSceneSharedDataId ID)
 	{
-		auto* Existing = SharedTokens.Find(ID);
-		return Existing ? Existing->GetPtr() : nullptr;
+		return SharedTokens.FindRef(ID);
 	}
 
 public:
@@ -147,34 +215,40 @@ public:
 
 private:
 
+	/** Destroy all tokens that have not yet been applied, and reset the arena */
+	void DiscardTokens();
+
 	struct FEntry
 	{
-		FEntry(const FMovieSceneEvaluationOperand& InOperand, const FMovieSceneEvaluationScope& InScope, const FMovieSceneContext& InContext, TInlineValue<IMovieSceneExecutionToken, 64>&& InToken)
+		FEntry(const FMovieSceneEvaluationOperand& InOperand, const FMovieSceneEvaluationScope& InScope, const FMovieSceneContext& InContext, IMovieSceneExecutionToken* InToken)
 			: Operand(InOperand)
 			, Scope(InScope)
 			, Context(InContext)
-			, Token(MoveTemp(InToken))
+			, Token(InToken)
 		{
 		}
 
-		FEntry(FEntry&&) = default;
-		FEntry& operator=(FEntry&&) = default;
-
 		/** The operand we were operating on when this token was added */
 		FMovieSceneEvaluationOperand Operand;
 		/** The evaluation scope at the time this token was created */
 		FMovieSceneEvaluationScope Scope;
 		/** The context from when this token was added */
 		FMovieSceneContext Context;
-		/** The user-provided token */
-		TInlineValue<IMovieSceneExecutionToken, 64> Token;
+		/** The user-provided token, allocated from the arena */
+		IMovieSceneExecutionToken* Token;
 	};
 
-	/** Ordered array of tokens */
+	/** Ordered array of tokens. Reset rather than emptied after each application. */
 	TArray<FEntry> OrderedTokens;
 
-	/** Sortable, shared array of identifyable tokens */
-	TMap<FMovieSceneSharedDataId, TInlineValue<IMovieSceneSharedExecutionToken, 32>> SharedTokens;
+	/** Sortable, shared array of identifyable tokens, allocated from the arena */
+	TMap<FMovieSceneSharedDataId, IMovieSceneSharedExecutionToken*> SharedTokens;
+
+	/** Scratch array used for sorting shared tokens on application, retained between evaluations */
+	TArray<IMovieSceneSharedExecutionToken*> SortedSharedTokens;
+
+	/** Linear arena that stores all tokens until they are applied */
+	FMovieSceneExecutionTokenArena Arena;
 
 	/** Accumulator used to marshal blended animation data */
 	FMovieSceneBlendingAccumulator BlendingAccumulator;
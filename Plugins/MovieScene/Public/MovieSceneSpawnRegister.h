@@ -18,6 +18,7 @@
 #include "Templates/SharedPointer.h"
 #include "Templates/TypeHash.h"
 #include "Templates/ValueOrError.h"
+#include "UObject/ObjectKey.h"
 #include "UObject/WeakObjectPtr.h"
 #include "UObject/WeakObjectPtrTemplates.h"
 
@@ -42,6 +43,39 @@ namespace UE::MovieScene
 	struct FSharedPlaybackState;
 }  // namespace UE::MovieScene
 
+/**
+ * Statistics for objects reused from the spawnable pool of an FMovieSceneSpawnRegister
+ */
+struct FMovieSceneSpawnablePoolStats
+{
+	/** The number of spawns that reused a pooled object */
+	int32 NumHits = 0;
+	/** The number of spawns that had to spawn a new object because there was no pooled object available */
+	int32 NumMisses = 0;
+	/** The number of objects that were parked in the pool instead of being destroyed */
+	int32 NumParked = 0;
+	/** The number of objects that were spawned ahead of time directly into the pool */
+	int32 NumPreSpawned = 0;
+	/** The total time spent spawning new objects on a miss, or ahead of time */
+	double SpawnSeconds = 0.0;
+	/** The total time spent reactivating pooled objects on a hit */
+	double ReuseSeconds = 0.0;
+
+	/** The proportion of spawns that reused a pooled object */
+	double GetHitRate() const
+	{
+		const int32 NumSpawns = NumHits + NumMisses;
+		return NumSpawns > 0 ? double(NumHits) / NumSpawns : 0.0;
+	}
+
+	/** The estimated time saved by reusing pooled objects, based on the average time taken to spawn a new object */
+	double GetEstimatedSavedSeconds() const
+	{
+		const int32 NumSpawned = NumMisses + NumPreSpawned;
+		return NumSpawned > 0 ? FMath::Max(0.0, NumHits * (SpawnSeconds / NumSpawned) - ReuseSeconds) : 0.0;
+	}
+};
+
 /**
  * Class responsible for managing spawnables in a movie scene
  */
@@ -83,6 +117,17 @@ public:
 	 */
 	MOVIESCENE_API virtual UObject* SpawnObject(const FGuid& BindingId, UMovieScene& MovieScene, FMovieSceneSequenceIDRef Template, TSharedRef<const FSharedPlaybackState> SharedPlaybackState, int32 BindingIndex);
 
+	/**
+	 * Spawn an object for the specified GUID ahead of time, and park it in the spawnable pool so that a subsequent call to SpawnObject is a cheap handoff.
+	 * Does nothing unless Sequencer.SpawnablePool.Enable is set, or if an object is already spawned or pooled for this binding.
+	 *
+	 * @param BindingId 	ID of the object to spawn
+	 * @param TemplateID 	Identifier for the template that will spawn the object
+	 * @param BindingIndex 	For level sequences using custom spawnable bindings, the index of the binding reference.
+	 * @return true if a new object was spawned into the pool, false otherwise
+	 */
+	MOVIESCENE_API bool PreSpawnObject(const FGuid& BindingId, UMovieScene& MovieScene, FMovieSceneSequenceIDRef TemplateID, TSharedRef<const FSharedPlaybackState> SharedPlaybackState, int32 BindingIndex);
+
 	/**
 	 * Destroy a specific previously spawned object
 	 *
@@ -137,6 +182,23 @@ public:
 	 */
 	MOVIESCENE_API void OnSequenceExpired(FMovieSceneSequenceIDRef TemplateID, TSharedRef<const FSharedPlaybackState> SharedPlaybackState);
 
+public:
+
+	/**
+	 * Destroy all objects that are currently parked in the spawnable pool. Called automatically by CleanUp.
+	 * Derived spawn registers should call this (or CleanUp) before they are destroyed: the base destructor can no longer reach
+	 * PreDestroyObject or DestroySpawnedObject, so it can only destroy any remaining pooled actors directly.
+	 */
+	MOVIESCENE_API void EmptySpawnablePool();
+
+	/**
+	 * Retrieve statistics for the spawnable pool. Only gathered while Sequencer.SpawnablePool.Enable is set.
+	 */
+	const FMovieSceneSpawnablePoolStats& GetSpawnablePoolStats() const
+	{
+		return PoolStats;
+	}
+
 public:
 
 	// Backwards compatible API, to be deprecated later
@@ -252,8 +314,73 @@ protected:
 	 */
 	virtual void DestroySpawnedObject(UObject& Object, UMovieSceneSpawnableBindingBase* CustomSpawnableBinding) = 0;
 
+	/** State of a pooled object from before it was deactivated, restored when the object is reused */
+	struct FPooledObjectState
+	{
+		/** Whether the actor was hidden in game */
+		bool bHiddenInGame = false;
+
+		/** Whether the actor had collision enabled */
+		bool bCollisionEnabled = true;
+
+		/** Whether the actor's primary tick function was enabled */
+		bool bTickEnabled = true;
+	};
+
+	/**
+	 * Called to deactivate a spawned object so that it can be parked in the spawnable pool instead of being destroyed.
+	 * The default implementation supports actors by hiding them and disabling their collision and ticking.
+	 *
+	 * @param Object 			The object to deactivate
+	 * @param OutState 			Receives the object's state from before it was deactivated
+	 * @return true if the object was deactivated and can be pooled, false to destroy it as normal
+	 */
+	MOVIESCENE_API virtual bool DeactivatePooledObject(UObject& Object, FPooledObjectState& OutState);
+
+	/**
+	 * Called to reactivate a pooled object when it is reused for a new spawn, after any pre-animated state captured for it has been restored
+	 *
+	 * @param Object 			The object to reactivate
+	 * @param State 			The object's state from before it was deactivated
+	 */
+	MOVIESCENE_API virtual void ReactivatePooledObject(UObject& Object, const FPooledObjectState& State);
+
 protected:
 
+	/**
+	 * Key that identifies objects within the spawnable pool that can be used interchangeably
+	 */
+	struct FSpawnablePoolKey
+	{
+		FSpawnablePoolKey() = default;
+
+		FSpawnablePoolKey(const UObject* InTemplate, int32 InBindingIndex)
+			: Template(InTemplate)
+			, BindingIndex(InBindingIndex)
+		{}
+
+		explicit operator bool() const
+		{
+			return Template != FObjectKey();
+		}
+
+		bool operator==(const FSpawnablePoolKey& Other) const
+		{
+			return Template == Other.Template && BindingIndex == Other.BindingIndex;
+		}
+
+		friend uint32 GetTypeHash(const FSpawnablePoolKey& Key)
+		{
+			return HashCombine(GetTypeHash(Key.Template), GetTypeHash(Key.BindingIndex));
+		}
+
+		/** The object template for old-style spawnables, or the custom spawnable binding that spawns the object */
+		FObjectKey Template;
+
+		/** For level sequences using custom spawnable bindings, the index of the binding reference. */
+		int32 BindingIndex = 0;
+	};
+
 	/** Structure holding information pertaining to a spawned object */
 	struct FSpawnedObject
 	{
@@ -271,6 +398,31 @@ protected:
 
 		/** What level of ownership this object was spawned with */
 		ESpawnOwnership Ownership;
+
+		/** Key for the spawnable pool that this object can be parked in when it is no longer needed. Only valid when pooling is enabled. */
+		FSpawnablePoolKey PoolKey;
+	};
+
+	/** An object that is parked in the spawnable pool */
+	struct FPooledObject
+	{
+		/** The deactivated object */
+		TWeakObjectPtr<UObject> Object;
+
+		/** The custom spawnable binding that spawned the object, if any, for when the pooled object is destroyed */
+		TWeakObjectPtr<UMovieSceneSpawnableBindingBase> CustomSpawnableBinding;
+
+		/** The object's state from before it was deactivated */
+		FPooledObjectState State;
+
+		/** The binding that the object was last spawned for, passed to PreDestroyObject when the pooled object is eventually destroyed */
+		FGuid BindingId;
+
+		/** The sequence that the object was last spawned for */
+		FMovieSceneSequenceID TemplateID;
+
+		/** For level sequences using custom spawnable bindings, the index of the binding reference. */
+		int32 BindingIndex = 0;
 	};
 
 	/**
@@ -305,11 +457,40 @@ protected:
 		int32 BindingIndex = 0;
 	};
 
+private:
+
+	/**
+	 * Reuse a deactivated object from the spawnable pool, restoring any pre-animated state that was captured for it
+	 */
+	UObject* TakePooledObject(const FSpawnablePoolKey& PoolKey, TSharedRef<const FSharedPlaybackState> SharedPlaybackState);
+
+	/**
+	 * Attempt to park a spawned object in the spawnable pool rather than destroying it
+	 */
+	bool ParkPooledObject(const FMovieSceneSpawnRegisterKey& Key, const FSpawnedObject& SpawnedObject, UMovieSceneSpawnableBindingBase* CustomSpawnableBinding);
+
+	/**
+	 * Destroy all pooled objects that match the specified predicate
+	 */
+	void DestroyPooledObjects(TFunctionRef<bool(const FPooledObject&)> Predicate);
+
+	/**
+	 * Call PreDestroyObject on this register and any custom spawnable binding, then destroy the object.
+	 * Used for every spawned or pooled object that is destroyed so that all destroy paths notify in the same way.
+	 */
+	void PreDestroyAndDestroySpawnedObject(UObject& Object, const FGuid& BindingId, int32 BindingIndex, FMovieSceneSequenceIDRef TemplateID, UMovieSceneSpawnableBindingBase* CustomSpawnableBinding);
+
 protected:
 
 	/** Register of spawned objects */
 	TMap<FMovieSceneSpawnRegisterKey, FSpawnedObject> Register;
 
+	/** Deactivated objects that can be reused for spawns with the same pool key */
+	TMap<FSpawnablePoolKey, TArray<FPooledObject>> SpawnablePool;
+
+	/** Statistics for the spawnable pool */
+	FMovieSceneSpawnablePoolStats PoolStats;
+
 	/** True when cleaning ourselves up. Used to bypass marking a sequence dirty when objects are modified since we're cleaning ourselves up */
 	bool bCleaningUp = false;
 };
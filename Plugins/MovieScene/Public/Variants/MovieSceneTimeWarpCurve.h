@@ -31,9 +31,27 @@ public:
 	UE::MovieScene::ETimeWarpChannelDomain GetDomain() const override;
 	/* End UMovieSceneTimeWarpGetter Implementation */
 
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual bool Modify(bool bAlwaysMarkDirty = true) override;
+#endif
+
+protected:
+
+	void UpdateInverseLookupTable();
+
+public:
+
 
 	/** Curve defined as a 1:1 mapping from unwarped to warped time. Supports all cycle and extrap modes. */
 	UPROPERTY(EditAnywhere, Category="TimeWarp")
 	FMovieSceneTimeWarpChannel Channel;
+
+private:
+
+#if WITH_EDITOR
+	/** True while inside Modify, which broadcasts signature changes before the channel's keys have been edited */
+	bool bIsModifying = false;
+#endif
 };
 